@@ -0,0 +1,267 @@
+/**
+ *  A simple interactive texas holdem poker program.
+ *  Copyright (C) 2020, Matt Zimmerer, mzimmere@gmail.com
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ **/
+
+#include "DuplicateEvaluator.h"
+
+#include <cmath>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include "PokerGame/AI.h"
+#include "PokerGame/Deck.h"
+#include "PokerGame/MCTS.h"
+#include "PokerGame/PokerGame.h"
+#include "PokerGame/PokerGameImpl.h"
+#include "PokerGame/Random.h"
+
+/// The z score of a 95% confidence interval
+static constexpr double CONFIDENCE_Z = 1.96;
+
+/** Decider that plays the first player in one seat and the second player in the other
+ */
+class DuplicateDecider
+{
+public:
+
+	/** Constructor
+	 *  @param players The player in each seat
+	 *  @param search_iterations_in The rollouts of each decision of a SEARCH player
+	 *  @param parameters The parameters that the player in each seat plays by if it is QUICK
+	 */
+	DuplicateDecider(const utl::array<DuplicateEvaluator::Player, 2>& players_in, uint32_t search_iterations_in,
+		const utl::array<const AI::Parameters*, 2>& parameters_in) :
+		players(players_in),
+		search_iterations(search_iterations_in),
+		parameters(parameters_in)
+	{
+	}
+
+	/** Decide an action
+	 *  @param state The full game state
+	 *  @param player_id The id of the player that is acting
+	 *  @param rng A random number generator
+	 *  @return The first element is the action, the second is the bet, if any
+	 */
+	utl::pair<PokerGameBase::PlayerAction, uint16_t> decide(const BasicPokerGameState<2>& state, uint8_t player_id, Random& rng)
+	{
+		switch (this->players[player_id])
+		{
+		case DuplicateEvaluator::Player::QUICK:
+			return AI::quickDecision<2>(state, rng, player_id, *this->parameters[player_id]);
+		case DuplicateEvaluator::Player::SEARCH:
+			return MCTS::decide<2>(state, player_id, this->search_iterations, 0, rng);
+		default:
+			return AI::computerDecision<2>(state, rng, player_id);
+		}
+	}
+
+private:
+
+	/// The player in each seat
+	utl::array<DuplicateEvaluator::Player, 2> players;
+
+	/// The rollouts of each decision of a SEARCH player
+	uint32_t search_iterations;
+
+	/// The parameters that the player in each seat plays by if it is QUICK
+	utl::array<const AI::Parameters*, 2> parameters;
+};
+
+/** Observer that ends the game after a single hand and keeps the final stacks
+ */
+class SingleHandObserver : public NullObserver
+{
+public:
+
+	/** Constructor
+	 *  @param stacks_in Set to each seat's stack at the end of the hand
+	 */
+	explicit SingleHandObserver(utl::array<uint16_t, 2>* stacks_in) : stacks(stacks_in) {}
+
+	template <class State, class RevealingPlayers>
+	bool roundEnd(bool, const utl::string<MAX_NAME_SIZE>&, uint16_t, RankedHand::Ranking, const State& state, const RevealingPlayers&)
+	{
+		// The stacks have been paid out, stop before the next hand
+		for (uint8_t seat = 0; seat < 2; ++seat)
+			(*this->stacks)[seat] = state.player_states[seat].stack;
+		return false;
+	}
+
+private:
+
+	/// Each seat's stack at the end of the hand
+	utl::array<uint16_t, 2>* stacks;
+};
+
+/** Dealer that deals a fixed deck order from a fixed dealer, so that both hands of a deal see the same cards
+ */
+class FixedDeckDealer
+{
+public:
+
+	/** Constructor
+	 *  @param order_in The deck order to deal
+	 */
+	explicit FixedDeckDealer(const Deck::Snapshot& order_in) : order(order_in) {}
+
+	uint8_t chooseDealer(Random& rng, uint8_t seats)
+	{
+		return 0;
+	}
+
+	void shuffle(Deck& deck)
+	{
+		deck.restoreSnapshot(this->order);
+	}
+
+	Card dealCard(Deck& deck)
+	{
+		return deck.dealCard();
+	}
+
+private:
+
+	/// The deck order to deal
+	Deck::Snapshot order;
+};
+
+/// A single hand of a deal
+using DuplicateGame = BasicPokerGame<2, DuplicateDecider, SingleHandObserver, FixedDeckDealer>;
+
+/** Get the half width of a 95% confidence interval of a mean
+ *  @param count The number of samples
+ *  @param sum The sum of the samples
+ *  @param squares The sum of the squares of the samples
+ *  @return The half width
+ */
+static double confidenceInterval(uint64_t count, double sum, double squares)
+{
+	if (count < 2)
+		return 0.0;
+	double mean = sum / count;
+	double variance = (squares - sum * mean) / (count - 1);
+	return CONFIDENCE_Z * std::sqrt(variance > 0.0 ? variance : 0.0) / std::sqrt(static_cast<double>(count));
+}
+
+void DuplicateEvaluator::Result::merge(const Result& other)
+{
+	this->deals += other.deals;
+	this->sum += other.sum;
+	this->squares += other.squares;
+	this->single_sum += other.single_sum;
+	this->single_squares += other.single_squares;
+}
+
+double DuplicateEvaluator::Result::winRate() const
+{
+	if (this->deals == 0)
+		return 0.0;
+	return this->sum / this->deals / (2 * SMALL_BLIND) * 100.0;
+}
+
+double DuplicateEvaluator::Result::confidence() const
+{
+	return confidenceInterval(this->deals, this->sum, this->squares) / (2 * SMALL_BLIND) * 100.0;
+}
+
+double DuplicateEvaluator::Result::singleConfidence() const
+{
+	return confidenceInterval(this->deals, this->single_sum, this->single_squares) / (2 * SMALL_BLIND) * 100.0;
+}
+
+DuplicateEvaluator::DuplicateEvaluator(Player first_in, Player second_in, uint32_t search_iterations_in, const AI::Parameters& first_parameters,
+	const AI::Parameters& second_parameters) :
+	first(first_in),
+	second(second_in),
+	search_iterations(search_iterations_in),
+	parameters({ first_parameters, second_parameters })
+{
+}
+
+DuplicateEvaluator::Result DuplicateEvaluator::evaluate(uint64_t deals, unsigned threads, uint32_t random_seed) const
+{
+	if (threads == 0)
+		threads = 1;
+
+	// Each thread plays a contiguous run of deals into its own result
+	std::vector<Result> thread_results(threads);
+	std::vector<std::thread> workers;
+	for (unsigned thread = 0; thread < threads; ++thread) {
+		uint64_t begin = deals * thread / threads;
+		uint64_t end = deals * (thread + 1) / threads;
+		workers.emplace_back([this, &thread_results, begin, end, thread, random_seed]() {
+			Result& result = thread_results[thread];
+			for (uint64_t deal = begin; deal < end; ++deal) {
+				int32_t winnings[2];
+				this->playDeal(random_seed + static_cast<uint32_t>(deal), winnings);
+
+				// The duplicate value of a deal is the mean of both hands, so that it is in the same units as a single hand
+				double value = (winnings[0] + winnings[1]) / 2.0;
+				++result.deals;
+				result.sum += value;
+				result.squares += value * value;
+				result.single_sum += winnings[0];
+				result.single_squares += static_cast<double>(winnings[0]) * winnings[0];
+			}
+		});
+	}
+	Result result;
+	for (unsigned thread = 0; thread < threads; ++thread) {
+		workers[thread].join();
+		result.merge(thread_results[thread]);
+	}
+	return result;
+}
+
+bool DuplicateEvaluator::parsePlayer(const char* name, Player& player)
+{
+	if (strcmp(name, "rules") == 0)
+		player = Player::RULES;
+	else if (strcmp(name, "quick") == 0)
+		player = Player::QUICK;
+	else if (strcmp(name, "search") == 0)
+		player = Player::SEARCH;
+	else
+		return false;
+	return true;
+}
+
+void DuplicateEvaluator::playDeal(uint32_t seed, int32_t* winnings) const
+{
+	// Shuffle the deal's deck order once
+	Random rng(seed);
+	Deck deck(rng);
+	deck.shuffle();
+	Deck::Snapshot order = deck.takeSnapshot();
+
+	// Play it with the first player in seat 0, then in seat 1, with the same seed for the decisions
+	for (uint8_t seat = 0; seat < 2; ++seat) {
+		utl::array<Player, 2> players;
+		utl::array<const AI::Parameters*, 2> seat_parameters;
+		players[seat] = this->first;
+		players[1 - seat] = this->second;
+		seat_parameters[seat] = &this->parameters[0];
+		seat_parameters[1 - seat] = &this->parameters[1];
+		utl::array<uint16_t, 2> stacks = { STACK, STACK };
+		DuplicateGame game(seed, SMALL_BLIND, STACK, DuplicateDecider(players, this->search_iterations, seat_parameters),
+			SingleHandObserver(&stacks), FixedDeckDealer(order));
+		game.play();
+		winnings[seat] = static_cast<int32_t>(stacks[seat]) - STACK;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,130 @@
+/**
+ *  A simple interactive texas holdem poker program.
+ *  Copyright (C) 2020, Matt Zimmerer, mzimmere@gmail.com
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ **/
+
+#pragma once
+
+#include <cstdint>
+
+#include <utl/array>
+
+#include "PokerGame/AI.h"
+
+/** Compares two AI players in duplicate format. Each deal is played twice from the same deck order and random seed,
+ *  once from each seat, so the luck of the cards largely cancels out of the difference between the two results
+ */
+class DuplicateEvaluator
+{
+public:
+
+	/// The AI players that may be compared
+	enum class Player : uint8_t {
+		RULES = 0,
+		QUICK = 1,
+		SEARCH = 2,
+	};
+
+	/// The winnings of the first player, summed over deals so that the results of threads may be merged
+	struct Result {
+
+		/// The number of deals, each is two hands
+		uint64_t deals{ 0 };
+
+		/// The sum of the first player's duplicate winnings, the mean of both hands of each deal, in chips
+		double sum{ 0.0 };
+
+		/// The sum of the squares of the duplicate winnings
+		double squares{ 0.0 };
+
+		/// The sum of the first player's winnings in the first hand of each deal alone, as plain play would measure them
+		double single_sum{ 0.0 };
+
+		/// The sum of the squares of the single hand winnings
+		double single_squares{ 0.0 };
+
+		/** Add the deals of another result
+		 *  @param other The other result
+		 */
+		void merge(const Result& other);
+
+		/** Get the first player's win rate
+		 *  @return The win rate in big blinds per 100 hands
+		 */
+		double winRate() const;
+
+		/** Get the half width of the 95% confidence interval of the win rate
+		 *  @return The half width in big blinds per 100 hands
+		 */
+		double confidence() const;
+
+		/** Get the half width of the 95% confidence interval that as many single hands would have
+		 *  @return The half width in big blinds per 100 hands
+		 */
+		double singleConfidence() const;
+	};
+
+	/** Constructor
+	 *  @param first The first player
+	 *  @param second The second player
+	 *  @param search_iterations The rollouts of each decision of a SEARCH player
+	 *  @param first_parameters The parameters that the first player plays by if it is QUICK
+	 *  @param second_parameters The parameters that the second player plays by if it is QUICK
+	 */
+	DuplicateEvaluator(Player first, Player second, uint32_t search_iterations, const AI::Parameters& first_parameters = AI::tunedParameters(),
+		const AI::Parameters& second_parameters = AI::tunedParameters());
+
+	/** Play deals in duplicate
+	 *  @param deals The number of deals
+	 *  @param threads The number of threads
+	 *  @param random_seed The random seed, deal N is shuffled and played with the seed random_seed + N
+	 *  @return The first player's winnings
+	 */
+	Result evaluate(uint64_t deals, unsigned threads, uint32_t random_seed) const;
+
+	/** Find a player by name
+	 *  @param name The name, rules, quick or search
+	 *  @param player The player
+	 *  @return True if the name was found
+	 */
+	static bool parsePlayer(const char* name, Player& player);
+
+	/// The small blind of each hand, the big blind is twice as large
+	static constexpr uint8_t SMALL_BLIND = 5;
+
+	/// Each player's stack at the start of each hand
+	static constexpr uint16_t STACK = 1000;
+
+private:
+
+	/** Play a deal from both seats
+	 *  @param seed The deal's seed
+	 *  @param winnings Set to the first player's winnings in each hand, first from seat 0 and then from seat 1
+	 */
+	void playDeal(uint32_t seed, int32_t* winnings) const;
+
+	/// The first player
+	Player first;
+
+	/// The second player
+	Player second;
+
+	/// The rollouts of each decision of a SEARCH player
+	uint32_t search_iterations;
+
+	/// The parameters that each player plays by if it is QUICK
+	utl::array<AI::Parameters, 2> parameters;
+};
\ No newline at end of file
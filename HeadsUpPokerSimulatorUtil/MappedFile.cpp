@@ -0,0 +1,97 @@
+/**
+ *  A simple interactive texas holdem poker program.
+ *  Copyright (C) 2020, Matt Zimmerer, mzimmere@gmail.com
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ **/
+#include "MappedFile.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#ifdef _WIN32
+MappedFile::MappedFile(const char* path)
+{
+	// Open the file and map a view of all of it
+	this->file_handle = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+	if (this->file_handle == INVALID_HANDLE_VALUE) {
+		this->file_handle = nullptr;
+		return;
+	}
+	LARGE_INTEGER file_size;
+	if (GetFileSizeEx(this->file_handle, &file_size) == FALSE || file_size.QuadPart == 0)
+		return;
+	this->mapping_handle = CreateFileMappingA(this->file_handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (this->mapping_handle == nullptr)
+		return;
+	this->mapped_data = static_cast<const uint8_t*>(MapViewOfFile(this->mapping_handle, FILE_MAP_READ, 0, 0, 0));
+	if (this->mapped_data != nullptr)
+		this->mapped_size = static_cast<size_t>(file_size.QuadPart);
+}
+
+MappedFile::~MappedFile()
+{
+	if (this->mapped_data != nullptr)
+		UnmapViewOfFile(this->mapped_data);
+	if (this->mapping_handle != nullptr)
+		CloseHandle(this->mapping_handle);
+	if (this->file_handle != nullptr)
+		CloseHandle(this->file_handle);
+}
+#else
+MappedFile::MappedFile(const char* path)
+{
+	// Open the file and map all of it, the descriptor is not needed once it is mapped
+	int descriptor = open(path, O_RDONLY);
+	if (descriptor < 0)
+		return;
+	struct stat file_status;
+	if (fstat(descriptor, &file_status) == 0 && file_status.st_size > 0) {
+		void* mapping = mmap(nullptr, static_cast<size_t>(file_status.st_size), PROT_READ, MAP_PRIVATE, descriptor, 0);
+		if (mapping != MAP_FAILED) {
+			madvise(mapping, static_cast<size_t>(file_status.st_size), MADV_SEQUENTIAL);
+			this->mapped_data = static_cast<const uint8_t*>(mapping);
+			this->mapped_size = static_cast<size_t>(file_status.st_size);
+		}
+	}
+	close(descriptor);
+}
+
+MappedFile::~MappedFile()
+{
+	if (this->mapped_data != nullptr)
+		munmap(const_cast<uint8_t*>(this->mapped_data), this->mapped_size);
+}
+#endif
+
+bool MappedFile::isOpen() const
+{
+	return this->mapped_data != nullptr;
+}
+
+const uint8_t* MappedFile::data() const
+{
+	return this->mapped_data;
+}
+
+size_t MappedFile::size() const
+{
+	return this->mapped_size;
+}
\ No newline at end of file
@@ -0,0 +1,71 @@
+/**
+ *  A simple interactive texas holdem poker program.
+ *  Copyright (C) 2020, Matt Zimmerer, mzimmere@gmail.com
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ **/
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+/** A read only view of a whole file, mapped into memory
+ */
+class MappedFile
+{
+public:
+
+	/** Map a file
+	 *  @param path The file path
+	 */
+	explicit MappedFile(const char* path);
+
+	/** Unmap the file
+	 */
+	~MappedFile();
+
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+
+	/** Check if the file was mapped
+	 *  @return True if the file was mapped, false if it could not be opened or is empty
+	 */
+	bool isOpen() const;
+
+	/** Access the file's contents
+	 *  @return The first byte of the file
+	 */
+	const uint8_t* data() const;
+
+	/** Get the file size
+	 *  @return The size in bytes
+	 */
+	size_t size() const;
+
+private:
+
+	/// The mapped contents
+	const uint8_t* mapped_data{ nullptr };
+
+	/// The file size
+	size_t mapped_size{ 0 };
+
+#ifdef _WIN32
+	/// The file handle
+	void* file_handle{ nullptr };
+
+	/// The file mapping handle
+	void* mapping_handle{ nullptr };
+#endif
+};
\ No newline at end of file
@@ -0,0 +1,238 @@
+/**
+ *  A simple interactive texas holdem poker program.
+ *  Copyright (C) 2020, Matt Zimmerer, mzimmere@gmail.com
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ **/
+
+#include "ParameterTuner.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#include "DuplicateEvaluator.h"
+
+/// The checkpoint file header, followed by the generation counts and the current parameters
+static const char CHECKPOINT_MAGIC[4] = { 'H', 'U', 'P', 'T' };
+static constexpr uint32_t CHECKPOINT_VERSION = 2;
+
+/// The most that a candidate moves each band limit from the current parameters, in hundredths
+static constexpr int LIMIT_STEP = 10;
+
+/// The range of the band limits, in hundredths
+static constexpr int LIMIT_MIN = 10;
+static constexpr int LIMIT_MAX = 400;
+
+/// The most that a candidate moves each chance from the current parameters, in units of 1/10000
+static constexpr int CHANCE_STEP = 1000;
+
+/// The highest chance to raise again when choosing a bet, so that the bet is sure to stop growing
+static constexpr int RAISE_MAX = 9000;
+
+/// The license that the generated header starts with, as every file does
+static const char* const LICENSE =
+	"/**\r\n"
+	" *  A simple interactive texas holdem poker program.\r\n"
+	" *  Copyright (C) 2020, Matt Zimmerer, mzimmere@gmail.com\r\n"
+	" *\r\n"
+	" *  This program is free software: you can redistribute it and/or modify\r\n"
+	" *  it under the terms of the GNU General Public License as published by\r\n"
+	" *  the Free Software Foundation, either version 3 of the License, or\r\n"
+	" *  (at your option) any later version.\r\n"
+	" *\r\n"
+	" *  This program is distributed in the hope that it will be useful,\r\n"
+	" *  but WITHOUT ANY WARRANTY; without even the implied warranty of\r\n"
+	" *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the\r\n"
+	" *  GNU General Public License for more details.\r\n"
+	" *\r\n"
+	" *  You should have received a copy of the GNU General Public License\r\n"
+	" *  along with this program.  If not, see <https://www.gnu.org/licenses/>.\r\n"
+	" **/\r\n";
+
+/** Move a value by a random step and keep it in a range
+ *  @param value The value
+ *  @param step The most that the value moves either way
+ *  @param lowest The lowest value
+ *  @param highest The highest value
+ *  @param rng A random number generator
+ *  @return The moved value
+ */
+static uint16_t perturb(uint16_t value, int step, int lowest, int highest, Random& rng)
+{
+	int result = static_cast<int>(value) + rng.getRandomNumberInRange(-step, step);
+	return static_cast<uint16_t>(std::min(std::max(result, lowest), highest));
+}
+
+/** Write an array of parameters as an initializer
+ *  @param file The file
+ *  @param values The values
+ *  @param count The number of values
+ */
+static void writeInitializer(FILE* file, const uint16_t* values, size_t count)
+{
+	fprintf(file, "    {");
+	for (size_t i = 0; i < count; ++i)
+		fprintf(file, " %u%s", static_cast<unsigned>(values[i]), i + 1 < count ? "," : "");
+	fprintf(file, " },\r\n");
+}
+
+ParameterTuner::ParameterTuner() :
+	current(AI::tunedParameters())
+{
+}
+
+double ParameterTuner::generation(uint64_t deals, unsigned threads, uint32_t random_seed)
+{
+	// Perturb the current parameters into the candidates
+	Random rng(random_seed + this->completed);
+	std::vector<AI::Parameters> candidates;
+	for (uint8_t i = 0; i < CANDIDATES; ++i)
+		candidates.push_back(this->mutate(rng));
+
+	// Each round every candidate left plays the same deals against the current parameters, and the better half plays on
+	std::vector<DuplicateEvaluator::Result> results(CANDIDATES);
+	std::vector<size_t> survivors(CANDIDATES);
+	for (size_t i = 0; i < CANDIDATES; ++i)
+		survivors[i] = i;
+	uint32_t deal_seed = (static_cast<uint32_t>(rng.getRandomNumberInRange(0, 0x7FFF)) << 15) | static_cast<uint32_t>(rng.getRandomNumberInRange(0, 0x7FFF));
+	uint64_t round_deals = deals;
+	while (true) {
+		for (size_t candidate : survivors) {
+			DuplicateEvaluator evaluator(DuplicateEvaluator::Player::QUICK, DuplicateEvaluator::Player::QUICK, 0, candidates[candidate], this->current);
+			results[candidate].merge(evaluator.evaluate(round_deals, threads, deal_seed));
+		}
+		std::sort(survivors.begin(), survivors.end(), [&results](size_t left, size_t right) {
+			return results[left].winRate() > results[right].winRate();
+		});
+		if (survivors.size() == 1)
+			break;
+		survivors.resize(survivors.size() / 2);
+		deal_seed += static_cast<uint32_t>(round_deals);
+		round_deals *= 2;
+	}
+
+	// The deals that picked the best candidate flatter it, play it again on fresh deals as many as its last round
+	deal_seed += static_cast<uint32_t>(round_deals);
+	DuplicateEvaluator evaluator(DuplicateEvaluator::Player::QUICK, DuplicateEvaluator::Player::QUICK, 0, candidates[survivors[0]], this->current);
+	DuplicateEvaluator::Result best = evaluator.evaluate(round_deals, threads, deal_seed);
+
+	// Keep the best candidate only if it beats the current parameters on the fresh deals by more than chance would
+	if (best.winRate() - best.confidence() > 0.0) {
+		this->current = candidates[survivors[0]];
+		++this->improved;
+	}
+	++this->completed;
+	return best.winRate();
+}
+
+uint32_t ParameterTuner::generations() const
+{
+	return this->completed;
+}
+
+uint32_t ParameterTuner::improvements() const
+{
+	return this->improved;
+}
+
+const AI::Parameters& ParameterTuner::parameters() const
+{
+	return this->current;
+}
+
+bool ParameterTuner::save(const char* path) const
+{
+	FILE* file = fopen(path, "wb");
+	if (file == nullptr)
+		return false;
+
+	// Write the header, then the parameters
+	uint32_t version = CHECKPOINT_VERSION;
+	bool result = fwrite(CHECKPOINT_MAGIC, 1, sizeof(CHECKPOINT_MAGIC), file) == sizeof(CHECKPOINT_MAGIC) &&
+		fwrite(&version, sizeof(version), 1, file) == 1 &&
+		fwrite(&this->completed, sizeof(this->completed), 1, file) == 1 &&
+		fwrite(&this->improved, sizeof(this->improved), 1, file) == 1 &&
+		fwrite(&this->current, sizeof(this->current), 1, file) == 1;
+
+	return fclose(file) == 0 && result;
+}
+
+bool ParameterTuner::load(const char* path)
+{
+	FILE* file = fopen(path, "rb");
+	if (file == nullptr)
+		return false;
+
+	// Check the header, and read everything before replacing any of it
+	char magic[sizeof(CHECKPOINT_MAGIC)];
+	uint32_t version = 0;
+	uint32_t generations = 0;
+	uint32_t improvements = 0;
+	AI::Parameters parameters;
+	bool result = fread(magic, 1, sizeof(magic), file) == sizeof(magic) && memcmp(magic, CHECKPOINT_MAGIC, sizeof(magic)) == 0 &&
+		fread(&version, sizeof(version), 1, file) == 1 && version == CHECKPOINT_VERSION &&
+		fread(&generations, sizeof(generations), 1, file) == 1 &&
+		fread(&improvements, sizeof(improvements), 1, file) == 1 &&
+		fread(&parameters, sizeof(parameters), 1, file) == 1;
+	fclose(file);
+	if (result == false)
+		return false;
+
+	this->completed = generations;
+	this->improved = improvements;
+	this->current = parameters;
+	return true;
+}
+
+bool ParameterTuner::writeHeader(const char* path) const
+{
+	FILE* file = fopen(path, "wb");
+	if (file == nullptr)
+		return false;
+
+	// Write the header as AI.cpp includes it, one array of the parameters per line, with CRLF line endings and no
+	// newline at the end as every source file has
+	fprintf(file, "%s\r\n#pragma once\r\n\r\n#include \"PokerGame/AI.h\"\r\n\r\n", LICENSE);
+	fprintf(file, "/// The parameters that the AI plays by the rate of return with, generated by the util's tune command\r\n");
+	fprintf(file, "static constexpr AI::Parameters tuned_parameters = {\r\n");
+	writeInitializer(file, this->current.band_limits.data(), this->current.band_limits.size());
+	writeInitializer(file, this->current.fold_chances.data(), this->current.fold_chances.size());
+	writeInitializer(file, this->current.call_chances.data(), this->current.call_chances.size());
+	writeInitializer(file, this->current.raise_chances.data(), this->current.raise_chances.size());
+	fprintf(file, "    0x%X,\r\n", static_cast<unsigned>(this->current.rounded_down_limits));
+	fprintf(file, "};");
+
+	return fclose(file) == 0;
+}
+
+AI::Parameters ParameterTuner::mutate(Random& rng) const
+{
+	AI::Parameters result = this->current;
+
+	// Move the band limits, and keep them ascending
+	for (uint16_t& limit : result.band_limits)
+		limit = perturb(limit, LIMIT_STEP, LIMIT_MIN, LIMIT_MAX, rng);
+	std::sort(result.band_limits.begin(), result.band_limits.end());
+	result.rounded_down_limits = AI::roundedDownLimits(result.band_limits);
+
+	// Move the chances of each band, the fold and call chances may not add up to more than certain
+	for (uint8_t band = 0; band < AI::BANDS; ++band) {
+		result.fold_chances[band] = perturb(result.fold_chances[band], CHANCE_STEP, 0, 10000, rng);
+		result.call_chances[band] = perturb(result.call_chances[band], CHANCE_STEP, 0, 10000 - result.fold_chances[band], rng);
+		result.raise_chances[band] = perturb(result.raise_chances[band], CHANCE_STEP, 0, RAISE_MAX, rng);
+	}
+	return result;
+}
\ No newline at end of file
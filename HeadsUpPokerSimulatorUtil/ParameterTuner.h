@@ -0,0 +1,101 @@
+/**
+ *  A simple interactive texas holdem poker program.
+ *  Copyright (C) 2020, Matt Zimmerer, mzimmere@gmail.com
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ **/
+
+#pragma once
+
+#include <cstdint>
+
+#include "PokerGame/AI.h"
+#include "PokerGame/Random.h"
+
+/** Tunes the parameters that the AI plays by the rate of return with. Each generation perturbs the current parameters into
+ *  candidates and narrows them down by successive halving: every candidate plays duplicate deals against the current
+ *  parameters, the better half plays on with twice as many deals until one is left. It plays again on fresh deals, so
+ *  that the deals that picked it do not flatter it, and it replaces the current parameters if it beats them there by
+ *  more than its confidence interval
+ */
+class ParameterTuner
+{
+public:
+
+	/** Construct a tuner that starts from the tuned parameters
+	 */
+	ParameterTuner();
+
+	/** Run a generation
+	 *  @param deals The deals that each candidate plays in the first round, each round after doubles them
+	 *  @param threads The number of threads that play each candidate's deals
+	 *  @param random_seed The random seed, the generation number is added to it
+	 *  @return The best candidate's duplicate win rate over the current parameters on the fresh deals, in big blinds per
+	 *  100 hands
+	 */
+	double generation(uint64_t deals, unsigned threads, uint32_t random_seed);
+
+	/** Get the number of generations run, including those of a loaded checkpoint
+	 *  @return The number of generations
+	 */
+	uint32_t generations() const;
+
+	/** Get the number of generations whose best candidate replaced the current parameters
+	 *  @return The number of improvements
+	 */
+	uint32_t improvements() const;
+
+	/** Get the current parameters
+	 *  @return The parameters
+	 */
+	const AI::Parameters& parameters() const;
+
+	/** Save the current parameters to a checkpoint file
+	 *  @param path The file path
+	 *  @return True if the checkpoint was written
+	 */
+	bool save(const char* path) const;
+
+	/** Load the current parameters from a checkpoint file
+	 *  @param path The file path
+	 *  @return True if the checkpoint was read, the parameters are unchanged otherwise
+	 */
+	bool load(const char* path);
+
+	/** Write the current parameters as the AIParameters.h header
+	 *  @param path The file path
+	 *  @return True if the header was written
+	 */
+	bool writeHeader(const char* path) const;
+
+	/// The candidates of each generation, a power of two so that each round halves them evenly
+	static constexpr uint8_t CANDIDATES = 16;
+
+private:
+
+	/** Perturb the current parameters into a candidate
+	 *  @param rng A random number generator
+	 *  @return The candidate
+	 */
+	AI::Parameters mutate(Random& rng) const;
+
+	/// The current parameters
+	AI::Parameters current;
+
+	/// The generations run
+	uint32_t completed{ 0 };
+
+	/// The generations whose best candidate replaced the current parameters
+	uint32_t improved{ 0 };
+};
\ No newline at end of file
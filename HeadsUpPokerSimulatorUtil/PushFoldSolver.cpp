@@ -0,0 +1,232 @@
+/**
+ *  A simple interactive texas holdem poker program.
+ *  Copyright (C) 2020, Matt Zimmerer, mzimmere@gmail.com
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ **/
+
+#include "PushFoldSolver.h"
+
+#include <cstdio>
+#include <cstring>
+#include <thread>
+
+#include "PokerGame/HandEvaluator.h"
+#include "PokerGame/Random.h"
+
+/// The equity file header, followed by the equity of each pair of hand classes
+static const char EQUITY_MAGIC[4] = { 'H', 'U', 'P', 'E' };
+static constexpr uint32_t EQUITY_VERSION = 1;
+
+/// The number of pairs of hand classes
+static constexpr size_t CLASS_PAIRS = static_cast<size_t>(PushFold::HAND_CLASSES) * PushFold::HAND_CLASSES;
+
+/// The card values and suits
+static constexpr uint8_t VALUES = 13;
+static constexpr uint8_t SUITS = 4;
+
+PushFoldSolver::PushFoldSolver() :
+	equities(CLASS_PAIRS, 5000),
+	pairs(CLASS_PAIRS, 0)
+{
+	// Count the pairs of hands that share no cards, they weigh the hand classes of the other player with card removal
+	std::vector<utl::array<uint8_t, 2>> row_hands;
+	std::vector<utl::array<uint8_t, 2>> column_hands;
+	for (uint8_t row = 0; row < PushFold::HAND_CLASSES; ++row) {
+		PushFoldSolver::hands(row, row_hands);
+		for (uint8_t column = 0; column < PushFold::HAND_CLASSES; ++column) {
+			PushFoldSolver::hands(column, column_hands);
+			uint16_t count = 0;
+			for (const auto& row_hand : row_hands) {
+				for (const auto& column_hand : column_hands) {
+					if (row_hand[0] != column_hand[0] && row_hand[0] != column_hand[1] && row_hand[1] != column_hand[0] && row_hand[1] != column_hand[1])
+						++count;
+				}
+			}
+			this->pairs[static_cast<size_t>(row) * PushFold::HAND_CLASSES + column] = count;
+		}
+	}
+}
+
+void PushFoldSolver::computeEquities(uint32_t samples, unsigned threads, uint32_t random_seed)
+{
+	if (threads == 0)
+		threads = 1;
+
+	// Each thread takes every threads'th row, and fills in the column's row as the complement
+	std::vector<std::thread> workers;
+	for (unsigned thread = 0; thread < threads; ++thread) {
+		workers.emplace_back([this, samples, threads, thread, random_seed]() {
+			Random rng(random_seed + thread);
+			std::vector<utl::array<uint8_t, 2>> row_hands;
+			std::vector<utl::array<uint8_t, 2>> column_hands;
+			std::vector<utl::pair<HandEvaluator::CardMask, HandEvaluator::CardMask>> matchups;
+			for (uint8_t row = static_cast<uint8_t>(thread); row < PushFold::HAND_CLASSES; row = static_cast<uint8_t>(row + threads)) {
+				PushFoldSolver::hands(row, row_hands);
+				for (uint8_t column = row; column < PushFold::HAND_CLASSES; ++column) {
+					PushFoldSolver::hands(column, column_hands);
+
+					// List the pairs of hands that share no cards
+					matchups.clear();
+					for (const auto& row_hand : row_hands) {
+						for (const auto& column_hand : column_hands) {
+							HandEvaluator::CardMask row_mask = (1ull << row_hand[0]) | (1ull << row_hand[1]);
+							HandEvaluator::CardMask column_mask = (1ull << column_hand[0]) | (1ull << column_hand[1]);
+							if ((row_mask & column_mask) == 0)
+								matchups.push_back(utl::pair<HandEvaluator::CardMask, HandEvaluator::CardMask>(row_mask, column_mask));
+						}
+					}
+
+					// Deal boards for each pair of hands in turn, a win scores two and a split one
+					uint64_t score = 0;
+					for (uint32_t sample = 0; sample < samples; ++sample) {
+						const auto& matchup = matchups[sample % matchups.size()];
+						HandEvaluator::CardMask dead = matchup.first | matchup.second;
+						HandEvaluator::CardMask board = 0;
+						for (uint8_t dealt = 0; dealt < 5;) {
+							uint8_t card = static_cast<uint8_t>(16 * rng.getRandomNumberInRange(0, SUITS - 1) + rng.getRandomNumberInRange(0, VALUES - 1));
+							if (((dead | board) & (1ull << card)) == 0) {
+								board |= 1ull << card;
+								++dealt;
+							}
+						}
+						uint32_t row_value = HandEvaluator::evaluate(matchup.first | board);
+						uint32_t column_value = HandEvaluator::evaluate(matchup.second | board);
+						score += row_value > column_value ? 2 : row_value == column_value ? 1 : 0;
+					}
+					uint16_t equity = static_cast<uint16_t>((score * 10000 + samples) / (2 * static_cast<uint64_t>(samples)));
+					this->equities[static_cast<size_t>(row) * PushFold::HAND_CLASSES + column] = equity;
+					this->equities[static_cast<size_t>(column) * PushFold::HAND_CLASSES + row] = static_cast<uint16_t>(10000 - equity);
+				}
+			}
+		});
+	}
+	for (auto& worker : workers)
+		worker.join();
+}
+
+bool PushFoldSolver::saveEquities(const char* path) const
+{
+	FILE* file = fopen(path, "wb");
+	if (file == nullptr)
+		return false;
+
+	// Write the header, then the equities
+	uint32_t version = EQUITY_VERSION;
+	bool result = fwrite(EQUITY_MAGIC, 1, sizeof(EQUITY_MAGIC), file) == sizeof(EQUITY_MAGIC) &&
+		fwrite(&version, sizeof(version), 1, file) == 1 &&
+		fwrite(this->equities.data(), sizeof(uint16_t), CLASS_PAIRS, file) == CLASS_PAIRS;
+
+	return fclose(file) == 0 && result;
+}
+
+bool PushFoldSolver::loadEquities(const char* path)
+{
+	FILE* file = fopen(path, "rb");
+	if (file == nullptr)
+		return false;
+
+	// Check the header, and read every equity before replacing any
+	char magic[sizeof(EQUITY_MAGIC)];
+	uint32_t version = 0;
+	std::vector<uint16_t> values(CLASS_PAIRS);
+	bool result = fread(magic, 1, sizeof(magic), file) == sizeof(magic) && memcmp(magic, EQUITY_MAGIC, sizeof(magic)) == 0 &&
+		fread(&version, sizeof(version), 1, file) == 1 && version == EQUITY_VERSION &&
+		fread(values.data(), sizeof(uint16_t), CLASS_PAIRS, file) == CLASS_PAIRS;
+	fclose(file);
+	if (result == false)
+		return false;
+
+	this->equities = values;
+	return true;
+}
+
+PushFoldSolver::Ranges PushFoldSolver::solve(uint8_t depth, uint32_t iterations) const
+{
+	// Start from pushing and calling everything, and move the averages towards each best response to them
+	Ranges average;
+	for (uint8_t hand_class = 0; hand_class < PushFold::HAND_CLASSES; ++hand_class) {
+		average.push[hand_class] = 1.0;
+		average.call[hand_class] = 1.0;
+	}
+	double stack = depth;
+	utl::array<double, PushFold::HAND_CLASSES> push_response;
+	utl::array<double, PushFold::HAND_CLASSES> call_response;
+	for (uint32_t iteration = 1; iteration <= iterations; ++iteration) {
+
+		// The small blind pushes if that loses less than the half big blind that folding does. A push that is not called
+		// wins the big blind, one that is called wins the equity share of both stacks
+		for (uint8_t row = 0; row < PushFold::HAND_CLASSES; ++row) {
+			double value = 0.0;
+			double weight = 0.0;
+			for (uint8_t column = 0; column < PushFold::HAND_CLASSES; ++column) {
+				size_t index = static_cast<size_t>(row) * PushFold::HAND_CLASSES + column;
+				double equity = this->equities[index] / 10000.0;
+				double call = average.call[column];
+				value += this->pairs[index] * (call * (2.0 * stack * equity - stack) + (1.0 - call));
+				weight += this->pairs[index];
+			}
+			push_response[row] = value > -0.5 * weight ? 1.0 : 0.0;
+		}
+
+		// The big blind calls if that loses less than the big blind that folding does, against the hands that push
+		for (uint8_t column = 0; column < PushFold::HAND_CLASSES; ++column) {
+			double value = 0.0;
+			double weight = 0.0;
+			for (uint8_t row = 0; row < PushFold::HAND_CLASSES; ++row) {
+				double pushes = this->pairs[static_cast<size_t>(row) * PushFold::HAND_CLASSES + column] * average.push[row];
+				double equity = this->equities[static_cast<size_t>(column) * PushFold::HAND_CLASSES + row] / 10000.0;
+				value += pushes * (2.0 * stack * equity - stack);
+				weight += pushes;
+			}
+			call_response[column] = weight > 0.0 && value > -weight ? 1.0 : 0.0;
+		}
+
+		// Average the best responses in
+		for (uint8_t hand_class = 0; hand_class < PushFold::HAND_CLASSES; ++hand_class) {
+			average.push[hand_class] += (push_response[hand_class] - average.push[hand_class]) / (iteration + 1);
+			average.call[hand_class] += (call_response[hand_class] - average.call[hand_class]) / (iteration + 1);
+		}
+	}
+	return average;
+}
+
+double PushFoldSolver::share(const utl::array<double, PushFold::HAND_CLASSES>& range) const
+{
+	// Weigh each hand class by its number of hands, pairs have 6, suited hands 4 and offsuit hands 12
+	double hands = 0.0;
+	for (uint8_t hand_class = 0; hand_class < PushFold::HAND_CLASSES; ++hand_class) {
+		uint8_t row = hand_class / VALUES;
+		uint8_t column = hand_class % VALUES;
+		hands += range[hand_class] * (row == column ? 6 : row > column ? 4 : 12);
+	}
+	return hands / 1326.0;
+}
+
+void PushFoldSolver::hands(uint8_t hand_class, std::vector<utl::array<uint8_t, 2>>& hands)
+{
+	// The row is the higher value of a suited hand and the lower value of an offsuit hand
+	uint8_t row = hand_class / VALUES;
+	uint8_t column = hand_class % VALUES;
+	hands.clear();
+	for (uint8_t first_suit = 0; first_suit < SUITS; ++first_suit) {
+		for (uint8_t second_suit = 0; second_suit < SUITS; ++second_suit) {
+			bool suited = first_suit == second_suit;
+			if ((row == column && first_suit < second_suit) || (row > column && suited) || (row < column && !suited)) {
+				utl::array<uint8_t, 2> hand = { static_cast<uint8_t>(16 * first_suit + row), static_cast<uint8_t>(16 * second_suit + column) };
+				hands.push_back(hand);
+			}
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,94 @@
+/**
+ *  A simple interactive texas holdem poker program.
+ *  Copyright (C) 2020, Matt Zimmerer, mzimmere@gmail.com
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ **/
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <utl/array>
+
+#include "PokerGame/PushFold.h"
+
+/** Solves the heads up push or fold game for the PushFold charts. The all in equity of every pair of hand classes is
+ *  computed once, or loaded from a file, after which each stack depth is solved by fictitious play in well under a second
+ */
+class PushFoldSolver
+{
+public:
+
+	/// The chance that each hand class pushes and calls at a stack depth
+	struct Ranges {
+
+		/// The chance that the small blind pushes each hand class
+		utl::array<double, PushFold::HAND_CLASSES> push{};
+
+		/// The chance that the big blind calls a push with each hand class
+		utl::array<double, PushFold::HAND_CLASSES> call{};
+	};
+
+	/** Construct a solver, counting the pairs of hands of each pair of hand classes that share no cards
+	 */
+	PushFoldSolver();
+
+	/** Compute the all in equity of every pair of hand classes, sampling boards for the pairs of hands that share no cards
+	 *  @param samples The boards sampled for each pair of hand classes
+	 *  @param threads The number of threads
+	 *  @param random_seed The random seed, each thread adds its index
+	 */
+	void computeEquities(uint32_t samples, unsigned threads, uint32_t random_seed);
+
+	/** Save the equities to a file
+	 *  @param path The file path
+	 *  @return True if the file was written
+	 */
+	bool saveEquities(const char* path) const;
+
+	/** Load the equities from a file
+	 *  @param path The file path
+	 *  @return True if the file was read, the equities are unchanged otherwise
+	 */
+	bool loadEquities(const char* path);
+
+	/** Solve a stack depth
+	 *  @param depth The effective stack depth in big blinds
+	 *  @param iterations The iterations of fictitious play
+	 *  @return The average ranges, that approach the equilibrium as the iterations grow
+	 */
+	Ranges solve(uint8_t depth, uint32_t iterations) const;
+
+	/** Get the share of all hands that a range holds
+	 *  @param range The chance of each hand class
+	 *  @return The share in the range [0..1]
+	 */
+	double share(const utl::array<double, PushFold::HAND_CLASSES>& range) const;
+
+private:
+
+	/** List the hands of a hand class
+	 *  @param hand_class The hand class
+	 *  @param hands Set to the hands, as the card indexes 16 * suit + value of the HandEvaluator card masks
+	 */
+	static void hands(uint8_t hand_class, std::vector<utl::array<uint8_t, 2>>& hands);
+
+	/// The all in equity of the row hand class against the column hand class, in units of 1/10000
+	std::vector<uint16_t> equities;
+
+	/// The number of pairs of hands of the row and column hand classes that share no cards
+	std::vector<uint16_t> pairs;
+};
\ No newline at end of file
@@ -0,0 +1,310 @@
+/**
+ *  A simple interactive texas holdem poker program.
+ *  Copyright (C) 2020, Matt Zimmerer, mzimmere@gmail.com
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ **/
+
+#include "StrategyTrainer.h"
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <thread>
+
+#include "PokerGame/HandEvaluator.h"
+
+/// The blinds and the size of a bet on the pre-flop and flop, bets on the turn and river are twice as large
+static constexpr uint16_t SMALL_BLIND = 1;
+static constexpr uint16_t BIG_BLIND = 2;
+static constexpr uint16_t SMALL_BET = 2;
+
+/// The units of the regret and average strategy tables, so that they may be added to atomically as integers
+static constexpr double REGRET_SCALE = 1000.0;
+static constexpr double AVERAGE_SCALE = 1000000.0;
+
+/// The checkpoint file header, followed by the regret and then the average strategy table
+static const char CHECKPOINT_MAGIC[4] = { 'H', 'U', 'S', 'T' };
+static constexpr uint32_t CHECKPOINT_VERSION = 1;
+
+/// The number of entries in each table
+static constexpr size_t ENTRIES = static_cast<size_t>(Strategy::INFORMATION_SETS) * Strategy::ACTIONS;
+
+StrategyTrainer::StrategyTrainer() :
+	regrets(ENTRIES),
+	averages(ENTRIES)
+{
+	for (size_t i = 0; i < ENTRIES; ++i) {
+		this->regrets[i].store(0, std::memory_order_relaxed);
+		this->averages[i].store(0, std::memory_order_relaxed);
+	}
+}
+
+void StrategyTrainer::train(uint64_t iterations, unsigned threads, uint32_t random_seed)
+{
+	if (threads == 0)
+		threads = 1;
+
+	// Split the iterations between threads, each with its own deck
+	std::vector<std::thread> workers;
+	for (unsigned thread = 0; thread < threads; ++thread) {
+		uint64_t share = iterations / threads + (thread < iterations % threads ? 1 : 0);
+		workers.emplace_back([this, share, thread, random_seed]() {
+			Random rng(random_seed + thread);
+			Deck deck(rng);
+			for (uint64_t i = 0; i < share; ++i) {
+
+				// Walk the tree once for each position, from the small blind's decision facing the big blind
+				Deal sampled = this->deal(deck);
+				for (uint8_t traverser = 0; traverser < Strategy::POSITIONS; ++traverser)
+					this->walk(sampled, traverser, 0, Strategy::FACING_BET, 0, { SMALL_BLIND, BIG_BLIND }, rng);
+				this->completed.fetch_add(1, std::memory_order_relaxed);
+			}
+		});
+	}
+	for (auto& worker : workers)
+		worker.join();
+}
+
+uint64_t StrategyTrainer::iterations() const
+{
+	return this->completed.load();
+}
+
+bool StrategyTrainer::save(const char* path) const
+{
+	FILE* file = fopen(path, "wb");
+	if (file == nullptr)
+		return false;
+
+	// Write the header, then both tables
+	uint32_t version = CHECKPOINT_VERSION;
+	uint32_t entries = static_cast<uint32_t>(ENTRIES);
+	uint64_t iterations = this->completed.load();
+	bool result = fwrite(CHECKPOINT_MAGIC, 1, sizeof(CHECKPOINT_MAGIC), file) == sizeof(CHECKPOINT_MAGIC) &&
+		fwrite(&version, sizeof(version), 1, file) == 1 &&
+		fwrite(&entries, sizeof(entries), 1, file) == 1 &&
+		fwrite(&iterations, sizeof(iterations), 1, file) == 1;
+	for (size_t i = 0; i < ENTRIES && result; ++i) {
+		int64_t regret = this->regrets[i].load(std::memory_order_relaxed);
+		result = fwrite(&regret, sizeof(regret), 1, file) == 1;
+	}
+	for (size_t i = 0; i < ENTRIES && result; ++i) {
+		int64_t average = this->averages[i].load(std::memory_order_relaxed);
+		result = fwrite(&average, sizeof(average), 1, file) == 1;
+	}
+
+	return fclose(file) == 0 && result;
+}
+
+bool StrategyTrainer::load(const char* path)
+{
+	FILE* file = fopen(path, "rb");
+	if (file == nullptr)
+		return false;
+
+	// Check the header, a checkpoint of another abstraction does not fit
+	char magic[sizeof(CHECKPOINT_MAGIC)];
+	uint32_t version = 0;
+	uint32_t entries = 0;
+	uint64_t iterations = 0;
+	bool result = fread(magic, 1, sizeof(magic), file) == sizeof(magic) && memcmp(magic, CHECKPOINT_MAGIC, sizeof(magic)) == 0 &&
+		fread(&version, sizeof(version), 1, file) == 1 && version == CHECKPOINT_VERSION &&
+		fread(&entries, sizeof(entries), 1, file) == 1 && entries == ENTRIES &&
+		fread(&iterations, sizeof(iterations), 1, file) == 1;
+
+	// Read both tables before replacing any
+	std::vector<int64_t> values(2 * ENTRIES);
+	if (result)
+		result = fread(values.data(), sizeof(int64_t), values.size(), file) == values.size();
+	fclose(file);
+	if (result == false)
+		return false;
+
+	for (size_t i = 0; i < ENTRIES; ++i) {
+		this->regrets[i].store(values[i], std::memory_order_relaxed);
+		this->averages[i].store(values[ENTRIES + i], std::memory_order_relaxed);
+	}
+	this->completed.store(iterations);
+	return true;
+}
+
+std::vector<uint8_t> StrategyTrainer::quantize() const
+{
+	std::vector<uint8_t> result(ENTRIES, 0);
+	for (uint16_t set = 0; set < Strategy::INFORMATION_SETS; ++set) {
+		Strategy::Node node = static_cast<Strategy::Node>(set % Strategy::NODES);
+
+		// Information sets that were never reached stay empty
+		int64_t total = 0;
+		for (uint8_t action = 0; action < Strategy::ACTIONS; ++action) {
+			if (Strategy::isLegal(node, static_cast<Strategy::Action>(action)))
+				total += this->averages[set * Strategy::ACTIONS + action].load(std::memory_order_relaxed);
+		}
+		if (total <= 0)
+			continue;
+
+		// Round down, then hand the remainder to the actions that lost the most to rounding
+		double remainders[Strategy::ACTIONS] = {};
+		int assigned = 0;
+		for (uint8_t action = 0; action < Strategy::ACTIONS; ++action) {
+			if (Strategy::isLegal(node, static_cast<Strategy::Action>(action)) == false)
+				continue;
+			double exact = 255.0 * static_cast<double>(this->averages[set * Strategy::ACTIONS + action].load(std::memory_order_relaxed)) / static_cast<double>(total);
+			result[set * Strategy::ACTIONS + action] = static_cast<uint8_t>(exact);
+			remainders[action] = exact - std::floor(exact);
+			assigned += result[set * Strategy::ACTIONS + action];
+		}
+		for (; assigned < 255; ++assigned) {
+			uint8_t best = 0;
+			for (uint8_t action = 1; action < Strategy::ACTIONS; ++action) {
+				if (remainders[action] > remainders[best])
+					best = action;
+			}
+			++result[set * Strategy::ACTIONS + best];
+			remainders[best] = -1.0;
+		}
+	}
+	return result;
+}
+
+StrategyTrainer::Deal StrategyTrainer::deal(Deck& deck) const
+{
+	Deal result;
+	deck.shuffle();
+
+	// Deal both hands and the whole board, then group each hand on each street
+	utl::array<utl::array<Card, 2>, Strategy::POSITIONS> hands;
+	for (auto& hand : hands) {
+		hand[0] = deck.dealCard();
+		hand[1] = deck.dealCard();
+	}
+	utl::vector<Card, 5> board;
+	for (uint8_t street = 0; street < Strategy::STREETS; ++street) {
+		while (board.size() < (street == 0 ? 0u : street + 2u))
+			board.push_back(deck.dealCard());
+		for (uint8_t position = 0; position < Strategy::POSITIONS; ++position)
+			result.buckets[position][street] = Strategy::cardBucket(hands[position], board);
+	}
+
+	// Settle the showdown now, every line that reaches the river shares it
+	uint32_t dealer = HandEvaluator::evaluate(hands[0], board);
+	uint32_t big_blind = HandEvaluator::evaluate(hands[1], board);
+	result.showdown = static_cast<int8_t>(dealer > big_blind ? 1 : (dealer < big_blind ? -1 : 0));
+	return result;
+}
+
+void StrategyTrainer::currentStrategy(uint16_t information_set, Strategy::Node node, double* strategy) const
+{
+	// Play each legal action in proportion to its positive regret, or uniformly without any
+	double total = 0.0;
+	uint8_t legal = 0;
+	for (uint8_t action = 0; action < Strategy::ACTIONS; ++action) {
+		strategy[action] = 0.0;
+		if (Strategy::isLegal(node, static_cast<Strategy::Action>(action)) == false)
+			continue;
+		++legal;
+		int64_t regret = this->regrets[information_set * Strategy::ACTIONS + action].load(std::memory_order_relaxed);
+		if (regret > 0) {
+			strategy[action] = static_cast<double>(regret);
+			total += strategy[action];
+		}
+	}
+	for (uint8_t action = 0; action < Strategy::ACTIONS; ++action) {
+		if (Strategy::isLegal(node, static_cast<Strategy::Action>(action)) == false)
+			continue;
+		strategy[action] = total > 0.0 ? strategy[action] / total : 1.0 / legal;
+	}
+}
+
+double StrategyTrainer::walk(const Deal& deal, uint8_t traverser, uint8_t street, Strategy::Node node, uint8_t actor,
+	utl::array<uint16_t, Strategy::POSITIONS> contributions, Random& rng)
+{
+	uint16_t information_set = Strategy::informationSet(street, actor, deal.buckets[actor][street], node);
+	double strategy[Strategy::ACTIONS];
+	this->currentStrategy(information_set, node, strategy);
+
+	// The other position adds its strategy to the average, and samples a single action
+	if (actor != traverser) {
+		for (uint8_t action = 0; action < Strategy::ACTIONS; ++action) {
+			if (strategy[action] > 0.0)
+				this->averages[information_set * Strategy::ACTIONS + action].fetch_add(std::llround(strategy[action] * AVERAGE_SCALE), std::memory_order_relaxed);
+		}
+		double random_value = rng.getRandomNumberInRange(0, 999999) / 1000000.0;
+		uint8_t sampled = Strategy::ACTIONS;
+		for (uint8_t action = 0; action < Strategy::ACTIONS; ++action) {
+			if (strategy[action] <= 0.0)
+				continue;
+			sampled = action;
+			random_value -= strategy[action];
+			if (random_value < 0.0)
+				break;
+		}
+		return this->act(deal, traverser, street, node, actor, static_cast<Strategy::Action>(sampled), contributions, rng);
+	}
+
+	// The traversing position tries every legal action, and regrets the ones that it should have played more
+	double values[Strategy::ACTIONS] = {};
+	double expected = 0.0;
+	for (uint8_t action = 0; action < Strategy::ACTIONS; ++action) {
+		if (Strategy::isLegal(node, static_cast<Strategy::Action>(action))) {
+			values[action] = this->act(deal, traverser, street, node, actor, static_cast<Strategy::Action>(action), contributions, rng);
+			expected += strategy[action] * values[action];
+		}
+	}
+	for (uint8_t action = 0; action < Strategy::ACTIONS; ++action) {
+		if (Strategy::isLegal(node, static_cast<Strategy::Action>(action)))
+			this->regrets[information_set * Strategy::ACTIONS + action].fetch_add(std::llround((values[action] - expected) * REGRET_SCALE), std::memory_order_relaxed);
+	}
+	return expected;
+}
+
+double StrategyTrainer::act(const Deal& deal, uint8_t traverser, uint8_t street, Strategy::Node node, uint8_t actor, Strategy::Action action,
+	utl::array<uint16_t, Strategy::POSITIONS> contributions, Random& rng)
+{
+	uint8_t other = static_cast<uint8_t>(1 - actor);
+	uint16_t bet = street < 2 ? SMALL_BET : 2 * SMALL_BET;
+
+	// The folding position loses its chips in the pot
+	if (action == Strategy::FOLD)
+		return actor == traverser ? -static_cast<double>(contributions[actor]) : static_cast<double>(contributions[other]);
+
+	// A bet or raise puts the other position to a decision
+	if (action == Strategy::RAISE) {
+		contributions[actor] = static_cast<uint16_t>(contributions[other] + bet);
+		return this->walk(deal, traverser, street, node == Strategy::FACING_BET ? Strategy::FACING_RAISE : Strategy::FACING_BET, other, contributions, rng);
+	}
+
+	// A check to open the street passes the decision on
+	if (node == Strategy::OPEN)
+		return this->walk(deal, traverser, street, Strategy::CHECKED, other, contributions, rng);
+
+	// The small blind completing pre-flop gives the big blind the option
+	bool limp = street == 0 && node == Strategy::FACING_BET && contributions[other] == BIG_BLIND;
+	contributions[actor] = contributions[other];
+	if (limp)
+		return this->walk(deal, traverser, street, Strategy::CHECKED, other, contributions, rng);
+
+	// Otherwise the street is over, the big blind opens the next one
+	if (street + 1 < Strategy::STREETS)
+		return this->walk(deal, traverser, static_cast<uint8_t>(street + 1), Strategy::OPEN, 1, contributions, rng);
+
+	// Show down
+	int8_t showdown = traverser == 0 ? deal.showdown : static_cast<int8_t>(-deal.showdown);
+	if (showdown > 0)
+		return static_cast<double>(contributions[1 - traverser]);
+	if (showdown < 0)
+		return -static_cast<double>(contributions[traverser]);
+	return 0.0;
+}
\ No newline at end of file
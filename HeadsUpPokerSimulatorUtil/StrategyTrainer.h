@@ -0,0 +1,134 @@
+/**
+ *  A simple interactive texas holdem poker program.
+ *  Copyright (C) 2020, Matt Zimmerer, mzimmere@gmail.com
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ **/
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <utl/array>
+#include <utl/vector>
+
+#include "PokerGame/Card.h"
+#include "PokerGame/Deck.h"
+#include "PokerGame/Random.h"
+#include "PokerGame/Strategy.h"
+
+/** Trains the Strategy abstraction of heads up play with external sampling Monte Carlo counterfactual regret
+ *  minimization. Threads share the regret and average strategy tables and update them with atomic adds, without locks
+ */
+class StrategyTrainer
+{
+public:
+
+	/** Construct a trainer with empty tables
+	 */
+	StrategyTrainer();
+
+	/** Run training iterations, each samples a deal and walks the game tree once for each position
+	 *  @param iterations The number of iterations
+	 *  @param threads The number of threads
+	 *  @param random_seed The random seed, each thread adds its index
+	 */
+	void train(uint64_t iterations, unsigned threads, uint32_t random_seed);
+
+	/** Get the number of iterations trained, including those of a loaded checkpoint
+	 *  @return The number of iterations
+	 */
+	uint64_t iterations() const;
+
+	/** Save the tables to a checkpoint file
+	 *  @param path The file path
+	 *  @return True if the checkpoint was written
+	 */
+	bool save(const char* path) const;
+
+	/** Load the tables from a checkpoint file
+	 *  @param path The file path
+	 *  @return True if the checkpoint was read, the tables are unchanged otherwise
+	 */
+	bool load(const char* path);
+
+	/** Quantize the average strategy to chances in units of 1/255, the legal actions of each information set add up to 255
+	 *  @return The table, ACTIONS chances for each information set
+	 */
+	std::vector<uint8_t> quantize() const;
+
+private:
+
+	/// The cards of a sampled deal, and each position's card bucket on each street
+	struct Deal {
+
+		/// The result of the showdown for the dealer's position, 1 for a win, 0 for a split and -1 for a loss
+		int8_t showdown{ 0 };
+
+		/// Each position's card bucket on each street
+		utl::array<utl::array<uint8_t, Strategy::STREETS>, Strategy::POSITIONS> buckets{};
+	};
+
+	/** Sample a deal
+	 *  @param deck The deck to deal from
+	 *  @return The deal
+	 */
+	Deal deal(Deck& deck) const;
+
+	/** Find the current strategy of an information set by regret matching
+	 *  @param information_set The information set
+	 *  @param node The betting node
+	 *  @param strategy The chance of each action
+	 */
+	void currentStrategy(uint16_t information_set, Strategy::Node node, double* strategy) const;
+
+	/** Walk the game tree from a decision, trying every action of the traversing position and sampling the other's
+	 *  @param deal The deal
+	 *  @param traverser The traversing position
+	 *  @param street The street
+	 *  @param node The betting node
+	 *  @param actor The position to act
+	 *  @param contributions Each position's chips in the pot
+	 *  @param rng A random number generator, for sampling
+	 *  @return The traversing position's expected winnings
+	 */
+	double walk(const Deal& deal, uint8_t traverser, uint8_t street, Strategy::Node node, uint8_t actor,
+		utl::array<uint16_t, Strategy::POSITIONS> contributions, Random& rng);
+
+	/** Take an action and walk on from the decision that follows it
+	 *  @param deal The deal
+	 *  @param traverser The traversing position
+	 *  @param street The street
+	 *  @param node The betting node
+	 *  @param actor The position that acts
+	 *  @param action The action
+	 *  @param contributions Each position's chips in the pot
+	 *  @param rng A random number generator, for sampling
+	 *  @return The traversing position's expected winnings
+	 */
+	double act(const Deal& deal, uint8_t traverser, uint8_t street, Strategy::Node node, uint8_t actor, Strategy::Action action,
+		utl::array<uint16_t, Strategy::POSITIONS> contributions, Random& rng);
+
+	/// The accumulated regret of each action, in units of 1/REGRET_SCALE chips
+	std::vector<std::atomic<int64_t>> regrets;
+
+	/// The accumulated chance of each action, in units of 1/AVERAGE_SCALE
+	std::vector<std::atomic<int64_t>> averages;
+
+	/// The iterations trained
+	std::atomic<uint64_t> completed{ 0 };
+};
\ No newline at end of file
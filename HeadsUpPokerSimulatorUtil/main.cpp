@@ -16,20 +16,44 @@
  *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
  **/
 
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
 #include <ctime>
+#include <deque>
 #include <iostream>
+#include <mutex>
 #include <string>
+#include <thread>
+#include <vector>
 
 #include <utl/array>
 #include <utl/list>
 #include <utl/utility>
 #include <utl/vector>
 
+#include "PokerGame/BinaryIO.h"
+#include "PokerGame/ConsoleIO.h"
 #include "PokerGame/Deck.h"
+#include "PokerGame/HandBuckets.h"
+#include "PokerGame/HandEvaluator.h"
+#include "PokerGame/HandHistory.h"
+#include "PokerGame/HandHistoryReplay.h"
+#include "PokerGame/HandHistoryStats.h"
+#include "PokerGame/NullIO.h"
+#include "PokerGame/PokerGame.h"
+#include "PokerGame/PokerGameImpl.h"
 #include "PokerGame/Random.h"
 #include "PokerGame/RankedHand.h"
 #include "PokerGame/AI.h"
 
+#include "DuplicateEvaluator.h"
+#include "MappedFile.h"
+#include "ParameterTuner.h"
+#include "PushFoldSolver.h"
+#include "StrategyTrainer.h"
+
 static utl::array<utl::array<utl::pair<int, int>, 13>, 13> results;
 
 static void logResults(bool result, const utl::array<Card, 2>& hand)
@@ -91,10 +115,10 @@ static void texasHoldemShowDown(Deck& deck)
 	logResults(won_round, hands[0]);
 }
 
-int main(int argc, char** argv)
+static int handStrengths()
 {
 	// Constuct deck
-	Random rng(time(nullptr));
+	Random rng(static_cast<uint32_t>(time(nullptr)));
 	Deck deck(rng);
 
 	// Run the test in a loop
@@ -128,4 +152,711 @@ int main(int argc, char** argv)
 	std::cout << "};" << std::endl;
 
 	return 0;
+}
+
+static int bucketEquities(uint32_t samples, uint32_t random_seed)
+{
+	Random rng(random_seed);
+	Deck deck(rng);
+
+	// Deal samples on each street, and play out a random opponent hand and runout for each
+	std::vector<uint64_t> shares(HandBuckets::BUCKETS, 0);
+	std::vector<uint64_t> counts(HandBuckets::BUCKETS, 0);
+	for (uint8_t board_size = 3; board_size <= 5; ++board_size) {
+		for (uint32_t i = 0; i < samples; ++i) {
+			deck.shuffle();
+
+			// Deal the hands and the board so far
+			utl::array<Card, 2> hand = { deck.dealCard(), deck.dealCard() };
+			utl::array<Card, 2> opponent = { deck.dealCard(), deck.dealCard() };
+			utl::vector<Card, 5> board;
+			for (uint8_t j = 0; j < board_size; ++j)
+				board.push_back(deck.dealCard());
+			uint16_t bucket = HandBuckets::bucket(hand, board);
+
+			// Run the board out, a win scores two and a split one
+			while (board.size() < 5)
+				board.push_back(deck.dealCard());
+			uint32_t value = HandEvaluator::evaluate(hand, board);
+			uint32_t opponent_value = HandEvaluator::evaluate(opponent, board);
+			shares[bucket] += value > opponent_value ? 2 : value == opponent_value ? 1 : 0;
+			counts[bucket] += 2;
+		}
+	}
+
+	// Buckets never seen take the share of their category on the same street
+	std::vector<uint8_t> equities(HandBuckets::BUCKETS, 0x80);
+	for (uint16_t bucket = 0; bucket < HandBuckets::BUCKETS; ++bucket) {
+		uint16_t first = bucket;
+		uint16_t group = HandBuckets::TEXTURES;
+		if (bucket < 2 * HandBuckets::DRAWING_STREET_BUCKETS)
+			group *= HandBuckets::DRAWS;
+		else
+			first = static_cast<uint16_t>(bucket - 2 * HandBuckets::DRAWING_STREET_BUCKETS);
+		first = static_cast<uint16_t>(bucket - first % group);
+		uint64_t share = shares[bucket];
+		uint64_t count = counts[bucket];
+		if (count == 0) {
+			for (uint16_t other = first; other < first + group; ++other) {
+				share += shares[other];
+				count += counts[other];
+			}
+		}
+		if (count != 0)
+			equities[bucket] = static_cast<uint8_t>((share * 255 + count / 2) / count);
+	}
+
+	// Print the bucket equity data blob
+	std::cout << "static const uint8_t bucket_equities[HandBuckets::BUCKETS] ROM_DATA = {" << std::endl;
+	for (uint16_t bucket = 0; bucket < HandBuckets::BUCKETS; ++bucket) {
+		std::cout << (bucket % 16 == 0 ? "\t" : " ") << "0x" << std::uppercase << std::hex << static_cast<int>(equities[bucket]) << std::dec << ",";
+		if (bucket % 16 == 15)
+			std::cout << std::endl;
+	}
+	std::cout << "};" << std::endl;
+
+	return 0;
+}
+
+static int trainStrategy(uint64_t iterations, unsigned threads, const char* checkpoint)
+{
+	// Resume from the checkpoint if there is one
+	StrategyTrainer trainer;
+	if (checkpoint != nullptr && trainer.load(checkpoint))
+		std::cerr << "Resumed after " << trainer.iterations() << " iterations" << std::endl;
+
+	// Train
+	auto start = std::chrono::steady_clock::now();
+	trainer.train(iterations, threads, static_cast<uint32_t>(time(nullptr)));
+	double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	std::cerr << iterations << " iterations in " << seconds << " seconds on " << threads << " threads, " << trainer.iterations() << " in all" << std::endl;
+	if (checkpoint != nullptr && trainer.save(checkpoint) == false) {
+		std::cerr << "Could not write " << checkpoint << std::endl;
+		return 1;
+	}
+
+	// Print the strategy data blob, one information set per line
+	std::vector<uint8_t> table = trainer.quantize();
+	std::cout << "static const uint8_t strategy_table[Strategy::INFORMATION_SETS * Strategy::ACTIONS] ROM_DATA = {" << std::endl;
+	for (size_t i = 0; i < table.size(); ++i) {
+		std::cout << (i % Strategy::ACTIONS == 0 ? "\t" : " ") << "0x" << std::uppercase << std::hex << (table[i] < 0x10 ? "0" : "")
+			<< static_cast<int>(table[i]) << std::dec << ",";
+		if (i % Strategy::ACTIONS == Strategy::ACTIONS - 1)
+			std::cout << std::endl;
+	}
+	std::cout << "};" << std::endl;
+
+	return 0;
+}
+
+/** Observer that stops a recorded game after a fixed number of rounds
+ */
+class RoundLimitObserver : public NullObserver
+{
+public:
+
+	explicit RoundLimitObserver(uint32_t max_rounds_in) : max_rounds(max_rounds_in) {}
+
+	bool roundEnd(bool, const utl::string<MAX_NAME_SIZE>&, uint16_t, RankedHand::Ranking, const HeadsUpPokerGame::PokerGameState&,
+		const utl::vector<uint8_t, 2>&)
+	{
+		return ++this->rounds < this->max_rounds;
+	}
+
+private:
+
+	uint32_t rounds = 0;
+	uint32_t max_rounds;
+};
+
+static void writeFile(const uint8_t* data, size_t size, void* opaque)
+{
+	fwrite(data, 1, size, static_cast<FILE*>(opaque));
+}
+
+static int recordGames(const char* path, uint32_t games, uint32_t random_seed)
+{
+	FILE* file = fopen(path, "wb");
+	if (file == nullptr) {
+		std::cerr << "Unable to open " << path << std::endl;
+		return 1;
+	}
+
+	// Play all AI heads up games, one stream per game, back to back
+	using Observer = TeeObserver<HandHistoryWriter<2>, RoundLimitObserver>;
+	for (uint32_t game = 0; game < games; ++game) {
+		uint32_t game_seed = random_seed + game;
+		BasicPokerGame<2, AIDecider<2>, Observer> poker_game(game_seed, 5, 500, AIDecider<2>(),
+			Observer(HandHistoryWriter<2>(&writeFile, file, game_seed, 5), RoundLimitObserver(1000)));
+		poker_game.play();
+	}
+
+	fclose(file);
+	return 0;
+}
+
+template <uint8_t SEATS>
+static HandHistoryReplayResult replayStream(const uint8_t* data, size_t size)
+{
+	HandHistoryReplayer<SEATS> replayer(data, size);
+	return replayer.replay();
+}
+
+static int replayGames(const char* path)
+{
+	MappedFile file(path);
+	if (file.isOpen() == false) {
+		std::cerr << "Unable to map " << path << std::endl;
+		return 1;
+	}
+
+	// Replay each stream in the file, the seat count follows the magic bytes and version
+	uint64_t hands = 0;
+	uint64_t mismatches = 0;
+	uint64_t skipped = 0;
+	uint32_t streams = 0;
+	size_t offset = 0;
+	auto start = std::chrono::steady_clock::now();
+	while (offset + 4 <= file.size()) {
+		HandHistoryReplayResult result;
+		switch (file.data()[offset + 3])
+		{
+		case 2:
+			result = replayStream<2>(file.data() + offset, file.size() - offset);
+			break;
+		case 6:
+			result = replayStream<6>(file.data() + offset, file.size() - offset);
+			break;
+		case 9:
+			result = replayStream<9>(file.data() + offset, file.size() - offset);
+			break;
+		default:
+			break;
+		}
+
+		// Stop at a stream that could not be read to its end, the rest of the file can not be found
+		hands += result.hands;
+		mismatches += result.mismatches;
+		skipped += result.skipped;
+		if (result.mismatches > 0)
+			std::cout << "Stream " << streams << " first diverges at hand " << result.first_mismatch << std::endl;
+		if (result.skipped > 0)
+			std::cout << "Stream " << streams << " has too many actions to replay at hand " << result.overlong_hand << ", "
+				<< result.skipped << " hands not replayed" << std::endl;
+		++streams;
+		if (result.complete == false || result.bytes == 0) {
+			std::cout << "Stream " << streams - 1 << " is incomplete at byte " << offset + result.bytes << std::endl;
+			break;
+		}
+		offset += result.bytes;
+	}
+	double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+	std::cout << streams << " streams, " << hands << " hands, " << mismatches << " mismatched hands, " << skipped << " hands not replayed" << std::endl;
+	std::cout << static_cast<uint64_t>(hands / (seconds > 0.0 ? seconds : 1.0)) << " hands per second" << std::endl;
+	return mismatches == 0 && skipped == 0 ? 0 : 1;
+}
+
+static std::string indexPath(const char* path)
+{
+	return std::string(path) + ".idx";
+}
+
+static bool findStreams(const MappedFile& file, std::vector<uint64_t>& offsets)
+{
+	// Walk the file one stream at a time, each stream's size is only known once it has been read
+	size_t offset = 0;
+	while (offset < file.size()) {
+		HandHistoryStats skipped;
+		size_t stream_size = skipped.addStream(file.data() + offset, file.size() - offset, 0);
+		if (stream_size == 0)
+			return false;
+		offsets.push_back(offset);
+		offset += stream_size;
+	}
+	return true;
+}
+
+static int indexGames(const char* path)
+{
+	MappedFile file(path);
+	std::vector<uint64_t> offsets;
+	if (file.isOpen() == false || findStreams(file, offsets) == false) {
+		std::cerr << "Unable to read " << path << std::endl;
+		return 1;
+	}
+
+	// The index is the offset of each stream, followed by the size of the file it indexes
+	offsets.push_back(file.size());
+	FILE* index = fopen(indexPath(path).c_str(), "wb");
+	if (index == nullptr) {
+		std::cerr << "Unable to open " << indexPath(path) << std::endl;
+		return 1;
+	}
+	fwrite(offsets.data(), sizeof(uint64_t), offsets.size(), index);
+	fclose(index);
+	std::cout << offsets.size() - 1 << " streams indexed" << std::endl;
+	return 0;
+}
+
+static int gameStats(const char* path, unsigned threads)
+{
+	MappedFile file(path);
+	if (file.isOpen() == false) {
+		std::cerr << "Unable to map " << path << std::endl;
+		return 1;
+	}
+
+	// Use the index if it is for this file, otherwise find the streams
+	std::vector<uint64_t> offsets;
+	MappedFile index(indexPath(path).c_str());
+	const uint64_t* indexed = reinterpret_cast<const uint64_t*>(index.data());
+	size_t indexed_count = index.size() / sizeof(uint64_t);
+	if (index.isOpen() == true && indexed_count > 0 && indexed[indexed_count - 1] == file.size())
+		offsets.assign(indexed, indexed + indexed_count - 1);
+	else if (findStreams(file, offsets) == false) {
+		std::cerr << "Unable to read " << path << std::endl;
+		return 1;
+	}
+	offsets.push_back(file.size());
+
+	// Each thread scans a contiguous run of streams into its own statistics
+	auto start = std::chrono::steady_clock::now();
+	size_t streams = offsets.size() - 1;
+	if (threads == 0)
+		threads = 1;
+	std::vector<HandHistoryStats> thread_stats(threads);
+	std::vector<std::thread> workers;
+	for (unsigned thread = 0; thread < threads; ++thread) {
+		size_t first = streams * thread / threads;
+		size_t last = streams * (thread + 1) / threads;
+		workers.emplace_back([&, first, last, thread]() {
+			for (size_t stream = first; stream < last; ++stream)
+				thread_stats[thread].addStream(file.data() + offsets[stream], static_cast<size_t>(offsets[stream + 1] - offsets[stream]));
+		});
+	}
+	HandHistoryStats stats;
+	for (unsigned thread = 0; thread < threads; ++thread) {
+		workers[thread].join();
+		stats.merge(thread_stats[thread]);
+	}
+	double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+	// Report each column
+	std::cout << streams << " streams, " << stats.hands << " hands" << std::endl;
+	for (size_t seat = 0; seat < stats.dealt.size(); ++seat) {
+		if (stats.dealt[seat] == 0)
+			continue;
+		std::cout << "Seat " << seat << ": VPIP " << 100.0 * stats.vpip[seat] / stats.dealt[seat] << "%, PFR "
+			<< 100.0 * stats.pfr[seat] / stats.dealt[seat] << "%" << std::endl;
+	}
+	static const char* const ranking_names[HandHistoryStats::RANKINGS] = { "Unranked", "High card", "Pair", "Two pair",
+		"Three of a kind", "Straight", "Flush", "Full house", "Four of a kind", "Straight flush", "Royal flush" };
+	for (size_t ranking = 0; ranking < HandHistoryStats::RANKINGS; ++ranking) {
+		if (stats.showdowns[ranking] == 0)
+			continue;
+		std::cout << ranking_names[ranking] << ": " << stats.showdowns[ranking] << " showdowns, won "
+			<< 100.0 * stats.showdown_wins[ranking] / stats.showdowns[ranking] << "%" << std::endl;
+	}
+	static const char* const street_names[HandHistoryStats::STREETS] = { "Pre-flop", "Flop", "Turn", "River" };
+	for (size_t street = 0; street < HandHistoryStats::STREETS; ++street) {
+		if (stats.street_hands[street] == 0)
+			continue;
+		std::cout << street_names[street] << ": " << stats.street_hands[street] << " hands, average pot "
+			<< static_cast<double>(stats.street_pots[street]) / stats.street_hands[street] << std::endl;
+	}
+	std::cout << static_cast<uint64_t>(stats.hands / (seconds > 0.0 ? seconds : 1.0)) << " hands per second on " << threads << " threads" << std::endl;
+	return 0;
+}
+
+static int duplicateMatch(const char* first_name, const char* second_name, uint64_t deals, unsigned threads, uint32_t random_seed,
+	uint32_t search_iterations)
+{
+	DuplicateEvaluator::Player first;
+	DuplicateEvaluator::Player second;
+	if (DuplicateEvaluator::parsePlayer(first_name, first) == false || DuplicateEvaluator::parsePlayer(second_name, second) == false) {
+		std::cerr << "Players are rules, quick or search" << std::endl;
+		return 1;
+	}
+
+	// Play every deal from both seats
+	auto start = std::chrono::steady_clock::now();
+	DuplicateEvaluator evaluator(first, second, search_iterations);
+	DuplicateEvaluator::Result result = evaluator.evaluate(deals, threads == 0 ? 1 : threads, random_seed);
+	double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+	// Report the first player's win rate, and how much narrower the interval is than single hands would give
+	std::cout << first_name << " vs " << second_name << ": " << result.winRate() << " +/- " << result.confidence()
+		<< " bb/100 over " << result.deals << " deals" << std::endl;
+	double single = result.singleConfidence();
+	if (single > 0.0) {
+		double ratio = result.confidence() / single;
+		std::cout << "Single hands: +/- " << single << " bb/100, duplicate variance is " << 100.0 * ratio * ratio << "%" << std::endl;
+	}
+	std::cout << static_cast<uint64_t>(2 * result.deals / (seconds > 0.0 ? seconds : 1.0)) << " hands per second on "
+		<< (threads == 0 ? 1 : threads) << " threads" << std::endl;
+	return 0;
+}
+
+static int tuneParameters(uint32_t generations, uint64_t deals, unsigned threads, const char* checkpoint, const char* header)
+{
+	// Resume from the checkpoint if there is one
+	ParameterTuner tuner;
+	if (checkpoint != nullptr && tuner.load(checkpoint))
+		std::cerr << "Resumed after " << tuner.generations() << " generations" << std::endl;
+
+	// Run each generation, and checkpoint it so that a long run may be stopped at any time
+	uint32_t random_seed = static_cast<uint32_t>(time(nullptr));
+	for (uint32_t i = 0; i < generations; ++i) {
+		auto start = std::chrono::steady_clock::now();
+		double win_rate = tuner.generation(deals, threads == 0 ? 1 : threads, random_seed);
+		double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+		std::cerr << "Generation " << tuner.generations() << ": best candidate " << win_rate << " bb/100, " << tuner.improvements()
+			<< " improvements, " << seconds << " seconds" << std::endl;
+		if (checkpoint != nullptr && tuner.save(checkpoint) == false) {
+			std::cerr << "Could not write " << checkpoint << std::endl;
+			return 1;
+		}
+	}
+	if (tuner.writeHeader(header) == false) {
+		std::cerr << "Could not write " << header << std::endl;
+		return 1;
+	}
+	return 0;
+}
+
+/** Print a push or fold chart data blob, one stack depth per line
+ *  @param name The name of the chart
+ *  @param charts The ranges of each stack depth
+ *  @param push True for the push chart, false for the call chart
+ */
+static void printChart(const char* name, const std::vector<PushFoldSolver::Ranges>& charts, bool push)
+{
+	std::cout << "static const uint8_t " << name << "[PushFold::MAX_DEPTH][PushFold::CHART_BYTES] ROM_DATA = {" << std::endl;
+	for (const PushFoldSolver::Ranges& ranges : charts) {
+		const utl::array<double, PushFold::HAND_CLASSES>& range = push ? ranges.push : ranges.call;
+		std::cout << "\t{";
+		for (uint8_t byte = 0; byte < PushFold::CHART_BYTES; ++byte) {
+
+			// Hand classes that are played at least half the time are in the chart
+			uint8_t bits = 0;
+			for (uint8_t bit = 0; bit < 8 && byte * 8 + bit < PushFold::HAND_CLASSES; ++bit) {
+				if (range[byte * 8 + bit] >= 0.5)
+					bits = static_cast<uint8_t>(bits | (1 << bit));
+			}
+			std::cout << (byte == 0 ? " " : ", ") << "0x" << std::uppercase << std::hex << (bits < 0x10 ? "0" : "") << static_cast<int>(bits) << std::dec;
+		}
+		std::cout << " }," << std::endl;
+	}
+	std::cout << "};" << std::endl;
+}
+
+static int pushFoldCharts(uint32_t samples, unsigned threads, const char* equity_path)
+{
+	// Load the equities if they have been computed, otherwise compute them and save them for the next run
+	if (threads == 0)
+		threads = 1;
+	PushFoldSolver solver;
+	auto start = std::chrono::steady_clock::now();
+	if (equity_path != nullptr && solver.loadEquities(equity_path)) {
+		std::cerr << "Loaded equities from " << equity_path << std::endl;
+	}
+	else {
+		solver.computeEquities(samples, threads, static_cast<uint32_t>(time(nullptr)));
+		double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+		std::cerr << "Computed equities in " << seconds << " seconds" << std::endl;
+		if (equity_path != nullptr && solver.saveEquities(equity_path) == false) {
+			std::cerr << "Could not write " << equity_path << std::endl;
+			return 1;
+		}
+	}
+
+	// Solve the stack depths, each thread takes every threads'th one
+	start = std::chrono::steady_clock::now();
+	std::vector<PushFoldSolver::Ranges> charts(PushFold::MAX_DEPTH);
+	std::vector<std::thread> workers;
+	for (unsigned thread = 0; thread < threads; ++thread) {
+		workers.emplace_back([&solver, &charts, threads, thread]() {
+			for (unsigned depth = thread + 1; depth <= PushFold::MAX_DEPTH; depth += threads)
+				charts[depth - 1] = solver.solve(static_cast<uint8_t>(depth), 2000);
+		});
+	}
+	for (auto& worker : workers)
+		worker.join();
+	double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	for (uint8_t depth = 1; depth <= PushFold::MAX_DEPTH; ++depth) {
+		std::cerr << static_cast<int>(depth) << " big blinds: push " << 100.0 * solver.share(charts[depth - 1].push) << "%, call "
+			<< 100.0 * solver.share(charts[depth - 1].call) << "%" << std::endl;
+	}
+	std::cerr << "Solved in " << seconds << " seconds on " << threads << " threads" << std::endl;
+
+	// Print the chart data blobs
+	printChart("push_chart", charts, true);
+	printChart("call_chart", charts, false);
+	return 0;
+}
+
+/** The bytes received from a device and the lines typed by the user, shared with the threads that read them
+ */
+struct RenderLink
+{
+	FILE* device_out = nullptr;
+	std::mutex mutex;
+	std::vector<uint8_t> bytes;
+	std::deque<std::string> lines;
+	bool device_closed = false;
+};
+
+static RenderLink render_link;
+
+static void writeConsole(const char* begin, const char* end, void* opaque)
+{
+	std::cout.write(begin, end - begin);
+	std::cout.flush();
+}
+
+static utl::string<ConsoleIO::MAX_USER_INPUT_LEN> readConsoleLine(void* opaque)
+{
+	RenderLink* link = static_cast<RenderLink*>(opaque);
+	std::string line;
+	{
+		std::lock_guard<std::mutex> lock(link->mutex);
+		if (link->lines.empty())
+			return utl::string<ConsoleIO::MAX_USER_INPUT_LEN>();
+		line = link->lines.front();
+		link->lines.pop_front();
+	}
+
+	// The device reads the same line, and answers its own prompt exactly as the console does
+	fputs(line.c_str(), link->device_out);
+	fputc('\r', link->device_out);
+	fflush(link->device_out);
+	return utl::string<ConsoleIO::MAX_USER_INPUT_LEN>(line.c_str());
+}
+
+static void delayConsole(int16_t delay_ms)
+{
+	std::this_thread::sleep_for(std::chrono::milliseconds(delay_ms));
+}
+
+static int renderGame(const char* path)
+{
+	FILE* device_in = fopen(path, "rb");
+	render_link.device_out = fopen(path, "ab");
+	if (device_in == nullptr || render_link.device_out == nullptr) {
+		std::cerr << "Unable to open " << path << std::endl;
+		return 1;
+	}
+
+	// Read the device and the user's lines on their own threads, so that neither waits for the other
+	std::thread([device_in]() {
+		int c;
+		while ((c = fgetc(device_in)) != EOF) {
+			std::lock_guard<std::mutex> lock(render_link.mutex);
+			render_link.bytes.push_back(static_cast<uint8_t>(c));
+		}
+		std::lock_guard<std::mutex> lock(render_link.mutex);
+		render_link.device_closed = true;
+	}).detach();
+	std::thread([]() {
+		std::string line;
+		while (std::getline(std::cin, line)) {
+			std::lock_guard<std::mutex> lock(render_link.mutex);
+			render_link.lines.push_back(line);
+		}
+	}).detach();
+
+	// Draw each frame as it arrives, and poll the prompts while the device waits for the user
+	ConsoleIO console(&writeConsole, &readConsoleLine, &delayConsole, &render_link);
+	BinaryIODecoder decoder(&ConsoleIO::userDecision, &ConsoleIO::playerAction, &ConsoleIO::subRoundChange, &ConsoleIO::roundEnd,
+		&ConsoleIO::gameEnd, &console);
+	while (decoder.isGameOver() == false) {
+		std::vector<uint8_t> bytes;
+		bool device_closed;
+		{
+			std::lock_guard<std::mutex> lock(render_link.mutex);
+			bytes.swap(render_link.bytes);
+			device_closed = render_link.device_closed;
+		}
+		decoder.feed(bytes.data(), bytes.size());
+		decoder.poll();
+		console.pollContinue();
+		if (device_closed == true && bytes.empty() == true)
+			break;
+		std::this_thread::sleep_for(std::chrono::milliseconds(10));
+	}
+	return 0;
+}
+
+/** Counts what a front end writes, and answers each of its prompts by checking, calling or continuing
+ */
+struct BenchLink
+{
+	uint64_t bytes = 0;
+	uint64_t writes = 0;
+};
+
+static void countWrite(const char* begin, const char* end, void* opaque)
+{
+	BenchLink* link = static_cast<BenchLink*>(opaque);
+	link->bytes += end - begin;
+	++link->writes;
+}
+
+static utl::string<ConsoleIO::MAX_USER_INPUT_LEN> readCallLine(void* opaque)
+{
+	return utl::string<ConsoleIO::MAX_USER_INPUT_LEN>("c");
+}
+
+static void delayNone(int16_t delay_ms)
+{
+}
+
+/** The events of a game played through BinaryIO
+ */
+struct RecordedGame
+{
+	std::vector<uint8_t> link;
+	uint64_t writes = 0;
+};
+
+static void recordLink(const char* begin, const char* end, void* opaque)
+{
+	RecordedGame* game = static_cast<RecordedGame*>(opaque);
+	game->link.insert(game->link.end(), begin, end);
+	++game->writes;
+}
+
+template <class FrontEnd, class MakeFrontEnd>
+static double drawGames(const std::vector<RecordedGame>& games, MakeFrontEnd make_front_end)
+{
+	// Decode each game's events into a fresh front end, so that only the decoding and the drawing are timed
+	auto start = std::chrono::steady_clock::now();
+	for (const RecordedGame& game : games) {
+		FrontEnd front_end = make_front_end();
+		BinaryIODecoder decoder(&FrontEnd::userDecision, &FrontEnd::playerAction, &FrontEnd::subRoundChange, &FrontEnd::roundEnd,
+			&FrontEnd::gameEnd, &front_end);
+		decoder.feed(game.link.data(), game.link.size());
+	}
+	return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+static void printBench(const char* name, uint32_t hands, double seconds, const BenchLink& link)
+{
+	std::cout << name << ": " << static_cast<double>(link.bytes) / hands << " bytes, " << static_cast<double>(link.writes) / hands
+		<< " writes, " << seconds * 1e6 / hands << " us per hand" << std::endl;
+}
+
+static int benchFrontEnds(uint32_t hands, uint32_t random_seed)
+{
+	// Play seeded games back to back through BinaryIO until enough hands have been played, keeping each game's events
+	std::vector<RecordedGame> games;
+	BenchLink binary_link;
+	uint32_t played = 0;
+	auto start = std::chrono::steady_clock::now();
+	for (uint32_t game = 0; played < hands; ++game) {
+		games.emplace_back();
+		BinaryIO binary_io(&recordLink, &readCallLine, &games.back());
+		PokerGame poker_game(random_seed + game, 5, 500, &BinaryIO::userDecision, &BinaryIO::playerAction, &BinaryIO::subRoundChange,
+			&BinaryIO::roundEnd, &BinaryIO::gameEnd, &binary_io);
+		PokerGame::StepResult result = PokerGame::StepResult::Running;
+		while (result != PokerGame::StepResult::GameOver && played < hands) {
+			result = poker_game.step();
+			if (result == PokerGame::StepResult::RoundOver || result == PokerGame::StepResult::GameOver)
+				++played;
+		}
+		binary_link.bytes += games.back().link.size();
+		binary_link.writes += games.back().writes;
+	}
+	double game_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+	// Draw the same events with ConsoleIO and with NullIO, the difference is the cost of drawing alone
+	BenchLink console_link;
+	double console_seconds = drawGames<ConsoleIO>(games, [&console_link]() {
+		return ConsoleIO(&countWrite, &readCallLine, &delayNone, &console_link);
+	});
+	double null_seconds = drawGames<NullIO>(games, []() { return NullIO(); });
+
+	std::cout << played << " hands in " << games.size() << " games from seed " << random_seed << ", "
+		<< game_seconds * 1e6 / played << " us per hand played" << std::endl;
+	std::cout << "BinaryIO: " << static_cast<double>(binary_link.bytes) / played << " bytes, "
+		<< static_cast<double>(binary_link.writes) / played << " writes per hand" << std::endl;
+	printBench("ConsoleIO", played, console_seconds, console_link);
+	printBench("NullIO", played, null_seconds, BenchLink());
+	std::cout << "ConsoleIO drawing: " << (console_seconds - null_seconds) * 1e6 / played << " us per hand" << std::endl;
+	return 0;
+}
+
+static int usage()
+{
+	std::cerr << "Usage:" << std::endl;
+	std::cerr << "  util strengths                      Print the pre-flop hand strength table" << std::endl;
+	std::cerr << "  util buckets [samples] [seed]       Print the post-flop bucket equity table" << std::endl;
+	std::cerr << "  util train <iterations> [threads] [checkpoint]" << std::endl;
+	std::cerr << "                                      Train the strategy tables and print them, resuming from a checkpoint" << std::endl;
+	std::cerr << "  util record <file> <games> [seed]   Record all AI heads up games to a hand history file" << std::endl;
+	std::cerr << "  util replay <file>                  Replay a hand history file and check it" << std::endl;
+	std::cerr << "  util index <file>                   Write an index of the streams in a hand history file" << std::endl;
+	std::cerr << "  util stats <file> [threads]         Print aggregate statistics of a hand history file" << std::endl;
+	std::cerr << "  util duplicate <first> <second> <deals> [threads] [seed] [iterations]" << std::endl;
+	std::cerr << "                                      Compare rules, quick or search AI players in duplicate hands" << std::endl;
+	std::cerr << "  util pushfold [samples] [threads] [equities]" << std::endl;
+	std::cerr << "                                      Print the push or fold charts, computing the equities or loading them" << std::endl;
+	std::cerr << "  util tune <generations> [deals] [threads] [checkpoint] [header]" << std::endl;
+	std::cerr << "                                      Tune the AI parameters and write them to AIParameters.h, resuming from a checkpoint" << std::endl;
+	std::cerr << "  util render <device>                Draw the game of a device built with BINARY_IO=1" << std::endl;
+	std::cerr << "  util bench [hands] [seed]           Measure the bytes, writes and time per hand of each front end" << std::endl;
+	return 1;
+}
+
+int main(int argc, char** argv)
+{
+	// Without a command, print the hand strength table
+	if (argc < 2 || strcmp(argv[1], "strengths") == 0)
+		return handStrengths();
+
+	if (strcmp(argv[1], "buckets") == 0)
+		return bucketEquities(argc >= 3 ? static_cast<uint32_t>(strtoul(argv[2], nullptr, 10)) : 10 * 1000 * 1000,
+			argc >= 4 ? static_cast<uint32_t>(strtoul(argv[3], nullptr, 10)) : static_cast<uint32_t>(time(nullptr)));
+
+	if (strcmp(argv[1], "train") == 0 && argc >= 3)
+		return trainStrategy(strtoull(argv[2], nullptr, 10), argc >= 4 ? static_cast<unsigned>(strtoul(argv[3], nullptr, 10)) : std::thread::hardware_concurrency(),
+			argc >= 5 ? argv[4] : nullptr);
+
+	if (strcmp(argv[1], "record") == 0 && argc >= 4)
+		return recordGames(argv[2], static_cast<uint32_t>(strtoul(argv[3], nullptr, 10)),
+			argc >= 5 ? static_cast<uint32_t>(strtoul(argv[4], nullptr, 10)) : static_cast<uint32_t>(time(nullptr)));
+
+	if (strcmp(argv[1], "replay") == 0 && argc >= 3)
+		return replayGames(argv[2]);
+
+	if (strcmp(argv[1], "index") == 0 && argc >= 3)
+		return indexGames(argv[2]);
+
+	if (strcmp(argv[1], "stats") == 0 && argc >= 3)
+		return gameStats(argv[2], argc >= 4 ? static_cast<unsigned>(strtoul(argv[3], nullptr, 10)) : std::thread::hardware_concurrency());
+
+	if (strcmp(argv[1], "duplicate") == 0 && argc >= 5)
+		return duplicateMatch(argv[2], argv[3], strtoull(argv[4], nullptr, 10),
+			argc >= 6 ? static_cast<unsigned>(strtoul(argv[5], nullptr, 10)) : std::thread::hardware_concurrency(),
+			argc >= 7 ? static_cast<uint32_t>(strtoul(argv[6], nullptr, 10)) : static_cast<uint32_t>(time(nullptr)),
+			argc >= 8 ? static_cast<uint32_t>(strtoul(argv[7], nullptr, 10)) : 64);
+
+	if (strcmp(argv[1], "pushfold") == 0)
+		return pushFoldCharts(argc >= 3 ? static_cast<uint32_t>(strtoul(argv[2], nullptr, 10)) : 20000,
+			argc >= 4 ? static_cast<unsigned>(strtoul(argv[3], nullptr, 10)) : std::thread::hardware_concurrency(), argc >= 5 ? argv[4] : nullptr);
+
+	if (strcmp(argv[1], "tune") == 0 && argc >= 3)
+		return tuneParameters(static_cast<uint32_t>(strtoul(argv[2], nullptr, 10)), argc >= 4 ? strtoull(argv[3], nullptr, 10) : 1000,
+			argc >= 5 ? static_cast<unsigned>(strtoul(argv[4], nullptr, 10)) : std::thread::hardware_concurrency(),
+			argc >= 6 ? argv[5] : nullptr, argc >= 7 ? argv[6] : "AIParameters.h");
+
+	if (strcmp(argv[1], "render") == 0 && argc >= 3)
+		return renderGame(argv[2]);
+
+	if (strcmp(argv[1], "bench") == 0)
+		return benchFrontEnds(argc >= 3 ? static_cast<uint32_t>(strtoul(argv[2], nullptr, 10)) : 1000,
+			argc >= 4 ? static_cast<uint32_t>(strtoul(argv[3], nullptr, 10)) : 1);
+
+	return usage();
 }
\ No newline at end of file
@@ -63,12 +63,14 @@ public:
      */
     size_t readBytes(char* begin, char* end);
 
-    /** Write a char to the UART bus.
+    /** Write a char to the UART bus. The char is queued for the TX interrupt to send, waiting only while the queue is
+     *  full
      *  @param chr The character to write
      */
     void writeChar(char chr);
 
-    /** Write bytes to the UART bus
+    /** Write bytes to the UART bus. The bytes are queued for the TX interrupt to send, waiting only while the queue is
+     *  full
      *  @param begin The beginning of the source buffer
      *  @param end The end of the source buffer
      *  @return The number of bytes written
@@ -53,6 +53,10 @@ public:
      */
     void delayMilliSeconds(uint16_t delay);
 
+    /** Idle briefly, the desktop has no interrupt to sleep until
+     */
+    void idle();
+
     /** Configure a UART port
      *  @param index The platform specific UART index to configure
      *  @param options The options to configure
@@ -54,6 +54,11 @@ public:
      */
 	void delayMilliSeconds(uint16_t delay);
 
+    /** Sleep in LPM0, which keeps the UART running, until the console receives a byte. Returns at once if the
+     *  console has received a byte
+     */
+	void idle();
+
     /** Configure a UART port
      *  @param index The platform specific UART index to configure
      *  @param options The options to configure
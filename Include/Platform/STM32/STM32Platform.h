@@ -63,6 +63,11 @@ public:
      */
 	void delayMilliSeconds(uint16_t delay);
 
+    /** Sleep until an interrupt wakes the CPU, at the latest the next millisecond tick. Returns at once if the
+     *  console has received a byte
+     */
+	void idle();
+
     /** Configure a UART port
      *  @param index The platform specific UART index to configure
      *  @param options The options to configure
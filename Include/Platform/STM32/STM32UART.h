@@ -63,7 +63,8 @@ public:
      */
     size_t readBytes(char* begin, char* end, uint32_t max_delay_ms = 0); // TODO XXX FIXME API update
 
-    /** Write bytes to the UART bus
+    /** Write bytes to the UART bus. The bytes are queued for the TX interrupt to send, waiting only while the queue is
+     *  full
      *  @param begin The beginning of the source buffer
      *  @param end The end of the source buffer
      *  @return The number of bytes written
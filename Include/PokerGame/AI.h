@@ -23,17 +23,161 @@
 #include <utl/utility>
 
 #include "PokerGame/Card.h"
-#include "PokerGame/PokerGame.h"
+#include "PokerGame/PokerGameBase.h"
+#include "PokerGame/PokerGameState.h"
+#include "PokerGame/Random.h"
+
+struct SeatProfile;
+
+/// The most hands the AI evaluates per decision after the flop. When every opponent holding and next card fit, it judges by
+/// effective hand strength, otherwise it samples its equity. Zero looks equity up in the HandBuckets tables instead
+#ifndef AI_EQUITY_BUDGET
+#define AI_EQUITY_BUDGET 50000
+#endif
+
+/// The entries of the EquityCache, that remembers the equity the AI estimates for each situation when it has a budget.
+/// A power of two, zero estimates every time
+#ifndef AI_EQUITY_CACHE
+#ifdef EMBEDDED_BUILD
+#define AI_EQUITY_CACHE 0
+#else
+#define AI_EQUITY_CACHE 65536
+#endif
+#endif
+
+/// Play from the Strategy tables trained by the util instead of by the rate of return
+#ifndef AI_STRATEGY
+#define AI_STRATEGY 0
+#endif
+
+/// The rollouts the AI plays per decision to search its actions with MCTS, zero plays by the rate of return
+#ifndef AI_MCTS
+#define AI_MCTS 0
+#endif
+
+/// The most milliseconds that the AI searches for per decision on desktop, zero only limits the rollouts
+#ifndef AI_MCTS_MILLISECONDS
+#define AI_MCTS_MILLISECONDS 0
+#endif
+
+/// The deepest effective stack in big blinds that the AI plays heads up by the PushFold charts before the flop, pushing
+/// or folding in the small blind and calling or folding a push. Zero always plays by the rate of return
+#ifndef AI_PUSH_FOLD_DEPTH
+#define AI_PUSH_FOLD_DEPTH 25
+#endif
 
 /** AI namespace, implements AI decision function
  */
 namespace AI
 {
+    /// The number of bands of rate of return that the AI plays differently
+    constexpr uint8_t BANDS = 4;
+
+    /** The parameters that the AI plays by the rate of return with, the tuned set is generated into AIParameters.h by
+     *  the util's tune command
+     */
+    struct Parameters
+    {
+        /// The rate of return that each band but the strongest is below, in hundredths and ascending
+        utl::array<uint16_t, BANDS - 1> band_limits;
+
+        /// The chance to fold in each band of rate of return, in units of 1/10000
+        utl::array<uint16_t, BANDS> fold_chances;
+
+        /// The chance to call in each band of rate of return, in units of 1/10000, the chance to raise is the rest
+        utl::array<uint16_t, BANDS> call_chances;
+
+        /// The chance to raise again when choosing a bet in each band of rate of return, in units of 1/10000
+        utl::array<uint16_t, BANDS> raise_chances;
+
+        /// A bit for each band limit whose nearest float is below it, as found by roundedDownLimits, so that the fixed
+        /// point band does not work it out on every decision
+        uint8_t rounded_down_limits;
+    };
+
+    /** Get the tuned parameters, that the AI plays by unless it is given others
+     *  @return The parameters
+     */
+    const Parameters& tunedParameters();
+
+    /** Find the band limits whose nearest float is below them, a float rate of return exactly on such a limit is in
+     *  the band below it
+     *  @param band_limits The band limits in hundredths
+     *  @return A bit for each band limit, the lowest for the first
+     */
+    uint8_t roundedDownLimits(const utl::array<uint16_t, BANDS - 1>& band_limits);
+
     /** AI decision function, decides on an action based on game state
+     *  @tparam SEATS The number of seats at the table
+     *  @param state The game state
+     *  @param rng A random number generator
+     *  @param player_id The id of the player that is acting
+     *  @result The action pair, with the first element specifying the action, and the second element specifying the bet, if any
+     */
+    template <uint8_t SEATS>
+    utl::pair<PokerGameBase::PlayerAction, uint16_t> computerDecision(const BasicPokerGameState<SEATS>& state, Random& rng, uint8_t player_id);
+
+    /** AI decision function that adjusts how it plays by the rate of return to its opponents' tendencies. Against
+     *  opponents that often fold to bets it raises more, and against loose or aggressive opponents it folds less
+     *  @tparam SEATS The number of seats at the table
      *  @param state The game state
      *  @param rng A random number generator
      *  @param player_id The id of the player that is acting
+     *  @param opponents The mean profile of the opponents still in the hand, see OpponentModel.h
      *  @result The action pair, with the first element specifying the action, and the second element specifying the bet, if any
      */
-    utl::pair<PokerGame::PlayerAction, uint16_t> computerDecision(const PokerGameState& state, Random& rng, uint8_t player_id);
+    template <uint8_t SEATS>
+    utl::pair<PokerGameBase::PlayerAction, uint16_t> computerDecision(const BasicPokerGameState<SEATS>& state, Random& rng, uint8_t player_id,
+        const SeatProfile& opponents);
+
+    /** AI decision function that plays by the rate of return with the post-flop equity looked up in the HandBuckets
+     *  tables, whatever the build options. It is cheap enough to play the rollouts of the MCTS search
+     *  @tparam SEATS The number of seats at the table
+     *  @param state The game state
+     *  @param rng A random number generator
+     *  @param player_id The id of the player that is acting
+     *  @result The action pair, with the first element specifying the action, and the second element specifying the bet, if any
+     */
+    template <uint8_t SEATS>
+    utl::pair<PokerGameBase::PlayerAction, uint16_t> quickDecision(const BasicPokerGameState<SEATS>& state, Random& rng, uint8_t player_id);
+
+    /** Quick AI decision function that plays by the given parameters instead of the tuned ones, to compare them
+     *  @tparam SEATS The number of seats at the table
+     *  @param state The game state
+     *  @param rng A random number generator
+     *  @param player_id The id of the player that is acting
+     *  @param parameters The parameters to play by
+     *  @result The action pair, with the first element specifying the action, and the second element specifying the bet, if any
+     */
+    template <uint8_t SEATS>
+    utl::pair<PokerGameBase::PlayerAction, uint16_t> quickDecision(const BasicPokerGameState<SEATS>& state, Random& rng, uint8_t player_id,
+        const Parameters& parameters);
+
+    /** Find the band of rate of return of a decision, the AI plays each band differently. The rate of return is the
+     *  hand strength over the pot odds, the bands are below each of the band limits and the rest
+     *  @param hand_strength The hand strength
+     *  @param pot_odds The pot odds
+     *  @param parameters The parameters with the band limits
+     *  @return The band, from 0 for the weakest to BANDS - 1 for the strongest
+     */
+    uint8_t rateOfReturnBand(float hand_strength, float pot_odds, const Parameters& parameters = tunedParameters());
+
+    /** Find the band of rate of return of a decision in integer arithmetic, used when AI_FIXED_POINT is defined.
+     *  It makes the same choice as rateOfReturnBand, except where the rate of return is exactly a band limit that float
+     *  division may land on either side of. A rate of return exactly on a limit that rounds down in float, such as 1.3,
+     *  is in the band below it
+     *  @param strength The hand strength in units of 1 / scale
+     *  @param scale The units of the hand strength
+     *  @param bet The bet that the pot odds are of
+     *  @param pot The chips in the pot
+     *  @param parameters The parameters with the band limits
+     *  @return The band, from 0 for the weakest to BANDS - 1 for the strongest
+     */
+    uint8_t fixedRateOfReturnBand(uint16_t strength, uint16_t scale, uint16_t bet, uint16_t pot, const Parameters& parameters = tunedParameters());
+
+    /** Look up the pre-flop strength of a hand
+     *  @param hand The player's hand
+     *  @return The strength in the range [0..255]
+     */
+    uint8_t preflopStrength(const utl::array<Card, 2>& hand);
 }
\ No newline at end of file
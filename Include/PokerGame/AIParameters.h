@@ -0,0 +1,31 @@
+/**
+ *  A simple interactive texas holdem poker program.
+ *  Copyright (C) 2020, Matt Zimmerer, mzimmere@gmail.com
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ **/
+
+#pragma once
+
+#include "PokerGame/AI.h"
+
+/// The parameters that the AI plays by the rate of return with. These are the original hand-set values, the util's
+/// tune command replaces this file with the parameters that it tunes
+static constexpr AI::Parameters tuned_parameters = {
+    { 80, 100, 130 },
+    { 9500, 8000, 0, 0 },
+    { 0, 500, 6000, 3000 },
+    { 500, 1500, 4000, 7000 },
+    0x4,
+};
\ No newline at end of file
@@ -0,0 +1,326 @@
+/**
+ *  A simple interactive texas holdem poker program.
+ *  Copyright (C) 2020, Matt Zimmerer, mzimmere@gmail.com
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ **/
+#pragma once
+
+#include <utl/string>
+#include <utl/utility>
+#include <utl/vector>
+
+#include "Card.h"
+#include "HandHistory.h"
+#include "PokerGame.h"
+#include "RankedHand.h"
+
+/**
+ *  Binary event protocol, an alternative to drawing the table as text. Each game event is sent as a frame that a host
+ *  decodes and draws. Integers and cards are encoded as in the hand history format, the seats are those of the game's
+ *  table size and the state is the one that the user at seat 0 sees.
+ *
+ *  Table:      TABLE seats, then the length and characters of each player's name and varint(stack). Sent before the
+ *              first hand, the first blind's chips are part of the stack
+ *  Hand:       HAND dealer, then the user's hole cards if the user has chips. Sent before the first blind, every player
+ *              with chips is dealt in
+ *  Action:     (player_id << 2 | action) followed by varint(bet) varint(pot_investment) varint(current_bet - pot_investment)
+ *              for a bet, the blinds included, or varint(pot_investment) for a check or call. The pot investment is the
+ *              player's once the chips are in the pot
+ *  Street:     STREET | subround, followed by the cards dealt to the board
+ *  Round end:  ROUND_END winner ranking varint(winnings) varint(seated_mask) varint(stack) for each seated player, then
+ *              varint(revealed_mask) and the hole cards of each revealed player. The winner is NO_WINNER for a draw
+ *  Decision:   DECISION, the user is asked for an action
+ *  Game end:   GAME_END, then the length and characters of the winner's name
+ *
+ *  Each frame ends with FRAME_END. Within a frame, FRAME_END and FRAME_ESCAPE are sent as FRAME_ESCAPE followed by
+ *  ESCAPED_END or ESCAPED_ESCAPE, as SLIP frames them, so that a host that loses a byte on the link drops only the
+ *  frame the byte was part of and decodes from the next one on.
+ *
+ *  The user's input is read as lines of text, exactly as ConsoleIO reads it, so that the host may forward what the
+ *  user types to the device as it is.
+ */
+class BinaryIO
+{
+public:
+
+	/// The first byte of a street frame, the subround is in the low bits
+	static constexpr uint8_t STREET = HandHistoryFormat::STREET;
+
+	/// The first byte of a table frame
+	static constexpr uint8_t TABLE = 0x80;
+
+	/// The first byte of a hand frame
+	static constexpr uint8_t HAND = 0x81;
+
+	/// The first byte of a round end frame
+	static constexpr uint8_t ROUND_END = 0x82;
+
+	/// The first byte of a decision frame
+	static constexpr uint8_t DECISION = 0x83;
+
+	/// The first byte of a game end frame
+	static constexpr uint8_t GAME_END = 0x84;
+
+	/// The winner sent for a draw
+	static constexpr uint8_t NO_WINNER = HandHistoryFormat::NO_WINNER;
+
+	/// The byte that ends each frame
+	static constexpr uint8_t FRAME_END = 0xC0;
+
+	/// The byte that starts an escaped byte of a frame
+	static constexpr uint8_t FRAME_ESCAPE = 0xDB;
+
+	/// Follows FRAME_ESCAPE for a FRAME_END byte of a frame
+	static constexpr uint8_t ESCAPED_END = 0xDC;
+
+	/// Follows FRAME_ESCAPE for a FRAME_ESCAPE byte of a frame
+	static constexpr uint8_t ESCAPED_ESCAPE = 0xDD;
+
+	/// The largest frame before it is escaped, a table frame of sixteen seats with names of the longest size
+	static constexpr size_t MAX_FRAME_SIZE = 2 + 16 * (MAX_NAME_SIZE + 4);
+
+	///  Write callback definition, writes the bytes to the link as they are
+	using WriteCallback = void(*)(const char* begin, const char* end, void* opaque);
+
+	/// Maximum allowed user input size
+	static constexpr size_t MAX_USER_INPUT_LEN = 8;
+
+	///  Read line callback definition, a callback that returns an empty line while no line has been entered makes
+	///  every prompt non-blocking
+	using ReadLineCallback = utl::string<MAX_USER_INPUT_LEN>(*)(void* opaque);
+
+	/** Constructor
+	 *  @param write_callback The write callback
+	 *  @param read_line_callback The read line callback
+	 *  @param opaque A user provided pointer that will be passed with callbacks
+	 */
+	BinaryIO(WriteCallback write_callback, ReadLineCallback read_line_callback, void* opaque = nullptr);
+
+	/** Send a decision frame, then read the user's decision
+	 *  @param state The current game state
+	 *  @return The player action, where the first element is the action and the second is a bet, if any. The action
+	 *  is PlayerAction::Pending while the read line callback has no line for the prompt
+	 *  @param opaque A user provided pointer to a specific BinaryIO instance
+	 */
+	static utl::pair<PokerGame::PlayerAction, uint16_t> userDecision(const PokerGameState& state, void* opaque);
+
+	/** Send an action frame, the first blind of a round is preceded by a hand frame
+	 *  @player_name The name of the player that acted
+	 *  @param action The player's action
+	 *  @param bet The bet, if any
+	 *  @param state The current game state
+	 *  @param opaque A user provided pointer to a specific BinaryIO instance
+	 */
+	static void playerAction(const utl::string<MAX_NAME_SIZE>& player_name, PokerGame::PlayerAction action, uint16_t bet,
+		const PokerGameState& state, void* opaque);
+
+	/** Send a street frame
+	 *  @param new_sub_round The new sub round
+	 *  @param state The current game state
+	 *  @param opaque A user provided pointer to a specific BinaryIO instance
+	 */
+	static void subRoundChange(PokerGame::SubRound new_sub_round, const PokerGameState& state, void* opaque);
+
+	/** Send a round end frame, then read whether the user continues
+	 *  @param draw True if the round was a draw
+	 *  @param winner The winner of the round
+	 *  @param winnings The pot size won
+	 *  @param ranking The ranking of the winning hand
+	 *  @param state The current game state
+	 *  @param True if the game should continue, false otherwise. If the read line callback has no line yet, the game
+	 *  continues and the prompt is answered through pollContinue
+	 *  @param opaque A user provided pointer to a specific BinaryIO instance
+	 */
+	static bool roundEnd(bool draw, const utl::string<MAX_NAME_SIZE>& winner, uint16_t winnings, RankedHand::Ranking ranking, const PokerGameState& state, void* opaque);
+
+	/** Send a game end frame
+	 *  @param winner The winner of the game
+	 *  @param opaque A user provided pointer to a specific BinaryIO instance
+	 */
+	static void gameEnd(const utl::string<MAX_NAME_SIZE>& winner, void* opaque);
+
+	/** Poll the continue or quit prompt of the end of a round, hold the game between rounds while it is pending
+	 *  @return CheckOrCall to continue, Quit to quit, or Pending while the user has not answered the prompt
+	 */
+	PokerGame::PlayerAction pollContinue();
+
+private:
+
+	/// The prompt waiting for user input
+	enum class Prompt : uint8_t {
+		None = 0,
+		Action = 1,
+		BetAmount = 2,
+		Continue = 3,
+	};
+
+	/// The prompt waiting for user input, so that a non-blocking prompt resumes where it left off
+	Prompt prompt{ Prompt::None };
+
+	/// The write callback
+	WriteCallback write_callback;
+
+	/// The read line callback
+	ReadLineCallback read_line_callback;
+
+	/// User provided pointer
+	void* opaque;
+
+	/// The frame encoder, which writes through writeBytes
+	HandHistoryEncoder encoder;
+
+	/// True once the table frame has been sent
+	bool table_sent{ false };
+
+	/// True while the last bytes of a frame are being written, so that the frame end is written with them
+	bool frame_ending{ false };
+
+	/// True while a round is being played, from its first blind to its end
+	bool in_hand{ false };
+
+	/** Escape encoded bytes and pass them to the write callback
+	 *  @param data The bytes
+	 *  @param size The number of bytes
+	 *  @param opaque A pointer to the BinaryIO instance
+	 */
+	static void writeBytes(const uint8_t* data, size_t size, void* opaque);
+
+	/** Write out the frame being encoded, and end it
+	 */
+	void endFrame();
+
+	/** Send the table frame, once
+	 *  @param state The current game state, at the first blind
+	 */
+	void sendTable(const PokerGameState& state);
+
+	/** Send the hand frame
+	 *  @param state The current game state, at the first blind
+	 */
+	void sendHand(const PokerGameState& state);
+
+	/** Find the seat of a named player
+	 *  @param player_name The player's name
+	 *  @param state The current game state
+	 *  @return The player's seat, or NO_WINNER if no player has the name
+	 */
+	static uint8_t playerID(const utl::string<MAX_NAME_SIZE>& player_name, const PokerGameState& state);
+};
+
+/** Decodes binary event frames on the host, rebuilding the game state that the user sees and passing each event to
+ *  callbacks of the same form that PokerGame calls, so that a ConsoleIO may draw the game. The device and the host must
+ *  be built for the same table size
+ */
+class BinaryIODecoder
+{
+public:
+
+	/** Constructor
+	 *  @param decision_callback Called when the device asks the user for a decision, and again on each poll until the
+	 *  callback no longer returns PlayerAction::Pending
+	 *  @param player_action_callback Called for each action frame
+	 *  @param subround_change_callback Called for each street frame
+	 *  @param round_end_callback Called for each round end frame
+	 *  @param game_end_callback Called for the game end frame
+	 *  @param opaque A pointer that is provided to all callbacks
+	 */
+	BinaryIODecoder(PokerGame::DecisionCallback decision_callback, PokerGame::PlayerActionCallback player_action_callback,
+		PokerGame::SubRoundChangeCallback subround_change_callback, PokerGame::RoundEndCallback round_end_callback,
+		PokerGame::GameEndCallback game_end_callback, void* opaque);
+
+	/** Decode bytes received from the device, calling back for each frame that they complete. A frame that lost or gained
+	 *  bytes on the link is dropped
+	 *  @param data The bytes
+	 *  @param size The number of bytes
+	 */
+	void feed(const uint8_t* data, size_t size);
+
+	/** Call the decision callback again while the user's decision is pending
+	 */
+	void poll();
+
+	/** Check if the game end frame has been decoded
+	 *  @return True once the game has ended
+	 */
+	bool isGameOver() const;
+
+	/** Get the decoded game state
+	 *  @return The state, as the user at seat 0 sees it
+	 */
+	const PokerGameState& getState() const;
+
+private:
+
+	/// The decision callback
+	PokerGame::DecisionCallback decision_callback;
+
+	/// The player action callback
+	PokerGame::PlayerActionCallback player_action_callback;
+
+	/// The subround change callback
+	PokerGame::SubRoundChangeCallback subround_change_callback;
+
+	/// The round end callback
+	PokerGame::RoundEndCallback round_end_callback;
+
+	/// The game end callback
+	PokerGame::GameEndCallback game_end_callback;
+
+	/// User provided pointer
+	void* opaque;
+
+	/// The decoded game state
+	PokerGameState state;
+
+	/// The bytes of the frame being received, unescaped
+	utl::vector<uint8_t, BinaryIO::MAX_FRAME_SIZE> frame;
+
+	/// True if the last byte received was FRAME_ESCAPE
+	bool escaping{ false };
+
+	/// True if the frame being received can not be decoded, it is dropped at its end
+	bool frame_dropped{ false };
+
+	/// True while the user's decision is pending
+	bool decision_pending{ false };
+
+	/// True once the game has ended
+	bool game_over{ false };
+
+	/** Decode a whole frame, applying it to the state and calling back. A frame that does not decode to exactly its
+	 *  length is dropped
+	 */
+	void decodeFrame();
+
+	/** Read a name
+	 *  @param reader The reader
+	 *  @return The name
+	 */
+	static utl::string<MAX_NAME_SIZE> readName(HandHistoryReader& reader);
+
+	/** Read the hole cards of a player
+	 *  @param reader The reader
+	 *  @param player_state The player
+	 */
+	static void readHand(HandHistoryReader& reader, PlayerState& player_state);
+
+	/** Move a player's chips to the pot
+	 *  @param next The state to update
+	 *  @param player_id The player
+	 *  @param pot_investment The player's pot investment once the chips are in the pot
+	 *  @return The number of chips moved
+	 */
+	static uint16_t moveToPot(PokerGameState& next, uint8_t player_id, uint16_t pot_investment);
+};
\ No newline at end of file
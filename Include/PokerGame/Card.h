@@ -67,11 +67,11 @@ public:
 	 */
 	Card(Value value, Suit suit);
 
-	/** Copy operator
+	/** Copy operator, defaulted so that cards and the snapshots that hold them stay trivially copyable
 	 *  @param other The card to copy
 	 *  @return A reference to this card
 	 */
-	Card& operator=(const Card& other);
+	Card& operator=(const Card& other) = default;
 
 	/** Get this card's value
 	 * @return The cards value as a Value enumeration
@@ -26,38 +26,68 @@
 #include "RankedHand.h"
 #include "PokerGame.h"
 
-  /** Console IO class
+/// Keep a copy of the last frame drawn to the terminal, so that each screen update only rewrites the cells that changed.
+/// Costs HEIGHT * WIDTH bytes of RAM, zero clears and redraws the whole screen on every update
+#ifndef CONSOLE_SHADOW_FRAME
+#define CONSOLE_SHADOW_FRAME 1
+#endif
+
+/// The size of the buffer that each screen update is assembled in. An update that fits is written to the console in a
+/// single write, a larger update is written each time the buffer fills
+#ifndef CONSOLE_FRAME_BUFFER
+#ifdef EMBEDDED_BUILD
+#define CONSOLE_FRAME_BUFFER 128
+#else
+#define CONSOLE_FRAME_BUFFER 2048
+#endif
+#endif
+
+/// The most player actions and sub round changes drawn in a single screen update, when they happen back to back. A
+/// decision or the end of a round draws any waiting events sooner, one draws every event
+#ifndef CONSOLE_COALESCE_EVENTS
+#define CONSOLE_COALESCE_EVENTS 6
+#endif
+
+  /** Console IO class, draws a PokerGame of the default table size
    */
 class ConsoleIO
 {
 public:
 
+	/// The table layout has room for up to six seats
+	static_assert(PokerGameState::SEATS <= 6, "ConsoleIO can not draw more than six seats");
+
 	/// The drawing region width
 	static constexpr uint16_t WIDTH = 80;
 
-	///  Write line callback definition
-	using WriteLineCallback = void(*)(const utl::string<WIDTH>& string, void* opaque);
+	/// The drawing region height, the last line holds the hint text and user input is entered below it
+	static constexpr uint8_t HEIGHT = 17;
+
+	///  Write callback definition, writes the bytes to the console as they are without starting a new line
+	using WriteCallback = void(*)(const char* begin, const char* end, void* opaque);
 
 	/// Maximum allowed user input size
 	static constexpr size_t MAX_USER_INPUT_LEN = 8;
 
-	///  Read line callback definition
+	///  Read line callback definition, a callback that returns an empty line while no line has been entered makes
+	///  every prompt non-blocking
 	using ReadLineCallback = utl::string<MAX_USER_INPUT_LEN>(*)(void* opaque);
 
 	// Delay callback definition
 	using DelayCallback = void(*)(int16_t delay_ms);
 
 	/** Constructor
-	 *  @param write_line_callback The write line callback
+	 *  @param write_callback The write callback
 	 *  @param read_line_callback The read line callback
 	 *  @param delay_callback The delay callback
 	 *  @param opaque A user provided pointer that will be passed with callbacks
 	 */
-	ConsoleIO(WriteLineCallback write_line_callback, ReadLineCallback read_line_callback, DelayCallback delay_callback, void* opaque = nullptr);
+	ConsoleIO(WriteCallback write_callback, ReadLineCallback read_line_callback, DelayCallback delay_callback, void* opaque = nullptr);
 
 	/** Let the user decide what to do based on the current poker game state
 	 *  @param state The current game state
-	 *  @return The player action, where the first element is the action and the second is a bet, if any
+	 *  @return The player action, where the first element is the action and the second is a bet, if any. The action
+	 *  is PlayerAction::Pending while the read line callback has no line for the prompt
 	 *  @param opaque A user provided pointer to a specific ConsoleIO instance
 	 */
 	static utl::pair<PokerGame::PlayerAction, uint16_t> userDecision(const PokerGameState& state, void* opaque);
@@ -85,7 +115,8 @@ public:
 	 *  @param winnings The pot size won
 	 *  @param ranking The ranking of the winning hand
 	 *  @param state The current game state
-	 *  @param True if the game should continue, false otherwise
+	 *  @param True if the game should continue, false otherwise. If the read line callback has no line yet, the game
+	 *  continues and the prompt is answered through pollContinue
 	 *  @param opaque A user provided pointer to a specific ConsoleIO instance
 	 */
 	static bool roundEnd(bool draw, const utl::string<MAX_NAME_SIZE>& winner, uint16_t winnings, RankedHand::Ranking ranking, const PokerGameState& state, void* opaque);
@@ -96,10 +127,26 @@ public:
 	 */
 	static void gameEnd(const utl::string<MAX_NAME_SIZE>& winner, void* opaque);
 
+	/** Poll the continue or quit prompt shown at the end of a round, hold the game between rounds while it is pending
+	 *  @return CheckOrCall to continue, Quit to quit, or Pending while the user has not answered the prompt
+	 */
+	PokerGame::PlayerAction pollContinue();
+
 private:
 
-	/// The write line callback
-	WriteLineCallback write_line_callback;
+	/// The prompt waiting for user input
+	enum class Prompt : uint8_t {
+		None = 0,
+		Action = 1,
+		BetAmount = 2,
+		Continue = 3,
+	};
+
+	/// The prompt waiting for user input, so that a non-blocking prompt resumes where it left off
+	Prompt prompt{ Prompt::None };
+
+	/// The write callback
+	WriteCallback write_callback;
 
 	/// The read line callback
 	ReadLineCallback read_line_callback;
@@ -125,6 +172,29 @@ private:
 	/// The information string queue
 	utl::list<utl::string<MAX_EVENT_STRING_LEN>, MAX_EVENT_STRING_QUEUE_LEN> event_string_queue;
 
+	/// Every event drawn together must still be in the event string queue
+	static_assert(CONSOLE_COALESCE_EVENTS >= 1 && CONSOLE_COALESCE_EVENTS <= MAX_EVENT_STRING_QUEUE_LEN, "CONSOLE_COALESCE_EVENTS must be from 1 to 12");
+
+	/// The events in the event string queue that have not been drawn yet
+	uint8_t pending_events{ 0 };
+
+	/// True while the terminal shows the last frame drawn, false when the next update must clear it first
+	bool frame_valid{ false };
+
+#if CONSOLE_SHADOW_FRAME
+	/// The last frame drawn to the terminal
+	utl::array<utl::array<char, WIDTH>, HEIGHT> shadow_frame;
+#endif
+
+	/// The shortest run of unchanged cells worth moving the cursor over, shorter runs are rewritten instead
+	static constexpr uint8_t MIN_SKIP_LEN = 8;
+
+	/// The longest cursor position escape sequence, "\033[17;80H"
+	static constexpr uint8_t MAX_CURSOR_LEN = 8;
+
+	/// The screen update being assembled
+	utl::string<CONSOLE_FRAME_BUFFER> frame_buffer;
+
 	/** Convert a line to a char
 	 *  @param input The user input
 	 *  @return The converted value
@@ -218,10 +288,43 @@ private:
 	 */
 	void printToCall(utl::string<WIDTH>& dst, size_t x);
 
-	/** Clear the terminal
-	 *  @param line_buffer A reference to a line buffer used to write to the console
+	/** Clear the terminal, unless it still shows the last frame drawn
+	 */
+	void clearTerminal();
+
+	/** Draw a line of the frame, writing only the runs of cells that differ from the last frame drawn
+	 *  @param row The row of the frame, from 0 to HEIGHT - 1
+	 *  @param line_buffer The line, cells past its end are blank
+	 */
+	void drawLine(uint8_t row, const utl::string<WIDTH>& line_buffer);
+
+	/** Move the cursor and write a run of cells
+	 *  @param row The row of the frame
+	 *  @param x The column of the first cell
+	 *  @param begin The beginning of the run
+	 *  @param end The end of the run
+	 */
+	void writeRun(uint8_t row, size_t x, const char* begin, const char* end);
+
+	/** Append a cursor position escape sequence to the frame buffer, flushing it first unless there is room for the
+	 *  sequence and a few cells after it
+	 *  @param row The row of the frame, HEIGHT is the line below the frame
+	 *  @param x The column
+	 */
+	void moveCursor(uint8_t row, size_t x);
+
+	/** Append a line of text to the frame buffer, flushing it first unless there is room for the line
+	 *  @param text The text
+	 */
+	void writeLine(const utl::string<WIDTH>& text);
+
+	/** Write the frame buffer to the console and empty it
+	 */
+	void flush();
+
+	/** Update the screen for an event, once enough events are waiting to be drawn together
 	 */
-	void clearTerminal(utl::string<WIDTH>& line_buffer);
+	void coalesceUpdate();
 
 	/** Update the screen by drawing the current screen buffer
 	 *  @tparam SIZE The maximum size of the hint_text string
@@ -29,6 +29,19 @@
 class Deck
 {
    public:
+    /// The number of cards in a deck
+    static constexpr uint8_t DECK_SIZE = 52;
+
+    /// A copy of the deck's order and deal position, used to fork or resume a game
+    struct Snapshot
+    {
+        /// The card order
+        utl::array<Card, DECK_SIZE> cards;
+
+        /// The deal cursor
+        uint8_t deal_cursor{0};
+    };
+
     /** Purposefully deleted default constructor
      */
     Deck() = delete;
@@ -49,10 +62,17 @@ class Deck
      */
     uint8_t cardsDealt() const;
 
-   private:
-    /// The number of cards in a deck
-    static constexpr uint8_t DECK_SIZE = 52;
+    /** Take a snapshot of the card order and deal position
+     *  @return The snapshot
+     */
+    Snapshot takeSnapshot() const;
 
+    /** Restore a snapshot previously taken with takeSnapshot
+     *  @param snapshot The snapshot to restore
+     */
+    void restoreSnapshot(const Snapshot& snapshot);
+
+   private:
     /// Random number generator
     Random& rng;
 
@@ -0,0 +1,58 @@
+/**
+ *  A simple interactive texas holdem poker program.
+ *  Copyright (C) 2020, Matt Zimmerer, mzimmere@gmail.com
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ **/
+
+#pragma once
+
+#include <utl/array>
+#include <utl/cstdint>
+#include <utl/vector>
+
+#include "PokerGame/Card.h"
+
+/** EquityCache namespace, remembers the equity that the AI has estimated for a hand on a board, so that a situation that
+ *  comes up again is not estimated again. Situations that differ only by the names of the suits share an entry. On
+ *  desktop the cache is set associative with second chance eviction, and threads share it without locks. On embedded
+ *  targets it is a small direct mapped table
+ */
+namespace EquityCache
+{
+    /** Compute the key of a situation, the same for every relabeling of the suits and every order of the cards
+     *  @param hand The player's hand
+     *  @param board The board
+     *  @param opponents The number of opponents still in the hand
+     *  @return The key
+     */
+    uint64_t key(const utl::array<Card, 2>& hand, const utl::vector<Card, 5>& board, uint8_t opponents);
+
+    /** Look up the equity of a situation
+     *  @param key The situation's key
+     *  @param equity Set to the equity if it is cached
+     *  @return True if the equity is cached
+     */
+    bool find(uint64_t key, uint16_t& equity);
+
+    /** Cache the equity of a situation, evicting one that has not been looked up recently if there is no room
+     *  @param key The situation's key
+     *  @param equity The equity
+     */
+    void store(uint64_t key, uint16_t equity);
+
+    /** Empty the cache
+     */
+    void clear();
+}
\ No newline at end of file
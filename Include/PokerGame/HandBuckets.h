@@ -0,0 +1,61 @@
+/**
+ *  A simple interactive texas holdem poker program.
+ *  Copyright (C) 2020, Matt Zimmerer, mzimmere@gmail.com
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ **/
+
+#pragma once
+
+#include <utl/array>
+#include <utl/cstdint>
+#include <utl/vector>
+
+#include "PokerGame/Card.h"
+
+/** HandBuckets namespace, classifies post-flop situations into a small number of buckets with precomputed equity, so
+ *  that targets too slow to estimate equity live can look it up instead
+ */
+namespace HandBuckets
+{
+    /// What the hole cards make beyond the board, from nothing but kickers up to a full house or better
+    constexpr uint8_t CATEGORIES = 8;
+
+    /// Board textures, a paired board, three cards of a suit and three ranks within reach of a straight each set a bit
+    constexpr uint8_t TEXTURES = 8;
+
+    /// Draws on the flop and turn, none, a gutshot, an open ended straight draw or a flush draw, and a combination
+    constexpr uint8_t DRAWS = 4;
+
+    /// The number of buckets on the flop, and again on the turn
+    constexpr uint16_t DRAWING_STREET_BUCKETS = static_cast<uint16_t>(CATEGORIES) * TEXTURES * DRAWS;
+
+    /// The number of buckets over the flop, turn and river, the river has no draws
+    constexpr uint16_t BUCKETS = 2 * DRAWING_STREET_BUCKETS + static_cast<uint16_t>(CATEGORIES) * TEXTURES;
+
+    /** Classify a hand on a board into its bucket
+     *  @param hand The player's hand
+     *  @param board The board, at least three cards
+     *  @return The bucket in the range [0..BUCKETS)
+     */
+    uint16_t bucket(const utl::array<Card, 2>& hand, const utl::vector<Card, 5>& board);
+
+    /** Look up the share of the pot that a bucket's hands expect against opponents holding unknown hands. The share
+     *  against several opponents is the share against one raised to the number of opponents
+     *  @param bucket The bucket
+     *  @param opponents The number of opponents still in the hand
+     *  @return The expected share of the pot in the range [0..10000]
+     */
+    uint16_t equity(uint16_t bucket, uint8_t opponents);
+}
\ No newline at end of file
@@ -0,0 +1,259 @@
+/**
+ *  A simple interactive texas holdem poker program.
+ *  Copyright (C) 2020, Matt Zimmerer, mzimmere@gmail.com
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ **/
+#pragma once
+
+#include <utl/array>
+#include <utl/cstdint>
+#include <utl/vector>
+
+#include "PokerGame/Card.h"
+#include "PokerGame/PokerGameState.h"
+#include "PokerGame/Random.h"
+#include "PokerGame/RankedHand.h"
+
+/** HandEvaluator namespace, implements a fast hand evaluator over bit masks of cards for exhaustive enumeration,
+ *  RankedHand remains the evaluator used for presenting a showdown
+ */
+namespace HandEvaluator
+{
+    /// A set of cards, bit (16 * suit + value) represents a single card
+    using CardMask = uint64_t;
+
+    /** Get the card mask of a single card
+     *  @param card The card
+     *  @return The card mask with only this card set
+     */
+    CardMask cardMask(const Card& card);
+
+    /** Evaluate the best five card hand within a set of up to seven cards
+     *  @param cards The cards
+     *  @return The hand value, higher values are better hands and equal values are equal hands
+     */
+    uint32_t evaluate(CardMask cards);
+
+    /** Evaluate the best five card hand made from a player's hand and the board
+     *  @param hand The player's hand
+     *  @param board The board cards
+     *  @return The hand value, higher values are better hands and equal values are equal hands
+     */
+    uint32_t evaluate(const utl::array<Card, 2>& hand, const utl::vector<Card, 5>& board);
+
+    /** Get the ranking of an evaluated hand
+     *  @param value The hand value
+     *  @return The ranking
+     */
+    RankedHand::Ranking ranking(uint32_t value);
+
+    /** Advance to the next combination of k indices chosen from n, in lexicographic order
+     *  @param index The indices, ascending
+     *  @param k The number of indices in use
+     *  @param n The number of items to choose from
+     *  @return False once every combination has been visited
+     */
+    bool nextCombination(utl::array<uint8_t, 5>& index, uint8_t k, uint8_t n);
+
+    /** Estimate a hand's share of the pot against opponents holding unknown hands. When every runout against every
+     *  single opponent hand fits in the budget they are enumerated exactly, and the share against several opponents
+     *  is the share against one raised to the number of opponents. Otherwise runouts and the hands of every opponent
+     *  are sampled, as many samples as the budget allows. The river needs about 1000 evaluations and the turn about
+     *  46000, the flop is always sampled
+     *  @param hand The player's hand
+     *  @param board The board, at least three cards
+     *  @param opponents The number of opponents still in the hand
+     *  @param budget The most hands to evaluate
+     *  @param rng A random number generator, for sampling
+     *  @return The expected share of the pot in the range [0..10000]
+     */
+    uint16_t handEquity(const utl::array<Card, 2>& hand, const utl::vector<Card, 5>& board, uint8_t opponents, uint32_t budget, Random& rng);
+
+    /** A hand's standing against every opponent holding on the current board, and after the next cards, from which
+     *  hand strength and its positive and negative potential follow. Counts are plain sums, so batches over separate
+     *  opponent holdings, for example on separate threads, are combined with merge()
+     */
+    struct HandPotential {
+
+        /// The standing of the hand against an opponent holding
+        enum Standing : uint8_t {
+            AHEAD = 0,
+            TIED = 1,
+            BEHIND = 2,
+            STANDINGS = 3,
+        };
+
+        /// The number of opponent holdings the hand stands against in each way on the current board
+        utl::array<uint32_t, STANDINGS> now{};
+
+        /// The number of opponent holdings and next cards, by the standing now and then the standing after the next cards
+        utl::array<utl::array<uint32_t, STANDINGS>, STANDINGS> later{};
+
+        /** Add the counts of another batch of opponent holdings
+         *  @param other The other batch
+         */
+        void merge(const HandPotential& other);
+
+        /** Get the share of opponent holdings the hand beats on the current board, a tie counts half
+         *  @return The hand strength in the range [0..10000]
+         */
+        uint16_t strength() const;
+
+        /** Get the chance that the next cards take the hand from behind to ahead, a tie counts half
+         *  @return The positive potential in the range [0..10000]
+         */
+        uint16_t positive() const;
+
+        /** Get the chance that the next cards take the hand from ahead to behind, a tie counts half
+         *  @return The negative potential in the range [0..10000]
+         */
+        uint16_t negative() const;
+
+        /** Get the effective hand strength against several opponents, the chance to be ahead of all of them now and of
+         *  getting ahead when behind
+         *  @param opponents The number of opponents still in the hand
+         *  @return The effective hand strength in the range [0..10000]
+         */
+        uint16_t effective(uint8_t opponents) const;
+    };
+
+    /** Count the evaluations needed to find a hand's potential
+     *  @param board_size The number of cards on the board
+     *  @param lookahead The number of next cards to look ahead, at most the cards still to come
+     *  @return The number of hands evaluated
+     */
+    uint32_t potentialEvaluations(uint8_t board_size, uint8_t lookahead);
+
+    /** Find a hand's standing against a batch of opponent holdings, now and over every combination of the next cards.
+     *  Opponent holdings are numbered in order of the pairs of cards that may still be dealt, there are 1081 on the
+     *  flop, 1035 on the turn and 990 on the river
+     *  @param hand The player's hand
+     *  @param board The board, at least three cards
+     *  @param lookahead The number of next cards to look ahead, at most the cards still to come
+     *  @param first The first opponent holding of the batch
+     *  @param last One past the last opponent holding of the batch
+     *  @return The counts of the batch
+     */
+    HandPotential handPotential(const utl::array<Card, 2>& hand, const utl::vector<Card, 5>& board, uint8_t lookahead, uint16_t first, uint16_t last);
+
+    /** Find a hand's standing against every opponent holding, now and over every combination of the next cards. On
+     *  the desktop the opponent holdings are split in batches between threads, embedded builds use a single batch
+     *  @param hand The player's hand
+     *  @param board The board, at least three cards
+     *  @param lookahead The number of next cards to look ahead, at most the cards still to come
+     *  @param threads The number of threads, zero uses one for each hardware thread
+     *  @return The counts over every opponent holding
+     */
+    HandPotential handPotential(const utl::array<Card, 2>& hand, const utl::vector<Card, 5>& board, uint8_t lookahead, uint8_t threads);
+
+    /** The exact all in equity of each player still in the hand, over every possible runout of the board
+     *  @tparam SEATS The number of seats at the table
+     */
+    template <uint8_t SEATS>
+    struct AllInEquity {
+
+        /// The share of a single board's pot that is awarded to its winners, divisible by any number of tied winners
+        static constexpr uint32_t SPLIT = 720720;
+
+        /// The number of runouts enumerated
+        uint32_t boards{ 0 };
+
+        /// Each player's summed share of the pot over every runout, in units of SPLIT per board
+        utl::array<uint64_t, SEATS> shares{};
+
+        /** Get a player's equity in hundredths of a percent
+         *  @param player_id The player
+         *  @return The equity in the range [0..10000]
+         */
+        uint16_t permyriad(uint8_t player_id) const
+        {
+            if (this->boards == 0)
+                return 0;
+            return static_cast<uint16_t>((this->shares[player_id] * 10000 + (static_cast<uint64_t>(this->boards) * SPLIT) / 2) / (static_cast<uint64_t>(this->boards) * SPLIT));
+        }
+    };
+
+    /** Compute the exact all in equity of each player still in the hand by dealing every possible remainder of the board.
+     *  Only the hands of players still in the hand and the board are treated as known. Up to 1.7 million runouts are
+     *  enumerated pre-flop, which is quick on a desktop but takes a long time on embedded targets
+     *  @tparam SEATS The number of seats at the table
+     *  @param state The game state
+     *  @return The equity of each player
+     */
+    template <uint8_t SEATS>
+    AllInEquity<SEATS> allInEquity(const BasicPokerGameState<SEATS>& state)
+    {
+        using SeatMask = typename BasicPokerGameState<SEATS>::SeatMask;
+        AllInEquity<SEATS> result;
+
+        // Mask the board and the hands of players still in the hand, these cards are known
+        CardMask board = 0;
+        for (const auto& card : state.board)
+            board |= cardMask(card);
+        CardMask dead = board;
+        utl::array<CardMask, SEATS> hands{};
+        for (SeatMask remaining = state.in_hand_mask; remaining != 0; remaining &= remaining - 1) {
+            uint8_t player_id = BasicPokerGameState<SEATS>::lowestSeat(remaining);
+            hands[player_id] = cardMask(state.player_states[player_id].hand[0]) | cardMask(state.player_states[player_id].hand[1]);
+            dead |= hands[player_id];
+        }
+
+        // Collect every card that may still be dealt
+        utl::array<CardMask, 52> live;
+        uint8_t live_count = 0;
+        for (uint8_t bit = 0; bit < 64; ++bit) {
+            CardMask card = static_cast<CardMask>(1) << bit;
+            if ((bit & 0x0F) < 13 && (dead & card) == 0)
+                live[live_count++] = card;
+        }
+
+        // Enumerate every combination of the missing board cards
+        uint8_t missing = static_cast<uint8_t>(5 - state.board.size());
+        utl::array<uint8_t, 5> index;
+        for (uint8_t i = 0; i < 5; ++i)
+            index[i] = i;
+        do {
+
+            // Complete the board
+            CardMask runout = board;
+            for (uint8_t i = 0; i < missing; ++i)
+                runout |= live[index[i]];
+
+            // Find the winning hands
+            uint32_t best = 0;
+            SeatMask winners = 0;
+            for (SeatMask remaining = state.in_hand_mask; remaining != 0; remaining &= remaining - 1) {
+                uint8_t player_id = BasicPokerGameState<SEATS>::lowestSeat(remaining);
+                uint32_t value = evaluate(runout | hands[player_id]);
+                if (value > best) {
+                    best = value;
+                    winners = static_cast<SeatMask>(1u << player_id);
+                }
+                else if (value == best) {
+                    winners |= static_cast<SeatMask>(1u << player_id);
+                }
+            }
+
+            // Split this board's pot between the winners
+            uint32_t share = AllInEquity<SEATS>::SPLIT / BasicPokerGameState<SEATS>::countSeats(winners);
+            for (; winners != 0; winners &= winners - 1)
+                result.shares[BasicPokerGameState<SEATS>::lowestSeat(winners)] += share;
+            ++result.boards;
+
+        } while (nextCombination(index, missing, live_count));
+
+        return result;
+    }
+}
\ No newline at end of file
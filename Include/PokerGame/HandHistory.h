@@ -0,0 +1,421 @@
+/**
+ *  A simple interactive texas holdem poker program.
+ *  Copyright (C) 2020, Matt Zimmerer, mzimmere@gmail.com
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ **/
+#pragma once
+
+#include <utl/array>
+#include <utl/cstddef>
+#include <utl/cstdint>
+#include <utl/string>
+#include <utl/vector>
+
+#include "Card.h"
+#include "PokerGameBase.h"
+#include "PokerGameState.h"
+#include "RankedHand.h"
+
+/**
+ *  Hand history stream format. Integers are unsigned LEB128 varints, cards are 6 bit codes (13 * suit + value) packed
+ *  least significant bit first and padded to a whole byte.
+ *
+ *  Stream header:  'H' 'H' version seats varint(random_seed) varint(small_blind)
+ *  Hand record:    varint(round_number) dealer varint(seated_mask) varint(starting_stack) for each seated player,
+ *                  then the two hole cards of each seated player
+ *  Hand events:    (player_id << 2 | action) followed by varint(bet) for a bet, the blinds are the first two bets.
+ *                  Calls are not followed by an amount, it is implied by the state of the hand.
+ *                  STREET | subround marks the flop, turn and river
+ *  Hand end:       END, the number of board cards, the board cards, varint(winnings), the winner or NO_WINNER for a draw
+ *  Stream end:     END_OF_STREAM, which directly follows the events of a hand that a player quit during
+ */
+class HandHistoryFormat
+{
+public:
+
+	/// The format version
+	static constexpr uint8_t VERSION = 1;
+
+	/// The first byte of a street marker, the subround is in the low bits
+	static constexpr uint8_t STREET = 0x40;
+
+	/// Marks the end of a hand's events
+	static constexpr uint8_t END = 0x80;
+
+	/// Marks the end of the stream
+	static constexpr uint8_t END_OF_STREAM = 0xC0;
+
+	/// The winner recorded for a draw
+	static constexpr uint8_t NO_WINNER = 0xFF;
+
+	/// The number of bits in a card code
+	static constexpr uint8_t CARD_BITS = 6;
+
+	/** Get a card's code
+	 *  @param card The card
+	 *  @return The code in the range [0..52)
+	 */
+	static uint8_t cardCode(const Card& card);
+
+	/** Get the card with a code
+	 *  @param code The code
+	 *  @return The card
+	 */
+	static Card codeCard(uint8_t code);
+
+	/** Encode an action with the player that performed it
+	 *  @param player_id The player
+	 *  @param action The action
+	 *  @return The event byte
+	 */
+	static uint8_t actionEvent(uint8_t player_id, PokerGameBase::PlayerAction action);
+};
+
+/** Streams hand history bytes to a write callback, buffering small writes
+ */
+class HandHistoryEncoder
+{
+public:
+
+	/// Write callback definition
+	using WriteCallback = void(*)(const uint8_t* data, size_t size, void* opaque);
+
+	/** Constructor
+	 *  @param write_callback Called with each buffered chunk of the stream
+	 *  @param opaque A pointer that is provided to the callback
+	 */
+	HandHistoryEncoder(WriteCallback write_callback, void* opaque);
+
+	/** Write a byte, any pending bits must have been aligned
+	 *  @param value The byte
+	 */
+	void writeByte(uint8_t value);
+
+	/** Write an unsigned varint
+	 *  @param value The value
+	 */
+	void writeVarint(uint32_t value);
+
+	/** Write the low bits of a value
+	 *  @param value The value
+	 *  @param bit_count The number of bits to write, at most 8
+	 */
+	void writeBits(uint8_t value, uint8_t bit_count);
+
+	/** Pad any pending bits to a whole byte
+	 */
+	void alignBits();
+
+	/** Pass the buffered bytes to the write callback
+	 */
+	void flush();
+
+private:
+
+	/// The number of bytes buffered before they are written
+	static constexpr size_t BUFFER_SIZE = 32;
+
+	/// The write callback
+	WriteCallback write_callback;
+
+	/// User provided pointer
+	void* opaque;
+
+	/// The buffered bytes
+	utl::vector<uint8_t, BUFFER_SIZE> buffer;
+
+	/// Bits waiting to fill a byte
+	uint16_t pending_bits{ 0 };
+
+	/// The number of bits waiting to fill a byte
+	uint8_t pending_bit_count{ 0 };
+};
+
+/** Observer that records every hand to a compact binary hand history stream
+ *  @tparam SEATS The number of seats at the table
+ */
+template <uint8_t SEATS>
+class HandHistoryWriter
+{
+public:
+
+	/** Constructor, the stream header is written with the first hand
+	 *  @param write_callback Called with each chunk of the stream
+	 *  @param opaque A pointer that is provided to the callback
+	 *  @param random_seed The game's random seed
+	 *  @param small_blind The game's small blind
+	 */
+	HandHistoryWriter(HandHistoryEncoder::WriteCallback write_callback, void* opaque, uint32_t random_seed_in, uint8_t small_blind_in)
+		: encoder(write_callback, opaque), random_seed(random_seed_in), small_blind(small_blind_in) {}
+
+	/** Record a player action, the first blind of a round starts the hand record
+	 *  @param player_name The player's name
+	 *  @param action The action the player performed
+	 *  @param bet The bet, if any
+	 *  @param state The full game state
+	 */
+	void playerAction(const utl::string<MAX_NAME_SIZE>& player_name, PokerGameBase::PlayerAction action, uint16_t bet, const BasicPokerGameState<SEATS>& state)
+	{
+		if (this->in_hand == false)
+			this->beginHand(state);
+
+		this->encoder.writeByte(HandHistoryFormat::actionEvent(this->playerID(player_name, state), action));
+		if (action == PokerGameBase::PlayerAction::Bet)
+			this->encoder.writeVarint(bet);
+	}
+
+	/** Record a new street
+	 *  @param new_sub_round The new subround
+	 *  @param state The full game state
+	 */
+	void subRoundChange(PokerGameBase::SubRound new_sub_round, const BasicPokerGameState<SEATS>& state)
+	{
+		// The hand record starts pre-flop
+		if (new_sub_round != PokerGameBase::SubRound::PreFlop)
+			this->encoder.writeByte(HandHistoryFormat::STREET | static_cast<uint8_t>(new_sub_round));
+	}
+
+	/** Record the end of the hand and write it out
+	 *  @param draw True if the round ended in a draw, false otherwise
+	 *  @param winner The round winner
+	 *  @param winnings The pot size won
+	 *  @param ranking The ranking of the winning hand
+	 *  @param state The full game state
+	 *  @param revealing_players A vector of player_ids cooresponding to those that revealed their cards
+	 *  @return Always true, recording never ends the game
+	 */
+	bool roundEnd(bool draw, const utl::string<MAX_NAME_SIZE>& winner, uint16_t winnings, RankedHand::Ranking ranking,
+		const BasicPokerGameState<SEATS>& state, const utl::vector<uint8_t, SEATS>& revealing_players)
+	{
+		// Record the board and the result
+		this->encoder.writeByte(HandHistoryFormat::END);
+		this->encoder.writeByte(static_cast<uint8_t>(state.board.size()));
+		for (const auto& card : state.board)
+			this->encoder.writeBits(HandHistoryFormat::cardCode(card), HandHistoryFormat::CARD_BITS);
+		this->encoder.alignBits();
+		this->encoder.writeVarint(winnings);
+		this->encoder.writeByte(draw ? HandHistoryFormat::NO_WINNER : this->playerID(winner, state));
+
+		// Write the hand out
+		this->encoder.flush();
+		this->in_hand = false;
+		return true;
+	}
+
+	/** Record the end of the stream
+	 *  @param winner The game winner
+	 */
+	void gameEnd(const utl::string<MAX_NAME_SIZE>& winner)
+	{
+		this->encoder.writeByte(HandHistoryFormat::END_OF_STREAM);
+		this->encoder.flush();
+	}
+
+private:
+
+	/// The stream encoder
+	HandHistoryEncoder encoder;
+
+	/// The game's random seed
+	uint32_t random_seed;
+
+	/// The game's small blind
+	uint8_t small_blind;
+
+	/// True once the stream header has been written
+	bool header_written{ false };
+
+	/// True while a hand is being recorded
+	bool in_hand{ false };
+
+	/// The number of hands recorded
+	uint32_t round_number{ 0 };
+
+	/** Start a hand record
+	 *  @param state The full game state, at the first blind
+	 */
+	void beginHand(const BasicPokerGameState<SEATS>& state)
+	{
+		// Write the stream header with the first hand
+		if (this->header_written == false) {
+			this->encoder.writeByte('H');
+			this->encoder.writeByte('H');
+			this->encoder.writeByte(HandHistoryFormat::VERSION);
+			this->encoder.writeByte(SEATS);
+			this->encoder.writeVarint(this->random_seed);
+			this->encoder.writeVarint(this->small_blind);
+			this->header_written = true;
+		}
+
+		// Write the table as it was dealt, blinds that have been posted are part of the starting stacks
+		this->encoder.writeVarint(++this->round_number);
+		this->encoder.writeByte(state.current_dealer);
+		this->encoder.writeVarint(state.seated_mask);
+		for (uint8_t player_id = 0; player_id < SEATS; ++player_id)
+			if (state.seated_mask & (1u << player_id))
+				this->encoder.writeVarint(state.player_states[player_id].stack + state.player_states[player_id].pot_investment);
+		for (uint8_t player_id = 0; player_id < SEATS; ++player_id) {
+			if (state.seated_mask & (1u << player_id)) {
+				this->encoder.writeBits(HandHistoryFormat::cardCode(state.player_states[player_id].hand[0]), HandHistoryFormat::CARD_BITS);
+				this->encoder.writeBits(HandHistoryFormat::cardCode(state.player_states[player_id].hand[1]), HandHistoryFormat::CARD_BITS);
+			}
+		}
+		this->encoder.alignBits();
+		this->in_hand = true;
+	}
+
+	/** Find the seat of a named player
+	 *  @param player_name The player's name
+	 *  @param state The full game state
+	 *  @return The player's seat
+	 */
+	static uint8_t playerID(const utl::string<MAX_NAME_SIZE>& player_name, const BasicPokerGameState<SEATS>& state)
+	{
+		for (uint8_t player_id = 0; player_id < SEATS; ++player_id)
+			if (state.player_states[player_id].name == player_name)
+				return player_id;
+		return HandHistoryFormat::NO_WINNER;
+	}
+};
+
+/// The header of a hand history stream
+struct HandHistoryHeader {
+	uint8_t version{ 0 };
+	uint8_t seats{ 0 };
+	uint32_t random_seed{ 0 };
+	uint16_t small_blind{ 0 };
+};
+
+/// A single decoded hand
+struct HandHistoryHand {
+
+	/// The largest table a hand may be decoded for
+	static constexpr uint8_t MAX_SEATS = 16;
+
+	/// The most events a hand keeps when it is decoded, the events of a longer hand are read past but not kept
+	static constexpr size_t MAX_EVENTS = 96;
+
+	/// A single player action
+	struct Event {
+		uint8_t player_id;
+		PokerGameBase::PlayerAction action;
+		uint16_t bet;
+	};
+
+	uint32_t round_number{ 0 };
+	uint8_t dealer{ 0 };
+	uint16_t seated_mask{ 0 };
+	utl::array<uint16_t, MAX_SEATS> starting_stacks{};
+	utl::array<utl::array<Card, 2>, MAX_SEATS> hands;
+	utl::vector<Event, MAX_EVENTS> events;
+
+	/// The number of events past MAX_EVENTS that were read but not kept, the events are only whole if this is zero
+	uint16_t dropped_events{ 0 };
+
+	/// The index of the first event of the flop, turn and river, or the event count if the street was not reached
+	utl::array<uint8_t, 3> street_events{};
+
+	utl::vector<Card, 5> board;
+	uint16_t winnings{ 0 };
+	uint8_t winner{ HandHistoryFormat::NO_WINNER };
+
+	/// False if the game ended during the hand, a quit, so it has no board or result
+	bool resolved{ true };
+};
+
+/** Decodes a hand history stream held in memory
+ */
+class HandHistoryReader
+{
+public:
+
+	/** Constructor
+	 *  @param data The stream
+	 *  @param size The stream size in bytes
+	 */
+	HandHistoryReader(const uint8_t* data, size_t size);
+
+	/** Read the stream header
+	 *  @param header The decoded header
+	 *  @return True if a valid header was read
+	 */
+	bool readHeader(HandHistoryHeader& header);
+
+	/** Read the next hand
+	 *  @param hand The decoded hand
+	 *  @return True if a hand was read, false at the end of the stream or if the stream is malformed
+	 */
+	bool readHand(HandHistoryHand& hand);
+
+	/** Check if the stream was read to its end marker
+	 *  @return True if the end of the stream was reached, false if it has not been or the stream is malformed
+	 */
+	bool isComplete() const;
+
+	/** Get the number of bytes that have been read
+	 *  @return The offset into the stream
+	 */
+	size_t getOffset() const;
+
+	/** Check if a read went past the end of the data, so that the data ends part way through what was being read
+	 *  @return True if the data was too short
+	 */
+	bool isTruncated() const;
+
+	/** Read a byte, any pending bits are discarded
+	 *  @return The byte, or zero past the end of the stream
+	 */
+	uint8_t readByte();
+
+	/** Read an unsigned varint
+	 *  @return The value
+	 */
+	uint32_t readVarint();
+
+	/** Read bits
+	 *  @param bit_count The number of bits to read, at most 8
+	 *  @return The value
+	 */
+	uint8_t readBits(uint8_t bit_count);
+
+private:
+
+	/// The stream
+	const uint8_t* data;
+
+	/// The stream size
+	size_t size;
+
+	/// The offset of the next byte
+	size_t offset{ 0 };
+
+	/// The number of seats at the table, from the header
+	uint8_t seats{ 0 };
+
+	/// True once the stream has been found to be malformed or has been read to its end
+	bool done{ false };
+
+	/// True once the end of the stream has been read
+	bool complete{ false };
+
+	/// True once a read has gone past the end of the data
+	bool truncated{ false };
+
+	/// Bits left over from the last byte read
+	uint16_t pending_bits{ 0 };
+
+	/// The number of bits left over from the last byte read
+	uint8_t pending_bit_count{ 0 };
+};
\ No newline at end of file
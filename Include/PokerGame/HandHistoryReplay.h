@@ -0,0 +1,364 @@
+/**
+ *  A simple interactive texas holdem poker program.
+ *  Copyright (C) 2020, Matt Zimmerer, mzimmere@gmail.com
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ **/
+#pragma once
+
+#include <utl/cstddef>
+#include <utl/cstdint>
+#include <utl/string>
+#include <utl/utility>
+#include <utl/vector>
+
+#include "Card.h"
+#include "Deck.h"
+#include "HandHistory.h"
+#include "PokerGame.h"
+#include "PokerGameImpl.h"
+#include "Random.h"
+
+/// The result of replaying a hand history stream
+struct HandHistoryReplayResult {
+
+	/// The number of hands replayed
+	uint32_t hands{ 0 };
+
+	/// The number of hands where the game did not reproduce the record
+	uint32_t mismatches{ 0 };
+
+	/// The round number of the first hand that did not reproduce the record, zero if every hand did
+	uint32_t first_mismatch{ 0 };
+
+	/// True if the stream was read to its end and every recorded hand was played, or read past if it could not be
+	bool complete{ false };
+
+	/// The round number of the first hand with more actions than a hand keeps, where the replay stopped, zero if every
+	/// hand could be replayed
+	uint32_t overlong_hand{ 0 };
+
+	/// The number of hands from the overlong hand on, that were read past but not replayed
+	uint32_t skipped{ 0 };
+
+	/// The number of bytes of the stream that were read, the offset of any stream that follows
+	size_t bytes{ 0 };
+};
+
+/** Re-drives a game from a hand history stream. The recorded cards are dealt in the order that the game deals them,
+ *  and the recorded actions are replayed as each player's decisions. Every hand's dealer, starting stacks, actions,
+ *  board and result are checked against the record, so a replay confirms the chip accounting of the recorded game.
+ *  @tparam SEATS The number of seats at the table, which must match the stream
+ */
+template <uint8_t SEATS>
+class HandHistoryReplayer
+{
+public:
+
+	/** Constructor
+	 *  @param data The stream
+	 *  @param size The stream size in bytes
+	 */
+	HandHistoryReplayer(const uint8_t* data, size_t size) : reader(data, size) {}
+
+	/** Replay the stream
+	 *  @return The result
+	 */
+	HandHistoryReplayResult replay()
+	{
+		// The stream must be for this table
+		if (this->reader.readHeader(this->header) == false || this->header.seats != SEATS) {
+			this->result.complete = this->reader.isComplete() && this->header.seats == SEATS;
+			this->result.bytes = this->reader.getOffset();
+			return this->result;
+		}
+
+		// Play the recorded game, if it holds a hand that can be replayed
+		if (this->loadHand() == true) {
+
+			// Every player starts with the first hand's largest stack
+			uint16_t starting_stack = 0;
+			for (uint8_t player_id = 0; player_id < SEATS; ++player_id)
+				if (this->hand.starting_stacks[player_id] > starting_stack)
+					starting_stack = this->hand.starting_stacks[player_id];
+
+			Game game(this->header.random_seed, static_cast<uint8_t>(this->header.small_blind), starting_stack, Decider(this), Observer(this), Dealer(this));
+			game.play();
+		}
+
+		// A hand with more actions than a hand keeps can not be replayed, and the game can not go on past it. Read past
+		// it and the hands after it, so that the streams that follow may still be found
+		if (this->hand_loaded == true && this->hand.dropped_events > 0) {
+			this->result.overlong_hand = this->hand.round_number;
+			do {
+				++this->result.skipped;
+			} while (this->reader.readHand(this->hand));
+			this->hand_loaded = false;
+		}
+
+		// A hand that was loaded but never played means the game ended before the record did
+		this->result.complete = this->reader.isComplete() && this->hand_loaded == false;
+		this->result.bytes = this->reader.getOffset();
+		return this->result;
+	}
+
+	/** Decider that replays the recorded actions
+	 */
+	class Decider
+	{
+	public:
+		explicit Decider(HandHistoryReplayer* replayer_in) : replayer(replayer_in) {}
+
+		utl::pair<PokerGameBase::PlayerAction, uint16_t> decide(const BasicPokerGameState<SEATS>& state, uint8_t player_id, Random& rng)
+		{
+			return this->replayer->decide(player_id);
+		}
+
+	private:
+		HandHistoryReplayer* replayer;
+	};
+
+	/** Observer that checks each event against the record
+	 */
+	class Observer
+	{
+	public:
+		explicit Observer(HandHistoryReplayer* replayer_in) : replayer(replayer_in) {}
+
+		void playerAction(const utl::string<MAX_NAME_SIZE>& player_name, PokerGameBase::PlayerAction action, uint16_t bet, const BasicPokerGameState<SEATS>& state)
+		{
+			this->replayer->checkAction(player_name, action, bet, state);
+		}
+
+		void subRoundChange(PokerGameBase::SubRound new_sub_round, const BasicPokerGameState<SEATS>& state) {}
+
+		bool roundEnd(bool draw, const utl::string<MAX_NAME_SIZE>& winner, uint16_t winnings, RankedHand::Ranking ranking,
+			const BasicPokerGameState<SEATS>& state, const utl::vector<uint8_t, SEATS>& revealing_players)
+		{
+			return this->replayer->checkRoundEnd(draw, winner, winnings, state);
+		}
+
+		void gameEnd(const utl::string<MAX_NAME_SIZE>& winner)
+		{
+			this->replayer->checkGameEnd();
+		}
+
+	private:
+		HandHistoryReplayer* replayer;
+	};
+
+	/** Dealer that deals the recorded cards
+	 */
+	class Dealer
+	{
+	public:
+		explicit Dealer(HandHistoryReplayer* replayer_in) : replayer(replayer_in) {}
+
+		uint8_t chooseDealer(Random& rng, uint8_t seats)
+		{
+			return this->replayer->hand.dealer;
+		}
+
+		void shuffle(Deck& deck)
+		{
+			this->replayer->stackDeck();
+		}
+
+		Card dealCard(Deck& deck)
+		{
+			return this->replayer->dealCard();
+		}
+
+	private:
+		HandHistoryReplayer* replayer;
+	};
+
+private:
+
+	/// The game that replays the stream
+	using Game = BasicPokerGame<SEATS, Decider, Observer, Dealer>;
+
+	/// The stream reader
+	HandHistoryReader reader;
+
+	/// The stream header
+	HandHistoryHeader header;
+
+	/// The hand being replayed
+	HandHistoryHand hand;
+
+	/// True while a hand has been read but not yet played to its end
+	bool hand_loaded{ false };
+
+	/// False once the hand being replayed has not reproduced the record
+	bool hand_matches{ true };
+
+	/// The next recorded event
+	size_t next_event{ 0 };
+
+	/// The recorded cards, in the order that the game deals them
+	utl::vector<Card, 2 * SEATS + 5> deal_order;
+
+	/// The next card to deal
+	size_t next_card{ 0 };
+
+	/// The replay result
+	HandHistoryReplayResult result;
+
+	/** Read the next hand
+	 *  @return True if a hand was read that can be replayed, a hand with more actions than it keeps can not be
+	 */
+	bool loadHand()
+	{
+		this->hand_loaded = this->reader.readHand(this->hand);
+		this->hand_matches = true;
+		this->next_event = 0;
+		return this->hand_loaded && this->hand.dropped_events == 0;
+	}
+
+	/** Note that the hand being replayed did not reproduce the record
+	 */
+	void mismatch()
+	{
+		if (this->hand_matches == false)
+			return;
+		this->hand_matches = false;
+		++this->result.mismatches;
+		if (this->result.first_mismatch == 0)
+			this->result.first_mismatch = this->hand.round_number;
+	}
+
+	/** Count the hand being replayed as played
+	 */
+	void finishHand()
+	{
+		++this->result.hands;
+		this->hand_loaded = false;
+	}
+
+	/** Order the recorded cards as the game deals them, a card to each player starting left of the dealer, twice, then the board
+	 */
+	void stackDeck()
+	{
+		this->deal_order.clear();
+		this->next_card = 0;
+		for (uint8_t card = 0; card < 2; ++card) {
+			uint8_t player_id = this->hand.dealer;
+			for (uint8_t dealt = 0; dealt < SEATS; ++dealt) {
+				player_id = (player_id + 1) % SEATS;
+				if (this->hand.seated_mask & (1u << player_id))
+					this->deal_order.push_back(this->hand.hands[player_id][card]);
+			}
+		}
+		for (const auto& card : this->hand.board)
+			this->deal_order.push_back(card);
+	}
+
+	/** Deal the next recorded card
+	 *  @return The card
+	 */
+	Card dealCard()
+	{
+		// The game dealt more cards than were recorded
+		if (this->next_card == this->deal_order.size()) {
+			this->mismatch();
+			return Card();
+		}
+		return this->deal_order[this->next_card++];
+	}
+
+	/** Replay a player's next recorded action
+	 *  @param player_id The player that is acting
+	 *  @return The recorded action, or a quit if the record has a different player acting
+	 */
+	utl::pair<PokerGameBase::PlayerAction, uint16_t> decide(uint8_t player_id)
+	{
+		// A quit is not recorded, it is the end of the actions of a hand that was never resolved
+		if (this->next_event == this->hand.events.size() && this->hand.resolved == false)
+			return utl::pair<PokerGameBase::PlayerAction, uint16_t>(PokerGameBase::PlayerAction::Quit, 0);
+
+		// The game has diverged from the record, stop replaying
+		if (this->next_event == this->hand.events.size() || this->hand.events[this->next_event].player_id != player_id) {
+			this->mismatch();
+			return utl::pair<PokerGameBase::PlayerAction, uint16_t>(PokerGameBase::PlayerAction::Quit, 0);
+		}
+
+		const HandHistoryHand::Event& event = this->hand.events[this->next_event];
+		return utl::pair<PokerGameBase::PlayerAction, uint16_t>(event.action, event.bet);
+	}
+
+	/** Check a player action against the record, the first blind checks the table as it was dealt
+	 *  @param player_name The player's name
+	 *  @param action The action the player performed
+	 *  @param bet The bet, if any
+	 *  @param state The full game state
+	 */
+	void checkAction(const utl::string<MAX_NAME_SIZE>& player_name, PokerGameBase::PlayerAction action, uint16_t bet, const BasicPokerGameState<SEATS>& state)
+	{
+		// Check the dealer and the starting stacks
+		if (this->next_event == 0) {
+			if (state.current_dealer != this->hand.dealer || state.seated_mask != this->hand.seated_mask)
+				this->mismatch();
+			for (uint8_t player_id = 0; player_id < SEATS; ++player_id)
+				if ((state.seated_mask & (1u << player_id)) && state.player_states[player_id].stack + state.player_states[player_id].pot_investment != this->hand.starting_stacks[player_id])
+					this->mismatch();
+		}
+
+		// Check the action, calls are recorded without an amount
+		if (this->next_event == this->hand.events.size()) {
+			this->mismatch();
+			return;
+		}
+		const HandHistoryHand::Event& event = this->hand.events[this->next_event++];
+		if (state.player_states[event.player_id].name != player_name || event.action != action || (action == PokerGameBase::PlayerAction::Bet && event.bet != bet))
+			this->mismatch();
+	}
+
+	/** Check the end of a hand against the record, and load the next hand
+	 *  @param draw True if the round ended in a draw, false otherwise
+	 *  @param winner The round winner
+	 *  @param winnings The pot size won
+	 *  @param state The full game state
+	 *  @return True if there is another hand to replay
+	 */
+	bool checkRoundEnd(bool draw, const utl::string<MAX_NAME_SIZE>& winner, uint16_t winnings, const BasicPokerGameState<SEATS>& state)
+	{
+		// Every action was replayed and the board and result agree
+		bool matches = this->next_event == this->hand.events.size() && this->hand.resolved == true && winnings == this->hand.winnings
+			&& state.board.size() == this->hand.board.size();
+		for (size_t i = 0; matches == true && i < state.board.size(); ++i)
+			matches = state.board[i].getValue() == this->hand.board[i].getValue() && state.board[i].getSuit() == this->hand.board[i].getSuit();
+		if (draw == true)
+			matches = matches && this->hand.winner == HandHistoryFormat::NO_WINNER;
+		else
+			matches = matches && this->hand.winner < SEATS && state.player_states[this->hand.winner].name == winner;
+		if (matches == false)
+			this->mismatch();
+
+		// Replay the next hand, if there is one
+		this->finishHand();
+		return this->loadHand();
+	}
+
+	/** Check the end of the game against the record, a hand that was quit ends with the game
+	 */
+	void checkGameEnd()
+	{
+		if (this->hand_loaded == true && this->hand.resolved == false && this->hand.dropped_events == 0) {
+			if (this->next_event != this->hand.events.size())
+				this->mismatch();
+			this->finishHand();
+		}
+	}
+};
\ No newline at end of file
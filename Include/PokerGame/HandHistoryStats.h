@@ -0,0 +1,88 @@
+/**
+ *  A simple interactive texas holdem poker program.
+ *  Copyright (C) 2020, Matt Zimmerer, mzimmere@gmail.com
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ **/
+#pragma once
+
+#include <utl/array>
+#include <utl/cstddef>
+#include <utl/cstdint>
+
+#include "HandHistory.h"
+#include "RankedHand.h"
+
+/** Aggregate statistics over recorded hands. Counters are plain sums, so statistics gathered over separate parts of
+ *  a hand history, for example by separate threads, are combined with merge()
+ */
+struct HandHistoryStats {
+
+	/// The columns that may be scanned, the hand count is always gathered
+	enum Column : uint8_t {
+		PREFLOP = 0x01,
+		SHOWDOWN = 0x02,
+		POTS = 0x04,
+		ALL = 0x07,
+	};
+
+	/// The number of rankings a hand may have
+	static constexpr size_t RANKINGS = static_cast<size_t>(RankedHand::Ranking::RoyalFlush) + 1;
+
+	/// The number of streets a hand may reach, pre-flop, flop, turn and river
+	static constexpr size_t STREETS = 4;
+
+	/// The number of hands scanned
+	uint32_t hands{ 0 };
+
+	/// The number of hands each seat was dealt into
+	utl::array<uint32_t, HandHistoryHand::MAX_SEATS> dealt{};
+
+	/// The number of hands each seat voluntarily put chips in the pot pre-flop
+	utl::array<uint32_t, HandHistoryHand::MAX_SEATS> vpip{};
+
+	/// The number of hands each seat raised pre-flop
+	utl::array<uint32_t, HandHistoryHand::MAX_SEATS> pfr{};
+
+	/// The number of hands shown down with each ranking
+	utl::array<uint32_t, RANKINGS> showdowns{};
+
+	/// The number of hands shown down with each ranking that won or split the pot
+	utl::array<uint32_t, RANKINGS> showdown_wins{};
+
+	/// The number of hands that reached each street
+	utl::array<uint32_t, STREETS> street_hands{};
+
+	/// The total pot of the hands that reached each street
+	utl::array<uint64_t, STREETS> street_pots{};
+
+	/** Gather the statistics of a hand
+	 *  @param hand The hand
+	 *  @param columns The columns to gather
+	 */
+	void add(const HandHistoryHand& hand, uint8_t columns = ALL);
+
+	/** Gather the statistics of every hand of a stream
+	 *  @param data The stream
+	 *  @param size The number of bytes available, the stream may be followed by others
+	 *  @param columns The columns to gather
+	 *  @return The stream's size in bytes, or zero if it is malformed or was not read to its end
+	 */
+	size_t addStream(const uint8_t* data, size_t size, uint8_t columns = ALL);
+
+	/** Add the statistics gathered by another scan
+	 *  @param other The other statistics
+	 */
+	void merge(const HandHistoryStats& other);
+};
\ No newline at end of file
@@ -0,0 +1,95 @@
+/**
+ *  A simple interactive texas holdem poker program.
+ *  Copyright (C) 2020, Matt Zimmerer, mzimmere@gmail.com
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ **/
+
+#pragma once
+
+#include <utl/array>
+#include <utl/cstdint>
+#include <utl/utility>
+
+#include "PokerGame/PokerGameBase.h"
+#include "PokerGame/PokerGameState.h"
+#include "PokerGame/Random.h"
+
+/** MCTS namespace, searches the AI's actions with Monte Carlo tree search. The tree is the acting player's actions, each
+ *  is chosen by UCB1 and valued by rollouts that resample the cards the player can not see and play out the hand with
+ *  AI::quickDecision in every seat
+ */
+namespace MCTS
+{
+    /// The actions searched at the root, a check is a call of nothing
+    enum Action : uint8_t {
+        FOLD = 0,
+        CALL = 1,
+        BET = 2,
+        ACTIONS = 3,
+    };
+
+    /// The visits and rewards of each root action, workers that search in parallel merge theirs
+    struct Statistics {
+
+        /// The number of rollouts played after each action
+        utl::array<uint32_t, ACTIONS> visits{};
+
+        /// The sum of the rewards of each action, each is the player's share of the chips at the table in units of 1/10000
+        utl::array<uint64_t, ACTIONS> rewards{};
+
+        /** Add the visits and rewards of another search
+         *  @param other The other search
+         */
+        void merge(const Statistics& other);
+
+        /** Get the mean reward of an action
+         *  @param action The action
+         *  @return The mean reward in the range [0..10000], zero if it was never visited
+         */
+        uint16_t mean(Action action) const;
+
+        /** Get the most visited action, the robust choice of MCTS, ties go to the higher mean reward
+         *  @return The action
+         */
+        Action best() const;
+    };
+
+    /** Search the actions of a player
+     *  @tparam SEATS The number of seats at the table
+     *  @param state The game state, only the parts that player_id may see are used
+     *  @param player_id The id of the player that is acting
+     *  @param iterations The number of rollouts to play
+     *  @param milliseconds On desktop, the search stops early after this many milliseconds, zero only limits the rollouts
+     *  @param threads On desktop, the number of root parallel workers, 0 uses every core. Ignored on embedded builds
+     *  @param rng A random number generator
+     *  @return The visits and rewards of each action
+     */
+    template <uint8_t SEATS>
+    Statistics search(const BasicPokerGameState<SEATS>& state, uint8_t player_id, uint32_t iterations, uint16_t milliseconds,
+        uint8_t threads, Random& rng);
+
+    /** Decide an action by searching the actions of a player on every core
+     *  @tparam SEATS The number of seats at the table
+     *  @param state The game state, only the parts that player_id may see are used
+     *  @param player_id The id of the player that is acting
+     *  @param iterations The number of rollouts to play
+     *  @param milliseconds On desktop, the search stops early after this many milliseconds, zero only limits the rollouts
+     *  @param rng A random number generator
+     *  @return The action pair, with the first element specifying the action, and the second element specifying the bet, if any
+     */
+    template <uint8_t SEATS>
+    utl::pair<PokerGameBase::PlayerAction, uint16_t> decide(const BasicPokerGameState<SEATS>& state, uint8_t player_id, uint32_t iterations,
+        uint16_t milliseconds, Random& rng);
+}
\ No newline at end of file
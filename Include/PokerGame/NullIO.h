@@ -0,0 +1,112 @@
+/**
+ *  A simple interactive texas holdem poker program.
+ *  Copyright (C) 2020, Matt Zimmerer, mzimmere@gmail.com
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ **/
+#pragma once
+
+#include <utl/string>
+#include <utl/utility>
+
+#include "PokerGame.h"
+#include "RankedHand.h"
+
+/** Null IO class, a front end for batch runs that draws nothing. It has the same callbacks as ConsoleIO, checks or
+ *  calls every decision, continues after every round and only counts the events that it is passed
+ */
+class NullIO
+{
+public:
+
+	/** Decide to check or call
+	 *  @param state The current game state
+	 *  @param opaque A user provided pointer to a specific NullIO instance
+	 *  @return A check or call
+	 */
+	static utl::pair<PokerGame::PlayerAction, uint16_t> userDecision(const PokerGameState& state, void* opaque);
+
+	/** Count a player action
+	 *  @player_name The name of the player that acted
+	 *  @param action The player's action
+	 *  @param bet The bet, if any
+	 *  @param state The current game state
+	 *  @param opaque A user provided pointer to a specific NullIO instance
+	 */
+	static void playerAction(const utl::string<MAX_NAME_SIZE>& player_name, PokerGame::PlayerAction action, uint16_t bet,
+		const PokerGameState& state, void* opaque);
+
+	/** Count a sub round change
+	 *  @param new_sub_round The new sub round
+	 *  @param state The current game state
+	 *  @param opaque A user provided pointer to a specific NullIO instance
+	 */
+	static void subRoundChange(PokerGame::SubRound new_sub_round, const PokerGameState& state, void* opaque);
+
+	/** Count the end of a round
+	 *  @param draw True if the round was a draw
+	 *  @param winner The winner of the round
+	 *  @param winnings The pot size won
+	 *  @param ranking The ranking of the winning hand
+	 *  @param state The current game state
+	 *  @param opaque A user provided pointer to a specific NullIO instance
+	 *  @return Always true, the game continues
+	 */
+	static bool roundEnd(bool draw, const utl::string<MAX_NAME_SIZE>& winner, uint16_t winnings, RankedHand::Ranking ranking, const PokerGameState& state, void* opaque);
+
+	/** Note the end of the game
+	 *  @param winner The winner of the game
+	 *  @param opaque A user provided pointer to a specific NullIO instance
+	 */
+	static void gameEnd(const utl::string<MAX_NAME_SIZE>& winner, void* opaque);
+
+	/** Never hold the game between rounds
+	 *  @return CheckOrCall
+	 */
+	PokerGame::PlayerAction pollContinue();
+
+	/** Get the number of decisions made
+	 *  @return The number of decisions
+	 */
+	uint32_t getDecisions() const;
+
+	/** Get the number of player actions and sub round changes passed
+	 *  @return The number of events
+	 */
+	uint32_t getEvents() const;
+
+	/** Get the number of rounds that have ended
+	 *  @return The number of rounds
+	 */
+	uint32_t getRounds() const;
+
+	/** Check if the game has ended
+	 *  @return True once the game has ended
+	 */
+	bool isGameOver() const;
+
+private:
+
+	/// The number of decisions made
+	uint32_t decisions{ 0 };
+
+	/// The number of player actions and sub round changes passed
+	uint32_t events{ 0 };
+
+	/// The number of rounds that have ended
+	uint32_t rounds{ 0 };
+
+	/// True once the game has ended
+	bool game_over{ false };
+};
\ No newline at end of file
@@ -0,0 +1,255 @@
+/**
+ *  A simple interactive texas holdem poker program.
+ *  Copyright (C) 2020, Matt Zimmerer, mzimmere@gmail.com
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ **/
+
+#pragma once
+
+#include <utl/array>
+#include <utl/cstdint>
+#include <utl/string>
+#include <utl/utility>
+
+#include "AI.h"
+#include "PokerGameBase.h"
+#include "PokerGameState.h"
+#include "Random.h"
+#include "RankedHand.h"
+
+/** Running statistics of how a seat plays. Each is an exponentially decaying average in units of 1/10000, so that
+ *  recent play counts the most, and each observation updates a single average in constant time
+ */
+struct SeatProfile {
+
+	/// Each observation moves an average 1/2^DECAY_SHIFT of the way towards it, roughly the last 2^DECAY_SHIFT count
+	static constexpr uint8_t DECAY_SHIFT = 4;
+
+	/// The value of every average before a seat is observed, the AI plays a neutral profile as it would without one
+	static constexpr uint16_t NEUTRAL = 5000;
+
+	/// The share of hands the seat voluntarily put chips in the pot pre-flop
+	uint16_t vpip{ NEUTRAL };
+
+	/// The share of hands the seat raised pre-flop
+	uint16_t pfr{ NEUTRAL };
+
+	/// The share of bets and raises among the seat's bets, raises and calls
+	uint16_t aggression{ NEUTRAL };
+
+	/// The share of bets the seat folded to
+	uint16_t fold_to_bet{ NEUTRAL };
+
+	/** Move an average towards an observation
+	 *  @param average The average
+	 *  @param happened True if the observed event happened
+	 */
+	static void observe(uint16_t& average, bool happened);
+
+	/** Observe the end of a hand the seat was dealt into
+	 *  @param voluntary True if the seat voluntarily put chips in the pot pre-flop
+	 *  @param raised True if the seat raised pre-flop
+	 */
+	void observeHand(bool voluntary, bool raised);
+
+	/** Observe an action of the seat, blinds are not observed
+	 *  @param action The action
+	 *  @param chips The chips the seat put in the pot
+	 *  @param facing_bet True if the seat had a bet to call
+	 */
+	void observeAction(PokerGameBase::PlayerAction action, uint16_t chips, bool facing_bet);
+
+	/** Get the aggression factor, the ratio of bets and raises to calls
+	 *  @return The aggression factor in hundredths, at most 10000
+	 */
+	uint16_t aggressionFactor() const;
+
+	/** Add another profile's averages, to find the mean of several seats
+	 *  @param other The other profile
+	 *  @param count The number of profiles added so far, including this one
+	 */
+	void accumulate(const SeatProfile& other, uint8_t count);
+};
+
+/** The profile of every seat at the table, shared between the OpponentModelObserver that updates it and the
+ *  OpponentModelDecider that plays against it
+ *  @tparam SEATS The number of seats at the table
+ */
+template <uint8_t SEATS>
+struct OpponentModel {
+
+	/// The profile of each seat
+	utl::array<SeatProfile, SEATS> profiles;
+
+	/** Find the mean profile of a player's opponents that are still in the hand
+	 *  @param state The game state
+	 *  @param player_id The player
+	 *  @return The mean profile, neutral if there are no opponents
+	 */
+	SeatProfile opponents(const BasicPokerGameState<SEATS>& state, uint8_t player_id) const
+	{
+		SeatProfile result;
+		uint8_t count = 0;
+		for (uint8_t seat = 0; seat < SEATS; ++seat) {
+			if (seat == player_id || (state.in_hand_mask & (1u << seat)) == 0)
+				continue;
+			result.accumulate(this->profiles[seat], ++count);
+		}
+		return result;
+	}
+};
+
+/** Observer that keeps an opponent model of every seat up to date, each action updates it in constant time
+ *  @tparam SEATS The number of seats at the table
+ */
+template <uint8_t SEATS>
+class OpponentModelObserver
+{
+public:
+
+	/// A set of seats, bit N represents player N
+	using SeatMask = typename BasicPokerGameState<SEATS>::SeatMask;
+
+	/** Constructor
+	 *  @param model The model to update
+	 */
+	explicit OpponentModelObserver(OpponentModel<SEATS>* model_in) : model(model_in) {}
+
+	/** Observe a player action, the blinds only move the bet
+	 *  @param player_name The player's name
+	 *  @param action The action the player performed
+	 *  @param bet The bet, if any
+	 *  @param state The full game state
+	 */
+	void playerAction(const utl::string<MAX_NAME_SIZE>& player_name, PokerGameBase::PlayerAction action, uint16_t bet, const BasicPokerGameState<SEATS>& state)
+	{
+		// The acting player had a bet to call if the bet was above his/her share of the pot before acting
+		uint8_t player_id = state.current_player;
+		bool facing_bet = this->current_bet > this->pot_shares[player_id];
+		uint16_t chips = state.current_pot_shares[player_id] - this->pot_shares[player_id];
+		this->current_bet = state.current_bet;
+		this->pot_shares[player_id] = state.current_pot_shares[player_id];
+		if (this->blinds)
+			return;
+
+		// Every chip put in pre-flop after the blinds is voluntary
+		SeatMask bit = static_cast<SeatMask>(1u << player_id);
+		if (this->preflop && chips > 0)
+			this->voluntary_mask |= bit;
+		if (this->preflop && action == PokerGameBase::PlayerAction::Bet)
+			this->raised_mask |= bit;
+		this->model->profiles[player_id].observeAction(action, chips, facing_bet);
+	}
+
+	/** Observe a new street, the blinds have been posted once the pre-flop betting round opens
+	 *  @param new_sub_round The new subround
+	 *  @param state The full game state
+	 */
+	void subRoundChange(PokerGameBase::SubRound new_sub_round, const BasicPokerGameState<SEATS>& state)
+	{
+		this->blinds = false;
+		this->preflop = new_sub_round == PokerGameBase::SubRound::PreFlop;
+		if (this->preflop)
+			this->dealt_mask = state.seated_mask;
+	}
+
+	/** Observe the end of a hand, updating the pre-flop statistics of every seat that was dealt in
+	 *  @param draw True if the round ended in a draw, false otherwise
+	 *  @param winner The round winner
+	 *  @param winnings The pot size won
+	 *  @param ranking The ranking of the winning hand
+	 *  @param state The full game state
+	 *  @param revealing_players A vector of player_ids cooresponding to those that revealed their cards
+	 *  @return Always true, observing never ends the game
+	 */
+	bool roundEnd(bool draw, const utl::string<MAX_NAME_SIZE>& winner, uint16_t winnings, RankedHand::Ranking ranking,
+		const BasicPokerGameState<SEATS>& state, const utl::vector<uint8_t, SEATS>& revealing_players)
+	{
+		for (uint8_t seat = 0; seat < SEATS; ++seat) {
+			if (this->dealt_mask & (1u << seat))
+				this->model->profiles[seat].observeHand((this->voluntary_mask & (1u << seat)) != 0, (this->raised_mask & (1u << seat)) != 0);
+			this->pot_shares[seat] = 0;
+		}
+
+		// The next hand starts with the blinds
+		this->blinds = true;
+		this->current_bet = 0;
+		this->dealt_mask = 0;
+		this->voluntary_mask = 0;
+		this->raised_mask = 0;
+		return true;
+	}
+
+	/** Observe the game end
+	 *  @param winner The game winner
+	 */
+	void gameEnd(const utl::string<MAX_NAME_SIZE>& winner) {}
+
+private:
+
+	/// The model to update
+	OpponentModel<SEATS>* model;
+
+	/// The bet before the next action
+	uint16_t current_bet{ 0 };
+
+	/// Each seat's share of the pot before its next action
+	utl::array<uint16_t, SEATS> pot_shares{};
+
+	/// True until the pre-flop betting round opens
+	bool blinds{ true };
+
+	/// True during the pre-flop betting round
+	bool preflop{ false };
+
+	/// The seats dealt into the hand
+	SeatMask dealt_mask{ 0 };
+
+	/// The seats that voluntarily put chips in the pot pre-flop
+	SeatMask voluntary_mask{ 0 };
+
+	/// The seats that raised pre-flop
+	SeatMask raised_mask{ 0 };
+};
+
+/** Decider that lets the AI play every seat against the opponent model of the other seats in the hand
+ *  @tparam SEATS The number of seats at the table
+ */
+template <uint8_t SEATS>
+class OpponentModelDecider
+{
+public:
+
+	/** Constructor
+	 *  @param model The model, kept up to date by an OpponentModelObserver
+	 */
+	explicit OpponentModelDecider(const OpponentModel<SEATS>* model_in) : model(model_in) {}
+
+	/** Decide an action
+	 *  @param state The full game state
+	 *  @param player_id The id of the player that is acting
+	 *  @param rng A random number generator
+	 *  @return The first element is the action, the second is the bet, if any
+	 */
+	utl::pair<PokerGameBase::PlayerAction, uint16_t> decide(const BasicPokerGameState<SEATS>& state, uint8_t player_id, Random& rng)
+	{
+		return AI::computerDecision<SEATS>(state, rng, player_id, this->model->opponents(state, player_id));
+	}
+
+private:
+
+	/// The opponent model
+	const OpponentModel<SEATS>* model;
+};
\ No newline at end of file
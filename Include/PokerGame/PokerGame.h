@@ -24,53 +24,66 @@
 #include <utl/vector>
 
 #include "Deck.h"
+#include "HandEvaluator.h"
+#include "PokerGameBase.h"
+#include "PokerGamePolicies.h"
 #include "PokerGameState.h"
 #include "Random.h"
 #include "RankedHand.h"
 
- /** Texas Holdem poker game class. Implements heads up poker against an AI opponent
+/** A fixed-size copy of everything needed to fork or resume a game
+ *  @tparam SEATS The number of seats at the table
+ */
+template <uint8_t SEATS>
+struct PokerGameSnapshot {
+	BasicPokerGameState<SEATS> state;
+	Deck::Snapshot deck;
+	Random rng{ 0 };
+	uint32_t round_number{ 0 };
+	bool run{ true };
+	PokerGameBase::Progress progress;
+};
+
+ /** Texas Holdem poker game class. Implements poker against AI opponents. The member definitions live in
+  *  PokerGameImpl.h, include it to instantiate a game with policies other than the defaults
+  *  @tparam SEATS The number of seats at the table, fixed at compile time so that heads up games carry no full ring state
+  *  @tparam Decider Decides actions for every seat, see PokerGamePolicies.h
+  *  @tparam Observer Notified of game events, see PokerGamePolicies.h
+  *  @tparam Dealer Chooses the first dealer and supplies the cards, see PokerGamePolicies.h
   */
-class PokerGame
+template <uint8_t SEATS, class Decider = CallbackDecider<SEATS>, class Observer = CallbackObserver<SEATS>, class Dealer = DeckDealer>
+class BasicPokerGame : public PokerGameBase
 {
 public:
 
-	/** An enumeration of possible player actions
-	 */
-	enum class PlayerAction : uint8_t
-	{
-		CheckOrCall = 1,
-		Bet = 2,
-		Fold = 3,
-		Quit = 4,
-	};
+	/// The game state for this table size
+	using PokerGameState = BasicPokerGameState<SEATS>;
+
+	/// A set of seats, bit N represents player N
+	using SeatMask = typename PokerGameState::SeatMask;
 
 	/// Decision callback definition
-	using DecisionCallback = utl::pair<PlayerAction, uint16_t>(*)(const PokerGameState& state, void* opaque);
+	using DecisionCallback = typename CallbackDecider<SEATS>::DecisionCallback;
 
 	/// Player action callback definition
-	using PlayerActionCallback =
-		void(*)(const utl::string<MAX_NAME_SIZE>& player_name, PlayerAction action, uint16_t bet, const PokerGameState& state, void* opaque);
-
-	/// Subround definitions
-	enum class SubRound : uint8_t
-	{
-		PreFlop = 1,
-		Flop = 2,
-		Turn = 3,
-		River = 4,
-	};
+	using PlayerActionCallback = typename CallbackObserver<SEATS>::PlayerActionCallback;
 
 	/// Sub round change callback definition
-	using SubRoundChangeCallback = void(*)(SubRound new_sub_round, const PokerGameState& state, void* opaque);
+	using SubRoundChangeCallback = typename CallbackObserver<SEATS>::SubRoundChangeCallback;
 
 	/// Round end callback definition
-	using RoundEndCallback = bool(*)(bool draw, const utl::string<MAX_NAME_SIZE>& winner, uint16_t winnings, RankedHand::Ranking ranking,
-		const PokerGameState& state, void* opaque);
+	using RoundEndCallback = typename CallbackObserver<SEATS>::RoundEndCallback;
 
 	/// Game end callback definition
-	using GameEndCallback = void(*)(const utl::string<MAX_NAME_SIZE>& winner, void* opaque);
+	using GameEndCallback = typename CallbackObserver<SEATS>::GameEndCallback;
+
+	/// All in equity of each player still in the hand
+	using AllInEquity = HandEvaluator::AllInEquity<SEATS>;
+
+	/// All in equity callback definition, called with the full state since every remaining hand is about to be revealed
+	using AllInEquityCallback = void(*)(const AllInEquity& equity, const PokerGameState& state, void* opaque);
 
-	/** Poker game constructor
+	/** Poker game constructor, for the callback driven Decider and Observer
 	 *  @param random_seed A random seed to used for random number generation
 	 *  @param small_blind The small blind amount
 	 *  @param starting_stack_size The starting stack size for each player
@@ -81,45 +94,89 @@ public:
 	 *  @param game_end_callback Called to notify of game end
 	 *  @param opaque A pointer that is provided to all callbacks
 	 */
-	PokerGame(uint32_t random_seed, uint8_t small_blind, uint16_t starting_stack_size, DecisionCallback decision_callback,
+	BasicPokerGame(uint32_t random_seed, uint8_t small_blind, uint16_t starting_stack_size, DecisionCallback decision_callback,
 		PlayerActionCallback player_action_callback, SubRoundChangeCallback subround_change_callback,
 		RoundEndCallback round_end_callback, GameEndCallback game_end_callback, void* opaque);
 
-	/** Play the game!
+	/** Poker game constructor, for any policies
+	 *  @param random_seed A random seed to used for random number generation
+	 *  @param small_blind The small blind amount
+	 *  @param starting_stack_size The starting stack size for each player
+	 *  @param decider Decides actions for every seat
+	 *  @param observer Notified of game events
+	 *  @param dealer Chooses the first dealer and supplies the cards
+	 */
+	BasicPokerGame(uint32_t random_seed, uint8_t small_blind, uint16_t starting_stack_size, const Decider& decider, const Observer& observer,
+		const Dealer& dealer = Dealer());
+
+	/// A fixed-size copy of everything needed to fork or resume a game, shared by every policy configuration
+	using Snapshot = PokerGameSnapshot<SEATS>;
+
+	/** Play the game! Steps the game until it ends, blocking on any decider that is waiting for input
 	 */
 	void play();
 
+	/** Advance the game by a single action, so that a main loop may service other work between steps
+	 *  @return WaitingForInput if a decider returned PlayerAction::Pending, RoundOver after each round,
+	 *  GameOver once the game has ended, otherwise Running
+	 */
+	StepResult step();
+
+	/** End the game, the next step reports the game end
+	 */
+	void quit();
+
+	/** Take a snapshot of the game state, the deck order and the random number generator state
+	 *  @return The snapshot
+	 */
+	Snapshot takeSnapshot() const;
+
+	/** Restore a snapshot taken from this or another instance. Snapshots taken between rounds resume
+	 *  with play(), snapshots taken from within a callback restore the hand in progress
+	 *  @param snapshot The snapshot to restore
+	 */
+	void restoreSnapshot(const Snapshot& snapshot);
+
+	/** Get the number of rounds that have been started
+	 *  @return The round number
+	 */
+	uint32_t getRoundNumber() const;
+
+	/** Report the exact all in equity of each remaining player whenever betting closes before the river. The equity
+	 *  is only computed while a callback is set, see HandEvaluator::allInEquity for its cost
+	 *  @param all_in_equity_callback Called before the rest of the board is dealt, or nullptr to stop reporting
+	 *  @param opaque A pointer that is provided to the callback
+	 */
+	void setAllInEquityCallback(AllInEquityCallback all_in_equity_callback, void* opaque);
+
 protected:
 
-	// The number of players seated
-	uint8_t MAX_PLAYERS = 6;
+	/// The number of players seated
+	static constexpr uint8_t MAX_PLAYERS = SEATS;
 
 	/// True if the game should continue running
 	bool run{ true };
 
+	/// The number of rounds that have been started
+	uint32_t round_number{ 0 };
+
+	/// Where the next step resumes
+	Progress progress;
+
 	/// The small blind
 	const uint8_t small_blind;
 
 	/// The starting stack size
 	const uint16_t starting_stack_size;
 
-	/// The decision callback
-	const DecisionCallback decision_callback;
-
-	/// The player action callback
-	const PlayerActionCallback player_action_callback;
+	/// The decider policy
+	Decider decider;
 
-	/// The subround change callback
-	const SubRoundChangeCallback subround_change_callback;
+	/// The observer policy
+	Observer observer;
 
-	/// The round end callback
-	const RoundEndCallback round_end_callback;
-
-	/// The game end callback
-	const GameEndCallback game_end_callback;
-
-	/// User provided pointer
-	void* opaque;
+	/// The dealer policy
+	Dealer dealer;
 
 	/// A random number generator
 	Random rng;
@@ -130,15 +187,25 @@ protected:
 	/// The current poker game state
 	PokerGameState current_state;
 
-	/** Play a round of texas holdem poker!
-	 *  @return True if the program should continue, false otherwise
+	/// Called with the all in equity when betting closes early, if set
+	AllInEquityCallback all_in_equity_callback{ nullptr };
+
+	/// The pointer provided to the all in equity callback
+	void* all_in_equity_opaque{ nullptr };
+
+	/** Start a round of texas holdem poker, dealing hands, posting blinds and opening the pre-flop betting round
+	 *  @return True if the round was started, false if only one player remains
 	 */
-	bool playRound();
+	bool startRound();
+
+	/** End the game, notifying the observer of the winner
+	 */
+	void endGame();
 
 	/** Choose the dealer for this round
-	 *  @return The dealer in the range [0..5]
+	 *  @return The dealer in the range [0..SEATS)
 	 */
-	virtual uint8_t chooseDealer();
+	uint8_t chooseDealer();
 
 	/** Increment a player_id, returning the next player that is still in the game
 	 *  @param player_id The id to increment
@@ -146,10 +213,17 @@ protected:
 	 */
 	uint8_t incrementPlayerID(uint8_t player_id);
 
+	/** Post a blind, capped at the player's stack
+	 *  @param player_id The player posting the blind
+	 *  @param blind The blind amount
+	 *  @return The amount posted
+	 */
+	uint16_t postBlind(uint8_t player_id, uint16_t blind);
+
 	/** Deal a single card
 	 *  @return The card
 	 */
-	virtual Card dealCard();
+	Card dealCard();
 
 	/** Deal cards to each player
 	 *  @param player_count The amount of players to deal cards to
@@ -176,33 +250,55 @@ protected:
 	 */
 	void fold(uint8_t player_id, const utl::pair<PlayerAction, uint16_t>& action);
 
-	/** Player action function, either lets the human player or AI take an action
+	/** Player action function, lets the decider choose an action for a player
 	 *  @param player A reference to the player object
 	 *  @return The first element is the action, the second is the bet, if any
 	 */
-	virtual utl::pair<PlayerAction, uint16_t> playerAction(uint8_t player_id);
+	utl::pair<PlayerAction, uint16_t> playerAction(uint8_t player_id);
 
-	/** Betting round wrapper, handles final callback
+	/** Open a betting round
 	 *  @param starting_player The player that starts the betting round
-	 *  @param players_acted The number of players that have acted
-	 *  @return True if the round should progress, false otherwise
 	 */
-	bool bettingRound(uint8_t starting_player, uint8_t players_acted);
+	void startBettingRound(uint8_t starting_player);
+
+	/// The status of a betting round after a step
+	enum class BettingStatus : uint8_t
+	{
+		Open = 1,
+		Waiting = 2,
+		Closed = 3,
+	};
 
-	/** Run through a betting round step, if a player bets, this function returns false and will need to be called again
-	 *  @param acting_player A reference to the ID of the player that currently has priority
-	 *  @param players_to_act A reference to the count of players that need to act
-	 *  @param actionable_players A reference to the count of players that may still make decisions
-	 *  @return True if the betting round is over, false otherwise
+	/** Let the next player in the betting round act
+	 *  @return Waiting if the player's decider is waiting for input, Closed once the betting round is over, otherwise Open
 	 */
-	bool bettingRoundStep(uint8_t& acting_player, uint8_t& players_to_act, uint8_t& actionable_players);
+	BettingStatus bettingRoundStep();
+
+	/** Close a betting round, moving on to the next street or ending the round
+	 *  @return The step result
+	 */
+	StepResult endBettingRound();
+
+	/** Deal the next street of the board and notify the observer
+	 */
+	void dealStreet();
+
+	/** Check whether betting has closed for the rest of the round, at most one player in the hand is not all in
+	 *  @return True if no further betting is possible
+	 */
+	bool bettingClosed() const;
+
+	/** Deal the rest of the board without betting rounds and resolve the round, once betting has closed
+	 *  @return True if the game should continue
+	 */
+	bool runOut();
 
 	/// Outcome struct, used to represent the outcome of a showdown
 	struct Outcome {
 		bool draw{ false };
 		utl::string<MAX_NAME_SIZE> winner;
 		RankedHand::Ranking ranking{ RankedHand::Ranking::Unranked };
-		utl::vector<uint8_t, 6> revealing_players;
+		utl::vector<uint8_t, SEATS> revealing_players;
 	};
 
 	/** Determine the outcome of a round, the showdown
@@ -215,31 +311,33 @@ protected:
 	 */
 	bool resolveRound();
 
-	/** Construct a state struct
-	 *  @param player The player who will receive this state snapshot
-	 *  @param revealing_players A vector of player_ids cooresponding to those that revealed their cards
-	 *  @return A copy of the PokerGameState
-	 */
-	PokerGameState constructState(uint8_t player_id, const utl::vector<uint8_t, 6>& revealing_players);
-
-	/** Callback to the user with a player action notification
+	/** Notify the observer of a player action
 	 *  @param player_name The player's name
 	 *  @param action The action the player performed
 	 *  @param bet The bet, if any
 	 */
 	void callbackWithPlayerAction(const utl::string<MAX_NAME_SIZE>& player_name, PlayerAction action, uint16_t bet);
 
-	/** Callback to the user with a subround change notification
+	/** Notify the observer of a subround change
 	 *  @param new_subround The new subround
 	 */
 	void callbackWithSubroundChange(SubRound new_subround);
 
-	/** Callback to the user with a round end notification
+	/** Notify the observer of a round end
 	 *  @param draw True if the round ended in a draw, false otherwise
 	 *  @param revealing_players A vector of player_ids cooresponding to those that revealed their cards
 	 *  @param winner The round winner
 	 *  @param ranking The ranking of the winning hand
 	 *  @param True if the round should continue, false otherwise
 	 */
-	bool callbackWithRoundEnd(bool draw, const utl::string<MAX_NAME_SIZE>& winner, const utl::vector<uint8_t, 6>& revealing_players, RankedHand::Ranking ranking);
+	bool callbackWithRoundEnd(bool draw, const utl::string<MAX_NAME_SIZE>& winner, const utl::vector<uint8_t, SEATS>& revealing_players, RankedHand::Ranking ranking);
 };
+
+/// The poker game for the default table size
+using PokerGame = BasicPokerGame<TABLE_SEATS>;
+
+/// A heads up poker game
+using HeadsUpPokerGame = BasicPokerGame<2>;
+
+/// A full ring poker game
+using FullRingPokerGame = BasicPokerGame<9>;
\ No newline at end of file
@@ -0,0 +1,89 @@
+/**
+ *  A simple interactive texas holdem poker program.
+ *  Copyright (C) 2020, Matt Zimmerer, mzimmere@gmail.com
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ **/
+#pragma once
+
+#include <utl/cstdint>
+#include <utl/string>
+
+#include "PokerGameState.h"
+
+ /** Definitions shared by poker games of every table size and policy configuration
+  */
+class PokerGameBase
+{
+public:
+
+	/** An enumeration of possible player actions
+	 */
+	enum class PlayerAction : uint8_t
+	{
+		Pending = 0,
+		CheckOrCall = 1,
+		Bet = 2,
+		Fold = 3,
+		Quit = 4,
+	};
+
+	/// Subround definitions
+	enum class SubRound : uint8_t
+	{
+		PreFlop = 1,
+		Flop = 2,
+		Turn = 3,
+		River = 4,
+	};
+
+	/// The result of a single step of the game
+	enum class StepResult : uint8_t
+	{
+		Running = 1,
+		WaitingForInput = 2,
+		RoundOver = 3,
+		GameOver = 4,
+	};
+
+	/// The stage that the next step resumes from
+	enum class Stage : uint8_t
+	{
+		ChooseDealer = 0,
+		NextRound = 1,
+		StartRound = 2,
+		Betting = 3,
+		EndGame = 4,
+		Finished = 5,
+	};
+
+	/// Everything needed to resume a game that is driven by step()
+	struct Progress {
+		Stage stage{ Stage::ChooseDealer };
+		uint8_t acting_player{ 0 };
+		uint8_t players_to_act{ 0 };
+		uint8_t actionable_players{ 0 };
+	};
+
+	/** Get the name of the player seated at a seat
+	 *  @param player_id The seat
+	 *  @return The player's name
+	 */
+	static utl::string<MAX_NAME_SIZE> seatName(uint8_t player_id);
+
+	/** Get the winner name reported for a split pot
+	 *  @return The name
+	 */
+	static utl::string<MAX_NAME_SIZE> drawName();
+};
\ No newline at end of file
@@ -0,0 +1,731 @@
+/**
+ *  A simple interactive texas holdem poker program.
+ *  Copyright (C) 2020, Matt Zimmerer, mzimmere@gmail.com
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ **/
+#pragma once
+
+#include "Exception.h"
+#include "PokerGame/PokerGame.h"
+
+template <uint8_t SEATS, class Decider, class Observer, class Dealer>
+BasicPokerGame<SEATS, Decider, Observer, Dealer>::BasicPokerGame(uint32_t random_seed_in, uint8_t small_blind_in, uint16_t starting_stack_size_in, DecisionCallback decision_callback_in,
+	PlayerActionCallback player_action_callback_in, SubRoundChangeCallback subround_change_callback_in,
+	RoundEndCallback round_end_callback_in, GameEndCallback game_end_callback_in, void* opaque_in)
+	: BasicPokerGame(random_seed_in, small_blind_in, starting_stack_size_in, Decider(decision_callback_in, opaque_in),
+		Observer(player_action_callback_in, subround_change_callback_in, round_end_callback_in, game_end_callback_in, opaque_in))
+{
+}
+
+template <uint8_t SEATS, class Decider, class Observer, class Dealer>
+BasicPokerGame<SEATS, Decider, Observer, Dealer>::BasicPokerGame(uint32_t random_seed_in, uint8_t small_blind_in, uint16_t starting_stack_size_in, const Decider& decider_in,
+	const Observer& observer_in, const Dealer& dealer_in)
+	: small_blind(small_blind_in), starting_stack_size(starting_stack_size_in),
+	decider(decider_in),
+	observer(observer_in),
+	dealer(dealer_in),
+	rng(random_seed_in),
+	deck(rng)
+{
+	// Initialize player states
+	for (uint8_t player_id = 0; player_id < MAX_PLAYERS; ++player_id) {
+		this->current_state.player_states[player_id].name = PokerGameBase::seatName(player_id);
+		this->current_state.player_states[player_id].stack = starting_stack_size_in;
+		this->current_state.player_states[player_id].pot_investment = 0;
+		this->current_state.player_states[player_id].folded = false;
+	}
+
+	// Initialize remaining current_state
+	this->current_state.current_bet = 0;
+	this->current_state.current_player = 0;
+	this->current_state.current_dealer = 0;
+	this->current_state.updateSeatMasks();
+}
+
+template <uint8_t SEATS, class Decider, class Observer, class Dealer>
+void BasicPokerGame<SEATS, Decider, Observer, Dealer>::play()
+{
+	// Step the game until it has ended
+	while (this->step() != StepResult::GameOver) {
+	}
+}
+
+template <uint8_t SEATS, class Decider, class Observer, class Dealer>
+PokerGameBase::StepResult BasicPokerGame<SEATS, Decider, Observer, Dealer>::step()
+{
+	// A game that is no longer running ends before the next round or action
+	if (this->run == false && this->progress.stage < Stage::EndGame)
+		this->progress.stage = Stage::EndGame;
+
+	switch (this->progress.stage)
+	{
+		// Determine the first dealer
+	case Stage::ChooseDealer:
+		this->current_state.current_dealer = this->chooseDealer();
+		this->progress.stage = Stage::StartRound;
+		return StepResult::Running;
+
+		// Choose the next dealer
+	case Stage::NextRound:
+		this->current_state.current_dealer = this->incrementPlayerID(this->current_state.current_dealer);
+		this->progress.stage = Stage::StartRound;
+		return StepResult::Running;
+
+		// Play a round of poker, unless only one player remains
+	case Stage::StartRound:
+		if (false == this->startRound())
+			this->progress.stage = Stage::EndGame;
+		return StepResult::Running;
+
+		// Let the next player act
+	case Stage::Betting:
+		switch (this->bettingRoundStep())
+		{
+		case BettingStatus::Waiting:
+			return StepResult::WaitingForInput;
+		case BettingStatus::Open:
+			return StepResult::Running;
+		default:
+			return this->endBettingRound();
+		}
+
+		// Report the game winner
+	case Stage::EndGame:
+		this->endGame();
+		this->progress.stage = Stage::Finished;
+		return StepResult::GameOver;
+
+	default:
+		return StepResult::GameOver;
+	}
+}
+
+template <uint8_t SEATS, class Decider, class Observer, class Dealer>
+void BasicPokerGame<SEATS, Decider, Observer, Dealer>::quit()
+{
+	this->run = false;
+}
+
+template <uint8_t SEATS, class Decider, class Observer, class Dealer>
+void BasicPokerGame<SEATS, Decider, Observer, Dealer>::endGame()
+{
+	// The human player quit the game, the AI with the highest chip count wins!
+	uint16_t highest_chip_count = 0;
+	uint16_t winning_player_id = 0;
+	for (uint8_t player_id = 0; player_id < MAX_PLAYERS; ++player_id)
+	{
+		// Skip the human player
+		if (player_id == 0)
+			continue;
+
+		// Track the largest chip count
+		if (this->current_state.player_states[player_id].stack > highest_chip_count) {
+			highest_chip_count = this->current_state.player_states[player_id].stack;
+			winning_player_id = player_id;
+		}
+	}
+	this->observer.gameEnd(this->current_state.player_states[winning_player_id].name);
+}
+
+template <uint8_t SEATS, class Decider, class Observer, class Dealer>
+typename BasicPokerGame<SEATS, Decider, Observer, Dealer>::Snapshot BasicPokerGame<SEATS, Decider, Observer, Dealer>::takeSnapshot() const
+{
+	Snapshot result;
+	result.state = this->current_state;
+	result.deck = this->deck.takeSnapshot();
+	result.rng = this->rng;
+	result.round_number = this->round_number;
+	result.run = this->run;
+	result.progress = this->progress;
+	return result;
+}
+
+template <uint8_t SEATS, class Decider, class Observer, class Dealer>
+void BasicPokerGame<SEATS, Decider, Observer, Dealer>::restoreSnapshot(const Snapshot& snapshot)
+{
+	this->current_state = snapshot.state;
+	this->deck.restoreSnapshot(snapshot.deck);
+	this->rng = snapshot.rng;
+	this->round_number = snapshot.round_number;
+	this->run = snapshot.run;
+	this->progress = snapshot.progress;
+}
+
+template <uint8_t SEATS, class Decider, class Observer, class Dealer>
+uint32_t BasicPokerGame<SEATS, Decider, Observer, Dealer>::getRoundNumber() const
+{
+	return this->round_number;
+}
+
+template <uint8_t SEATS, class Decider, class Observer, class Dealer>
+bool BasicPokerGame<SEATS, Decider, Observer, Dealer>::startRound()
+{
+	// Initialize player state
+	for (size_t i = 0; i < MAX_PLAYERS; ++i) {
+		this->current_state.player_states[i].pot_investment = 0;
+		this->current_state.player_states[i].folded = false;
+	}
+
+	// Every player with chips is dealt into this round
+	this->current_state.updateSeatMasks();
+	uint8_t players_remaining = PokerGameState::countSeats(this->current_state.seated_mask);
+
+	// If there is only one player remaining, that player wins!
+	if (players_remaining == 1)
+		return false;
+
+	// Count this round
+	++this->round_number;
+
+	// Shuffle the deck
+	this->dealer.shuffle(this->deck);
+
+	// Deal hands
+	this->dealCards(players_remaining);
+
+	// Small blind
+	uint8_t small_blind_target = this->incrementPlayerID(this->current_state.current_dealer);
+	uint16_t small_blind_posted = this->postBlind(small_blind_target, this->small_blind);
+	this->current_state.current_bet = this->small_blind;
+	this->callbackWithPlayerAction(this->current_state.player_states[small_blind_target].name, PlayerAction::Bet,
+		small_blind_posted);
+
+	// Big blind
+	uint8_t big_blind_target = this->incrementPlayerID(small_blind_target);
+	uint16_t big_blind_posted = this->postBlind(big_blind_target, 2 * this->small_blind);
+	this->current_state.current_bet += this->small_blind;
+	this->callbackWithPlayerAction(this->current_state.player_states[big_blind_target].name, PlayerAction::Bet,
+		big_blind_posted);
+
+	// Pre-flop betting round
+	this->current_state.board.clear();
+	this->callbackWithSubroundChange(SubRound::PreFlop);
+	this->startBettingRound(this->incrementPlayerID(big_blind_target));
+	return true;
+}
+
+template <uint8_t SEATS, class Decider, class Observer, class Dealer>
+uint16_t BasicPokerGame<SEATS, Decider, Observer, Dealer>::postBlind(uint8_t player_id, uint16_t blind)
+{
+	// A player that can not cover the blind is all in for what he/she has
+	if (blind > this->current_state.player_states[player_id].stack)
+		blind = this->current_state.player_states[player_id].stack;
+
+	// Move the blind to the pot
+	this->current_state.current_player = player_id;
+	this->current_state.player_states[player_id].stack -= blind;
+	this->current_state.player_states[player_id].pot_investment += blind;
+	this->current_state.current_pot_shares[player_id] += blind;
+	this->current_state.updateSeat(player_id);
+	return blind;
+}
+
+template <uint8_t SEATS, class Decider, class Observer, class Dealer>
+void BasicPokerGame<SEATS, Decider, Observer, Dealer>::setAllInEquityCallback(AllInEquityCallback all_in_equity_callback_in, void* opaque_in)
+{
+	this->all_in_equity_callback = all_in_equity_callback_in;
+	this->all_in_equity_opaque = opaque_in;
+}
+
+template <uint8_t SEATS, class Decider, class Observer, class Dealer>
+bool BasicPokerGame<SEATS, Decider, Observer, Dealer>::bettingClosed() const
+{
+	// A single player that is not all in has nobody left to bet against
+	return PokerGameState::countSeats(this->current_state.can_act_mask) <= 1;
+}
+
+template <uint8_t SEATS, class Decider, class Observer, class Dealer>
+bool BasicPokerGame<SEATS, Decider, Observer, Dealer>::runOut()
+{
+	// Report the equity of each remaining hand before the rest of the board is known
+	if (this->all_in_equity_callback != nullptr)
+		this->all_in_equity_callback(HandEvaluator::allInEquity(this->current_state), this->current_state, this->all_in_equity_opaque);
+
+	// Deal the remaining streets, the observer still sees each subround
+	while (this->current_state.board.size() < 5)
+		this->dealStreet();
+
+	return this->resolveRound();
+}
+
+template <uint8_t SEATS, class Decider, class Observer, class Dealer>
+void BasicPokerGame<SEATS, Decider, Observer, Dealer>::dealStreet()
+{
+	// The flop
+	if (this->current_state.board.size() == 0) {
+		this->current_state.board.push_back(this->dealCard());
+		this->current_state.board.push_back(this->dealCard());
+		this->current_state.board.push_back(this->dealCard());
+		this->callbackWithSubroundChange(SubRound::Flop);
+		return;
+	}
+
+	// The turn or the river
+	this->current_state.board.push_back(this->dealCard());
+	this->callbackWithSubroundChange(this->current_state.board.size() == 4 ? SubRound::Turn : SubRound::River);
+}
+
+template <uint8_t SEATS, class Decider, class Observer, class Dealer>
+uint8_t BasicPokerGame<SEATS, Decider, Observer, Dealer>::chooseDealer()
+{
+	return this->dealer.chooseDealer(this->rng, SEATS);
+}
+
+template <uint8_t SEATS, class Decider, class Observer, class Dealer>
+uint8_t BasicPokerGame<SEATS, Decider, Observer, Dealer>::incrementPlayerID(uint8_t player_id) {
+
+	// The next seated player, skipping players with zero stack and pot investment
+	return PokerGameState::nextSeat(this->current_state.seated_mask, player_id);
+}
+
+template <uint8_t SEATS, class Decider, class Observer, class Dealer>
+Card BasicPokerGame<SEATS, Decider, Observer, Dealer>::dealCard()
+{
+	return this->dealer.dealCard(this->deck);
+}
+
+template <uint8_t SEATS, class Decider, class Observer, class Dealer>
+void BasicPokerGame<SEATS, Decider, Observer, Dealer>::dealCards(uint8_t player_count)
+{
+	// Deal two cards to each player starting with the player left of the dealer
+	static constexpr size_t TWO_CARDS = 2;
+	for (size_t card = 0; card < TWO_CARDS; ++card) {
+
+		// Deal a single card to each player starting left of the dealer
+		int draw_target = this->incrementPlayerID(this->current_state.current_dealer);
+		for (size_t i = 0; i < player_count; ++i)
+		{
+			// Give the player the card
+			this->current_state.player_states[draw_target].hand[card] = this->dealCard();
+
+			// Determine who will receive the next card
+			draw_target = this->incrementPlayerID(draw_target);
+		}
+	}
+}
+
+template <uint8_t SEATS, class Decider, class Observer, class Dealer>
+bool BasicPokerGame<SEATS, Decider, Observer, Dealer>::checkOrCall(int8_t player_id, const utl::pair<PlayerAction, uint16_t>& action)
+{
+	// If it was a call, move chips to the pot
+	if (this->current_state.current_bet > 0)
+	{
+		// Lookup this player's current bet
+		uint16_t chips_in_pot = this->current_state.player_states[player_id].pot_investment;
+
+		// Determine how many chips are required to call
+		uint16_t to_call = this->current_state.current_bet - chips_in_pot;
+
+		// Players can only call with the chips that they have
+		if (to_call > this->current_state.player_states[player_id].stack) {
+			to_call = this->current_state.player_states[player_id].stack;
+		}
+
+		// Remove chips from this player's stack
+		this->current_state.player_states[player_id].stack -= to_call;
+
+		// Remember this players bet
+		this->current_state.player_states[player_id].pot_investment += to_call;
+
+		// Add the chips to the pot
+		this->current_state.current_pot_shares[player_id] += to_call;
+		this->current_state.updateSeat(player_id);
+
+		// Call action callback
+		this->callbackWithPlayerAction(this->current_state.player_states[player_id].name, PlayerAction::CheckOrCall, to_call);
+	}
+
+	// Return true if this player is all in
+	if (this->current_state.player_states[player_id].stack == 0)
+		return true;
+	else
+		return false;
+}
+
+template <uint8_t SEATS, class Decider, class Observer, class Dealer>
+bool BasicPokerGame<SEATS, Decider, Observer, Dealer>::bet(int8_t player_id, utl::pair<PlayerAction, uint16_t>& action)
+{
+	// Lookup this player's current bet
+	uint16_t chips_in_pot = this->current_state.player_states[player_id].pot_investment;
+
+	// Determine how many chips are required to flat call
+	uint16_t to_call = this->current_state.current_bet - chips_in_pot;
+
+	// Determine how many chips the player must put into the pot
+	uint16_t chips_to_pot = to_call + action.second;
+
+	// Players can only bet with the chips that they have
+	if (chips_to_pot > this->current_state.player_states[player_id].stack) {
+		chips_to_pot = this->current_state.player_states[player_id].stack;
+		action.second = chips_to_pot;
+	}
+
+	// Remove chips from this player's stack
+	this->current_state.player_states[player_id].stack -= chips_to_pot;
+
+	// Remember this players bet
+	this->current_state.player_states[player_id].pot_investment += chips_to_pot;
+
+	// Add the chips to the pot
+	this->current_state.current_pot_shares[player_id] += chips_to_pot;
+
+	// Adjust the current bet
+	this->current_state.current_bet = this->current_state.player_states[player_id].pot_investment;
+	this->current_state.updateSeat(player_id);
+
+	// Call action callback
+	if (action.first == PlayerAction::CheckOrCall)
+		this->callbackWithPlayerAction(this->current_state.player_states[player_id].name, PlayerAction::CheckOrCall,
+			to_call);
+	else
+		this->callbackWithPlayerAction(this->current_state.player_states[player_id].name, action.first, action.second);
+
+	// Return true if this player is all in
+	if (this->current_state.player_states[player_id].stack == 0)
+		return true;
+	else
+		return false;
+}
+
+template <uint8_t SEATS, class Decider, class Observer, class Dealer>
+void BasicPokerGame<SEATS, Decider, Observer, Dealer>::fold(uint8_t player_id, const utl::pair<PlayerAction, uint16_t>& action)
+{
+	// Mark the player as folded
+	this->current_state.player_states[player_id].folded = true;
+	this->current_state.updateSeat(player_id);
+
+	// Call action callback
+	this->callbackWithPlayerAction(this->current_state.player_states[player_id].name, PlayerAction::Fold, 0);
+}
+
+template <uint8_t SEATS, class Decider, class Observer, class Dealer>
+utl::pair<PokerGameBase::PlayerAction, uint16_t> BasicPokerGame<SEATS, Decider, Observer, Dealer>::playerAction(uint8_t player_id)
+{
+	// Allow the decider to choose an action, it is responsible for only using what the player may see
+	return this->decider.decide(this->current_state, player_id, this->rng);
+}
+
+template <uint8_t SEATS, class Decider, class Observer, class Dealer>
+void BasicPokerGame<SEATS, Decider, Observer, Dealer>::startBettingRound(uint8_t starting_player)
+{
+	// Every player that can still make a decision needs to act
+	this->progress.stage = Stage::Betting;
+	this->progress.acting_player = starting_player;
+	this->progress.actionable_players = PokerGameState::countSeats(this->current_state.can_act_mask);
+	this->progress.players_to_act = this->progress.actionable_players;
+}
+
+template <uint8_t SEATS, class Decider, class Observer, class Dealer>
+typename BasicPokerGame<SEATS, Decider, Observer, Dealer>::BettingStatus BasicPokerGame<SEATS, Decider, Observer, Dealer>::bettingRoundStep()
+{
+	// If every player has acted, or every player has folded or is all in, nobody is left to act
+	SeatMask can_act_mask = this->current_state.can_act_mask;
+	if (this->progress.players_to_act == 0 || can_act_mask == 0)
+		return BettingStatus::Closed;
+
+	// Set deciding_player, skipping players that have folded or have no chips
+	uint8_t deciding_player = this->progress.acting_player;
+	if ((can_act_mask & (1u << deciding_player)) == 0)
+		deciding_player = PokerGameState::nextSeat(can_act_mask, deciding_player);
+
+	// Let either players or AI decide their actions, a pending decision is asked for again on the next step
+	this->current_state.current_player = deciding_player;
+	utl::pair<PlayerAction, uint16_t> action = this->playerAction(deciding_player);
+	if (action.first == PlayerAction::Pending)
+		return BettingStatus::Waiting;
+
+	// Increment starting player
+	this->progress.acting_player = this->incrementPlayerID(deciding_player);
+
+	// Deincrement players_to_act
+	--this->progress.players_to_act;
+
+	// Switch to action specific implementation
+	switch (action.first)
+	{
+		// Check or call, depending on current bet
+	case PlayerAction::CheckOrCall:
+		if (true == this->checkOrCall(deciding_player, action)) {
+
+			// If the player goes all in, he may no longer act
+			--this->progress.actionable_players;
+		}
+		break;
+
+		// Bet
+	case PlayerAction::Bet:
+
+		// If the player can not afford to bet, just call
+		if (this->current_state.player_states[deciding_player].stack <= this->current_state.current_bet - this->current_state.player_states[deciding_player].pot_investment) {
+			if (true == this->checkOrCall(deciding_player, action)) {
+
+				// If the player goes all in, he may no longer act
+				--this->progress.actionable_players;
+			}
+			break;
+		}
+
+		// Every other player that may still act needs to act again
+		this->progress.players_to_act = this->progress.actionable_players - 1;
+
+		// Call bet
+		if (true == this->bet(deciding_player, action)) {
+
+			// If the player goes all in, he may no longer act
+			--this->progress.actionable_players;
+		}
+		break;
+
+		// Fold
+	case PlayerAction::Fold:
+
+		// Call fold
+		this->fold(deciding_player, action);
+
+		// One less player may now act
+		--this->progress.actionable_players;
+
+		// If there is only one player left after a fold, no more players may make actions
+		if (this->progress.actionable_players == 1)
+			this->progress.players_to_act = 0;
+		break;
+
+		// Quit
+	case PlayerAction::Quit:
+
+		// Set run to false
+		this->run = false;
+		return BettingStatus::Closed;
+
+		// Invalid actions
+	default:
+		Exception::EXCEPTION();
+	}
+
+	// The betting round is over once nobody is left to act
+	if (this->progress.players_to_act == 0 || this->current_state.can_act_mask == 0)
+		return BettingStatus::Closed;
+	return BettingStatus::Open;
+}
+
+template <uint8_t SEATS, class Decider, class Observer, class Dealer>
+PokerGameBase::StepResult BasicPokerGame<SEATS, Decider, Observer, Dealer>::endBettingRound()
+{
+	// If the player quit, end the game
+	if (this->run == false) {
+		this->progress.stage = Stage::EndGame;
+		return StepResult::Running;
+	}
+
+	// If there is only a single player still in the hand, the others have folded
+	if (PokerGameState::countSeats(this->current_state.in_hand_mask) == 1) {
+
+		// He/she wins the pot
+		uint8_t player_id = PokerGameState::lowestSeat(this->current_state.in_hand_mask);
+		this->current_state.player_states[player_id].stack += this->current_state.chipsRemaining();
+
+		// Callback with round end
+		utl::vector<uint8_t, SEATS> revealing_players;
+		this->run = this->callbackWithRoundEnd(false, this->current_state.player_states[player_id].name, revealing_players, RankedHand::Ranking::Unranked);
+	}
+
+	// After the river betting round, the showdown
+	else if (this->current_state.board.size() == 5) {
+		this->run = this->resolveRound();
+	}
+
+	// If no more betting is possible, run out the rest of the board
+	else if (this->bettingClosed()) {
+		this->run = this->runOut();
+	}
+
+	// Otherwise deal the next street, and open its betting round
+	else {
+		this->dealStreet();
+		this->startBettingRound(this->incrementPlayerID(this->current_state.current_dealer));
+		return StepResult::Running;
+	}
+
+	return StepResult::RoundOver;
+}
+
+template <uint8_t SEATS, class Decider, class Observer, class Dealer>
+#ifdef EMBEDDED_BUILD
+typename BasicPokerGame<SEATS, Decider, Observer, Dealer>::Outcome __attribute__((noinline)) BasicPokerGame<SEATS, Decider, Observer, Dealer>::determineOutcome()
+#else
+typename BasicPokerGame<SEATS, Decider, Observer, Dealer>::Outcome BasicPokerGame<SEATS, Decider, Observer, Dealer>::determineOutcome()
+#endif
+{
+	Outcome result;
+	uint16_t winnings = 0;
+
+	// Rank each player's hand
+	utl::list<RankedHand, SEATS> ranked_hands;
+	for (SeatMask remaining = this->current_state.in_hand_mask; remaining != 0; remaining &= remaining - 1)
+	{
+		// Construct the ranked hand at the back of the list for each player still in the hand
+		uint8_t player_id = PokerGameState::lowestSeat(remaining);
+		ranked_hands.emplace_back(player_id, this->current_state.player_states[player_id].hand, this->current_state.board);
+	}
+
+	// Each of these players revealed their hands
+	for (const auto& ranked_hand : ranked_hands)
+		result.revealing_players.push_back(ranked_hand.getPlayerID());
+
+	// Sort the list in descending order
+	ranked_hands.sort([](const RankedHand& lhs, const RankedHand& rhs) { return lhs >= rhs;	});
+
+	// Only populate the result on the first iteration of the following loop
+	bool first_iteration = false;
+
+	// Give the winner his share of the chips, as long as there are still chips in the pot
+	do {
+
+		// Count the number of winners (to support split pots)
+		size_t winners = 0;
+		for (const auto& ranked_hand : ranked_hands) {
+			if (ranked_hand == ranked_hands.front())
+				++winners;
+		}
+
+		// If this is the first iteration
+		if (first_iteration == false) {
+
+			// Set the result
+			result.draw = winners == 1 ? false : true;
+			result.winner = winners == 1 ? this->current_state.player_states[ranked_hands.begin()->getPlayerID()].name : PokerGameBase::drawName();
+			result.ranking = ranked_hands.begin()->getRanking();
+
+			// Clear 'first_iteration'
+			first_iteration = true;
+		}
+
+		// Create a list of id to stack mappings
+		struct StackMapping {
+			uint8_t player_id;
+			uint16_t chip_count;
+		};
+		utl::list<StackMapping, SEATS> stack_mapping;
+		int i = 0;
+		for (const auto& ranked_hand : ranked_hands) {
+
+			// If this ranked hand is not one of the wining hands, dont add it to the mapping
+			if (static_cast<size_t>(i) >= winners)
+				break;
+
+			// Add this player_id and chip count to the stack mapping
+			stack_mapping.emplace_back();
+			stack_mapping.back().player_id = ranked_hand.getPlayerID();
+			stack_mapping.back().chip_count = this->current_state.current_pot_shares[stack_mapping.back().player_id];
+
+			++i;
+		}
+
+		// Sort the stack mapping list ascending
+		stack_mapping.sort([](const StackMapping& lhs, const StackMapping& rhs) { return lhs.chip_count <= rhs.chip_count; });
+
+		// For each entry in the list but the last
+		uint16_t carry_over = 0;
+		size_t iterations = stack_mapping.size() - 1;
+		for (size_t i = 0; i < iterations; ++i) {
+
+			// Add carry over
+			this->current_state.player_states[stack_mapping.front().player_id].stack += carry_over;
+
+			// Get this players chip share
+			winnings = this->current_state.getChipShare(stack_mapping.front().player_id);
+			winnings /= static_cast<uint16_t>(winners);
+
+			// Give the player the winnings
+			this->current_state.player_states[stack_mapping.front().player_id].stack += winnings;
+
+			// Add to the carry over value
+			carry_over += winnings;
+
+			// Pop this entry from the list
+			stack_mapping.pop_front();
+		}
+
+		// Add carry over
+		this->current_state.player_states[stack_mapping.front().player_id].stack += carry_over;
+
+		// Get this players chip share
+		winnings = this->current_state.getChipShare(stack_mapping.front().player_id);
+		winnings /= static_cast<uint16_t>(winners);
+
+		// Give the player the winnings
+		this->current_state.player_states[stack_mapping.front().player_id].stack += winnings;
+
+		// Pop this ranked hand from the list
+		for (size_t i = 0; i < winners; ++i)
+			ranked_hands.pop_front();
+
+	} while (this->current_state.chipsRemaining() > 0);
+
+	// Set player 0's chip share to the winnings, so that this chips are still represented in the pot
+	this->current_state.current_pot_shares[0] = winnings;
+
+	return result;
+}
+
+template <uint8_t SEATS, class Decider, class Observer, class Dealer>
+bool BasicPokerGame<SEATS, Decider, Observer, Dealer>::resolveRound()
+{
+	// Determine the match outcome
+	Outcome outcome = determineOutcome();
+
+	// Callback with the result
+	return this->callbackWithRoundEnd(outcome.draw, outcome.winner, outcome.revealing_players, outcome.ranking);
+}
+
+template <uint8_t SEATS, class Decider, class Observer, class Dealer>
+void BasicPokerGame<SEATS, Decider, Observer, Dealer>::callbackWithPlayerAction(const utl::string<MAX_NAME_SIZE>& player_name, PlayerAction action, uint16_t bet)
+{
+	// Notify the observer
+	this->observer.playerAction(player_name, action, bet, this->current_state);
+}
+
+template <uint8_t SEATS, class Decider, class Observer, class Dealer>
+void BasicPokerGame<SEATS, Decider, Observer, Dealer>::callbackWithSubroundChange(SubRound new_subround)
+{
+	// Notify the observer with the subround change information
+	this->observer.subRoundChange(new_subround, this->current_state);
+}
+
+template <uint8_t SEATS, class Decider, class Observer, class Dealer>
+bool BasicPokerGame<SEATS, Decider, Observer, Dealer>::callbackWithRoundEnd(bool draw, const utl::string<MAX_NAME_SIZE>& winner, const utl::vector<uint8_t, SEATS>& revealing_players, RankedHand::Ranking ranking)
+{
+	// Cache 'winnings'
+	uint16_t winnings = this->current_state.chipsRemaining();
+
+	// Clear the current bet
+	this->current_state.current_bet = 0;
+
+	// Clear pot share counters
+	this->current_state.current_pot_shares.clear();
+
+	// Initialize player state
+	for (size_t i = 0; i < MAX_PLAYERS; ++i) {
+		this->current_state.player_states[i].pot_investment = 0;
+		this->current_state.player_states[i].folded = false;
+	}
+	this->current_state.updateSeatMasks();
+
+	// The next step starts the next round
+	this->progress.stage = Stage::NextRound;
+
+	// Notify the observer with the round end information
+	return this->observer.roundEnd(draw, winner, winnings, ranking, this->current_state, revealing_players);
+}
\ No newline at end of file
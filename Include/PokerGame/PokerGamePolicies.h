@@ -0,0 +1,351 @@
+/**
+ *  A simple interactive texas holdem poker program.
+ *  Copyright (C) 2020, Matt Zimmerer, mzimmere@gmail.com
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ **/
+#pragma once
+
+#include <utl/string>
+#include <utl/utility>
+#include <utl/vector>
+
+#include "AI.h"
+#include "Card.h"
+#include "Deck.h"
+#include "PokerGameBase.h"
+#include "PokerGameState.h"
+#include "Random.h"
+#include "RankedHand.h"
+
+/**
+ *  Policies plug into BasicPokerGame as template parameters, so that their calls are resolved at compile time.
+ *
+ *  A Decider decides actions for every seat. It receives the full game state and must only use the parts of it
+ *  that player_id may see. A Decider waiting on input that has not arrived yet returns PlayerAction::Pending, and is
+ *  asked again on the next step:
+ *      utl::pair<PokerGameBase::PlayerAction, uint16_t> decide(const BasicPokerGameState<SEATS>& state, uint8_t player_id, Random& rng);
+ *
+ *  An Observer is notified of game events. It receives the full game state, and is responsible for hiding hands
+ *  before showing the state to a player:
+ *      void playerAction(const utl::string<MAX_NAME_SIZE>& player_name, PokerGameBase::PlayerAction action, uint16_t bet, const BasicPokerGameState<SEATS>& state);
+ *      void subRoundChange(PokerGameBase::SubRound new_sub_round, const BasicPokerGameState<SEATS>& state);
+ *      bool roundEnd(bool draw, const utl::string<MAX_NAME_SIZE>& winner, uint16_t winnings, RankedHand::Ranking ranking,
+ *          const BasicPokerGameState<SEATS>& state, const utl::vector<uint8_t, SEATS>& revealing_players);
+ *      void gameEnd(const utl::string<MAX_NAME_SIZE>& winner);
+ *
+ *  A Dealer chooses the first dealer and supplies the cards:
+ *      uint8_t chooseDealer(Random& rng, uint8_t seats);
+ *      void shuffle(Deck& deck);
+ *      Card dealCard(Deck& deck);
+ */
+
+/** Decider that lets the human player at seat 0 decide through a callback, every other seat is played by the AI
+ *  @tparam SEATS The number of seats at the table
+ */
+template <uint8_t SEATS>
+class CallbackDecider
+{
+public:
+
+	/// Decision callback definition
+	using DecisionCallback = utl::pair<PokerGameBase::PlayerAction, uint16_t>(*)(const BasicPokerGameState<SEATS>& state, void* opaque);
+
+	/** Constructor
+	 *  @param decision_callback Called when human input is required
+	 *  @param opaque A pointer that is provided to the callback
+	 */
+	CallbackDecider(DecisionCallback decision_callback_in, void* opaque_in) : decision_callback(decision_callback_in), opaque(opaque_in) {}
+
+	/** Decide an action
+	 *  @param state The full game state
+	 *  @param player_id The id of the player that is acting
+	 *  @param rng A random number generator
+	 *  @return The first element is the action, the second is the bet, if any
+	 */
+	utl::pair<PokerGameBase::PlayerAction, uint16_t> decide(const BasicPokerGameState<SEATS>& state, uint8_t player_id, Random& rng)
+	{
+		// Allow the player to decide an action, only showing him/her his/her own hand
+		if (player_id == 0) {
+			utl::vector<uint8_t, SEATS> revealing_players;
+			return this->decision_callback(state.playerView(player_id, revealing_players), this->opaque);
+		}
+
+		// Allow AI to make a decision
+		return AI::computerDecision<SEATS>(state, rng, player_id);
+	}
+
+private:
+
+	/// The decision callback
+	DecisionCallback decision_callback;
+
+	/// User provided pointer
+	void* opaque;
+};
+
+/** Decider that lets the AI play every seat
+ *  @tparam SEATS The number of seats at the table
+ */
+template <uint8_t SEATS>
+class AIDecider
+{
+public:
+
+	/** Decide an action
+	 *  @param state The full game state
+	 *  @param player_id The id of the player that is acting
+	 *  @param rng A random number generator
+	 *  @return The first element is the action, the second is the bet, if any
+	 */
+	utl::pair<PokerGameBase::PlayerAction, uint16_t> decide(const BasicPokerGameState<SEATS>& state, uint8_t player_id, Random& rng)
+	{
+		return AI::computerDecision<SEATS>(state, rng, player_id);
+	}
+};
+
+/** Observer that forwards each event to a callback, showing the state as the human player at seat 0 sees it
+ *  @tparam SEATS The number of seats at the table
+ */
+template <uint8_t SEATS>
+class CallbackObserver
+{
+public:
+
+	/// Player action callback definition
+	using PlayerActionCallback = void(*)(const utl::string<MAX_NAME_SIZE>& player_name, PokerGameBase::PlayerAction action, uint16_t bet,
+		const BasicPokerGameState<SEATS>& state, void* opaque);
+
+	/// Sub round change callback definition
+	using SubRoundChangeCallback = void(*)(PokerGameBase::SubRound new_sub_round, const BasicPokerGameState<SEATS>& state, void* opaque);
+
+	/// Round end callback definition
+	using RoundEndCallback = bool(*)(bool draw, const utl::string<MAX_NAME_SIZE>& winner, uint16_t winnings, RankedHand::Ranking ranking,
+		const BasicPokerGameState<SEATS>& state, void* opaque);
+
+	/// Game end callback definition
+	using GameEndCallback = void(*)(const utl::string<MAX_NAME_SIZE>& winner, void* opaque);
+
+	/** Constructor
+	 *  @param player_action_callback Called to notify of a player action
+	 *  @param subround_change_callback Called to notify of a subround change
+	 *  @param round_end_callback Called to notify of a round end
+	 *  @param game_end_callback Called to notify of game end
+	 *  @param opaque A pointer that is provided to all callbacks
+	 */
+	CallbackObserver(PlayerActionCallback player_action_callback_in, SubRoundChangeCallback subround_change_callback_in,
+		RoundEndCallback round_end_callback_in, GameEndCallback game_end_callback_in, void* opaque_in)
+		: player_action_callback(player_action_callback_in), subround_change_callback(subround_change_callback_in),
+		round_end_callback(round_end_callback_in), game_end_callback(game_end_callback_in), opaque(opaque_in) {}
+
+	/** Notify of a player action
+	 *  @param player_name The player's name
+	 *  @param action The action the player performed
+	 *  @param bet The bet, if any
+	 *  @param state The full game state
+	 */
+	void playerAction(const utl::string<MAX_NAME_SIZE>& player_name, PokerGameBase::PlayerAction action, uint16_t bet, const BasicPokerGameState<SEATS>& state)
+	{
+		utl::vector<uint8_t, SEATS> revealing_players;
+		this->player_action_callback(player_name, action, bet, state.playerView(0, revealing_players), this->opaque);
+	}
+
+	/** Notify of a subround change
+	 *  @param new_sub_round The new subround
+	 *  @param state The full game state
+	 */
+	void subRoundChange(PokerGameBase::SubRound new_sub_round, const BasicPokerGameState<SEATS>& state)
+	{
+		utl::vector<uint8_t, SEATS> revealing_players;
+		this->subround_change_callback(new_sub_round, state.playerView(0, revealing_players), this->opaque);
+	}
+
+	/** Notify of a round end
+	 *  @param draw True if the round ended in a draw, false otherwise
+	 *  @param winner The round winner
+	 *  @param winnings The pot size won
+	 *  @param ranking The ranking of the winning hand
+	 *  @param state The full game state
+	 *  @param revealing_players A vector of player_ids cooresponding to those that revealed their cards
+	 *  @return True if the game should continue, false otherwise
+	 */
+	bool roundEnd(bool draw, const utl::string<MAX_NAME_SIZE>& winner, uint16_t winnings, RankedHand::Ranking ranking,
+		const BasicPokerGameState<SEATS>& state, const utl::vector<uint8_t, SEATS>& revealing_players)
+	{
+		return this->round_end_callback(draw, winner, winnings, ranking, state.playerView(0, revealing_players), this->opaque);
+	}
+
+	/** Notify of the game end
+	 *  @param winner The game winner
+	 */
+	void gameEnd(const utl::string<MAX_NAME_SIZE>& winner)
+	{
+		this->game_end_callback(winner, this->opaque);
+	}
+
+private:
+
+	/// The player action callback
+	PlayerActionCallback player_action_callback;
+
+	/// The subround change callback
+	SubRoundChangeCallback subround_change_callback;
+
+	/// The round end callback
+	RoundEndCallback round_end_callback;
+
+	/// The game end callback
+	GameEndCallback game_end_callback;
+
+	/// User provided pointer
+	void* opaque;
+};
+
+/** Observer that ignores every event and never ends the game, derive from it to handle only some events
+ */
+class NullObserver
+{
+public:
+
+	/** Ignore a player action
+	 */
+	template <class State>
+	void playerAction(const utl::string<MAX_NAME_SIZE>&, PokerGameBase::PlayerAction, uint16_t, const State&) {}
+
+	/** Ignore a subround change
+	 */
+	template <class State>
+	void subRoundChange(PokerGameBase::SubRound, const State&) {}
+
+	/** Ignore a round end
+	 *  @return Always true, the game continues
+	 */
+	template <class State, class RevealingPlayers>
+	bool roundEnd(bool, const utl::string<MAX_NAME_SIZE>&, uint16_t, RankedHand::Ranking, const State&, const RevealingPlayers&)
+	{
+		return true;
+	}
+
+	/** Ignore the game end
+	 */
+	void gameEnd(const utl::string<MAX_NAME_SIZE>&) {}
+};
+
+/** Observer that forwards each event to two observers, for example to draw the game and record it at once
+ *  @tparam First The first observer, notified first
+ *  @tparam Second The second observer
+ */
+template <class First, class Second>
+class TeeObserver
+{
+public:
+
+	/** Constructor
+	 *  @param first The first observer
+	 *  @param second The second observer
+	 */
+	TeeObserver(const First& first_in, const Second& second_in) : first(first_in), second(second_in) {}
+
+	/** Notify of a player action
+	 *  @param player_name The player's name
+	 *  @param action The action the player performed
+	 *  @param bet The bet, if any
+	 *  @param state The full game state
+	 */
+	template <class State>
+	void playerAction(const utl::string<MAX_NAME_SIZE>& player_name, PokerGameBase::PlayerAction action, uint16_t bet, const State& state)
+	{
+		this->first.playerAction(player_name, action, bet, state);
+		this->second.playerAction(player_name, action, bet, state);
+	}
+
+	/** Notify of a subround change
+	 *  @param new_sub_round The new subround
+	 *  @param state The full game state
+	 */
+	template <class State>
+	void subRoundChange(PokerGameBase::SubRound new_sub_round, const State& state)
+	{
+		this->first.subRoundChange(new_sub_round, state);
+		this->second.subRoundChange(new_sub_round, state);
+	}
+
+	/** Notify of a round end
+	 *  @param draw True if the round ended in a draw, false otherwise
+	 *  @param winner The round winner
+	 *  @param winnings The pot size won
+	 *  @param ranking The ranking of the winning hand
+	 *  @param state The full game state
+	 *  @param revealing_players A vector of player_ids cooresponding to those that revealed their cards
+	 *  @return True if both observers continue the game, false otherwise
+	 */
+	template <class State, class RevealingPlayers>
+	bool roundEnd(bool draw, const utl::string<MAX_NAME_SIZE>& winner, uint16_t winnings, RankedHand::Ranking ranking,
+		const State& state, const RevealingPlayers& revealing_players)
+	{
+		// Notify both observers, even if the first ends the game
+		bool first_continues = this->first.roundEnd(draw, winner, winnings, ranking, state, revealing_players);
+		bool second_continues = this->second.roundEnd(draw, winner, winnings, ranking, state, revealing_players);
+		return first_continues && second_continues;
+	}
+
+	/** Notify of the game end
+	 *  @param winner The game winner
+	 */
+	void gameEnd(const utl::string<MAX_NAME_SIZE>& winner)
+	{
+		this->first.gameEnd(winner);
+		this->second.gameEnd(winner);
+	}
+
+	/// The first observer
+	First first;
+
+	/// The second observer
+	Second second;
+};
+
+/** Dealer that chooses a random first dealer and deals from a shuffled deck
+ */
+class DeckDealer
+{
+public:
+
+	/** Choose the first dealer
+	 *  @param rng A random number generator
+	 *  @param seats The number of seats at the table
+	 *  @return The dealer in the range [0..seats)
+	 */
+	uint8_t chooseDealer(Random& rng, uint8_t seats)
+	{
+		return static_cast<uint8_t>(rng.getRandomNumberInRange(0, seats - 1));
+	}
+
+	/** Shuffle the deck before a round
+	 *  @param deck The deck
+	 */
+	void shuffle(Deck& deck)
+	{
+		deck.shuffle();
+	}
+
+	/** Deal a single card
+	 *  @param deck The deck
+	 *  @return The card
+	 */
+	Card dealCard(Deck& deck)
+	{
+		return deck.dealCard();
+	}
+};
\ No newline at end of file
@@ -18,6 +18,7 @@
 #pragma once
 
 #include <utl/array>
+#include <utl/string>
 #include <utl/vector>
 
 #include "Card.h"
@@ -25,6 +26,26 @@
 /// The maximum allowed name size
 static constexpr size_t MAX_NAME_SIZE = 5;
 
+/// The default number of seats at the table, override with -DTABLE_SEATS=N
+#ifndef TABLE_SEATS
+#define TABLE_SEATS 6
+#endif
+
+/** Selects the smallest unsigned integer with one bit per seat
+ *  @tparam SEATS The number of seats at the table
+ */
+template <uint8_t SEATS, bool FITS_IN_BYTE = (SEATS <= 8)>
+struct SeatMaskType
+{
+    using type = uint8_t;
+};
+
+template <uint8_t SEATS>
+struct SeatMaskType<SEATS, false>
+{
+    using type = uint16_t;
+};
+
 struct PlayerState
 {
     /// Default constructor
@@ -46,10 +67,22 @@ struct PlayerState
     bool folded;
 };
 
-struct PokerGameState
+/** The state of a poker game
+ *  @tparam SEATS_IN The number of seats at the table
+ */
+template <uint8_t SEATS_IN>
+struct BasicPokerGameState
 {
+    static_assert(SEATS_IN >= 2 && SEATS_IN <= 16, "A table seats between 2 and 16 players");
+
+    /// The number of seats at the table
+    static constexpr uint8_t SEATS = SEATS_IN;
+
+    /// A set of seats, bit N represents player N
+    using SeatMask = typename SeatMaskType<SEATS>::type;
+
     /// An array of each player's pot share
-    utl::array<uint16_t, 6> current_pot_shares;
+    utl::array<uint16_t, SEATS> current_pot_shares;
 
     /// The current bet
     uint16_t current_bet{0};
@@ -64,7 +97,113 @@ struct PokerGameState
 	utl::vector<Card, 5> board;
 
     /// An array of all player states
-	utl::array<PlayerState, 6> player_states;
+	utl::array<PlayerState, SEATS> player_states;
+
+    /// Players dealt into the current round, including those that folded or are all in
+    SeatMask seated_mask{0};
+
+    /// Players still contesting the pot
+    SeatMask in_hand_mask{0};
+
+    /// Players that may still make decisions, in hand and not all in
+    SeatMask can_act_mask{0};
+
+    /// Players that are all in
+    SeatMask all_in_mask{0};
+
+    /** Count the seats in a seat mask
+     *  @param mask The seat mask
+     *  @return The number of seats set
+     */
+    static uint8_t countSeats(SeatMask mask)
+    {
+        // Add up bits in pairs, then nibbles, then bytes
+        mask = mask - ((mask >> 1) & 0x5555);
+        mask = (mask & 0x3333) + ((mask >> 2) & 0x3333);
+        mask = (mask + (mask >> 4)) & 0x0F0F;
+        return (mask + (mask >> 8)) & 0x1F;
+    }
+
+    /** Find the lowest seat in a non-empty seat mask
+     *  @param mask The seat mask
+     *  @return The lowest seat set
+     */
+    static uint8_t lowestSeat(SeatMask mask)
+    {
+        // Binary search for the lowest set bit
+        uint8_t seat = 0;
+        if ((mask & 0xFF) == 0) { mask >>= 8; seat += 8; }
+        if ((mask & 0x0F) == 0) { mask >>= 4; seat += 4; }
+        if ((mask & 0x03) == 0) { mask >>= 2; seat += 2; }
+        if ((mask & 0x01) == 0) { seat += 1; }
+        return seat;
+    }
+
+    /** Find the next seat after player_id in a non-empty seat mask, wrapping around the table
+     *  @param mask The seat mask
+     *  @param player_id The seat to start after
+     *  @return The next seat set
+     */
+    static uint8_t nextSeat(SeatMask mask, uint8_t player_id)
+    {
+        // Prefer seats above player_id, otherwise wrap around to the lowest seat
+        SeatMask above = mask & static_cast<SeatMask>(~((2u << player_id) - 1));
+        return lowestSeat(above != 0 ? above : mask);
+    }
+
+    /** Recompute a single player's seat mask bits from his/her player state
+     *  @param player_id The player to update
+     */
+    void updateSeat(uint8_t player_id)
+    {
+        const PlayerState& player_state = this->player_states[player_id];
+        SeatMask bit = static_cast<SeatMask>(1u << player_id);
+
+        // Players with chips in front of them or in the pot are seated
+        bool seated = player_state.stack > 0 || player_state.pot_investment > 0;
+        bool in_hand = seated && player_state.folded == false;
+
+        this->seated_mask = seated ? (this->seated_mask | bit) : (this->seated_mask & ~bit);
+        this->in_hand_mask = in_hand ? (this->in_hand_mask | bit) : (this->in_hand_mask & ~bit);
+        this->can_act_mask = (in_hand && player_state.stack > 0) ? (this->can_act_mask | bit) : (this->can_act_mask & ~bit);
+        this->all_in_mask = (in_hand && player_state.stack == 0) ? (this->all_in_mask | bit) : (this->all_in_mask & ~bit);
+    }
+
+    /** Recompute every player's seat mask bits
+     */
+    void updateSeatMasks()
+    {
+        for (uint8_t player_id = 0; player_id < SEATS; ++player_id)
+            this->updateSeat(player_id);
+    }
+
+    /** Construct the view of this state that a player may see, every other player's hand is unrevealed
+     *  @param player_id The player who will receive this view
+     *  @param revealing_players A vector of player_ids cooresponding to those that revealed their cards
+     *  @return A copy of the state
+     */
+    BasicPokerGameState playerView(uint8_t player_id, const utl::vector<uint8_t, SEATS>& revealing_players) const
+    {
+        BasicPokerGameState state = *this;
+
+        // The player receiving the view is the current player
+        state.current_player = player_id;
+
+        // Initialize each hand as unrevealed
+        for (auto& player_state : state.player_states) {
+            player_state.hand[0] = Card(Card::Value::Unrevealed, Card::Suit::Unrevealed);
+            player_state.hand[1] = Card(Card::Value::Unrevealed, Card::Suit::Unrevealed);
+        }
+
+        // Every player can see their own hand
+        state.player_states[player_id].hand = this->player_states[player_id].hand;
+
+        // Reveal hands indicated in the revealing_players vector
+        for (const auto& revealing_player_id : revealing_players)
+            state.player_states[revealing_player_id].hand = this->player_states[revealing_player_id].hand;
+
+        return state;
+    }
 
     /** Return the number of chips remaining in the pot
      *  @param The number of chips remaining
@@ -92,7 +231,7 @@ struct PokerGameState
         uint16_t result = pot_investment;
 
         // For each player that is not player_id
-        for (size_t i = 0; i < 6; ++i) {
+        for (size_t i = 0; i < SEATS; ++i) {
             if (player_id == i)
                 continue;
 
@@ -110,4 +249,7 @@ struct PokerGameState
 
         return result;
     }
-};
\ No newline at end of file
+};
+
+/// The poker game state for the default table size
+using PokerGameState = BasicPokerGameState<TABLE_SEATS>;
\ No newline at end of file
@@ -0,0 +1,68 @@
+/**
+ *  A simple interactive texas holdem poker program.
+ *  Copyright (C) 2020, Matt Zimmerer, mzimmere@gmail.com
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ **/
+
+#pragma once
+
+#include <utl/array>
+#include <utl/cstdint>
+
+#include "PokerGame/Card.h"
+
+/** PushFold namespace, the heads up push or fold charts that the util's pushfold command solves. With short stacks the
+ *  small blind either pushes all in or folds, and the big blind either calls the push or folds. The charts hold a bit for
+ *  each of the 169 pre-flop hand classes at each effective stack depth in whole big blinds
+ */
+namespace PushFold
+{
+    /// The pre-flop hand classes, 13 pairs, 78 suited and 78 offsuit hands
+    constexpr uint8_t HAND_CLASSES = 169;
+
+    /// The deepest effective stack in big blinds that the charts hold
+    constexpr uint8_t MAX_DEPTH = 25;
+
+    /// The bytes of the chart of a single stack depth, one bit per hand class
+    constexpr uint8_t CHART_BYTES = (HAND_CLASSES + 7) / 8;
+
+    /** Get the class of a hand. Classes are a 13 by 13 grid of the card values, pairs are on the diagonal, suited hands
+     *  have the higher value as the row and offsuit hands have it as the column
+     *  @param hand The hand
+     *  @return The hand class in the range [0..HAND_CLASSES)
+     */
+    uint8_t handClass(const utl::array<Card, 2>& hand);
+
+    /** Get the effective stack depth of a decision
+     *  @param effective_stack The smaller of the two players' stacks at the start of the hand
+     *  @param big_blind The big blind
+     *  @return The depth in whole big blinds, rounded to the nearest and at least 1
+     */
+    uint16_t depth(uint16_t effective_stack, uint16_t big_blind);
+
+    /** Check whether the small blind pushes a hand
+     *  @param hand_class The hand class
+     *  @param depth The effective stack depth in big blinds, in the range [1..MAX_DEPTH]
+     *  @return True to push all in, false to fold
+     */
+    bool push(uint8_t hand_class, uint8_t depth);
+
+    /** Check whether the big blind calls a push with a hand
+     *  @param hand_class The hand class
+     *  @param depth The effective stack depth in big blinds, in the range [1..MAX_DEPTH]
+     *  @return True to call, false to fold
+     */
+    bool call(uint8_t hand_class, uint8_t depth);
+}
\ No newline at end of file
@@ -165,13 +165,12 @@ protected:
 	 */
 	bool isStraight(StraightMap& straight_map);
 
-	/** Check if the hand is a straight flush
+	/** Check if the hand is a straight flush, a straight among the cards of the flush suit
 	 *  @param is_flush A reference to the is_flush pair
-	 *  @param is_straight If true, a straight was detected
-	 *  @param straight_map A reference to the straight map
-	 *  @return True if this hand is a straight, false otherwise
+	 *  @param straight_map A reference to the straight map, replaced by the straight flush cards if one is found
+	 *  @return True if this hand is a straight flush, false otherwise
 	 */
-	bool isStraightFlush(const utl::pair<bool, Card::Suit>& is_flush, bool is_straight, const StraightMap& straight_map);
+	bool isStraightFlush(const utl::pair<bool, Card::Suit>& is_flush, StraightMap& straight_map);
 
 	/** Rank the hand as a royal flush
 	 */
@@ -0,0 +1,105 @@
+/**
+ *  A simple interactive texas holdem poker program.
+ *  Copyright (C) 2020, Matt Zimmerer, mzimmere@gmail.com
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ **/
+
+#pragma once
+
+#include <utl/array>
+#include <utl/cstdint>
+#include <utl/vector>
+
+#include "PokerGame/Card.h"
+#include "PokerGame/Random.h"
+
+/** Strategy namespace, the abstraction of heads up play that the util's trainer solves, and the trained strategy
+ *  tables that the AI plays from when AI_STRATEGY is set. Each street allows a bet and a raise of a fixed size, and
+ *  hands are grouped in a few card buckets on each street
+ */
+namespace Strategy
+{
+    /// The streets, pre-flop, flop, turn and river
+    constexpr uint8_t STREETS = 4;
+
+    /// The positions, the dealer posts the small blind and acts first pre-flop, the big blind acts first after the flop
+    constexpr uint8_t POSITIONS = 2;
+
+    /// The card buckets on each street, from the weakest hands to the strongest
+    constexpr uint8_t BUCKETS = 8;
+
+    /// The betting nodes within a street
+    enum Node : uint8_t {
+        OPEN = 0,
+        CHECKED = 1,
+        FACING_BET = 2,
+        FACING_RAISE = 3,
+        NODES = 4,
+    };
+
+    /// The abstract actions, a check is a call of nothing and a bet is a raise of nothing
+    enum Action : uint8_t {
+        FOLD = 0,
+        CALL = 1,
+        RAISE = 2,
+        ACTIONS = 3,
+    };
+
+    /// The number of information sets, each holds the chance of every action
+    constexpr uint16_t INFORMATION_SETS = static_cast<uint16_t>(STREETS) * POSITIONS * BUCKETS * NODES;
+
+    /** Check whether an action may be taken at a node, there is nothing to fold to before a bet and no raise after a raise
+     *  @param node The betting node
+     *  @param action The action
+     *  @return True if the action is legal
+     */
+    bool isLegal(Node node, Action action);
+
+    /** Get the street of a board
+     *  @param board_size The number of cards on the board
+     *  @return The street in the range [0..STREETS)
+     */
+    uint8_t street(uint8_t board_size);
+
+    /** Group a hand into a card bucket, by its pre-flop strength and after the flop by the equity of its HandBuckets bucket
+     *  @param hand The player's hand
+     *  @param board The board
+     *  @return The card bucket in the range [0..BUCKETS)
+     */
+    uint8_t cardBucket(const utl::array<Card, 2>& hand, const utl::vector<Card, 5>& board);
+
+    /** Get the information set of a decision
+     *  @param street The street
+     *  @param position The position
+     *  @param bucket The card bucket
+     *  @param node The betting node
+     *  @return The information set in the range [0..INFORMATION_SETS)
+     */
+    uint16_t informationSet(uint8_t street, uint8_t position, uint8_t bucket, Node node);
+
+    /** Look up the trained chance of an action
+     *  @param information_set The information set
+     *  @param action The action
+     *  @return The chance in units of 1/255, the legal actions of an information set add up to 255
+     */
+    uint8_t probability(uint16_t information_set, Action action);
+
+    /** Choose an action with the trained chances, information sets that were never trained check or call
+     *  @param information_set The information set
+     *  @param rng A random number generator
+     *  @return The action
+     */
+    Action chooseAction(uint16_t information_set, Random& rng);
+}
\ No newline at end of file
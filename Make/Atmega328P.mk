@@ -12,6 +12,21 @@ CXXFLAGS += -DEMBEDDED_BUILD
 CXXFLAGS += -DPLATFORM_ATMEGA328P
 CXXFLAGS += -DF_CPU=16000000UL
 
+# Play heads up by default to save RAM, build with TABLE_SEATS=6 for a six seat table
+TABLE_SEATS ?= 2
+
+# Look up equity after the flop in the bucket tables, sampling with 64 bit card masks is too slow and too large for the stack here
+AI_EQUITY_BUDGET ?= 0
+
+# The shadow frame takes more RAM than there is to spare, redraw the whole screen on every update
+CONSOLE_SHADOW_FRAME ?= 0
+
+# Write each screen update to the UART in pieces, through a small buffer
+CONSOLE_FRAME_BUFFER ?= 64
+
+# There is no floating point unit, make the AI decide in integer arithmetic
+CXXFLAGS += -DAI_FIXED_POINT
+
 LDFLAGS += -mmcu=atmega328p
 LDFLAGS += -Os
 LDFLAGS += -Wl,--gc-sections
@@ -13,6 +13,7 @@ CXXFLAGS += -flto
 LDFLAGS += -Os
 LDFLAGS += -Wl,--gc-sections
 LDFLAGS += -flto
+LDFLAGS += -pthread
 
 APP_OBJ += $(OBJECTDIR)/Source/Platform/Desktop/DesktopPlatform.o
 APP_OBJ += $(OBJECTDIR)/Source/Platform/Desktop/DesktopSPI.o
@@ -13,6 +13,18 @@ CXXFLAGS += -DPLATFORM_MSP430FR2355
 #CXXFLAGS += -DF_CPU=16000000UL
 CXXFLAGS += -IC:\ti\msp430-gcc\include
 
+# Look up equity after the flop in the bucket tables, sampling with 64 bit card masks is too slow and too large for the stack here
+AI_EQUITY_BUDGET ?= 0
+
+# The shadow frame takes more RAM than there is to spare, redraw the whole screen on every update
+CONSOLE_SHADOW_FRAME ?= 0
+
+# Write each screen update to the UART in pieces, through a small buffer
+CONSOLE_FRAME_BUFFER ?= 128
+
+# There is no floating point unit, make the AI decide in integer arithmetic
+CXXFLAGS += -DAI_FIXED_POINT
+
 LDFLAGS += -mmcu=msp430fr2355
 LDFLAGS += -TC:\ti\msp430-gcc\include\msp430fr2355.ld
 LDFLAGS += -LC:\ti\msp430-gcc\include
@@ -24,6 +24,21 @@ CXXFLAGS += -DPLATFORM_STM32
 
 CXXFLAGS += -I ./STM32
 
+# Sample a few hundred hands per decision after the flop, a few milliseconds at 48MHz
+AI_EQUITY_BUDGET ?= 500
+
+# Remember the equity of the last few dozen situations, in 4 bytes each
+AI_EQUITY_CACHE ?= 64
+
+# The shadow frame takes more RAM than there is to spare in 4KB, redraw the whole screen on every update
+CONSOLE_SHADOW_FRAME ?= 0
+
+# Write each screen update to the UART in pieces, through a small buffer
+CONSOLE_FRAME_BUFFER ?= 256
+
+# The Cortex-M0 has no floating point unit, make the AI decide in integer arithmetic
+CXXFLAGS += -DAI_FIXED_POINT
+
 LDFLAGS += -mcpu=cortex-m0
 LDFLAGS += -mthumb
 LDFLAGS += -Wall
@@ -19,6 +19,7 @@
 #include "Platform/Atmega328p/Atmega328pPlatform.h"
 
 #include <avr/eeprom.h>
+#include <avr/sleep.h>
 #include <util/delay.h>
 
 #include "Platform/Atmega328p/Atmega328pUART.h"
@@ -81,6 +82,26 @@ void PlatformAtmega328p::delayMilliSeconds(uint16_t delay)
 		_delay_ms(1.0);
 }
 
+void PlatformAtmega328p::idle()
+{
+	// Sleep in idle mode, the UART and its interrupts keep running
+	set_sleep_mode(SLEEP_MODE_IDLE);
+
+	// Critical section, a byte that arrives after the check wakes the CPU as it sleeps
+	cli();
+
+	// Sleep only if no byte is waiting, sei takes effect after the next instruction so the sleep can not be missed
+	if (((utl::fifo<char, 8>&)isr_fifo).size() == 0) {
+		sleep_enable();
+		sei();
+		sleep_cpu();
+		sleep_disable();
+	}
+
+	// End critical section
+	sei();
+}
+
 UART PlatformAtmega328p::configureUART(int index, const UART::UARTOptions& options_in)
 {
 	UART result(isr_fifo, options_in);
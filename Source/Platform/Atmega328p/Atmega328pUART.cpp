@@ -34,6 +34,24 @@ ISR(USART_RX_vect)
 	((utl::fifo<char, 8>&)isr_fifo).push(UDR0);
 }
 
+/// Bytes waiting to be sent by the data register empty ISR
+static volatile utl::fifo<char, 32> tx_fifo;
+
+ISR(USART_UDRE_vect)
+{
+	// C-style cast away tx_fifo's volatile keyword, we will manage concurrent access
+
+	// If every byte has been sent, disable this interrupt until more are written
+	if (((utl::fifo<char, 32>&)tx_fifo).size() == 0)
+	{
+		UCSR0B &= ~(1 << UDRIE0);
+		return;
+	}
+
+	// Send the next byte
+	UDR0 = ((utl::fifo<char, 32>&)tx_fifo).pop();
+}
+
 UART::UART() : isr_fifo_internal(nullptr)
 {
 }
@@ -87,12 +105,26 @@ int UART::readChar()
 
 void UART::writeChar(char chr)
 {
-	// While the UART peripheral is busy writing a byte, wait
-	while (!(UCSR0A & (1 << UDRE0)))
-		;
+	// Queue the byte, waiting while the TX fifo is full
+	bool queued = false;
+	while (queued == false)
+	{
+		// Critical section
+		cli();
+
+		// If there is space, queue the byte
+		if (((utl::fifo<char, 32>&)tx_fifo).full() == false)
+		{
+			((utl::fifo<char, 32>&)tx_fifo).push(chr);
+			queued = true;
+		}
+
+		// End critical section
+		sei();
+	}
 
-	// Write the byte
-	UDR0 = chr;
+	// Enable the data register empty interrupt, which sends the queued bytes while the caller carries on
+	UCSR0B |= (1 << UDRIE0);
 }
 
 size_t UART::writeBytes(const char* begin, const char* end)
@@ -45,6 +45,12 @@ void PlatformDesktop::delayMilliSeconds(uint16_t delay)
 	std::this_thread::sleep_for(std::chrono::milliseconds(delay));
 }
 
+void PlatformDesktop::idle()
+{
+	// Idle briefly, the desktop has no interrupt to sleep until
+	this->delayMilliSeconds(10);
+}
+
 UART PlatformDesktop::configureUART(int index, const UART::UARTOptions& options_in)
 {
 	return UART(options_in);
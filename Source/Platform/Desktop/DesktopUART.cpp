@@ -75,8 +75,10 @@ UART& UART::operator=(const UART& other)
 
 size_t UART::writeBytes(const char* begin, const char* end)
 {
-	// Write bytes to cout
-	std::cout << std::string(begin, end);
+	// Write bytes to cout in one piece, without copying them into a string first, and flush them since the console does
+	// not always end a write with a new line
+	std::cout.write(begin, end - begin);
+	std::cout.flush();
 	return end - begin;
 }
 
@@ -58,6 +58,20 @@ void PlatformMSP430FR2355::delayMilliSeconds(uint16_t delay)
     // TODO XXX FIXME
 }
 
+void PlatformMSP430FR2355::idle()
+{
+    // Critical section, a byte that arrives after the check wakes the CPU as it sleeps
+    __disable_interrupt();
+
+    // Sleep in LPM0 only if no byte is waiting, entering LPM0 enables interrupts in the same instruction. The RX
+    // interrupt wakes the CPU
+    if (((utl::fifo<char, 8>&)isr_fifo).size() == 0)
+        __bis_SR_register(LPM0_bits | GIE);
+
+    // End critical section
+    __enable_interrupt();
+}
+
 UART PlatformMSP430FR2355::configureUART(int index, const UART::UARTOptions& options_in)
 {
     UART result(isr_fifo, options_in);
@@ -22,25 +22,66 @@
 
 volatile utl::fifo<char, 8> isr_fifo;
 
+/// Bytes waiting to be sent by the TX interrupt
+static volatile utl::fifo<char, 64> tx_fifo;
+
 void __attribute__((interrupt(USCI_A1_VECTOR))) USCI_A1_ISR(void)
 {
-    // C-style cast away isr_fifo's volatile keyword, we will manage concurrent access
+    // C-style cast away the fifos' volatile keyword, we will manage concurrent access
+    switch (UCA1IV)
+    {
+    case USCI_UART_UCRXIFG:
+
+        // If the isr_fifo is full, throw away a byte to make space
+        if (((utl::fifo<char, 8>&)isr_fifo).full() == true)
+            ((utl::fifo<char, 8>&)isr_fifo).pop();
+
+        // Push a byte from the UART buffer into the ISR fifo
+        ((utl::fifo<char, 8>&)isr_fifo).push(UCA1RXBUF);
+
+        // Wake the CPU if it is idle
+        __bic_SR_register_on_exit(LPM0_bits);
+        break;
+
+    case USCI_UART_UCTXIFG:
 
-    // If the isr_fifo is full, throw away a byte to make space
-    if (((utl::fifo<char, 8>&)isr_fifo).full() == true)
-        ((utl::fifo<char, 8>&)isr_fifo).pop();
+        // If every byte has been sent, disable the TX interrupt until more are written. Reading UCA1IV cleared the
+        // TX flag, set it again so that the interrupt fires as soon as it is enabled
+        if (((utl::fifo<char, 64>&)tx_fifo).size() == 0)
+        {
+            UCA1IE &= ~UCTXIE;
+            UCA1IFG |= UCTXIFG;
+            break;
+        }
+
+        // Send the next byte
+        UCA1TXBUF = ((utl::fifo<char, 64>&)tx_fifo).pop();
+        break;
 
-    // Push a byte from the UART buffer into the ISR fifo
-    ((utl::fifo<char, 8>&)isr_fifo).push(UCA1RXBUF);
+    default:
+        break;
+    }
 }
 
 static void writeChar(char c)
 {
-    // Write the byte
-    UCA1TXBUF = c;
-
-    // Wait for the byte to finish writing
-    while (!(UCA1IFG & UCTXIFG));
+    // Queue the byte, waiting while the TX fifo is full
+    bool queued = false;
+    while (queued == false)
+    {
+        // Critical section
+        UCA1IE &= ~UCTXIE;
+
+        // If there is space, queue the byte
+        if (((utl::fifo<char, 64>&)tx_fifo).full() == false)
+        {
+            ((utl::fifo<char, 64>&)tx_fifo).push(c);
+            queued = true;
+        }
+
+        // End critical section, the TX interrupt sends the queued bytes while the caller carries on
+        UCA1IE |= UCTXIE;
+    }
 }
 
 static int readChar(utl::fifo<char, 8>& isr_fifo)
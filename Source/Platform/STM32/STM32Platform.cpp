@@ -163,6 +163,19 @@ void PlatformSTM32::delayMilliSeconds(uint16_t delay)
     } while (1);
 }
 
+void PlatformSTM32::idle()
+{
+    // Critical section, an interrupt that is raised after the check still wakes the CPU from WFI
+    __disable_irq();
+
+    // Sleep only if no byte is waiting, the RX interrupt or the millisecond timer wakes the CPU
+    if (((utl::fifo<char, 8>&)isr_fifo).size() == 0)
+        __WFI();
+
+    // End critical section, the interrupt that woke the CPU runs now
+    __enable_irq();
+}
+
 UART PlatformSTM32::configureUART(int index, const UART::UARTOptions& options_in)
 {
     UART result(isr_fifo, options_in);
@@ -26,26 +26,56 @@
 
 volatile utl::fifo<char, 8> isr_fifo;
 
+/// Bytes waiting to be sent by the TX empty interrupt
+static volatile utl::fifo<char, 64> tx_fifo;
+
 void USART1_IRQHandler(void)
 {
-    // C-style cast away isr_fifo's volatile keyword, we will manage concurrent access
+    // C-style cast away the fifos' volatile keyword, we will manage concurrent access
 
-    // If the isr_fifo is full, throw away a byte to make space
-    if (((utl::fifo<char, 8>&)isr_fifo).full() == true)
-        ((utl::fifo<char, 8>&)isr_fifo).pop();
+    // If a byte has been received
+    if ((USART1->ISR & USART_ISR_RXNE) != 0)
+    {
+        // If the isr_fifo is full, throw away a byte to make space
+        if (((utl::fifo<char, 8>&)isr_fifo).full() == true)
+            ((utl::fifo<char, 8>&)isr_fifo).pop();
 
-    // Push a byte from the UART buffer into the ISR fifo
-    ((utl::fifo<char, 8>&)isr_fifo).push(USART1->RDR);
+        // Push a byte from the UART buffer into the ISR fifo
+        ((utl::fifo<char, 8>&)isr_fifo).push(USART1->RDR);
+    }
+
+    // If the transmit register is empty and there are bytes waiting to be sent
+    if ((USART1->CR1 & USART_CR1_TXEIE) != 0 && (USART1->ISR & USART_ISR_TXE) != 0)
+    {
+        // Send the next byte, or disable the TX empty interrupt until more are written once every byte has been sent
+        if (((utl::fifo<char, 64>&)tx_fifo).size() > 0)
+            USART1->TDR = ((utl::fifo<char, 64>&)tx_fifo).pop();
+        else
+            USART1->CR1 &= ~USART_CR1_TXEIE;
+    }
 }
 
 static void writeChar(char c)
 {
-    // Write the byte
-    USART1->TDR = static_cast<char>(c);
-
-    // Wait for the byte to finish writing
-    while ((USART1->ISR & USART_ISR_TXE) == 0)
-        ;
+    // Queue the byte, waiting while the TX fifo is full
+    bool queued = false;
+    while (queued == false)
+    {
+        // Critical section
+        NVIC_DisableIRQ(USART1_IRQn);
+
+        // If there is space, queue the byte and enable the TX empty interrupt, which sends the queued bytes while the
+        // caller carries on
+        if (((utl::fifo<char, 64>&)tx_fifo).full() == false)
+        {
+            ((utl::fifo<char, 64>&)tx_fifo).push(c);
+            USART1->CR1 |= USART_CR1_TXEIE;
+            queued = true;
+        }
+
+        // End critical section
+        NVIC_EnableIRQ(USART1_IRQn);
+    }
 }
 
 static int readChar(utl::fifo<char, 8>& isr_fifo)
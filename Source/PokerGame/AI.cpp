@@ -19,6 +19,15 @@
 #include "PokerGame/AI.h"
 
 #include "Platform/Platform.h"
+#include "PokerGame/AIParameters.h"
+#include "PokerGame/EquityCache.h"
+#include "PokerGame/HandBuckets.h"
+#include "PokerGame/HandEvaluator.h"
+#include "PokerGame/MCTS.h"
+#include "PokerGame/OpponentModel.h"
+#include "PokerGame/PokerGame.h"
+#include "PokerGame/PushFold.h"
+#include "PokerGame/Strategy.h"
 
 static const uint8_t hand_strengths[91] ROM_DATA = {
 		0xBD,
@@ -132,7 +141,39 @@ size_t getOffset(Card::Value left_value, Card::Value right_value)
 	return result;
 }
 
-static float handStrength(const utl::array<Card, 2>& hand)
+const AI::Parameters& AI::tunedParameters()
+{
+	return tuned_parameters;
+}
+
+/** Check if a band limit rounds down to the nearest float, so that a float rate of return exactly on it is below it
+ *  @param hundredths The band limit in hundredths
+ *  @return True if the nearest float is below the limit
+ */
+static bool roundsDownToFloat(uint16_t hundredths)
+{
+	if (hundredths == 0)
+		return false;
+
+	// Scale the limit up to a 24 bit float mantissa, the remainder is the part that rounding drops or carries
+	uint8_t shift = 0;
+	while ((static_cast<uint64_t>(hundredths) << shift) / 100 < (1ul << 23))
+		++shift;
+	uint64_t remainder = (static_cast<uint64_t>(hundredths) << shift) % 100;
+	return remainder != 0 && remainder < 50;
+}
+
+uint8_t AI::roundedDownLimits(const utl::array<uint16_t, BANDS - 1>& band_limits)
+{
+	uint8_t result = 0;
+	for (uint8_t band = 0; band < BANDS - 1; ++band) {
+		if (roundsDownToFloat(band_limits[band]))
+			result |= static_cast<uint8_t>(1 << band);
+	}
+	return result;
+}
+
+uint8_t AI::preflopStrength(const utl::array<Card, 2>& hand)
 {
 	// Order the hand values low to high
 	utl::array<Card::Value, 2> ordered_hand_values;
@@ -149,7 +190,84 @@ static float handStrength(const utl::array<Card, 2>& hand)
 	return ACCESS_ROM_DATA(hand_strengths[getOffset(ordered_hand_values[0], ordered_hand_values[1])]);
 }
 
-static float calculatePotOdds(const PokerGameState& state, uint16_t bet)
+template <uint8_t SEATS>
+static uint16_t postflopEquity(const BasicPokerGameState<SEATS>& state, Random& rng, uint8_t player_id)
+{
+	// Estimate the share of the pot against every other player still in the hand, or look it up without a budget
+	uint8_t opponents = static_cast<uint8_t>(BasicPokerGameState<SEATS>::countSeats(state.in_hand_mask) - 1);
+#if AI_EQUITY_BUDGET > 0
+#if AI_EQUITY_CACHE > 0
+
+	// Look up situations that have been judged before
+	uint64_t key = EquityCache::key(state.player_states[player_id].hand, state.board, opponents);
+	uint16_t equity = 0;
+	if (EquityCache::find(key, equity))
+		return equity;
+#else
+	uint16_t equity = 0;
+#endif
+
+	// Judge by effective hand strength over the next card when every opponent holding fits in the budget. Evaluate on
+	// the calling thread, the AI may be one of many players already running on every hardware thread
+	if (HandEvaluator::potentialEvaluations(static_cast<uint8_t>(state.board.size()), 1) <= AI_EQUITY_BUDGET)
+		equity = HandEvaluator::handPotential(state.player_states[player_id].hand, state.board, 1, 1).effective(opponents);
+	else
+		equity = HandEvaluator::handEquity(state.player_states[player_id].hand, state.board, opponents, AI_EQUITY_BUDGET, rng);
+#if AI_EQUITY_CACHE > 0
+	EquityCache::store(key, equity);
+#endif
+	return equity;
+#else
+	(void)rng;
+	return HandBuckets::equity(HandBuckets::bucket(state.player_states[player_id].hand, state.board), opponents);
+#endif
+}
+
+#ifdef AI_FIXED_POINT
+utl::pair<PokerGame::PlayerAction, uint16_t> decide(Random& rng, uint16_t fold, uint16_t call, uint16_t raise)
+{
+	utl::pair<PokerGame::PlayerAction, uint16_t> result;
+
+	// Get a random value, in units of 1/10000
+	int random16 = rng.getRandomNumberInRange(0, 10000);
+
+	// Fold
+	if (random16 < fold) {
+		result.first = PokerGame::PlayerAction::Fold;
+		result.second = 0;
+		return result;
+	}
+
+	// Call
+	if (random16 < fold + call) {
+		result.first = PokerGame::PlayerAction::CheckOrCall;
+		result.second = 0;
+		return result;
+	}
+
+	// Raise
+	result.first = PokerGame::PlayerAction::Bet;
+	result.second = 0;
+	return result;
+}
+
+uint16_t decideBet(Random& rng, uint16_t base, uint16_t max, uint16_t raise)
+{
+	uint16_t result = base;
+
+	// While a random value, in units of 1/10000, is below the raise rate, increase the bet
+	while (rng.getRandomNumberInRange(0, 10000) < raise)
+		result += base;
+
+	// Make sure that the bet does not exceed the AI's max
+	if (result > max)
+		return max;
+	else
+		return result;
+}
+#else
+template <uint8_t SEATS>
+static float calculatePotOdds(const BasicPokerGameState<SEATS>& state, uint16_t bet)
 {
 	uint16_t pot = state.chipsRemaining();
 	return static_cast<float>(bet) / (static_cast<float>(bet) + static_cast<float>(pot));
@@ -208,38 +326,225 @@ uint16_t decideBet(Random& rng, uint16_t base, uint16_t max, float raise)
 	else
 		return result;
 }
+#endif
 
-utl::pair<PokerGame::PlayerAction, uint16_t> AI::computerDecision(const PokerGameState& state, Random& rng, uint8_t player_id)
+uint8_t AI::rateOfReturnBand(float hand_strength, float pot_odds, const Parameters& parameters)
 {
-	// Calculate Pot Odds
-	float pot_odds;
+	// Calculate rate of return, and find the first band limit that it is below
+	float rate_of_return = hand_strength / pot_odds;
+	uint8_t band = 0;
+	while (band < BANDS - 1 && !(rate_of_return < parameters.band_limits[band] / 100.0))
+		++band;
+	return band;
+}
+
+uint8_t AI::fixedRateOfReturnBand(uint16_t strength, uint16_t scale, uint16_t bet, uint16_t pot, const Parameters& parameters)
+{
+	// Without a bet the pot odds are zero, and the rate of return is unbounded
+	if (bet == 0)
+		return BANDS - 1;
+
+	// Rate of return is strength * (bet + pot) / (scale * bet), compare it to hundredths without dividing. Cancel the
+	// hundredths against a scale that they divide, so that both sides fit in 32 bits
+	uint32_t strength_hundredths = strength;
+	uint32_t unit_scale = scale;
+	if (scale % 100 == 0)
+		unit_scale /= 100;
+	else
+		strength_hundredths *= 100;
+
+	// The chips are below 2^17 and the bet below 2^16, so the products fit while the strength is below 2^15 and the
+	// limits below 2^16 units, as they are for every strength and limit that the AI plays by. Past that, drop low bits
+	// of the chips and the bet alike, keeping a bet of at least one
+	uint32_t largest_limit = parameters.band_limits[BANDS - 2] * unit_scale;
+	uint8_t shift = 0;
+	while ((strength_hundredths >> (15 + shift)) != 0 || (largest_limit >> (16 + shift)) != 0)
+		++shift;
+	uint32_t chips = (static_cast<uint32_t>(bet) + pot) >> shift;
+	uint32_t odds_bet = static_cast<uint32_t>(bet) >> shift;
+	if (odds_bet == 0)
+		odds_bet = 1;
+
+	// Find the first band limit that the rate of return is below
+	uint32_t rate_hundredths = strength_hundredths * chips;
+	uint32_t unit = unit_scale * odds_bet;
+	uint8_t band = 0;
+	while (band < BANDS - 1) {
+		uint32_t limit = parameters.band_limits[band] * unit;
+		if (rate_hundredths < limit || (rate_hundredths == limit && (parameters.rounded_down_limits >> band) & 1))
+			break;
+		++band;
+	}
+	return band;
+}
+
+#if AI_STRATEGY
+template <uint8_t SEATS>
+static utl::pair<PokerGame::PlayerAction, uint16_t> strategyDecision(const BasicPokerGameState<SEATS>& state, Random& rng, uint8_t player_id)
+{
+	// The dealer plays the small blind's position, the big blind opens each street after the flop
+	uint8_t street = Strategy::street(static_cast<uint8_t>(state.board.size()));
+	uint8_t position = player_id == state.current_dealer ? 0 : 1;
+	Strategy::Node node = Strategy::CHECKED;
+	if (state.current_bet - state.current_pot_shares[player_id])
+		node = Strategy::FACING_BET;
+	else if (position == 1 && street != 0)
+		node = Strategy::OPEN;
+
+	// Choose an action from the trained chances
+	uint8_t bucket = Strategy::cardBucket(state.player_states[player_id].hand, state.board);
+	Strategy::Action action = Strategy::chooseAction(Strategy::informationSet(street, position, bucket, node), rng);
+	utl::pair<PokerGame::PlayerAction, uint16_t> result;
+	result.second = 0;
+	if (action == Strategy::FOLD) {
+		result.first = PokerGame::PlayerAction::Fold;
+	}
+	else if (action == Strategy::CALL) {
+		result.first = PokerGame::PlayerAction::CheckOrCall;
+	}
+	else {
+		result.first = PokerGame::PlayerAction::Bet;
+		result.second = decideBet(rng, state.current_bet / 2, state.player_states[player_id].stack, 0);
+	}
+	return result;
+}
+#endif
+
+/** Shift the chances of a band of rate of return by the opponents' tendencies, a neutral profile leaves them unchanged
+ *  @param opponents The mean profile of the opponents still in the hand
+ *  @param facing_bet True if there is a bet to call
+ *  @param preflop True before the flop
+ *  @param fold The chance to fold in units of 1/10000, the chance to raise is what the fold and call chances leave
+ *  @param call The chance to call in units of 1/10000
+ */
+static void adjustChances(const SeatProfile& opponents, bool facing_bet, bool preflop, uint16_t& fold, uint16_t& call)
+{
+	// Turn up to half of the calls into raises against opponents that fold to bets, or the raises into calls against
+	// opponents that do not
+	int32_t raise_shift = (static_cast<int32_t>(opponents.fold_to_bet) - SeatProfile::NEUTRAL) * call / 10000;
+	int32_t adjusted_call = static_cast<int32_t>(call) - raise_shift;
+	if (adjusted_call > 10000 - fold)
+		adjusted_call = 10000 - fold;
+	call = static_cast<uint16_t>(adjusted_call);
+
+	// Facing a bet, turn up to half of the folds into calls against loose players pre-flop and aggressive players after
+	// the flop, since their bets are weaker, or calls into folds against tight and passive players
+	if (facing_bet) {
+		int32_t looseness = preflop ? opponents.vpip : opponents.aggression;
+		int32_t fold_shift = (looseness - SeatProfile::NEUTRAL) * fold / 10000;
+		if (fold_shift < -static_cast<int32_t>(call))
+			fold_shift = -static_cast<int32_t>(call);
+		fold = static_cast<uint16_t>(fold - fold_shift);
+		call = static_cast<uint16_t>(call + fold_shift);
+	}
+}
+
+#if AI_PUSH_FOLD_DEPTH > 0
+/** Decide heads up before the flop by the push or fold charts, when the effective stack is short
+ *  @tparam SEATS The number of seats at the table
+ *  @param state The game state
+ *  @param player_id The id of the player that is acting
+ *  @param result Set to the action pair if the charts decide
+ *  @return True if the charts decided, false to decide by the rate of return
+ */
+template <uint8_t SEATS>
+static bool pushFoldDecision(const BasicPokerGameState<SEATS>& state, uint8_t player_id, utl::pair<PokerGame::PlayerAction, uint16_t>& result)
+{
+	// The charts are of heads up play before the flop
+	if (state.board.size() != 0 || BasicPokerGameState<SEATS>::countSeats(state.seated_mask) != 2 ||
+		BasicPokerGameState<SEATS>::countSeats(state.in_hand_mask) != 2)
+		return false;
+
+	// The effective stack is the smaller of the stacks at the start of the hand
+	uint8_t opponent = BasicPokerGameState<SEATS>::nextSeat(state.in_hand_mask, player_id);
+	uint16_t share = state.current_pot_shares[player_id];
+	uint16_t opponent_share = state.current_pot_shares[opponent];
+	uint16_t stack = state.player_states[player_id].stack + share;
+	uint16_t opponent_stack = state.player_states[opponent].stack + opponent_share;
+	uint16_t effective = stack < opponent_stack ? stack : opponent_stack;
+	uint8_t hand_class = PushFold::handClass(state.player_states[player_id].hand);
+
+	// The small blind opens by pushing all in or folding
+	if (share * 2 == state.current_bet && opponent_share == state.current_bet) {
+		uint16_t depth = PushFold::depth(effective, state.current_bet);
+		if (depth > AI_PUSH_FOLD_DEPTH || depth > PushFold::MAX_DEPTH)
+			return false;
+		bool push = PushFold::push(hand_class, static_cast<uint8_t>(depth));
+		result.first = push ? PokerGame::PlayerAction::Bet : PokerGame::PlayerAction::Fold;
+		result.second = push ? state.player_states[player_id].stack : 0;
+		return true;
+	}
+
+	// Facing a push that covers the rest of the stack, call or fold as the big blind does, taking the chips already in
+	// the pot as the big blind
+	if (share > 0 && opponent_share > share && (state.player_states[opponent].stack == 0 || opponent_share >= stack)) {
+		uint16_t depth = PushFold::depth(effective, share);
+		if (depth > AI_PUSH_FOLD_DEPTH || depth > PushFold::MAX_DEPTH)
+			return false;
+		result.first = PushFold::call(hand_class, static_cast<uint8_t>(depth)) ? PokerGame::PlayerAction::CheckOrCall : PokerGame::PlayerAction::Fold;
+		result.second = 0;
+		return true;
+	}
+	return false;
+}
+#endif
+
+/** Decide by the rate of return of the hand, playing each band by its chances
+ *  @tparam SEATS The number of seats at the table
+ *  @param state The game state
+ *  @param rng A random number generator
+ *  @param player_id The id of the player that is acting
+ *  @param equity The post-flop equity of the hand in units of 1/10000, unused pre-flop
+ *  @param opponents The mean profile of the opponents still in the hand, or nullptr to play every opponent alike
+ *  @param parameters The parameters to play by
+ *  @return The action pair, with the first element specifying the action, and the second element specifying the bet, if any
+ */
+template <uint8_t SEATS>
+static utl::pair<PokerGame::PlayerAction, uint16_t> rateOfReturnDecision(const BasicPokerGameState<SEATS>& state, Random& rng, uint8_t player_id,
+	uint16_t equity, const SeatProfile* opponents, const AI::Parameters& parameters)
+{
+#if AI_PUSH_FOLD_DEPTH > 0
+	// With short stacks heads up, push or fold by the charts
+	utl::pair<PokerGame::PlayerAction, uint16_t> push_fold;
+	if (pushFoldDecision(state, player_id, push_fold))
+		return push_fold;
+#endif
+
+	// The pot odds are of the bet to call, or of half the current bet if there is no bet
+	uint16_t odds_bet;
 	if (state.current_bet - state.current_pot_shares[player_id]) {
 
 		// There is a bet
-		pot_odds = calculatePotOdds(state, state.current_bet - state.current_pot_shares[player_id]);
+		odds_bet = state.current_bet - state.current_pot_shares[player_id];
 	}
 	else {
 
 		// There is no bet
-		pot_odds = calculatePotOdds(state, state.current_bet / 2);
+		odds_bet = state.current_bet / 2;
 	}
 
-	// Lookup hand strength
-	float hand_strength = handStrength(state.player_states[player_id].hand);
+	// Find the band of rate of return
+#ifdef AI_FIXED_POINT
+	uint8_t band = state.board.size() >= 3 ? AI::fixedRateOfReturnBand(equity, 10000, odds_bet, state.chipsRemaining(), parameters)
+		: AI::fixedRateOfReturnBand(AI::preflopStrength(state.player_states[player_id].hand), 1, odds_bet, state.chipsRemaining(), parameters);
+#else
+	float pot_odds = calculatePotOdds(state, odds_bet);
+	float hand_strength = state.board.size() >= 3 ? static_cast<float>(equity) / 10000.0f : AI::preflopStrength(state.player_states[player_id].hand);
+	uint8_t band = AI::rateOfReturnBand(hand_strength, pot_odds, parameters);
+#endif
 
-	// Calculate rate of return
-	float rate_of_return = hand_strength / pot_odds;
+	// Adjust the chances to the opponents
+	uint16_t fold = parameters.fold_chances[band];
+	uint16_t call = parameters.call_chances[band];
+	if (opponents != nullptr)
+		adjustChances(*opponents, state.current_bet - state.current_pot_shares[player_id] != 0, state.board.size() == 0, fold, call);
 
 	// Decide
-	utl::pair<PokerGame::PlayerAction, uint16_t> result;
-	if (rate_of_return < 0.8)
-		result = decide(rng, 0.95f, 0.0f, 0.05f);
-	else if (rate_of_return < 1.0)
-		result = decide(rng, 0.80f, 0.05f, 0.15f);
-	else if (rate_of_return < 1.3)
-		result = decide(rng, 0.00f, 0.60f, 0.40f);
-	else
-		result = decide(rng, 0.00f, 0.30f, 0.70f);
+#ifdef AI_FIXED_POINT
+	utl::pair<PokerGame::PlayerAction, uint16_t> result = decide(rng, fold, call, parameters.raise_chances[band]);
+#else
+	utl::pair<PokerGame::PlayerAction, uint16_t> result = decide(rng, fold / 10000.0f, call / 10000.0f, parameters.raise_chances[band] / 10000.0f);
+#endif
 
 	// Do not fold if there is no bet
 	if (state.current_bet - state.current_pot_shares[player_id] == 0) {
@@ -249,15 +554,87 @@ utl::pair<PokerGame::PlayerAction, uint16_t> AI::computerDecision(const PokerGam
 
 	// Determine bet amount
 	if (result.first == PokerGame::PlayerAction::Bet) {
-		if (rate_of_return < 0.8)
-			result.second = decideBet(rng, state.current_bet / 2, state.player_states[player_id].stack, 0.05f);
-		else if (rate_of_return < 1.0)
-			result.second = decideBet(rng, state.current_bet / 2, state.player_states[player_id].stack, 0.15f);
-		else if (rate_of_return < 1.3)
-			result.second = decideBet(rng, state.current_bet / 2, state.player_states[player_id].stack, 0.40f);
-		else
-			result.second = decideBet(rng, state.current_bet / 2, state.player_states[player_id].stack, 0.70f);
+#ifdef AI_FIXED_POINT
+		result.second = decideBet(rng, state.current_bet / 2, state.player_states[player_id].stack, parameters.raise_chances[band]);
+#else
+		result.second = decideBet(rng, state.current_bet / 2, state.player_states[player_id].stack, parameters.raise_chances[band] / 10000.0f);
+#endif
 	}
 
 	return result;
-}
\ No newline at end of file
+}
+
+template <uint8_t SEATS>
+utl::pair<PokerGame::PlayerAction, uint16_t> AI::computerDecision(const BasicPokerGameState<SEATS>& state, Random& rng, uint8_t player_id)
+{
+#if AI_STRATEGY
+	// Play the trained strategy
+	return strategyDecision(state, rng, player_id);
+#elif AI_MCTS
+	// Search for the action that wins the most chips
+	return MCTS::decide(state, player_id, AI_MCTS, AI_MCTS_MILLISECONDS, rng);
+#else
+	// Lookup hand strength pre-flop, after the flop estimate it from the board
+	return rateOfReturnDecision(state, rng, player_id, state.board.size() >= 3 ? postflopEquity(state, rng, player_id) : 0, nullptr, tuned_parameters);
+#endif
+}
+
+template <uint8_t SEATS>
+utl::pair<PokerGame::PlayerAction, uint16_t> AI::computerDecision(const BasicPokerGameState<SEATS>& state, Random& rng, uint8_t player_id,
+	const SeatProfile& opponents)
+{
+#if AI_STRATEGY || AI_MCTS
+	// The trained strategy and the search play every opponent alike
+	(void)opponents;
+	return computerDecision(state, rng, player_id);
+#else
+	// Lookup hand strength pre-flop, after the flop estimate it from the board
+	return rateOfReturnDecision(state, rng, player_id, state.board.size() >= 3 ? postflopEquity(state, rng, player_id) : 0, &opponents, tuned_parameters);
+#endif
+}
+
+template <uint8_t SEATS>
+utl::pair<PokerGame::PlayerAction, uint16_t> AI::quickDecision(const BasicPokerGameState<SEATS>& state, Random& rng, uint8_t player_id)
+{
+	return quickDecision(state, rng, player_id, tuned_parameters);
+}
+
+template <uint8_t SEATS>
+utl::pair<PokerGame::PlayerAction, uint16_t> AI::quickDecision(const BasicPokerGameState<SEATS>& state, Random& rng, uint8_t player_id,
+	const Parameters& parameters)
+{
+	// Lookup hand strength pre-flop, after the flop look it up in the bucket tables
+	uint16_t equity = 0;
+	if (state.board.size() >= 3) {
+		uint8_t opponents = static_cast<uint8_t>(BasicPokerGameState<SEATS>::countSeats(state.in_hand_mask) - 1);
+		equity = HandBuckets::equity(HandBuckets::bucket(state.player_states[player_id].hand, state.board), opponents);
+	}
+	return rateOfReturnDecision(state, rng, player_id, equity, nullptr, parameters);
+}
+
+// Instantiate the supported table sizes
+#ifdef EMBEDDED_BUILD
+template utl::pair<PokerGame::PlayerAction, uint16_t> AI::computerDecision(const BasicPokerGameState<TABLE_SEATS>&, Random&, uint8_t);
+template utl::pair<PokerGame::PlayerAction, uint16_t> AI::computerDecision(const BasicPokerGameState<TABLE_SEATS>&, Random&, uint8_t, const SeatProfile&);
+template utl::pair<PokerGame::PlayerAction, uint16_t> AI::quickDecision(const BasicPokerGameState<TABLE_SEATS>&, Random&, uint8_t);
+template utl::pair<PokerGame::PlayerAction, uint16_t> AI::quickDecision(const BasicPokerGameState<TABLE_SEATS>&, Random&, uint8_t, const AI::Parameters&);
+#else
+template utl::pair<PokerGame::PlayerAction, uint16_t> AI::computerDecision(const BasicPokerGameState<2>&, Random&, uint8_t);
+template utl::pair<PokerGame::PlayerAction, uint16_t> AI::computerDecision(const BasicPokerGameState<2>&, Random&, uint8_t, const SeatProfile&);
+template utl::pair<PokerGame::PlayerAction, uint16_t> AI::quickDecision(const BasicPokerGameState<2>&, Random&, uint8_t);
+template utl::pair<PokerGame::PlayerAction, uint16_t> AI::quickDecision(const BasicPokerGameState<2>&, Random&, uint8_t, const AI::Parameters&);
+template utl::pair<PokerGame::PlayerAction, uint16_t> AI::computerDecision(const BasicPokerGameState<6>&, Random&, uint8_t);
+template utl::pair<PokerGame::PlayerAction, uint16_t> AI::computerDecision(const BasicPokerGameState<6>&, Random&, uint8_t, const SeatProfile&);
+template utl::pair<PokerGame::PlayerAction, uint16_t> AI::quickDecision(const BasicPokerGameState<6>&, Random&, uint8_t);
+template utl::pair<PokerGame::PlayerAction, uint16_t> AI::quickDecision(const BasicPokerGameState<6>&, Random&, uint8_t, const AI::Parameters&);
+template utl::pair<PokerGame::PlayerAction, uint16_t> AI::computerDecision(const BasicPokerGameState<9>&, Random&, uint8_t);
+template utl::pair<PokerGame::PlayerAction, uint16_t> AI::computerDecision(const BasicPokerGameState<9>&, Random&, uint8_t, const SeatProfile&);
+template utl::pair<PokerGame::PlayerAction, uint16_t> AI::quickDecision(const BasicPokerGameState<9>&, Random&, uint8_t);
+template utl::pair<PokerGame::PlayerAction, uint16_t> AI::quickDecision(const BasicPokerGameState<9>&, Random&, uint8_t, const AI::Parameters&);
+#if TABLE_SEATS != 2 && TABLE_SEATS != 6 && TABLE_SEATS != 9
+template utl::pair<PokerGame::PlayerAction, uint16_t> AI::computerDecision(const BasicPokerGameState<TABLE_SEATS>&, Random&, uint8_t);
+template utl::pair<PokerGame::PlayerAction, uint16_t> AI::computerDecision(const BasicPokerGameState<TABLE_SEATS>&, Random&, uint8_t, const SeatProfile&);
+template utl::pair<PokerGame::PlayerAction, uint16_t> AI::quickDecision(const BasicPokerGameState<TABLE_SEATS>&, Random&, uint8_t);
+template utl::pair<PokerGame::PlayerAction, uint16_t> AI::quickDecision(const BasicPokerGameState<TABLE_SEATS>&, Random&, uint8_t, const AI::Parameters&);
+#endif
+#endif
\ No newline at end of file
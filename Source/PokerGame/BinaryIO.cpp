@@ -0,0 +1,526 @@
+/**
+ *  A simple interactive texas holdem poker program.
+ *  Copyright (C) 2020, Matt Zimmerer, mzimmere@gmail.com
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ **/
+#include "PokerGame/BinaryIO.h"
+
+#include <utl/cstdlib>
+
+BinaryIO::BinaryIO(WriteCallback write_callback_in, ReadLineCallback read_line_callback_in, void* opaque_in) : write_callback(write_callback_in),
+	read_line_callback(read_line_callback_in), opaque(opaque_in), encoder(&BinaryIO::writeBytes, this)
+{
+}
+
+utl::pair<PokerGame::PlayerAction, uint16_t> BinaryIO::userDecision(const PokerGameState& state, void* opaque)
+{
+	BinaryIO* self = reinterpret_cast<BinaryIO*>(opaque);
+
+	// Ask the host to prompt the user, unless the prompt is already waiting for input
+	if (self->prompt != Prompt::Action && self->prompt != Prompt::BetAmount)
+	{
+		self->encoder.writeByte(DECISION);
+		self->endFrame();
+		self->prompt = Prompt::Action;
+	}
+
+	do
+	{
+		// Get user input, if there is none yet the decision is pending
+		utl::string<MAX_USER_INPUT_LEN> input;
+		input = self->read_line_callback(self->opaque);
+		if (input.size() == 0)
+			return utl::pair<PokerGame::PlayerAction, uint16_t>(PokerGame::PlayerAction::Pending, 0);
+
+		// If the user is betting, the input is the amount
+		if (self->prompt == Prompt::BetAmount)
+		{
+			self->prompt = Prompt::None;
+			return utl::pair<PokerGame::PlayerAction, uint16_t>(PokerGame::PlayerAction::Bet, static_cast<uint16_t>(strtol(input.c_str(), nullptr, 10)));
+		}
+
+		// If the user entered something invalid, the host asks again
+		char action = input[0];
+		if (action != 'c' && action != 'b' && action != 'f' && action != 'q')
+			continue;
+
+		// If the user is betting, the next line is the amount
+		if (action == 'b')
+		{
+			self->prompt = Prompt::BetAmount;
+			continue;
+		}
+
+		// Translate user inputs into PlayerAction enum class values
+		PokerGame::PlayerAction player_action;
+		if (action == 'c')
+			player_action = PokerGame::PlayerAction::CheckOrCall;
+		else if (action == 'f')
+			player_action = PokerGame::PlayerAction::Fold;
+		else
+			player_action = PokerGame::PlayerAction::Quit;
+
+		self->prompt = Prompt::None;
+		return utl::pair<PokerGame::PlayerAction, uint16_t>(player_action, 0);
+
+	} while (1);
+}
+
+void BinaryIO::playerAction(const utl::string<MAX_NAME_SIZE>& player_name, PokerGame::PlayerAction action, uint16_t bet,
+	const PokerGameState& state, void* opaque)
+{
+	BinaryIO* self = reinterpret_cast<BinaryIO*>(opaque);
+
+	// The first blind of a round starts the hand
+	if (self->in_hand == false)
+	{
+		self->sendTable(state);
+		self->sendHand(state);
+		self->in_hand = true;
+	}
+
+	// Send the action with the chips that it moved
+	uint8_t player_id = BinaryIO::playerID(player_name, state);
+	self->encoder.writeByte(HandHistoryFormat::actionEvent(player_id, action));
+	uint16_t pot_investment = state.player_states[player_id].pot_investment;
+	if (action == PokerGame::PlayerAction::Bet)
+	{
+		self->encoder.writeVarint(bet);
+		self->encoder.writeVarint(pot_investment);
+		self->encoder.writeVarint(state.current_bet - pot_investment);
+	}
+	else if (action == PokerGame::PlayerAction::CheckOrCall)
+	{
+		self->encoder.writeVarint(pot_investment);
+	}
+	self->endFrame();
+}
+
+void BinaryIO::subRoundChange(PokerGame::SubRound new_sub_round, const PokerGameState& state, void* opaque)
+{
+	BinaryIO* self = reinterpret_cast<BinaryIO*>(opaque);
+
+	// Send the cards dealt to the board, the flop deals three and the turn and river one each
+	uint8_t dealt = 0;
+	if (new_sub_round == PokerGame::SubRound::Flop)
+		dealt = 3;
+	else if (new_sub_round != PokerGame::SubRound::PreFlop)
+		dealt = 1;
+	self->encoder.writeByte(STREET | static_cast<uint8_t>(new_sub_round));
+	for (size_t i = state.board.size() - dealt; i < state.board.size(); ++i)
+		self->encoder.writeBits(HandHistoryFormat::cardCode(state.board[i]), HandHistoryFormat::CARD_BITS);
+	self->encoder.alignBits();
+	self->endFrame();
+}
+
+bool BinaryIO::roundEnd(bool draw, const utl::string<MAX_NAME_SIZE>& winner, uint16_t winnings, RankedHand::Ranking ranking,
+	const PokerGameState& state, void* opaque)
+{
+	BinaryIO* self = reinterpret_cast<BinaryIO*>(opaque);
+
+	// Send the result and the stacks it left
+	self->encoder.writeByte(ROUND_END);
+	self->encoder.writeByte(draw ? NO_WINNER : BinaryIO::playerID(winner, state));
+	self->encoder.writeByte(static_cast<uint8_t>(ranking));
+	self->encoder.writeVarint(winnings);
+	self->encoder.writeVarint(state.seated_mask);
+	for (uint8_t player_id = 0; player_id < PokerGameState::SEATS; ++player_id)
+		if (state.seated_mask & (1u << player_id))
+			self->encoder.writeVarint(state.player_states[player_id].stack);
+
+	// Send the hands that were revealed, the user's hand is already known
+	uint16_t revealed_mask = 0;
+	for (uint8_t player_id = 1; player_id < PokerGameState::SEATS; ++player_id)
+		if (state.player_states[player_id].hand[0].getSuit() != Card::Suit::Unrevealed)
+			revealed_mask = static_cast<uint16_t>(revealed_mask | (1u << player_id));
+	self->encoder.writeVarint(revealed_mask);
+	for (uint8_t player_id = 1; player_id < PokerGameState::SEATS; ++player_id) {
+		if (revealed_mask & (1u << player_id)) {
+			self->encoder.writeBits(HandHistoryFormat::cardCode(state.player_states[player_id].hand[0]), HandHistoryFormat::CARD_BITS);
+			self->encoder.writeBits(HandHistoryFormat::cardCode(state.player_states[player_id].hand[1]), HandHistoryFormat::CARD_BITS);
+		}
+	}
+	self->encoder.alignBits();
+	self->endFrame();
+	self->in_hand = false;
+
+	// Ask user to continue or quit
+	self->prompt = Prompt::Continue;
+	PokerGame::PlayerAction action = self->pollContinue();
+
+	// If the user wants to quit, return false
+	if (action == PokerGame::PlayerAction::Quit)
+		return false;
+
+	return true;
+}
+
+void BinaryIO::gameEnd(const utl::string<MAX_NAME_SIZE>& winner, void* opaque)
+{
+	BinaryIO* self = reinterpret_cast<BinaryIO*>(opaque);
+
+	// Send the winner's name, the game has no state left to find the winner's seat in
+	self->encoder.writeByte(GAME_END);
+	self->encoder.writeByte(static_cast<uint8_t>(winner.size()));
+	for (const char c : winner)
+		self->encoder.writeByte(static_cast<uint8_t>(c));
+	self->endFrame();
+}
+
+PokerGame::PlayerAction BinaryIO::pollContinue()
+{
+	// Only the end of a round waits for the user to continue
+	if (this->prompt != Prompt::Continue)
+		return PokerGame::PlayerAction::CheckOrCall;
+
+	do
+	{
+		// Get user input, if there is none yet the prompt is pending
+		utl::string<MAX_USER_INPUT_LEN> input;
+		input = this->read_line_callback(this->opaque);
+		if (input.size() == 0)
+			return PokerGame::PlayerAction::Pending;
+
+		// If the user entered something invalid, the host asks again
+		if (input[0] != 'c' && input[0] != 'q')
+			continue;
+
+		this->prompt = Prompt::None;
+		return input[0] == 'q' ? PokerGame::PlayerAction::Quit : PokerGame::PlayerAction::CheckOrCall;
+
+	} while (1);
+}
+
+void BinaryIO::writeBytes(const uint8_t* data, size_t size, void* opaque)
+{
+	BinaryIO* self = reinterpret_cast<BinaryIO*>(opaque);
+
+	// Escape the bytes that would read as framing, writing them out a chunk at a time
+	char escaped[32];
+	size_t escaped_size = 0;
+	for (size_t i = 0; i < size; ++i) {
+		if (escaped_size + 2 > sizeof(escaped)) {
+			self->write_callback(escaped, escaped + escaped_size, self->opaque);
+			escaped_size = 0;
+		}
+		if (data[i] == FRAME_END) {
+			escaped[escaped_size++] = static_cast<char>(FRAME_ESCAPE);
+			escaped[escaped_size++] = static_cast<char>(ESCAPED_END);
+		}
+		else if (data[i] == FRAME_ESCAPE) {
+			escaped[escaped_size++] = static_cast<char>(FRAME_ESCAPE);
+			escaped[escaped_size++] = static_cast<char>(ESCAPED_ESCAPE);
+		}
+		else {
+			escaped[escaped_size++] = static_cast<char>(data[i]);
+		}
+	}
+
+	// End the frame in the same write as its last bytes
+	if (self->frame_ending == true) {
+		if (escaped_size == sizeof(escaped)) {
+			self->write_callback(escaped, escaped + escaped_size, self->opaque);
+			escaped_size = 0;
+		}
+		escaped[escaped_size++] = static_cast<char>(FRAME_END);
+		self->frame_ending = false;
+	}
+	self->write_callback(escaped, escaped + escaped_size, self->opaque);
+}
+
+void BinaryIO::endFrame()
+{
+	this->frame_ending = true;
+	this->encoder.flush();
+
+	// The frame's bytes were all written as the encoder filled, write the frame end alone
+	if (this->frame_ending == true) {
+		const char frame_end = static_cast<char>(FRAME_END);
+		this->write_callback(&frame_end, &frame_end + 1, this->opaque);
+		this->frame_ending = false;
+	}
+}
+
+void BinaryIO::sendTable(const PokerGameState& state)
+{
+	// The names do not change during the game
+	if (this->table_sent == true)
+		return;
+
+	this->encoder.writeByte(TABLE);
+	this->encoder.writeByte(PokerGameState::SEATS);
+	for (const auto& player_state : state.player_states) {
+		this->encoder.writeByte(static_cast<uint8_t>(player_state.name.size()));
+		for (const char c : player_state.name)
+			this->encoder.writeByte(static_cast<uint8_t>(c));
+		this->encoder.writeVarint(player_state.stack + player_state.pot_investment);
+	}
+	this->endFrame();
+	this->table_sent = true;
+}
+
+void BinaryIO::sendHand(const PokerGameState& state)
+{
+	// The stacks are those that the table frame or the last round end sent
+	this->encoder.writeByte(HAND);
+	this->encoder.writeByte(state.current_dealer);
+
+	// Send the user's hole cards, if the user was dealt in
+	if (state.seated_mask & 1u) {
+		this->encoder.writeBits(HandHistoryFormat::cardCode(state.player_states[0].hand[0]), HandHistoryFormat::CARD_BITS);
+		this->encoder.writeBits(HandHistoryFormat::cardCode(state.player_states[0].hand[1]), HandHistoryFormat::CARD_BITS);
+	}
+	this->encoder.alignBits();
+	this->endFrame();
+}
+
+uint8_t BinaryIO::playerID(const utl::string<MAX_NAME_SIZE>& player_name, const PokerGameState& state)
+{
+	for (uint8_t player_id = 0; player_id < PokerGameState::SEATS; ++player_id)
+		if (state.player_states[player_id].name == player_name)
+			return player_id;
+	return NO_WINNER;
+}
+
+BinaryIODecoder::BinaryIODecoder(PokerGame::DecisionCallback decision_callback_in, PokerGame::PlayerActionCallback player_action_callback_in,
+	PokerGame::SubRoundChangeCallback subround_change_callback_in, PokerGame::RoundEndCallback round_end_callback_in,
+	PokerGame::GameEndCallback game_end_callback_in, void* opaque_in) : decision_callback(decision_callback_in),
+	player_action_callback(player_action_callback_in), subround_change_callback(subround_change_callback_in),
+	round_end_callback(round_end_callback_in), game_end_callback(game_end_callback_in), opaque(opaque_in)
+{
+}
+
+void BinaryIODecoder::feed(const uint8_t* data, size_t size)
+{
+	for (size_t i = 0; i < size; ++i)
+	{
+		uint8_t byte = data[i];
+
+		// Decode the frame once its end has arrived, and start the next one whether or not it could be
+		if (byte == BinaryIO::FRAME_END)
+		{
+			if (this->frame_dropped == false && this->frame.size() > 0)
+				this->decodeFrame();
+			this->frame.clear();
+			this->escaping = false;
+			this->frame_dropped = false;
+			continue;
+		}
+
+		// Unescape the bytes that would read as framing
+		if (this->escaping == true)
+		{
+			this->escaping = false;
+			if (byte == BinaryIO::ESCAPED_END)
+				byte = BinaryIO::FRAME_END;
+			else if (byte == BinaryIO::ESCAPED_ESCAPE)
+				byte = BinaryIO::FRAME_ESCAPE;
+			else
+				this->frame_dropped = true;
+		}
+		else if (byte == BinaryIO::FRAME_ESCAPE)
+		{
+			this->escaping = true;
+			continue;
+		}
+
+		// A frame can not be longer than the longest frame, drop one that is
+		if (this->frame.size() == BinaryIO::MAX_FRAME_SIZE)
+			this->frame_dropped = true;
+		if (this->frame_dropped == false)
+			this->frame.push_back(byte);
+	}
+}
+
+void BinaryIODecoder::poll()
+{
+	// Ask again until the user has decided
+	if (this->decision_pending == false)
+		return;
+	utl::pair<PokerGame::PlayerAction, uint16_t> decision = this->decision_callback(this->state, this->opaque);
+	if (decision.first != PokerGame::PlayerAction::Pending)
+		this->decision_pending = false;
+}
+
+bool BinaryIODecoder::isGameOver() const
+{
+	return this->game_over;
+}
+
+const PokerGameState& BinaryIODecoder::getState() const
+{
+	return this->state;
+}
+
+void BinaryIODecoder::decodeFrame()
+{
+	// Decode into a copy of the state, which is kept only if the whole frame decodes
+	HandHistoryReader reader(this->frame.begin(), this->frame.size());
+	PokerGameState next = this->state;
+	uint8_t type = reader.readByte();
+	uint8_t player_id = type >> 2;
+	PokerGame::PlayerAction action = static_cast<PokerGame::PlayerAction>((type & 0x03) + 1);
+	uint16_t bet = 0;
+	uint8_t winner = BinaryIO::NO_WINNER;
+	RankedHand::Ranking ranking = RankedHand::Ranking::Unranked;
+	uint16_t winnings = 0;
+	utl::string<MAX_NAME_SIZE> winner_name;
+
+	if (type < BinaryIO::STREET)
+	{
+		// Drop actions of seats that this table size does not have
+		if (player_id >= PokerGameState::SEATS)
+			return;
+
+		if (action == PokerGame::PlayerAction::Bet) {
+			bet = static_cast<uint16_t>(reader.readVarint());
+			BinaryIODecoder::moveToPot(next, player_id, static_cast<uint16_t>(reader.readVarint()));
+			next.current_bet = static_cast<uint16_t>(next.player_states[player_id].pot_investment + reader.readVarint());
+		}
+		else if (action == PokerGame::PlayerAction::CheckOrCall) {
+			bet = BinaryIODecoder::moveToPot(next, player_id, static_cast<uint16_t>(reader.readVarint()));
+		}
+		else if (action == PokerGame::PlayerAction::Fold) {
+			next.player_states[player_id].folded = true;
+			next.updateSeat(player_id);
+		}
+	}
+	else if (type < BinaryIO::TABLE)
+	{
+		// The pre-flop clears the board of the last round, the flop deals three cards and the turn and river one each
+		PokerGame::SubRound sub_round = static_cast<PokerGame::SubRound>(type & 0x3F);
+		uint8_t dealt = 1;
+		if (sub_round == PokerGame::SubRound::PreFlop) {
+			next.board.clear();
+			dealt = 0;
+		}
+		else if (sub_round == PokerGame::SubRound::Flop) {
+			dealt = 3;
+		}
+		for (uint8_t i = 0; i < dealt && next.board.size() < 5; ++i)
+			next.board.push_back(HandHistoryFormat::codeCard(reader.readBits(HandHistoryFormat::CARD_BITS)));
+	}
+	else if (type == BinaryIO::TABLE)
+	{
+		// Read every player, keeping those of the seats that this table size has
+		uint8_t seats = reader.readByte();
+		for (uint8_t seat = 0; seat < seats; ++seat) {
+			utl::string<MAX_NAME_SIZE> name = BinaryIODecoder::readName(reader);
+			uint16_t stack = static_cast<uint16_t>(reader.readVarint());
+			if (seat < PokerGameState::SEATS) {
+				next.player_states[seat].name = name;
+				next.player_states[seat].stack = stack;
+			}
+		}
+	}
+	else if (type == BinaryIO::HAND)
+	{
+		// Start the round with every other hand hidden, the pot was cleared by the last round end
+		next.current_dealer = reader.readByte();
+		for (auto& player_state : next.player_states) {
+			player_state.hand[0] = Card(Card::Value::Unrevealed, Card::Suit::Unrevealed);
+			player_state.hand[1] = Card(Card::Value::Unrevealed, Card::Suit::Unrevealed);
+		}
+		if (next.player_states[0].stack > 0)
+			BinaryIODecoder::readHand(reader, next.player_states[0]);
+		next.updateSeatMasks();
+	}
+	else if (type == BinaryIO::ROUND_END)
+	{
+		// Clear the pot, as the game does before it reports the end of the round
+		winner = reader.readByte();
+		ranking = static_cast<RankedHand::Ranking>(reader.readByte());
+		winnings = static_cast<uint16_t>(reader.readVarint());
+		uint16_t seated_mask = static_cast<uint16_t>(reader.readVarint());
+		next.current_bet = 0;
+		for (uint8_t seat = 0; seat < PokerGameState::SEATS; ++seat) {
+			PlayerState& player_state = next.player_states[seat];
+			player_state.stack = (seated_mask & (1u << seat)) ? static_cast<uint16_t>(reader.readVarint()) : 0;
+			player_state.pot_investment = 0;
+			player_state.folded = false;
+			next.current_pot_shares[seat] = 0;
+		}
+
+		// Reveal the hands that were shown
+		uint16_t revealed_mask = static_cast<uint16_t>(reader.readVarint());
+		for (uint8_t seat = 0; seat < PokerGameState::SEATS; ++seat)
+			if (revealed_mask & (1u << seat))
+				BinaryIODecoder::readHand(reader, next.player_states[seat]);
+		next.updateSeatMasks();
+	}
+	else if (type == BinaryIO::GAME_END)
+	{
+		winner_name = BinaryIODecoder::readName(reader);
+	}
+	else if (type != BinaryIO::DECISION)
+	{
+		// Drop a frame that can not be decoded
+		return;
+	}
+
+	// Drop a frame that is cut short or runs on, it lost bytes on the link
+	if (reader.isTruncated() == true || reader.getOffset() != this->frame.size())
+		return;
+	this->state = next;
+
+	// Pass the event on
+	if (winner < PokerGameState::SEATS)
+		winner_name = this->state.player_states[winner].name;
+	if (type < BinaryIO::STREET)
+		this->player_action_callback(this->state.player_states[player_id].name, action, bet, this->state, this->opaque);
+	else if (type < BinaryIO::TABLE)
+		this->subround_change_callback(static_cast<PokerGame::SubRound>(type & 0x3F), this->state, this->opaque);
+	else if (type == BinaryIO::ROUND_END)
+		this->round_end_callback(winner == BinaryIO::NO_WINNER, winner_name, winnings, ranking, this->state, this->opaque);
+	else if (type == BinaryIO::GAME_END) {
+		this->game_over = true;
+		this->game_end_callback(winner_name, this->opaque);
+	}
+	else if (type == BinaryIO::DECISION) {
+		this->decision_pending = true;
+		this->poll();
+	}
+}
+
+utl::string<MAX_NAME_SIZE> BinaryIODecoder::readName(HandHistoryReader& reader)
+{
+	// Keep as much of the name as fits
+	utl::string<MAX_NAME_SIZE> name;
+	uint8_t size = reader.readByte();
+	for (uint8_t i = 0; i < size; ++i) {
+		char c = static_cast<char>(reader.readByte());
+		if (i < MAX_NAME_SIZE) {
+			name.resize(i + 1);
+			name[i] = c;
+		}
+	}
+	return name;
+}
+
+void BinaryIODecoder::readHand(HandHistoryReader& reader, PlayerState& player_state)
+{
+	player_state.hand[0] = HandHistoryFormat::codeCard(reader.readBits(HandHistoryFormat::CARD_BITS));
+	player_state.hand[1] = HandHistoryFormat::codeCard(reader.readBits(HandHistoryFormat::CARD_BITS));
+}
+
+uint16_t BinaryIODecoder::moveToPot(PokerGameState& next, uint8_t player_id, uint16_t pot_investment)
+{
+	uint16_t chips = static_cast<uint16_t>(pot_investment - next.player_states[player_id].pot_investment);
+	next.player_states[player_id].stack -= chips;
+	next.player_states[player_id].pot_investment = pot_investment;
+	next.current_pot_shares[player_id] += chips;
+	next.updateSeat(player_id);
+	return chips;
+}
\ No newline at end of file
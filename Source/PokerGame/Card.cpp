@@ -33,12 +33,6 @@ Card::Card(Value value_in, Suit suit_in)
     this->value_and_suit |= static_cast<uint8_t>(value_in);
 }
 
-Card& Card::operator=(const Card& other)
-{
-	this->value_and_suit = other.value_and_suit;
-	return *this;
-}
-
 Card::Value Card::getValue() const
 {
 	return static_cast<Card::Value>(this->value_and_suit & VALUE_BIT_MASK);
@@ -23,7 +23,7 @@
 
 #include "Platform/Platform.h"
 
-ConsoleIO::ConsoleIO(WriteLineCallback write_line_callback_in, ReadLineCallback read_line_callback_in, DelayCallback delay_callback_in, void* opaque_in) : write_line_callback(write_line_callback_in), read_line_callback(read_line_callback_in), delay_callback(delay_callback_in), opaque(opaque_in)
+ConsoleIO::ConsoleIO(WriteCallback write_callback_in, ReadLineCallback read_line_callback_in, DelayCallback delay_callback_in, void* opaque_in) : write_callback(write_callback_in), read_line_callback(read_line_callback_in), delay_callback(delay_callback_in), opaque(opaque_in)
 {
 }
 
@@ -31,9 +31,6 @@ utl::pair<PokerGame::PlayerAction, uint16_t> ConsoleIO::userDecision(const Poker
 {
 	ConsoleIO* self = reinterpret_cast<ConsoleIO*>(opaque);
 
-	// Copy the state
-	self->cached_state = state;
-
 	// Switch the text 'Check' with 'Call' depending on whether or not there is a bet
 	utl::string<8> checkorcall;
 	if (state.current_bet > 0)
@@ -41,68 +38,69 @@ utl::pair<PokerGame::PlayerAction, uint16_t> ConsoleIO::userDecision(const Poker
 	else
 		checkorcall = ACCESS_ROM_STR(32, "Check");
 
-	// Update the screen
+	// Ask the user what action to perform, unless the prompt is already waiting for input
+	if (self->prompt != Prompt::Action && self->prompt != Prompt::BetAmount)
 	{
+		// Copy the state
+		self->cached_state = state;
+
+		// Update the screen
 		utl::string<64> hint_text = checkorcall;
 		hint_text += ACCESS_ROM_STR(64, "(c), bet(b), fold(f), or quit(q)?");
 		self->updateScreen<64>(hint_text);
+		self->prompt = Prompt::Action;
 	}
 
-	// Ask user what action to perform
-	char action;
 	do
 	{
-		// Get user input
+		// Get user input, if there is none yet the decision is pending
 		utl::string<MAX_USER_INPUT_LEN> input;
 		input = self->read_line_callback(self->opaque);
-		action = ConsoleIO::userInputToChar(input);
+		if (input.size() == 0)
+			return utl::pair<PokerGame::PlayerAction, uint16_t>(PokerGame::PlayerAction::Pending, 0);
+
+		// If the user is betting, the input is the amount
+		if (self->prompt == Prompt::BetAmount)
+		{
+			// Return a pair with the action and bet amount
+			self->prompt = Prompt::None;
+			return utl::pair<PokerGame::PlayerAction, uint16_t>(PokerGame::PlayerAction::Bet, ConsoleIO::userInputToInt(input));
+		}
 
 		// If the user entered something invalid, ask again
+		char action = ConsoleIO::userInputToChar(input);
 		if (action != 'c' && action != 'b' && action != 'f' && action != 'q')
 		{
 			utl::string<64> hint_text = ACCESS_ROM_STR(32, "Invalid entry. ");
 			hint_text += checkorcall;
 			hint_text += ACCESS_ROM_STR(64, "(c), bet(b), fold(f) or quit(q)?");
 			self->updateScreen<64>(hint_text);
+			continue;
 		}
-		else
+
+		// If the user is betting, ask for an amount
+		if (action == 'b')
 		{
-			break;
+			// Update the screen
+			utl::string<64> hint_text = ACCESS_ROM_STR(64, "Enter an amount to bet.");
+			self->updateScreen<64>(hint_text);
+			self->prompt = Prompt::BetAmount;
+			continue;
 		}
 
-	} while (1);
-
-	// If the user is betting, ask for an amount
-	int bet_amt = 0;
-	if (action == 'b')
-	{
-		// Update the screen
-		utl::string<64> hint_text = ACCESS_ROM_STR(64, "Enter an amount to bet.");
-		self->updateScreen<64>(hint_text);
-
-		// Get user input
-		utl::string<MAX_USER_INPUT_LEN> input;
-		input = self->read_line_callback(self->opaque);
-		bet_amt = ConsoleIO::userInputToInt(input);
-
-		// Return a pair with the action and bet amount
-		return utl::pair<PokerGame::PlayerAction, uint16_t>(PokerGame::PlayerAction::Bet, bet_amt);
-	}
-
-	// Translate user inputs into PlayerAction enum class values
-	PokerGame::PlayerAction player_action = static_cast<PokerGame::PlayerAction>(action);
-	if (action == 'c')
-		player_action = PokerGame::PlayerAction::CheckOrCall;
-	else if (action == 'b')
-		player_action = PokerGame::PlayerAction::Bet;
-	else if (action == 'f')
-		player_action = PokerGame::PlayerAction::Fold;
-	else
-		player_action = PokerGame::PlayerAction::Quit;
+		// Translate user inputs into PlayerAction enum class values
+		PokerGame::PlayerAction player_action;
+		if (action == 'c')
+			player_action = PokerGame::PlayerAction::CheckOrCall;
+		else if (action == 'f')
+			player_action = PokerGame::PlayerAction::Fold;
+		else
+			player_action = PokerGame::PlayerAction::Quit;
 
-	utl::pair<PokerGame::PlayerAction, uint16_t> result(player_action, bet_amt);
+		self->prompt = Prompt::None;
+		return utl::pair<PokerGame::PlayerAction, uint16_t>(player_action, 0);
 
-	return result;
+	} while (1);
 }
 
 void ConsoleIO::playerAction(const utl::string<MAX_NAME_SIZE>& player_name, PokerGame::PlayerAction action, uint16_t bet,
@@ -121,9 +119,8 @@ void ConsoleIO::playerAction(const utl::string<MAX_NAME_SIZE>& player_name, Poke
 	// Copy the state
 	self->cached_state = state;
 
-	// Update the screen
-	utl::string<32> hint_text = ACCESS_ROM_STR(32, "");
-	self->updateScreen<32>(hint_text);
+	// Update the screen, unless the event can be drawn with the next few
+	self->coalesceUpdate();
 }
 
 void ConsoleIO::subRoundChange(PokerGame::SubRound new_sub_round, const PokerGameState& state, void* opaque)
@@ -139,9 +136,8 @@ void ConsoleIO::subRoundChange(PokerGame::SubRound new_sub_round, const PokerGam
 	// Copy the state
 	self->cached_state = state;
 
-	// Update the screen
-	utl::string<32> hint_text = ACCESS_ROM_STR(32, "");
-	self->updateScreen<32>(hint_text);
+	// Update the screen, unless the event can be drawn with the next few
+	self->coalesceUpdate();
 }
 
 bool ConsoleIO::roundEnd(bool draw, const utl::string<MAX_NAME_SIZE>& winner, uint16_t winnings, RankedHand::Ranking ranking,
@@ -166,29 +162,11 @@ bool ConsoleIO::roundEnd(bool draw, const utl::string<MAX_NAME_SIZE>& winner, ui
 	}
 
 	// Ask user to continue or quit
-	char action;
-	do
-	{
-		// Get user input
-		utl::string<MAX_USER_INPUT_LEN> input;
-		input = self->read_line_callback(self->opaque);
-		action = ConsoleIO::userInputToChar(input);
-
-		// If the user entered something invalid, ask again
-		if (action != 'c' && action != 'q')
-		{
-			utl::string<64> hint_text = ACCESS_ROM_STR(64, "Invalid entry.Continue(c) or quit(q) ? ? ");
-			self->updateScreen<64>(hint_text);
-		}
-		else
-		{
-			break;
-		}
-
-	} while (1);
+	self->prompt = Prompt::Continue;
+	PokerGame::PlayerAction action = self->pollContinue();
 
 	// If the user wants to quit, return false
-	if (action == 'q')
+	if (action == PokerGame::PlayerAction::Quit)
 		return false;
 
 	return true;
@@ -200,12 +178,43 @@ void ConsoleIO::gameEnd(const utl::string<MAX_NAME_SIZE>& winner, void* opaque)
 
 	// Correct for grammer
 	if (winner == ACCESS_ROM_STR(32, "You"))
-		self->write_line_callback(ACCESS_ROM_STR(32, "You win!"), self->opaque);
+		self->writeLine(ACCESS_ROM_STR(32, "You win!"));
 	else
-		self->write_line_callback(ACCESS_ROM_STR(32, "Computer wins!"), self->opaque);
+		self->writeLine(ACCESS_ROM_STR(32, "Computer wins!"));
+	self->frame_valid = false;
 
 	// Final message
-	self->write_line_callback(ACCESS_ROM_STR(32, "Thanks for playing!"), self->opaque);
+	self->writeLine(ACCESS_ROM_STR(32, "Thanks for playing!"));
+	self->flush();
+}
+
+PokerGame::PlayerAction ConsoleIO::pollContinue()
+{
+	// Only the end of a round waits for the user to continue
+	if (this->prompt != Prompt::Continue)
+		return PokerGame::PlayerAction::CheckOrCall;
+
+	do
+	{
+		// Get user input, if there is none yet the prompt is pending
+		utl::string<MAX_USER_INPUT_LEN> input;
+		input = this->read_line_callback(this->opaque);
+		if (input.size() == 0)
+			return PokerGame::PlayerAction::Pending;
+
+		// If the user entered something invalid, ask again
+		char action = ConsoleIO::userInputToChar(input);
+		if (action != 'c' && action != 'q')
+		{
+			utl::string<64> hint_text = ACCESS_ROM_STR(64, "Invalid entry.Continue(c) or quit(q) ? ? ");
+			this->updateScreen<64>(hint_text);
+			continue;
+		}
+
+		this->prompt = Prompt::None;
+		return action == 'q' ? PokerGame::PlayerAction::Quit : PokerGame::PlayerAction::CheckOrCall;
+
+	} while (1);
 }
 
 char ConsoleIO::userInputToChar(const utl::string<MAX_USER_INPUT_LEN>& input)
@@ -289,8 +298,9 @@ utl::string<ConsoleIO::MAX_EVENT_STRING_LEN> ConsoleIO::actionToString(const utl
 		}
 		break;
 
-		// Quit
+		// Quit, or no action yet
 	case PokerGame::PlayerAction::Quit:
+	case PokerGame::PlayerAction::Pending:
 		return ACCESS_ROM_STR(32, "");
 	}
 
@@ -476,6 +486,10 @@ void ConsoleIO::printCard(utl::string<WIDTH>& dst, size_t x, const Card& card)
 
 void ConsoleIO::printHand(utl::string<WIDTH>& dst, size_t x, size_t player_id)
 {
+	// Skip seats that this table size does not have
+	if (player_id >= PokerGameState::SEATS)
+		return;
+
 	// Dont print anything if a player has folded
 	if (this->cached_state.player_states[player_id].folded == true)
 		return;
@@ -491,6 +505,10 @@ void ConsoleIO::printHand(utl::string<WIDTH>& dst, size_t x, size_t player_id)
 
 void ConsoleIO::printName(utl::string<WIDTH>& dst, size_t x, size_t player_id)
 {
+	// Skip seats that this table size does not have
+	if (player_id >= PokerGameState::SEATS)
+		return;
+
 	// If the player has no chips, dont print his/her name
 	if (this->cached_state.player_states[player_id].stack == 0 && this->cached_state.player_states[player_id].pot_investment == 0)
 		return;
@@ -504,6 +522,10 @@ void ConsoleIO::printName(utl::string<WIDTH>& dst, size_t x, size_t player_id)
 
 void ConsoleIO::printChipStackCount(utl::string<WIDTH>& dst, size_t x, size_t player_id)
 {
+	// Skip seats that this table size does not have
+	if (player_id >= PokerGameState::SEATS)
+		return;
+
 	// If the player has no chips, dont print the chip count
 	if (this->cached_state.player_states[player_id].stack == 0 && this->cached_state.player_states[player_id].pot_investment == 0)
 		return;
@@ -533,11 +555,116 @@ void ConsoleIO::printToCall(utl::string<WIDTH>& dst, size_t x)
 	ConsoleIO::lineBufferCopy(dst, count_string.begin(), count_string.end(), x);
 }
 
-void ConsoleIO::clearTerminal(utl::string<WIDTH>& line_buffer)
+void ConsoleIO::clearTerminal()
+{
+#if CONSOLE_SHADOW_FRAME
+	// If the terminal still shows the last frame drawn, only the cells that changed need to be written
+	if (this->frame_valid == true)
+		return;
+
+	// Every cell of a cleared terminal is blank
+	for (auto& row : this->shadow_frame)
+		utl::fill(row.begin(), row.end(), ' ');
+#endif
+
+	// Write the clear screen string to the frame buffer
+	this->frame_buffer += ACCESS_ROM_STR(8, "\033[2J");
+}
+
+void ConsoleIO::drawLine(uint8_t row, const utl::string<WIDTH>& line_buffer)
+{
+	// Pad the line with blank cells
+	utl::array<char, WIDTH> line;
+	utl::fill(line.begin(), line.end(), ' ');
+	for (size_t i = 0; i < line_buffer.size(); ++i)
+		line[i] = line_buffer[i];
+
+	// Compare against the last frame drawn, or against the blank cells of a cleared terminal
+#if CONSOLE_SHADOW_FRAME
+	utl::array<char, WIDTH>& previous = this->shadow_frame[row];
+#else
+	utl::array<char, WIDTH> previous;
+	utl::fill(previous.begin(), previous.end(), ' ');
+#endif
+
+	size_t x = 0;
+	while (x < WIDTH)
+	{
+		// Skip cells that are unchanged
+		if (line[x] == previous[x])
+		{
+			++x;
+			continue;
+		}
+
+		// Extend the run of changed cells over unchanged cells, until the cursor is worth moving over them
+		size_t run_end = x + 1;
+		for (size_t i = run_end; i < WIDTH && i - run_end < MIN_SKIP_LEN; ++i)
+		{
+			if (line[i] != previous[i])
+				run_end = i + 1;
+		}
+
+		// Write the run
+		this->writeRun(row, x, line.begin() + x, line.begin() + run_end);
+		x = run_end;
+	}
+
+#if CONSOLE_SHADOW_FRAME
+	// Remember the line as it is drawn now
+	previous = line;
+#endif
+}
+
+void ConsoleIO::writeRun(uint8_t row, size_t x, const char* begin, const char* end)
 {
-	// Write the clear screan string to the console
-	line_buffer = ACCESS_ROM_STR(32, "\033[2J\033[1;1H");
-	this->write_line_callback(line_buffer, this->opaque);
+	while (begin != end)
+	{
+		// Move the cursor to the rest of the run
+		this->moveCursor(row, x);
+
+		// Copy as much of the run as fits in the frame buffer
+		size_t size = this->frame_buffer.size();
+		size_t count = CONSOLE_FRAME_BUFFER - size;
+		if (count > static_cast<size_t>(end - begin))
+			count = end - begin;
+		this->frame_buffer.resize(size + count);
+		for (size_t i = 0; i < count; ++i)
+			this->frame_buffer[size + i] = *begin++;
+		x += count;
+	}
+}
+
+void ConsoleIO::moveCursor(uint8_t row, size_t x)
+{
+	// Flush the frame buffer, unless the longest sequence and a few cells still fit
+	if (this->frame_buffer.size() + MAX_CURSOR_LEN + 4 > CONSOLE_FRAME_BUFFER)
+		this->flush();
+
+	// Append the 1 based row and column
+	this->frame_buffer += ACCESS_ROM_STR(8, "\033[");
+	this->frame_buffer += utl::to_string<4>(row + 1);
+	this->frame_buffer += ACCESS_ROM_STR(2, ";");
+	this->frame_buffer += utl::to_string<4>(x + 1);
+	this->frame_buffer += ACCESS_ROM_STR(2, "H");
+}
+
+void ConsoleIO::writeLine(const utl::string<WIDTH>& text)
+{
+	// Flush the frame buffer, unless the text and the new line still fit
+	if (this->frame_buffer.size() + text.size() + 2 > CONSOLE_FRAME_BUFFER)
+		this->flush();
+
+	this->frame_buffer += text;
+	this->frame_buffer += ACCESS_ROM_STR(4, "\r\n");
+}
+
+void ConsoleIO::flush()
+{
+	// Write the frame buffer to the console in a single write
+	if (this->frame_buffer.size() > 0)
+		this->write_callback(this->frame_buffer.begin(), this->frame_buffer.end(), this->opaque);
+	this->frame_buffer.clear();
 }
 
 void ConsoleIO::writeNextEventString(utl::list<utl::string<MAX_EVENT_STRING_LEN>, MAX_EVENT_STRING_QUEUE_LEN>::iterator& iter,
@@ -557,19 +684,30 @@ void ConsoleIO::writeNextEventString(utl::list<utl::string<MAX_EVENT_STRING_LEN>
 	}
 }
 
+void ConsoleIO::coalesceUpdate()
+{
+	// Wait for more events, the queue keeps them in order until they are drawn
+	if (++this->pending_events < CONSOLE_COALESCE_EVENTS)
+		return;
+
+	// Update the screen
+	utl::string<32> hint_text = ACCESS_ROM_STR(32, "");
+	this->updateScreen<32>(hint_text);
+}
+
 template <const size_t SIZE>
 void ConsoleIO::updateScreen(const utl::string<SIZE>& hint_text)
 {
 	// Construct line buffer
 	utl::string<WIDTH> line_buffer;
 
-	// Clear the terminal
-	this->clearTerminal(line_buffer);
+	// Clear the terminal, unless it still shows the last frame drawn
+	this->clearTerminal();
 
-	// Write a line of all '#' characters
+	// Draw a line of all '#' characters
 	line_buffer.resize(WIDTH);
 	utl::fill(line_buffer.begin(), line_buffer.end(), '#');
-	this->write_line_callback(line_buffer, this->opaque);
+	this->drawLine(0, line_buffer);
 
 	// Get an iterator at the beginning of the event string queue
 	auto iter = this->event_string_queue.begin();
@@ -579,27 +717,27 @@ void ConsoleIO::updateScreen(const utl::string<SIZE>& hint_text)
 
 	this->printHand(line_buffer, 11, 2);
 	this->printHand(line_buffer, 24, 3);
-	this->write_line_callback(line_buffer, this->opaque);
+	this->drawLine(1, line_buffer);
 
 	// Draw line 2
 	this->writeNextEventString(iter, line_buffer);
 	this->printName(line_buffer, 11, 2);
 	this->printName(line_buffer, 24, 3);
-	this->write_line_callback(line_buffer, this->opaque);
+	this->drawLine(2, line_buffer);
 
 	// Draw line 3
 	this->writeNextEventString(iter, line_buffer);
 	this->printChipStackCount(line_buffer, 11, 2);
 	this->printChipStackCount(line_buffer, 24, 3);
-	this->write_line_callback(line_buffer, this->opaque);
+	this->drawLine(3, line_buffer);
 
 	// Prepare line 4
 	this->writeNextEventString(iter, line_buffer);
-	this->write_line_callback(line_buffer, this->opaque);
+	this->drawLine(4, line_buffer);
 
 	// Prepare line 5
 	this->writeNextEventString(iter, line_buffer);
-	this->write_line_callback(line_buffer, this->opaque);
+	this->drawLine(5, line_buffer);
 
 	// Prepare line 6
 	this->writeNextEventString(iter, line_buffer);
@@ -613,7 +751,7 @@ void ConsoleIO::updateScreen(const utl::string<SIZE>& hint_text)
 		printCard(line_buffer, EVENT_TEXT_OFFSET / 2 + 5, *board_iter);
 	}
 	this->printHand(line_buffer, 33, 4);
-	this->write_line_callback(line_buffer, this->opaque);
+	this->drawLine(6, line_buffer);
 
 	// Prepare line 7
 	this->writeNextEventString(iter, line_buffer);
@@ -627,53 +765,62 @@ void ConsoleIO::updateScreen(const utl::string<SIZE>& hint_text)
 		printCard(line_buffer, EVENT_TEXT_OFFSET / 2 + 3, *board_iter);
 	}
 	this->printName(line_buffer, 33, 4);
-	this->write_line_callback(line_buffer, this->opaque);
+	this->drawLine(7, line_buffer);
 
 	// Prepare line 8
 	this->writeNextEventString(iter, line_buffer);
 	this->printChipStackCount(line_buffer, 4, 1);
 	this->printChipStackCount(line_buffer, 33, 4);
-	this->write_line_callback(line_buffer, this->opaque);
+	this->drawLine(8, line_buffer);
 
 	// Prepare line 9
 	this->writeNextEventString(iter, line_buffer);
-	this->write_line_callback(line_buffer, this->opaque);
+	this->drawLine(9, line_buffer);
 
 	// Prepare line 10
 	this->writeNextEventString(iter, line_buffer);
 	this->printHand(line_buffer, 10, 0);
 	this->printHand(line_buffer, 23, 5);
-	this->write_line_callback(line_buffer, this->opaque);
+	this->drawLine(10, line_buffer);
 
 	// Prepare line 11
 	this->writeNextEventString(iter, line_buffer);
 	this->printName(line_buffer, 10, 0);
 	this->printName(line_buffer, 23, 5);
-	this->write_line_callback(line_buffer, this->opaque);
+	this->drawLine(11, line_buffer);
 
 	// Prepare line 12
 	this->writeNextEventString(iter, line_buffer);
 	this->printChipStackCount(line_buffer, 10, 0);
 	this->printChipStackCount(line_buffer, 23, 5);
-	this->write_line_callback(line_buffer, this->opaque);
+	this->drawLine(12, line_buffer);
 
-	// Write a line of all '#' characters
+	// Draw a line of all '#' characters
 	utl::fill(line_buffer.begin(), line_buffer.end(), '#');
-	this->write_line_callback(line_buffer, this->opaque);
+	this->drawLine(13, line_buffer);
 
 	// Draw the pot chip stack count
 	utl::fill(line_buffer.begin(), line_buffer.end(), ' ');
 	this->printPotStackCount(line_buffer, 0);
-	this->write_line_callback(line_buffer, this->opaque);
+	this->drawLine(14, line_buffer);
 
 	// Draw the to call message
 	utl::fill(line_buffer.begin(), line_buffer.end(), ' ');
 	this->printToCall(line_buffer, 0);
-	this->write_line_callback(line_buffer, this->opaque);
+	this->drawLine(15, line_buffer);
 
 	// Print hint text
 	line_buffer = hint_text;
-	this->write_line_callback(line_buffer, this->opaque);
+	this->drawLine(16, line_buffer);
+
+	// Erase any user input below the frame, leaving the cursor on the line below the hint text
+	this->moveCursor(HEIGHT, 0);
+	this->frame_buffer += ACCESS_ROM_STR(8, "\033[J");
+
+	// Write the whole update to the console at once
+	this->flush();
+	this->frame_valid = true;
+	this->pending_events = 0;
 
 	// Wait 100ms after each screen draw
 	this->delay_callback(100);
@@ -72,4 +72,18 @@ Card Deck::dealCard()
 uint8_t Deck::cardsDealt() const
 {
     return this->deal_cursor;
+}
+
+Deck::Snapshot Deck::takeSnapshot() const
+{
+    Snapshot result;
+    result.cards = this->cards;
+    result.deal_cursor = this->deal_cursor;
+    return result;
+}
+
+void Deck::restoreSnapshot(const Snapshot& snapshot)
+{
+    this->cards = snapshot.cards;
+    this->deal_cursor = snapshot.deal_cursor;
 }
\ No newline at end of file
@@ -0,0 +1,200 @@
+/**
+ *  A simple interactive texas holdem poker program.
+ *  Copyright (C) 2020, Matt Zimmerer, mzimmere@gmail.com
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ **/
+
+#include "PokerGame/EquityCache.h"
+
+#ifndef EMBEDDED_BUILD
+#include <atomic>
+#endif
+
+#include "PokerGame/AI.h"
+
+/** Mix the bits of a value, the splitmix64 finalizer
+ *  @param value The value
+ *  @return The mixed value
+ */
+static uint64_t mix(uint64_t value)
+{
+	value ^= value >> 30;
+	value *= 0xBF58476D1CE4E5B9ull;
+	value ^= value >> 27;
+	value *= 0x94D049BB133111EBull;
+	value ^= value >> 31;
+	return value;
+}
+
+uint64_t EquityCache::key(const utl::array<Card, 2>& hand, const utl::vector<Card, 5>& board, uint8_t opponents)
+{
+	// Describe each suit by the values of the hand in it above the values of the board in it
+	utl::array<uint32_t, 4> suits = { 0, 0, 0, 0 };
+	for (const Card& card : hand)
+		suits[static_cast<uint8_t>(card.getSuit())] |= 1ul << (13 + static_cast<uint8_t>(card.getValue()));
+	for (const Card& card : board)
+		suits[static_cast<uint8_t>(card.getSuit())] |= 1ul << static_cast<uint8_t>(card.getValue());
+
+	// Suits with the same description are interchangeable, so sorting the descriptions names the suits canonically
+	for (uint8_t i = 1; i < 4; ++i) {
+		uint32_t suit = suits[i];
+		uint8_t j = i;
+		for (; j > 0 && suits[j - 1] < suit; --j)
+			suits[j] = suits[j - 1];
+		suits[j] = suit;
+	}
+
+	// Mix the 26 bit descriptions and the number of opponents into the key
+	uint64_t high = (static_cast<uint64_t>(suits[0]) << 26) | suits[1];
+	uint64_t low = (static_cast<uint64_t>(suits[2]) << 26) | suits[3];
+	return mix(mix(high ^ (static_cast<uint64_t>(opponents) << 56)) ^ low);
+}
+
+// The cache is only built when the AI estimates equity
+#if AI_EQUITY_BUDGET > 0 && AI_EQUITY_CACHE > 0
+static_assert((AI_EQUITY_CACHE & (AI_EQUITY_CACHE - 1)) == 0, "The equity cache holds a power of two entries");
+
+#ifdef EMBEDDED_BUILD
+
+/// A cached equity, the tag is the top bits of the key with the highest bit set so that an empty entry never matches
+struct Entry {
+	uint16_t tag;
+	uint16_t equity;
+};
+
+/// The cache, each key has a single entry
+static utl::array<Entry, AI_EQUITY_CACHE> entries;
+
+/** Get the tag of a key
+ *  @param key The key
+ *  @return The tag, never zero
+ */
+static uint16_t tagOf(uint64_t key)
+{
+	return static_cast<uint16_t>(key >> 48) | 0x8000;
+}
+
+bool EquityCache::find(uint64_t key, uint16_t& equity)
+{
+	const Entry& entry = entries[static_cast<size_t>(key & (AI_EQUITY_CACHE - 1))];
+	if (entry.tag != tagOf(key))
+		return false;
+	equity = entry.equity;
+	return true;
+}
+
+void EquityCache::store(uint64_t key, uint16_t equity)
+{
+	// The newest equity replaces whatever shared its entry
+	Entry& entry = entries[static_cast<size_t>(key & (AI_EQUITY_CACHE - 1))];
+	entry.tag = tagOf(key);
+	entry.equity = equity;
+}
+
+void EquityCache::clear()
+{
+	for (Entry& entry : entries)
+		entry.tag = 0;
+}
+
+#else
+
+/// The entries of each set, that a key may be stored in
+static constexpr uint8_t WAYS = 4;
+
+/// Each entry packs the top 47 bits of its key, with the highest set so that an empty entry never matches, a bit that
+/// is set when it is looked up and the equity in the low 16 bits
+static constexpr uint64_t TAG_MASK = ~0x1FFFFull;
+static constexpr uint64_t REFERENCED = 0x10000ull;
+static constexpr uint64_t EQUITY_MASK = 0xFFFFull;
+
+/// The cache, a single word per entry so that entries are read and replaced whole without locks
+static std::atomic<uint64_t> entries[AI_EQUITY_CACHE];
+
+/** Get the tag of a key
+ *  @param key The key
+ *  @return The tag, in the bits of TAG_MASK
+ */
+static uint64_t tagOf(uint64_t key)
+{
+	return (key | (1ull << 63)) & TAG_MASK;
+}
+
+/** Get the first entry of a key's set
+ *  @param key The key
+ *  @return The index of the first entry
+ */
+static size_t setOf(uint64_t key)
+{
+	return static_cast<size_t>(key & (AI_EQUITY_CACHE - 1) & ~static_cast<uint64_t>(WAYS - 1));
+}
+
+bool EquityCache::find(uint64_t key, uint16_t& equity)
+{
+	uint64_t tag = tagOf(key);
+	size_t set = setOf(key);
+	for (uint8_t way = 0; way < WAYS; ++way) {
+		uint64_t entry = entries[set + way].load(std::memory_order_relaxed);
+		if ((entry & TAG_MASK) != tag)
+			continue;
+
+		// Give the entry a second chance before it is evicted, writing only if it has not had one yet
+		if ((entry & REFERENCED) == 0)
+			entries[set + way].fetch_or(REFERENCED, std::memory_order_relaxed);
+		equity = static_cast<uint16_t>(entry & EQUITY_MASK);
+		return true;
+	}
+	return false;
+}
+
+void EquityCache::store(uint64_t key, uint16_t equity)
+{
+	uint64_t tag = tagOf(key);
+	uint64_t word = tag | equity;
+	size_t set = setOf(key);
+
+	// Replace the key's own entry, or fill an empty one
+	for (uint8_t way = 0; way < WAYS; ++way) {
+		uint64_t entry = entries[set + way].load(std::memory_order_relaxed);
+		if ((entry & TAG_MASK) == tag || entry == 0) {
+			if (entries[set + way].compare_exchange_strong(entry, word, std::memory_order_relaxed))
+				return;
+		}
+	}
+
+	// Evict the first entry that has not been looked up since its last chance, taking the chances of those that have
+	for (uint8_t way = 0; way < WAYS; ++way) {
+		uint64_t entry = entries[set + way].load(std::memory_order_relaxed);
+		if ((entry & REFERENCED) == 0) {
+			if (entries[set + way].compare_exchange_strong(entry, word, std::memory_order_relaxed))
+				return;
+		}
+		else {
+			entries[set + way].fetch_and(~REFERENCED, std::memory_order_relaxed);
+		}
+	}
+
+	// Every entry had a chance, so evict the first
+	entries[set].store(word, std::memory_order_relaxed);
+}
+
+void EquityCache::clear()
+{
+	for (std::atomic<uint64_t>& entry : entries)
+		entry.store(0, std::memory_order_relaxed);
+}
+
+#endif
+#endif
\ No newline at end of file
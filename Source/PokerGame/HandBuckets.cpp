@@ -0,0 +1,227 @@
+/**
+ *  A simple interactive texas holdem poker program.
+ *  Copyright (C) 2020, Matt Zimmerer, mzimmere@gmail.com
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ **/
+
+#include "PokerGame/HandBuckets.h"
+
+#include "Platform/Platform.h"
+#include "PokerGame/HandEvaluator.h"
+#include "PokerGame/RankedHand.h"
+
+/// Each bucket's share of the pot against a single opponent holding a random hand in the range [0..255], flop, turn then
+/// river, printed by the util's buckets command
+static const uint8_t bucket_equities[HandBuckets::BUCKETS] ROM_DATA = {
+	0x59, 0x6C, 0x88, 0xA1, 0x65, 0x73, 0x91, 0xA2, 0x48, 0x58, 0x80, 0x8E, 0x60, 0x60, 0x60, 0x60,
+	0x51, 0x69, 0x7B, 0x9F, 0x60, 0x60, 0x60, 0x60, 0x41, 0x55, 0x75, 0x8D, 0x60, 0x60, 0x60, 0x60,
+	0xA2, 0xA0, 0xC4, 0xA0, 0xA0, 0xA0, 0xA0, 0xA0, 0x87, 0xA0, 0xB2, 0xA0, 0xA0, 0xA0, 0xA0, 0xA0,
+	0x95, 0xA7, 0xB1, 0xC9, 0xA0, 0xA0, 0xA0, 0xA0, 0x7D, 0x8D, 0xA5, 0xB7, 0xA0, 0xA0, 0xA0, 0xA0,
+	0xCE, 0xC8, 0xE0, 0xC8, 0xC8, 0xC8, 0xC8, 0xC8, 0xAC, 0xC8, 0xCF, 0xC8, 0xC8, 0xC8, 0xC8, 0xC8,
+	0xB8, 0xC1, 0xC3, 0xD6, 0xC8, 0xC8, 0xC8, 0xC8, 0x99, 0xA1, 0xBE, 0xC7, 0xC8, 0xC8, 0xC8, 0xC8,
+	0xE0, 0xC4, 0xC4, 0xC4, 0xB5, 0xC4, 0xC4, 0xC4, 0xC1, 0xC4, 0xC4, 0xC4, 0xC4, 0xC4, 0xC4, 0xC4,
+	0xD0, 0xC4, 0xC4, 0xC4, 0xC4, 0xC4, 0xC4, 0xC4, 0xB3, 0xC4, 0xC4, 0xC4, 0xC4, 0xC4, 0xC4, 0xC4,
+	0xEF, 0xED, 0xED, 0xED, 0xEE, 0xED, 0xED, 0xED, 0xD4, 0xED, 0xED, 0xED, 0xED, 0xED, 0xED, 0xED,
+	0xE1, 0xED, 0xED, 0xED, 0xED, 0xED, 0xED, 0xED, 0xC9, 0xED, 0xED, 0xED, 0xED, 0xED, 0xED, 0xED,
+	0xE8, 0xE8, 0xE8, 0xE8, 0xE8, 0xE8, 0xE8, 0xE8, 0xE8, 0xE8, 0xE8, 0xE8, 0xE8, 0xE8, 0xE8, 0xE8,
+	0xE9, 0xE8, 0xF2, 0xE8, 0xE8, 0xE8, 0xE8, 0xE8, 0xC4, 0xE8, 0xDF, 0xE8, 0xE8, 0xE8, 0xE8, 0xE8,
+	0xF1, 0xF1, 0xF1, 0xF1, 0xF1, 0xF1, 0xF1, 0xF1, 0xF0, 0xF1, 0xF1, 0xF1, 0xF1, 0xF1, 0xF1, 0xF1,
+	0xF1, 0xF1, 0xF1, 0xF1, 0xF1, 0xF1, 0xF1, 0xF1, 0xF2, 0xF1, 0xF1, 0xF1, 0xF1, 0xF1, 0xF1, 0xF1,
+	0xF7, 0xF7, 0xF7, 0xF7, 0xF7, 0xF7, 0xF7, 0xF7, 0xF7, 0xF7, 0xF7, 0xF7, 0xF7, 0xF7, 0xF7, 0xF7,
+	0xF7, 0xF7, 0xF7, 0xF7, 0xF7, 0xF7, 0xF7, 0xF7, 0xFF, 0xF7, 0xF7, 0xF7, 0xF7, 0xF7, 0xF7, 0xF7,
+	0x46, 0x51, 0x5F, 0x75, 0x57, 0x5B, 0x6E, 0x7B, 0x3B, 0x44, 0x5D, 0x69, 0x49, 0x4E, 0x69, 0x6E,
+	0x3F, 0x50, 0x5A, 0x75, 0x50, 0x5D, 0x65, 0x7D, 0x35, 0x44, 0x55, 0x69, 0x44, 0x51, 0x62, 0x71,
+	0xA0, 0x99, 0xB5, 0x99, 0x99, 0x99, 0x99, 0x99, 0x89, 0x99, 0xA7, 0x99, 0x99, 0x99, 0x99, 0x99,
+	0x93, 0xA0, 0xA6, 0xB4, 0x99, 0x99, 0x99, 0x99, 0x7E, 0x89, 0x9A, 0xA7, 0x99, 0x99, 0x99, 0x99,
+	0xD7, 0xC9, 0xE0, 0xC9, 0xC9, 0xC9, 0xC9, 0xC9, 0xB9, 0xC9, 0xD4, 0xC9, 0xC9, 0xC9, 0xC9, 0xC9,
+	0xC3, 0xCC, 0xCC, 0xD7, 0xC9, 0xC9, 0xC9, 0xC9, 0xA9, 0xB1, 0xC1, 0xCA, 0xC9, 0xC9, 0xC9, 0xC9,
+	0xE9, 0xBD, 0xEB, 0xBD, 0xB6, 0xBD, 0xC5, 0xBD, 0xCA, 0xBD, 0xDF, 0xBD, 0xA2, 0xBD, 0xB5, 0xBD,
+	0xD7, 0xBD, 0xDF, 0xBD, 0xAA, 0xB1, 0xB5, 0xC1, 0xBC, 0xBD, 0xD1, 0xBD, 0x98, 0x9D, 0xAB, 0xB2,
+	0xF6, 0xEB, 0xEB, 0xEB, 0xF1, 0xEB, 0xF4, 0xEB, 0xDB, 0xEB, 0xED, 0xEB, 0xDA, 0xEB, 0xE7, 0xEB,
+	0xE6, 0xEB, 0xEB, 0xEB, 0xE4, 0xEA, 0xEA, 0xE9, 0xCD, 0xEB, 0xE1, 0xEB, 0xD0, 0xD7, 0xDC, 0xE4,
+	0xE3, 0xE3, 0xE3, 0xE3, 0xE3, 0xE3, 0xE3, 0xE3, 0xE3, 0xE3, 0xE3, 0xE3, 0xE3, 0xE3, 0xE3, 0xE3,
+	0xE7, 0xE3, 0xEB, 0xE3, 0xE6, 0xE3, 0xE9, 0xE3, 0xC9, 0xE3, 0xDE, 0xE3, 0xCB, 0xE3, 0xDC, 0xE3,
+	0xE7, 0xE7, 0xE7, 0xE7, 0xE7, 0xE7, 0xE7, 0xE7, 0xE7, 0xE7, 0xE7, 0xE7, 0xE9, 0xE7, 0xE7, 0xE7,
+	0xE7, 0xE7, 0xE7, 0xE7, 0xE7, 0xE7, 0xE7, 0xE7, 0xE7, 0xE7, 0xE7, 0xE7, 0xE8, 0xE7, 0xE7, 0xE7,
+	0xF0, 0xF0, 0xF0, 0xF0, 0xEE, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xFC, 0xF0, 0xF0, 0xF0,
+	0xF0, 0xF0, 0xF0, 0xF0, 0xFB, 0xF0, 0xF0, 0xF0, 0xFE, 0xF0, 0xF0, 0xF0, 0xFA, 0xF0, 0xF0, 0xF0,
+	0x33, 0x4E, 0x30, 0x45, 0x2F, 0x41, 0x2C, 0x3B, 0x9D, 0x8A, 0x8F, 0x8A, 0x8E, 0x8A, 0x81, 0x8A,
+	0xDE, 0xC7, 0xCC, 0xC7, 0xCD, 0xC7, 0xBC, 0xC7, 0xF4, 0xB9, 0xDF, 0xAB, 0xE1, 0xAF, 0xCD, 0xA2,
+	0xFE, 0xF6, 0xE8, 0xE6, 0xEA, 0xEB, 0xD7, 0xDC, 0xE6, 0xE6, 0xE6, 0xE6, 0xED, 0xEA, 0xDC, 0xDC,
+	0xE4, 0xE4, 0xE6, 0xE0, 0xE4, 0xE4, 0xE5, 0xE2, 0xEE, 0xE9, 0xEE, 0xEE, 0xEE, 0xF3, 0xFE, 0xF7,
+};
+
+/** Find the highest rank in a non-empty rank mask
+ *  @param ranks The rank mask, bit N represents value N
+ *  @return The highest rank
+ */
+static uint8_t highestRank(uint16_t ranks)
+{
+	uint8_t rank = static_cast<uint8_t>(Card::Value::Ace);
+	while ((ranks & (1u << rank)) == 0)
+		--rank;
+	return rank;
+}
+
+/** Count the ranks in a rank mask
+ *  @param ranks The rank mask
+ *  @return The number of ranks set
+ */
+static uint8_t countRanks(uint16_t ranks)
+{
+	uint8_t count = 0;
+	for (; ranks != 0; ranks &= static_cast<uint16_t>(ranks - 1))
+		++count;
+	return count;
+}
+
+/** Shift every rank in a rank mask up by one and let the ace also play low in bit zero
+ *  @param ranks The rank mask
+ *  @return The shifted rank mask
+ */
+static uint16_t aceLow(uint16_t ranks)
+{
+	return static_cast<uint16_t>((ranks << 1) | ((ranks >> static_cast<uint8_t>(Card::Value::Ace)) & 0x01));
+}
+
+/** Check whether a rank mask holds a straight
+ *  @param ranks The rank mask
+ *  @return True if five ranks are in a run
+ */
+static bool hasStraight(uint16_t ranks)
+{
+	// A bit survives if it starts a run of five ranks
+	uint16_t shifted = aceLow(ranks);
+	return (shifted & (shifted >> 1) & (shifted >> 2) & (shifted >> 3) & (shifted >> 4)) != 0;
+}
+
+/** Check whether a rank mask holds three ranks within the span of a straight
+ *  @param ranks The rank mask
+ *  @return True if three ranks fit in a run of five
+ */
+static bool isConnected(uint16_t ranks)
+{
+	uint16_t shifted = aceLow(ranks);
+	for (uint8_t low = 0; low <= 9; ++low) {
+		if (countRanks((shifted >> low) & 0x1F) >= 3)
+			return true;
+	}
+	return false;
+}
+
+/** Classify what the hole cards make beyond the board
+ *  @param hand The player's hand
+ *  @param board_ranks The ranks on the board
+ *  @param made The ranking of the hand with the board
+ *  @param on_board The ranking of the board alone
+ *  @return The category in the range [0..CATEGORIES)
+ */
+static uint8_t category(const utl::array<Card, 2>& hand, uint16_t board_ranks, RankedHand::Ranking made, RankedHand::Ranking on_board)
+{
+	// The hole cards add nothing but kickers
+	if (made == on_board)
+		return 0;
+
+	switch (made) {
+	case RankedHand::Ranking::Pair: {
+
+		// The pair is a pocket pair or a hole card that matches the board, top pair and over pairs are stronger
+		uint8_t first = static_cast<uint8_t>(hand[0].getValue());
+		uint8_t pair = hand[0].getValue() == hand[1].getValue() || (board_ranks & (1u << first)) != 0 ? first : static_cast<uint8_t>(hand[1].getValue());
+		return pair >= highestRank(board_ranks) ? 2 : 1;
+	}
+	case RankedHand::Ranking::TwoPair:
+		return 3;
+	case RankedHand::Ranking::ThreeOfAKind:
+		return 4;
+	case RankedHand::Ranking::Straight:
+		return 5;
+	case RankedHand::Ranking::Flush:
+		return 6;
+	default:
+		return 7;
+	}
+}
+
+uint16_t HandBuckets::bucket(const utl::array<Card, 2>& hand, const utl::vector<Card, 5>& board)
+{
+	// Collect the ranks held in each suit by the board alone, then with the hand
+	utl::array<uint16_t, 4> board_suits{};
+	HandEvaluator::CardMask board_cards = 0;
+	for (const auto& card : board) {
+		board_suits[static_cast<uint8_t>(card.getSuit())] |= static_cast<uint16_t>(1u << static_cast<uint8_t>(card.getValue()));
+		board_cards |= HandEvaluator::cardMask(card);
+	}
+	utl::array<uint16_t, 4> suits = board_suits;
+	for (const auto& card : hand)
+		suits[static_cast<uint8_t>(card.getSuit())] |= static_cast<uint16_t>(1u << static_cast<uint8_t>(card.getValue()));
+	uint16_t board_ranks = board_suits[0] | board_suits[1] | board_suits[2] | board_suits[3];
+	uint16_t ranks = suits[0] | suits[1] | suits[2] | suits[3];
+
+	// Classify the made hand
+	RankedHand::Ranking on_board = HandEvaluator::ranking(HandEvaluator::evaluate(board_cards));
+	RankedHand::Ranking made = HandEvaluator::ranking(HandEvaluator::evaluate(board_cards | HandEvaluator::cardMask(hand[0]) | HandEvaluator::cardMask(hand[1])));
+	uint8_t made_category = category(hand, board_ranks, made, on_board);
+
+	// Classify the board
+	uint8_t texture = 0;
+	if (countRanks(board_ranks) < board.size())
+		texture |= 0x01;
+	for (uint16_t suit : board_suits) {
+		if (countRanks(suit) >= 3)
+			texture |= 0x02;
+	}
+	if (isConnected(board_ranks))
+		texture |= 0x04;
+
+	// The river has no draws
+	if (board.size() == 5)
+		return 2 * DRAWING_STREET_BUCKETS + made_category * TEXTURES + texture;
+
+	// Look for four cards to a flush that uses a hole card
+	uint8_t draw = 0;
+	if (made < RankedHand::Ranking::Flush) {
+		for (const auto& card : hand) {
+			if (countRanks(suits[static_cast<uint8_t>(card.getSuit())]) == 4)
+				draw = 2;
+		}
+	}
+
+	// Count the ranks that complete a straight that the board alone does not, one is a gutshot and two are open ended
+	if (made < RankedHand::Ranking::Straight) {
+		uint8_t outs = 0;
+		for (uint8_t rank = 0; rank <= static_cast<uint8_t>(Card::Value::Ace); ++rank) {
+			uint16_t out = static_cast<uint16_t>(1u << rank);
+			if ((ranks & out) == 0 && hasStraight(ranks | out) && !hasStraight(board_ranks | out))
+				++outs;
+		}
+		draw = static_cast<uint8_t>(draw + (outs > 2 ? 2 : outs));
+	}
+	if (draw >= DRAWS)
+		draw = DRAWS - 1;
+
+	uint16_t street_offset = board.size() == 4 ? DRAWING_STREET_BUCKETS : 0;
+	return static_cast<uint16_t>(street_offset + (made_category * TEXTURES + texture) * DRAWS + draw);
+}
+
+uint16_t HandBuckets::equity(uint16_t bucket, uint8_t opponents)
+{
+	// Scale the share against one opponent to [0..10000], then take it once more for each further opponent
+	uint32_t share = ACCESS_ROM_DATA(bucket_equities[bucket]);
+	uint32_t result = 10000;
+	for (uint8_t i = 0; i < opponents; ++i)
+		result = (result * share + 127) / 255;
+	return static_cast<uint16_t>(result);
+}
\ No newline at end of file
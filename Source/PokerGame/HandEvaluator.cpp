@@ -0,0 +1,512 @@
+/**
+ *  A simple interactive texas holdem poker program.
+ *  Copyright (C) 2020, Matt Zimmerer, mzimmere@gmail.com
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ **/
+#include "PokerGame/HandEvaluator.h"
+
+#ifndef EMBEDDED_BUILD
+#include <thread>
+#include <vector>
+#endif
+
+/// The bit offset of each category within a hand value, the ranks that break ties fill the nibbles below it
+static constexpr uint8_t CATEGORY_BIT_OFFSET = 20;
+
+/// The ranks of a single suit
+static constexpr uint16_t SUIT_MASK = 0x1FFF;
+
+/** Find the highest rank in a non-empty rank mask
+ *  @param ranks The rank mask, bit N represents value N
+ *  @return The highest rank
+ */
+static uint8_t highestRank(uint16_t ranks)
+{
+	// Binary search for the highest set bit
+	uint8_t rank = 0;
+	if (ranks & 0xFF00) { ranks >>= 8; rank += 8; }
+	if (ranks & 0x00F0) { ranks >>= 4; rank += 4; }
+	if (ranks & 0x000C) { ranks >>= 2; rank += 2; }
+	if (ranks & 0x0002) { rank += 1; }
+	return rank;
+}
+
+/** Count the ranks in a rank mask
+ *  @param ranks The rank mask
+ *  @return The number of ranks set
+ */
+static uint8_t countRanks(uint16_t ranks)
+{
+	// Add up bits in pairs, then nibbles, then bytes
+	ranks = ranks - ((ranks >> 1) & 0x5555);
+	ranks = (ranks & 0x3333) + ((ranks >> 2) & 0x3333);
+	ranks = (ranks + (ranks >> 4)) & 0x0F0F;
+	return (ranks + (ranks >> 8)) & 0x1F;
+}
+
+/** Pack the highest ranks of a rank mask into a hand value
+ *  @param value The hand value so far
+ *  @param ranks The rank mask
+ *  @param count The number of ranks to pack
+ *  @param shift The bit offset of the first rank
+ *  @return The hand value
+ */
+static uint32_t packRanks(uint32_t value, uint16_t ranks, uint8_t count, uint8_t shift)
+{
+	for (uint8_t i = 0; i < count && ranks != 0; ++i, shift -= 4) {
+		uint8_t rank = highestRank(ranks);
+		value |= static_cast<uint32_t>(rank) << shift;
+		ranks &= static_cast<uint16_t>(~(1u << rank));
+	}
+	return value;
+}
+
+/** Find the highest straight within a rank mask
+ *  @param ranks The rank mask
+ *  @return The rank of the straight's highest card, or -1 if there is no straight
+ */
+static int8_t straightHigh(uint16_t ranks)
+{
+	// Shift every rank up by one and let the ace also play low in bit zero
+	uint16_t shifted = static_cast<uint16_t>((ranks << 1) | ((ranks >> static_cast<uint8_t>(Card::Value::Ace)) & 0x01));
+
+	// A bit survives if it starts a run of five ranks
+	uint16_t runs = shifted & (shifted >> 1) & (shifted >> 2) & (shifted >> 3) & (shifted >> 4);
+	if (runs == 0)
+		return -1;
+	return static_cast<int8_t>(highestRank(runs) + 3);
+}
+
+/** Build a hand value
+ *  @param ranking The hand's category
+ *  @return The hand value with no tie breaking ranks
+ */
+static uint32_t category(RankedHand::Ranking ranking)
+{
+	return static_cast<uint32_t>(ranking) << CATEGORY_BIT_OFFSET;
+}
+
+HandEvaluator::CardMask HandEvaluator::cardMask(const Card& card)
+{
+	return static_cast<CardMask>(1) << (16 * static_cast<uint8_t>(card.getSuit()) + static_cast<uint8_t>(card.getValue()));
+}
+
+uint32_t HandEvaluator::evaluate(CardMask cards)
+{
+	// Split the cards into suits
+	uint16_t spades = static_cast<uint16_t>(cards) & SUIT_MASK;
+	uint16_t clubs = static_cast<uint16_t>(cards >> 16) & SUIT_MASK;
+	uint16_t diamonds = static_cast<uint16_t>(cards >> 32) & SUIT_MASK;
+	uint16_t hearts = static_cast<uint16_t>(cards >> 48) & SUIT_MASK;
+
+	// Ranks held at least once, twice, three and four times
+	uint16_t ranks = spades | clubs | diamonds | hearts;
+	uint16_t two_or_more = (spades & clubs) | (diamonds & hearts) | ((spades | clubs) & (diamonds | hearts));
+	uint16_t three_or_more = (spades & clubs & (diamonds | hearts)) | (diamonds & hearts & (spades | clubs));
+	uint16_t quads = spades & clubs & diamonds & hearts;
+	uint16_t trips = three_or_more & static_cast<uint16_t>(~quads);
+	uint16_t pairs = two_or_more & static_cast<uint16_t>(~three_or_more);
+
+	// Look for a flush, at most one suit can hold five of seven cards
+	uint16_t flush = 0;
+	const uint16_t suits[] = { spades, clubs, diamonds, hearts };
+	for (uint16_t suit : suits) {
+		if (countRanks(suit) >= 5)
+			flush = suit;
+	}
+
+	// Straight flush
+	if (flush != 0) {
+		int8_t high = straightHigh(flush);
+		if (high >= 0)
+			return category(RankedHand::Ranking::StraightFlush) | (static_cast<uint32_t>(high) << 16);
+	}
+
+	// Four of a kind
+	if (quads != 0) {
+		uint8_t quad = highestRank(quads);
+		return packRanks(category(RankedHand::Ranking::FourOfAKind) | (static_cast<uint32_t>(quad) << 16),
+			ranks & static_cast<uint16_t>(~(1u << quad)), 1, 12);
+	}
+
+	// Full house, the second set of trips may play as the pair
+	if (trips != 0) {
+		uint8_t trip = highestRank(trips);
+		uint16_t fillers = (trips & static_cast<uint16_t>(~(1u << trip))) | pairs;
+		if (fillers != 0)
+			return category(RankedHand::Ranking::FullHouse) | (static_cast<uint32_t>(trip) << 16) | (static_cast<uint32_t>(highestRank(fillers)) << 12);
+	}
+
+	// Flush
+	if (flush != 0)
+		return packRanks(category(RankedHand::Ranking::Flush), flush, 5, 16);
+
+	// Straight
+	int8_t high = straightHigh(ranks);
+	if (high >= 0)
+		return category(RankedHand::Ranking::Straight) | (static_cast<uint32_t>(high) << 16);
+
+	// Three of a kind
+	if (trips != 0) {
+		uint8_t trip = highestRank(trips);
+		return packRanks(category(RankedHand::Ranking::ThreeOfAKind) | (static_cast<uint32_t>(trip) << 16),
+			ranks & static_cast<uint16_t>(~(1u << trip)), 2, 12);
+	}
+
+	// Two pair and one pair
+	if (pairs != 0) {
+		uint8_t high_pair = highestRank(pairs);
+		uint16_t low_pairs = pairs & static_cast<uint16_t>(~(1u << high_pair));
+		if (low_pairs != 0) {
+			uint8_t low_pair = highestRank(low_pairs);
+			return packRanks(category(RankedHand::Ranking::TwoPair) | (static_cast<uint32_t>(high_pair) << 16) | (static_cast<uint32_t>(low_pair) << 12),
+				ranks & static_cast<uint16_t>(~((1u << high_pair) | (1u << low_pair))), 1, 8);
+		}
+		return packRanks(category(RankedHand::Ranking::Pair) | (static_cast<uint32_t>(high_pair) << 16),
+			ranks & static_cast<uint16_t>(~(1u << high_pair)), 3, 12);
+	}
+
+	// High card
+	return packRanks(category(RankedHand::Ranking::HighCard), ranks, 5, 16);
+}
+
+uint32_t HandEvaluator::evaluate(const utl::array<Card, 2>& hand, const utl::vector<Card, 5>& board)
+{
+	CardMask cards = cardMask(hand[0]) | cardMask(hand[1]);
+	for (const auto& card : board)
+		cards |= cardMask(card);
+	return evaluate(cards);
+}
+
+RankedHand::Ranking HandEvaluator::ranking(uint32_t value)
+{
+	// An ace high straight flush is a royal flush
+	RankedHand::Ranking result = static_cast<RankedHand::Ranking>(value >> CATEGORY_BIT_OFFSET);
+	if (result == RankedHand::Ranking::StraightFlush && ((value >> 16) & 0x0F) == static_cast<uint8_t>(Card::Value::Ace))
+		return RankedHand::Ranking::RoyalFlush;
+	return result;
+}
+
+bool HandEvaluator::nextCombination(utl::array<uint8_t, 5>& index, uint8_t k, uint8_t n)
+{
+	// Advance the rightmost index that has room, then restart every index to its right
+	for (int8_t i = static_cast<int8_t>(k) - 1; i >= 0; --i) {
+		if (index[i] < n - k + i) {
+			++index[i];
+			for (uint8_t j = static_cast<uint8_t>(i + 1); j < k; ++j)
+				index[j] = static_cast<uint8_t>(index[j - 1] + 1);
+			return true;
+		}
+	}
+	return false;
+}
+
+/** Enumerate every runout against every single opponent hand
+ *  @param hand The player's hand
+ *  @param board The board
+ *  @param live The cards that may still be dealt
+ *  @param live_count The number of cards that may still be dealt
+ *  @param missing The number of board cards still to come
+ *  @return The share of the pot against a single opponent in the range [0..10000]
+ */
+static uint16_t exactEquity(HandEvaluator::CardMask hand, HandEvaluator::CardMask board, const utl::array<HandEvaluator::CardMask, 52>& live,
+	uint8_t live_count, uint8_t missing)
+{
+	// Count a win as two halves, so that a split is a single half
+	uint32_t halves = 0;
+	uint32_t contests = 0;
+	utl::array<uint8_t, 5> index;
+	for (uint8_t i = 0; i < 5; ++i)
+		index[i] = i;
+	do {
+
+		// Complete the board, and evaluate the player's hand once for every opponent hand
+		HandEvaluator::CardMask runout = board;
+		for (uint8_t i = 0; i < missing; ++i)
+			runout |= live[index[i]];
+		uint32_t value = HandEvaluator::evaluate(runout | hand);
+
+		// Every pair of the remaining cards is a possible opponent hand
+		for (uint8_t first = 0; first < live_count; ++first) {
+			if (runout & live[first])
+				continue;
+			for (uint8_t second = first + 1; second < live_count; ++second) {
+				if (runout & live[second])
+					continue;
+				uint32_t opponent = HandEvaluator::evaluate(runout | live[first] | live[second]);
+				halves += value > opponent ? 2 : (value == opponent ? 1 : 0);
+				++contests;
+			}
+		}
+	} while (missing > 0 && HandEvaluator::nextCombination(index, missing, live_count));
+
+	return static_cast<uint16_t>((static_cast<uint64_t>(halves) * 5000 + contests / 2) / contests);
+}
+
+uint16_t HandEvaluator::handEquity(const utl::array<Card, 2>& hand, const utl::vector<Card, 5>& board, uint8_t opponents, uint32_t budget, Random& rng)
+{
+	// With nobody left to beat, the pot is won
+	if (opponents == 0)
+		return 10000;
+
+	// Mask the known cards, and collect every card that may still be dealt
+	CardMask hand_mask = cardMask(hand[0]) | cardMask(hand[1]);
+	CardMask board_mask = 0;
+	for (const auto& card : board)
+		board_mask |= cardMask(card);
+	utl::array<CardMask, 52> live;
+	uint8_t live_count = 0;
+	for (uint8_t bit = 0; bit < 64; ++bit) {
+		CardMask card = static_cast<CardMask>(1) << bit;
+		if ((bit & 0x0F) < 13 && ((hand_mask | board_mask) & card) == 0)
+			live[live_count++] = card;
+	}
+	uint8_t missing = static_cast<uint8_t>(5 - board.size());
+
+	// Enumerate exactly when it fits in the budget
+	uint32_t runouts = missing == 0 ? 1 : (missing == 1 ? live_count : static_cast<uint32_t>(live_count) * (live_count - 1) / 2);
+	uint32_t opponent_hands = static_cast<uint32_t>(live_count - missing) * (live_count - missing - 1) / 2;
+	if (runouts * (opponent_hands + 1) <= budget) {
+		uint32_t equity = exactEquity(hand_mask, board_mask, live, live_count, missing);
+		uint32_t result = equity;
+		for (uint8_t i = 1; i < opponents; ++i)
+			result = (result * equity + 5000) / 10000;
+		return static_cast<uint16_t>(result);
+	}
+
+	// Otherwise sample, each sample deals the rest of the board and every opponent's hand from the live cards
+	static constexpr uint32_t SPLIT = 720720;
+	uint32_t samples = budget / (opponents + 1u);
+	if (samples == 0)
+		samples = 1;
+	uint8_t drawn = static_cast<uint8_t>(missing + 2 * opponents);
+	if (drawn > live_count)
+		return 0;
+	uint64_t shares = 0;
+	for (uint32_t sample = 0; sample < samples; ++sample) {
+
+		// Partially shuffle the live cards, the first drawn cards are the deal
+		for (uint8_t i = 0; i < drawn; ++i) {
+			uint8_t j = static_cast<uint8_t>(rng.getRandomNumberInRange(i, live_count - 1));
+			CardMask swap = live[i];
+			live[i] = live[j];
+			live[j] = swap;
+		}
+		CardMask runout = board_mask;
+		for (uint8_t i = 0; i < missing; ++i)
+			runout |= live[i];
+
+		// The player wins or splits the pot unless an opponent has a better hand
+		uint32_t value = evaluate(runout | hand_mask);
+		uint8_t ties = 1;
+		bool beaten = false;
+		for (uint8_t opponent = 0; opponent < opponents && beaten == false; ++opponent) {
+			uint32_t opponent_value = evaluate(runout | live[missing + 2 * opponent] | live[missing + 2 * opponent + 1]);
+			if (opponent_value > value)
+				beaten = true;
+			else if (opponent_value == value)
+				++ties;
+		}
+		if (beaten == false)
+			shares += SPLIT / ties;
+	}
+
+	return static_cast<uint16_t>((shares * 10000 + (static_cast<uint64_t>(samples) * SPLIT) / 2) / (static_cast<uint64_t>(samples) * SPLIT));
+}
+
+void HandEvaluator::HandPotential::merge(const HandPotential& other)
+{
+	for (uint8_t i = 0; i < STANDINGS; ++i) {
+		this->now[i] += other.now[i];
+		for (uint8_t j = 0; j < STANDINGS; ++j)
+			this->later[i][j] += other.later[i][j];
+	}
+}
+
+uint16_t HandEvaluator::HandPotential::strength() const
+{
+	// Count in halves, so that a tie is a single half
+	uint64_t halves = 2 * static_cast<uint64_t>(this->now[AHEAD]) + this->now[TIED];
+	uint64_t total = 2 * (static_cast<uint64_t>(this->now[AHEAD]) + this->now[TIED] + this->now[BEHIND]);
+	if (total == 0)
+		return 0;
+	return static_cast<uint16_t>((halves * 10000 + total / 2) / total);
+}
+
+uint16_t HandEvaluator::HandPotential::positive() const
+{
+	// Behind and getting ahead counts whole, behind and tying or tied and getting ahead counts half
+	uint64_t halves = 2 * static_cast<uint64_t>(this->later[BEHIND][AHEAD]) + this->later[BEHIND][TIED] + this->later[TIED][AHEAD];
+	uint64_t total = 0;
+	for (uint8_t i = 0; i < STANDINGS; ++i)
+		total += 2 * static_cast<uint64_t>(this->later[BEHIND][i]) + this->later[TIED][i];
+	if (total == 0)
+		return 0;
+	return static_cast<uint16_t>((halves * 10000 + total / 2) / total);
+}
+
+uint16_t HandEvaluator::HandPotential::negative() const
+{
+	// Ahead and falling behind counts whole, ahead and tying or tied and falling behind counts half
+	uint64_t halves = 2 * static_cast<uint64_t>(this->later[AHEAD][BEHIND]) + this->later[AHEAD][TIED] + this->later[TIED][BEHIND];
+	uint64_t total = 0;
+	for (uint8_t i = 0; i < STANDINGS; ++i)
+		total += 2 * static_cast<uint64_t>(this->later[AHEAD][i]) + this->later[TIED][i];
+	if (total == 0)
+		return 0;
+	return static_cast<uint16_t>((halves * 10000 + total / 2) / total);
+}
+
+uint16_t HandEvaluator::HandPotential::effective(uint8_t opponents) const
+{
+	// The chance to be ahead of every opponent, then the chance of getting ahead from behind
+	uint32_t strength = this->strength();
+	uint32_t result = 10000;
+	for (uint8_t i = 0; i < opponents; ++i)
+		result = (result * strength + 5000) / 10000;
+	return static_cast<uint16_t>(result + ((10000 - result) * this->positive() + 5000) / 10000);
+}
+
+uint32_t HandEvaluator::potentialEvaluations(uint8_t board_size, uint8_t lookahead)
+{
+	// Every opponent holding is evaluated once now, and against every combination of the next cards
+	if (lookahead > 5 - board_size)
+		lookahead = static_cast<uint8_t>(5 - board_size);
+	uint8_t live_count = static_cast<uint8_t>(50 - board_size);
+	uint32_t holdings = static_cast<uint32_t>(live_count) * (live_count - 1) / 2;
+	uint32_t rest = static_cast<uint32_t>(live_count - 2);
+	uint32_t runouts = lookahead == 0 ? 0 : (lookahead == 1 ? rest : rest * (rest - 1) / 2);
+	return holdings * (1 + runouts * (lookahead == 1 ? 1 : 2));
+}
+
+/** Classify the standing of a hand against an opponent's
+ *  @param value The hand value
+ *  @param opponent The opponent's hand value
+ *  @return The standing
+ */
+static HandEvaluator::HandPotential::Standing standing(uint32_t value, uint32_t opponent)
+{
+	if (value > opponent)
+		return HandEvaluator::HandPotential::AHEAD;
+	if (value == opponent)
+		return HandEvaluator::HandPotential::TIED;
+	return HandEvaluator::HandPotential::BEHIND;
+}
+
+HandEvaluator::HandPotential HandEvaluator::handPotential(const utl::array<Card, 2>& hand, const utl::vector<Card, 5>& board, uint8_t lookahead,
+	uint16_t first, uint16_t last)
+{
+	HandPotential result;
+
+	// Mask the known cards, and collect every card that may still be dealt
+	CardMask hand_mask = cardMask(hand[0]) | cardMask(hand[1]);
+	CardMask board_mask = 0;
+	for (const auto& card : board)
+		board_mask |= cardMask(card);
+	utl::array<CardMask, 52> live;
+	uint8_t live_count = 0;
+	for (uint8_t bit = 0; bit < 64; ++bit) {
+		CardMask card = static_cast<CardMask>(1) << bit;
+		if ((bit & 0x0F) < 13 && ((hand_mask | board_mask) & card) == 0)
+			live[live_count++] = card;
+	}
+	uint8_t missing = static_cast<uint8_t>(5 - board.size());
+	if (lookahead > missing)
+		lookahead = missing;
+
+	// With a single next card the player's hand depends on that card alone, so evaluate it once for the whole batch
+	uint32_t value = evaluate(board_mask | hand_mask);
+	utl::array<uint32_t, 52> next_values;
+	if (lookahead == 1) {
+		for (uint8_t i = 0; i < live_count; ++i)
+			next_values[i] = evaluate(board_mask | hand_mask | live[i]);
+	}
+
+	// Every pair of the live cards is an opponent holding
+	uint16_t holding = 0;
+	for (uint8_t a = 0; a < live_count && holding < last; ++a) {
+		for (uint8_t b = static_cast<uint8_t>(a + 1); b < live_count && holding < last; ++b, ++holding) {
+			if (holding < first)
+				continue;
+			CardMask opponent = live[a] | live[b];
+			HandPotential::Standing now = standing(value, evaluate(board_mask | opponent));
+			++result.now[now];
+			if (lookahead == 0)
+				continue;
+
+			// Deal the next card from the cards the opponent does not hold
+			if (lookahead == 1) {
+				for (uint8_t i = 0; i < live_count; ++i) {
+					if (i != a && i != b)
+						++result.later[now][standing(next_values[i], evaluate(board_mask | opponent | live[i]))];
+				}
+				continue;
+			}
+
+			// Deal every combination of the next cards from the cards the opponent does not hold
+			utl::array<CardMask, 52> rest;
+			uint8_t rest_count = 0;
+			for (uint8_t i = 0; i < live_count; ++i) {
+				if (i != a && i != b)
+					rest[rest_count++] = live[i];
+			}
+			utl::array<uint8_t, 5> index;
+			for (uint8_t i = 0; i < 5; ++i)
+				index[i] = i;
+			do {
+				CardMask runout = board_mask;
+				for (uint8_t i = 0; i < lookahead; ++i)
+					runout |= rest[index[i]];
+				++result.later[now][standing(evaluate(runout | hand_mask), evaluate(runout | opponent))];
+			} while (nextCombination(index, lookahead, rest_count));
+		}
+	}
+
+	return result;
+}
+
+HandEvaluator::HandPotential HandEvaluator::handPotential(const utl::array<Card, 2>& hand, const utl::vector<Card, 5>& board, uint8_t lookahead,
+	uint8_t threads)
+{
+	uint8_t live_count = static_cast<uint8_t>(50 - board.size());
+	uint16_t holdings = static_cast<uint16_t>(live_count * (live_count - 1) / 2);
+
+#ifndef EMBEDDED_BUILD
+	// Split the opponent holdings between threads
+	if (threads == 0)
+		threads = static_cast<uint8_t>(std::thread::hardware_concurrency() > 255 ? 255 : std::thread::hardware_concurrency());
+	if (threads > 1) {
+		std::vector<HandPotential> batches(threads);
+		std::vector<std::thread> workers;
+		for (uint8_t thread = 0; thread < threads; ++thread) {
+			uint16_t first = static_cast<uint16_t>(static_cast<uint32_t>(holdings) * thread / threads);
+			uint16_t last = static_cast<uint16_t>(static_cast<uint32_t>(holdings) * (thread + 1) / threads);
+			workers.emplace_back([&hand, &board, &batches, lookahead, thread, first, last]() {
+				batches[thread] = handPotential(hand, board, lookahead, first, last);
+			});
+		}
+		HandPotential result;
+		for (uint8_t thread = 0; thread < threads; ++thread) {
+			workers[thread].join();
+			result.merge(batches[thread]);
+		}
+		return result;
+	}
+#else
+	(void)threads;
+#endif
+
+	return handPotential(hand, board, lookahead, 0, holdings);
+}
\ No newline at end of file
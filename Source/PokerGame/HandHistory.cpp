@@ -0,0 +1,273 @@
+/**
+ *  A simple interactive texas holdem poker program.
+ *  Copyright (C) 2020, Matt Zimmerer, mzimmere@gmail.com
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ **/
+#include "PokerGame/HandHistory.h"
+
+uint8_t HandHistoryFormat::cardCode(const Card& card)
+{
+	return static_cast<uint8_t>(13 * static_cast<uint8_t>(card.getSuit()) + static_cast<uint8_t>(card.getValue()));
+}
+
+Card HandHistoryFormat::codeCard(uint8_t code)
+{
+	return Card(static_cast<Card::Value>(code % 13), static_cast<Card::Suit>(code / 13));
+}
+
+uint8_t HandHistoryFormat::actionEvent(uint8_t player_id, PokerGameBase::PlayerAction action)
+{
+	return static_cast<uint8_t>((player_id << 2) | (static_cast<uint8_t>(action) - 1));
+}
+
+HandHistoryEncoder::HandHistoryEncoder(WriteCallback write_callback_in, void* opaque_in) : write_callback(write_callback_in), opaque(opaque_in)
+{
+}
+
+void HandHistoryEncoder::writeByte(uint8_t value)
+{
+	// Write the buffer out once it is full
+	if (this->buffer.size() == BUFFER_SIZE)
+		this->flush();
+	this->buffer.push_back(value);
+}
+
+void HandHistoryEncoder::writeVarint(uint32_t value)
+{
+	// Seven bits per byte, the high bit marks that more bytes follow
+	while (value >= 0x80) {
+		this->writeByte(static_cast<uint8_t>(value | 0x80));
+		value >>= 7;
+	}
+	this->writeByte(static_cast<uint8_t>(value));
+}
+
+void HandHistoryEncoder::writeBits(uint8_t value, uint8_t bit_count)
+{
+	// Append the bits above those pending, writing each byte as it fills
+	this->pending_bits |= static_cast<uint16_t>((value & ((1u << bit_count) - 1)) << this->pending_bit_count);
+	this->pending_bit_count += bit_count;
+	while (this->pending_bit_count >= 8) {
+		this->writeByte(static_cast<uint8_t>(this->pending_bits));
+		this->pending_bits >>= 8;
+		this->pending_bit_count -= 8;
+	}
+}
+
+void HandHistoryEncoder::alignBits()
+{
+	if (this->pending_bit_count > 0)
+		this->writeByte(static_cast<uint8_t>(this->pending_bits));
+	this->pending_bits = 0;
+	this->pending_bit_count = 0;
+}
+
+void HandHistoryEncoder::flush()
+{
+	if (this->buffer.size() > 0)
+		this->write_callback(this->buffer.begin(), this->buffer.size(), this->opaque);
+	this->buffer.clear();
+}
+
+HandHistoryReader::HandHistoryReader(const uint8_t* data_in, size_t size_in) : data(data_in), size(size_in)
+{
+}
+
+bool HandHistoryReader::readHeader(HandHistoryHeader& header)
+{
+	// Check the magic bytes
+	if (this->readByte() != 'H' || this->readByte() != 'H') {
+		this->done = true;
+		return false;
+	}
+
+	header.version = this->readByte();
+	header.seats = this->readByte();
+	header.random_seed = this->readVarint();
+	header.small_blind = static_cast<uint16_t>(this->readVarint());
+
+	// Only this version, and tables that a hand may be decoded for, are supported
+	if (this->done == true || header.version != HandHistoryFormat::VERSION || header.seats < 2 || header.seats > HandHistoryHand::MAX_SEATS) {
+		this->done = true;
+		return false;
+	}
+	this->seats = header.seats;
+	return true;
+}
+
+bool HandHistoryReader::readHand(HandHistoryHand& hand)
+{
+	// The header must be read first
+	if (this->done == true || this->seats == 0 || this->offset >= this->size)
+		return false;
+
+	// Check for the end of the stream
+	if (this->data[this->offset] == HandHistoryFormat::END_OF_STREAM) {
+		++this->offset;
+		this->done = true;
+		this->complete = true;
+		return false;
+	}
+
+	// The table as it was dealt
+	hand.round_number = this->readVarint();
+	hand.dealer = this->readByte();
+	hand.seated_mask = static_cast<uint16_t>(this->readVarint());
+	for (uint8_t player_id = 0; player_id < this->seats; ++player_id)
+		hand.starting_stacks[player_id] = (hand.seated_mask & (1u << player_id)) ? static_cast<uint16_t>(this->readVarint()) : 0;
+	for (uint8_t player_id = 0; player_id < this->seats; ++player_id) {
+		if (hand.seated_mask & (1u << player_id)) {
+			hand.hands[player_id][0] = HandHistoryFormat::codeCard(this->readBits(HandHistoryFormat::CARD_BITS));
+			hand.hands[player_id][1] = HandHistoryFormat::codeCard(this->readBits(HandHistoryFormat::CARD_BITS));
+		}
+	}
+
+	// The events, until the end of the hand
+	hand.events.clear();
+	hand.dropped_events = 0;
+	for (auto& street_event : hand.street_events)
+		street_event = 0;
+	uint8_t streets = 0;
+	do {
+		uint8_t event = this->readByte();
+		if (this->done == true)
+			return false;
+
+		// The end of the hand
+		if (event == HandHistoryFormat::END)
+			break;
+
+		// The game ended during the hand, it was never resolved
+		if (event == HandHistoryFormat::END_OF_STREAM) {
+			this->done = true;
+			this->complete = true;
+			break;
+		}
+
+		// A new street
+		if ((event & 0xC0) == HandHistoryFormat::STREET) {
+			if (streets < hand.street_events.size())
+				hand.street_events[streets++] = static_cast<uint8_t>(hand.events.size());
+			continue;
+		}
+
+		// A player action
+		if ((event & 0xC0) != 0) {
+			this->done = true;
+			return false;
+		}
+		HandHistoryHand::Event decoded;
+		decoded.player_id = event >> 2;
+		decoded.action = static_cast<PokerGameBase::PlayerAction>((event & 0x03) + 1);
+		decoded.bet = decoded.action == PokerGameBase::PlayerAction::Bet ? static_cast<uint16_t>(this->readVarint()) : 0;
+
+		// The game does not cap raises, read past the actions of a hand too long to keep so that the hands after it
+		// are still read
+		if (hand.events.size() == hand.events.capacity()) {
+			if (hand.dropped_events < UINT16_MAX)
+				++hand.dropped_events;
+			continue;
+		}
+		hand.events.push_back(decoded);
+
+	} while (1);
+
+	// Streets that were not reached start after the last event
+	for (; streets < hand.street_events.size(); ++streets)
+		hand.street_events[streets] = static_cast<uint8_t>(hand.events.size());
+
+	// A hand that was quit has no result
+	if (this->complete == true) {
+		hand.board.clear();
+		hand.winnings = 0;
+		hand.winner = HandHistoryFormat::NO_WINNER;
+		hand.resolved = false;
+		return true;
+	}
+
+	// The board and the result
+	uint8_t board_size = this->readByte();
+	if (board_size > 5) {
+		this->done = true;
+		return false;
+	}
+	hand.board.clear();
+	for (uint8_t i = 0; i < board_size; ++i)
+		hand.board.push_back(HandHistoryFormat::codeCard(this->readBits(HandHistoryFormat::CARD_BITS)));
+	hand.winnings = static_cast<uint16_t>(this->readVarint());
+	hand.winner = this->readByte();
+	hand.resolved = true;
+
+	return this->done == false;
+}
+
+bool HandHistoryReader::isComplete() const
+{
+	return this->complete;
+}
+
+size_t HandHistoryReader::getOffset() const
+{
+	return this->offset;
+}
+
+bool HandHistoryReader::isTruncated() const
+{
+	return this->truncated;
+}
+
+uint8_t HandHistoryReader::readByte()
+{
+	// Discard any bits left over from bit reads
+	this->pending_bits = 0;
+	this->pending_bit_count = 0;
+
+	// Reading past the end of the stream marks it malformed
+	if (this->offset >= this->size) {
+		this->done = true;
+		this->truncated = true;
+		return 0;
+	}
+	return this->data[this->offset++];
+}
+
+uint32_t HandHistoryReader::readVarint()
+{
+	uint32_t result = 0;
+	for (uint8_t shift = 0; shift < 35; shift += 7) {
+		uint8_t byte = this->readByte();
+		result |= static_cast<uint32_t>(byte & 0x7F) << shift;
+		if ((byte & 0x80) == 0)
+			break;
+	}
+	return result;
+}
+
+uint8_t HandHistoryReader::readBits(uint8_t bit_count)
+{
+	// Refill from the next byte when there are not enough bits left over
+	if (this->pending_bit_count < bit_count) {
+		uint16_t pending_bits = this->pending_bits;
+		uint8_t pending_bit_count = this->pending_bit_count;
+		uint16_t byte = this->readByte();
+		this->pending_bits = static_cast<uint16_t>(pending_bits | (byte << pending_bit_count));
+		this->pending_bit_count = static_cast<uint8_t>(pending_bit_count + 8);
+	}
+
+	uint8_t result = static_cast<uint8_t>(this->pending_bits & ((1u << bit_count) - 1));
+	this->pending_bits >>= bit_count;
+	this->pending_bit_count -= bit_count;
+	return result;
+}
\ No newline at end of file
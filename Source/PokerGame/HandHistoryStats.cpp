@@ -0,0 +1,143 @@
+/**
+ *  A simple interactive texas holdem poker program.
+ *  Copyright (C) 2020, Matt Zimmerer, mzimmere@gmail.com
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ **/
+#include "PokerGame/HandHistoryStats.h"
+
+#include "PokerGame/HandEvaluator.h"
+
+void HandHistoryStats::add(const HandHistoryHand& hand, uint8_t columns)
+{
+	++this->hands;
+	for (uint8_t player_id = 0; player_id < HandHistoryHand::MAX_SEATS; ++player_id)
+		if (hand.seated_mask & (1u << player_id))
+			++this->dealt[player_id];
+
+	// A hand too long to keep every action of counts toward the hands dealt and the pots, but who acted and who folded
+	// is not all known
+	if (hand.dropped_events > 0)
+		columns &= static_cast<uint8_t>(~(PREFLOP | SHOWDOWN));
+
+	// Pre-flop, the blinds are the first two bets and do not count as putting chips in voluntarily
+	if (columns & PREFLOP) {
+		utl::array<uint16_t, HandHistoryHand::MAX_SEATS> invested{};
+		uint16_t current_bet = 0;
+		uint16_t voluntary = 0;
+		uint16_t raised = 0;
+		for (size_t i = 0; i < hand.street_events[0]; ++i) {
+			const HandHistoryHand::Event& event = hand.events[i];
+			if (event.player_id >= HandHistoryHand::MAX_SEATS)
+				continue;
+			switch (event.action)
+			{
+			case PokerGameBase::PlayerAction::CheckOrCall:
+
+				// Checking the big blind's option is not voluntary
+				if (invested[event.player_id] < current_bet)
+					voluntary |= static_cast<uint16_t>(1u << event.player_id);
+				invested[event.player_id] = current_bet;
+				break;
+
+			case PokerGameBase::PlayerAction::Bet:
+				if (i < 2) {
+					invested[event.player_id] = event.bet;
+				}
+				else {
+					voluntary |= static_cast<uint16_t>(1u << event.player_id);
+					raised |= static_cast<uint16_t>(1u << event.player_id);
+					invested[event.player_id] = current_bet + event.bet;
+				}
+				if (invested[event.player_id] > current_bet)
+					current_bet = invested[event.player_id];
+				break;
+
+			default:
+				break;
+			}
+		}
+		for (; voluntary != 0; voluntary &= voluntary - 1)
+			++this->vpip[BasicPokerGameState<HandHistoryHand::MAX_SEATS>::lowestSeat(voluntary)];
+		for (; raised != 0; raised &= raised - 1)
+			++this->pfr[BasicPokerGameState<HandHistoryHand::MAX_SEATS>::lowestSeat(raised)];
+	}
+
+	// A showdown is a full board with more than one player that did not fold
+	if ((columns & SHOWDOWN) && hand.resolved == true && hand.board.size() == 5) {
+		uint16_t showing = hand.seated_mask;
+		for (const auto& event : hand.events)
+			if (event.action == PokerGameBase::PlayerAction::Fold && event.player_id < HandHistoryHand::MAX_SEATS)
+				showing &= static_cast<uint16_t>(~(1u << event.player_id));
+
+		if (BasicPokerGameState<HandHistoryHand::MAX_SEATS>::countSeats(showing) > 1) {
+
+			// Rank each shown hand, the best hands won or split the pot
+			utl::array<uint32_t, HandHistoryHand::MAX_SEATS> values{};
+			uint32_t best = 0;
+			for (uint16_t remaining = showing; remaining != 0; remaining &= remaining - 1) {
+				uint8_t player_id = BasicPokerGameState<HandHistoryHand::MAX_SEATS>::lowestSeat(remaining);
+				values[player_id] = HandEvaluator::evaluate(hand.hands[player_id], hand.board);
+				if (values[player_id] > best)
+					best = values[player_id];
+			}
+			for (uint16_t remaining = showing; remaining != 0; remaining &= remaining - 1) {
+				uint8_t player_id = BasicPokerGameState<HandHistoryHand::MAX_SEATS>::lowestSeat(remaining);
+				size_t ranking = static_cast<size_t>(HandEvaluator::ranking(values[player_id]));
+				++this->showdowns[ranking];
+				if (values[player_id] == best)
+					++this->showdown_wins[ranking];
+			}
+		}
+	}
+
+	// The street a hand reached is the street its board was dealt to
+	if ((columns & POTS) && hand.resolved == true) {
+		size_t street = hand.board.size() < 3 ? 0 : hand.board.size() - 2;
+		++this->street_hands[street];
+		this->street_pots[street] += hand.winnings;
+	}
+}
+
+size_t HandHistoryStats::addStream(const uint8_t* data, size_t size, uint8_t columns)
+{
+	HandHistoryReader reader(data, size);
+	HandHistoryHeader header;
+	if (reader.readHeader(header) == false)
+		return 0;
+
+	// The hand is reused, decoding does not allocate
+	HandHistoryHand hand;
+	while (reader.readHand(hand))
+		this->add(hand, columns);
+	return reader.isComplete() ? reader.getOffset() : 0;
+}
+
+void HandHistoryStats::merge(const HandHistoryStats& other)
+{
+	this->hands += other.hands;
+	for (size_t i = 0; i < HandHistoryHand::MAX_SEATS; ++i) {
+		this->dealt[i] += other.dealt[i];
+		this->vpip[i] += other.vpip[i];
+		this->pfr[i] += other.pfr[i];
+	}
+	for (size_t i = 0; i < RANKINGS; ++i) {
+		this->showdowns[i] += other.showdowns[i];
+		this->showdown_wins[i] += other.showdown_wins[i];
+	}
+	for (size_t i = 0; i < STREETS; ++i) {
+		this->street_hands[i] += other.street_hands[i];
+		this->street_pots[i] += other.street_pots[i];
+	}
+}
\ No newline at end of file
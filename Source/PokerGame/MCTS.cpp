@@ -0,0 +1,445 @@
+/**
+ *  A simple interactive texas holdem poker program.
+ *  Copyright (C) 2020, Matt Zimmerer, mzimmere@gmail.com
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ **/
+
+#include "PokerGame/MCTS.h"
+
+#ifndef EMBEDDED_BUILD
+#include <chrono>
+#include <thread>
+#include <vector>
+#endif
+
+#include "PokerGame/AI.h"
+#include "PokerGame/PokerGameImpl.h"
+
+/// The square of the UCB1 exploration constant, in tenths
+static constexpr uint64_t EXPLORATION_TENTHS = 20;
+
+/// The searching player's action at the root of a rollout
+struct Rollout {
+
+	/// The searching player
+	uint8_t player_id{ 0 };
+
+	/// The root action
+	utl::pair<PokerGameBase::PlayerAction, uint16_t> action;
+
+	/// True until the searching player has taken the root action
+	bool pending{ false };
+};
+
+/** Decider that takes the root action for the searching player, then lets the quick AI play every seat
+ *  @tparam SEATS The number of seats at the table
+ */
+template <uint8_t SEATS>
+class RolloutDecider
+{
+public:
+
+	/** Constructor
+	 *  @param rollout The rollout being played
+	 */
+	explicit RolloutDecider(Rollout* rollout_in) : rollout(rollout_in) {}
+
+	/** Decide an action
+	 *  @param state The full game state
+	 *  @param player_id The id of the player that is acting
+	 *  @param rng A random number generator
+	 *  @return The first element is the action, the second is the bet, if any
+	 */
+	utl::pair<PokerGameBase::PlayerAction, uint16_t> decide(const BasicPokerGameState<SEATS>& state, uint8_t player_id, Random& rng)
+	{
+		// The searching player acts first, with the root action
+		if (this->rollout->pending && player_id == this->rollout->player_id) {
+			this->rollout->pending = false;
+			return this->rollout->action;
+		}
+		return AI::quickDecision<SEATS>(state, rng, player_id);
+	}
+
+private:
+
+	/// The rollout being played
+	Rollout* rollout;
+};
+
+/** A game that plays out the rest of a hand from a snapshot
+ *  @tparam SEATS The number of seats at the table
+ */
+template <uint8_t SEATS>
+class RolloutGame : public BasicPokerGame<SEATS, RolloutDecider<SEATS>, NullObserver>
+{
+public:
+
+	/// The game played out
+	using Game = BasicPokerGame<SEATS, RolloutDecider<SEATS>, NullObserver>;
+
+	/** Constructor
+	 *  @param rollout The rollout being played
+	 */
+	explicit RolloutGame(Rollout* rollout) : Game(0, 0, 0, RolloutDecider<SEATS>(rollout), NullObserver()) {}
+
+	/** Play out the hand of a snapshot
+	 *  @param snapshot The snapshot, in the betting round of the searching player
+	 *  @param player_id The searching player
+	 *  @return The searching player's stack after the hand
+	 */
+	uint16_t playOut(const typename Game::Snapshot& snapshot, uint8_t player_id)
+	{
+		this->restoreSnapshot(snapshot);
+		while (this->step() == PokerGameBase::StepResult::Running) {
+		}
+		return this->current_state.player_states[player_id].stack;
+	}
+};
+
+/** Draw a seed for another random number generator, in steps that fit a 16 bit int
+ *  @param rng A random number generator
+ *  @return The seed
+ */
+static uint32_t drawSeed(Random& rng)
+{
+	uint32_t high = static_cast<uint32_t>(rng.getRandomNumberInRange(0, 0x7FFF));
+	uint32_t low = static_cast<uint32_t>(rng.getRandomNumberInRange(0, 0x7FFF));
+	return (high << 15) | low;
+}
+
+/** Approximate a natural logarithm, interpolating between powers of two
+ *  @param value The value, at least 1
+ *  @return The natural logarithm in thousandths
+ */
+static uint32_t logarithm(uint32_t value)
+{
+	// Find the power of two below the value
+	uint8_t power = 0;
+	while ((value >> (power + 1)) != 0)
+		++power;
+
+	// Interpolate the base 2 logarithm in thousandths, then scale it by ln(2)
+	uint32_t fraction = static_cast<uint32_t>((static_cast<uint64_t>(value - (1ul << power)) * 1000) >> power);
+	return (static_cast<uint32_t>(power) * 1000 + fraction) * 693 / 1000;
+}
+
+/** Find an integer square root
+ *  @param value The value
+ *  @return The square root, rounded down
+ */
+static uint32_t squareRoot(uint64_t value)
+{
+	// Find each bit of the root from the highest
+	uint64_t result = 0;
+	uint64_t bit = 1ull << 62;
+	while (bit > value)
+		bit >>= 2;
+	while (bit != 0) {
+		if (value >= result + bit) {
+			value -= result + bit;
+			result = (result >> 1) + bit;
+		}
+		else {
+			result >>= 1;
+		}
+		bit >>= 2;
+	}
+	return static_cast<uint32_t>(result);
+}
+
+/** Choose the next action to visit with UCB1, every legal action is visited once first
+ *  @param statistics The visits and rewards so far
+ *  @param legal The legal actions, bit N represents action N
+ *  @return The action
+ */
+static MCTS::Action select(const MCTS::Statistics& statistics, uint8_t legal)
+{
+	// Visit each legal action once
+	uint32_t total = 0;
+	for (uint8_t action = 0; action < MCTS::ACTIONS; ++action) {
+		if ((legal & (1u << action)) == 0)
+			continue;
+		if (statistics.visits[action] == 0)
+			return static_cast<MCTS::Action>(action);
+		total += statistics.visits[action];
+	}
+
+	// Then the action with the highest upper confidence bound, its mean plus an exploration term in units of 1/10000
+	uint64_t scaled_logarithm = EXPLORATION_TENTHS * 10000ull * logarithm(total);
+	MCTS::Action result = MCTS::CALL;
+	uint32_t best_bound = 0;
+	for (uint8_t action = 0; action < MCTS::ACTIONS; ++action) {
+		if ((legal & (1u << action)) == 0)
+			continue;
+		uint32_t bound = statistics.mean(static_cast<MCTS::Action>(action)) + squareRoot(scaled_logarithm / statistics.visits[action]);
+		if (bound > best_bound) {
+			best_bound = bound;
+			result = static_cast<MCTS::Action>(action);
+		}
+	}
+	return result;
+}
+
+/** Find the legal root actions of a player, there is nothing to fold to without a bet and no bet without the chips to raise
+ *  @tparam SEATS The number of seats at the table
+ *  @param state The game state
+ *  @param player_id The id of the player that is acting
+ *  @return The legal actions, bit N represents action N
+ */
+template <uint8_t SEATS>
+static uint8_t legalActions(const BasicPokerGameState<SEATS>& state, uint8_t player_id)
+{
+	uint16_t to_call = state.current_bet - state.current_pot_shares[player_id];
+	uint8_t result = 1u << MCTS::CALL;
+	if (to_call > 0)
+		result |= 1u << MCTS::FOLD;
+	if (state.player_states[player_id].stack > to_call)
+		result |= 1u << MCTS::BET;
+	return result;
+}
+
+/** Convert a root action to the game's action, a bet is the AI's smallest bet of half the current bet
+ *  @tparam SEATS The number of seats at the table
+ *  @param state The game state
+ *  @param action The root action
+ *  @return The first element is the action, the second is the bet, if any
+ */
+template <uint8_t SEATS>
+static utl::pair<PokerGameBase::PlayerAction, uint16_t> gameAction(const BasicPokerGameState<SEATS>& state, MCTS::Action action)
+{
+	utl::pair<PokerGameBase::PlayerAction, uint16_t> result;
+	result.second = 0;
+	if (action == MCTS::FOLD) {
+		result.first = PokerGameBase::PlayerAction::Fold;
+	}
+	else if (action == MCTS::CALL) {
+		result.first = PokerGameBase::PlayerAction::CheckOrCall;
+	}
+	else {
+		result.first = PokerGameBase::PlayerAction::Bet;
+		result.second = state.current_bet / 2;
+	}
+	return result;
+}
+
+/** Sample the cards that a player can not see into a snapshot, the other players' hands and the rest of the deck
+ *  @tparam SEATS The number of seats at the table
+ *  @param player_id The searching player
+ *  @param rng A random number generator
+ *  @param snapshot The snapshot holding the state, its hands and deck are replaced
+ */
+template <uint8_t SEATS>
+static void sampleHiddenCards(uint8_t player_id, Random& rng, PokerGameSnapshot<SEATS>& snapshot)
+{
+	// Order the deck with the cards the player can not see first, and the player's hand and the board last
+	const BasicPokerGameState<SEATS>& state = snapshot.state;
+	uint8_t unseen = 0;
+	uint8_t seen = Deck::DECK_SIZE;
+	for (uint8_t i = 0; i < Deck::DECK_SIZE; ++i) {
+		Card card(static_cast<Card::Value>(i % 13), static_cast<Card::Suit>(i / 13));
+		bool known = false;
+		for (const Card& held : state.player_states[player_id].hand)
+			known = known || (held.getValue() == card.getValue() && held.getSuit() == card.getSuit());
+		for (const Card& shown : state.board)
+			known = known || (shown.getValue() == card.getValue() && shown.getSuit() == card.getSuit());
+		if (known)
+			snapshot.deck.cards[--seen] = card;
+		else
+			snapshot.deck.cards[unseen++] = card;
+	}
+
+	// Shuffle only as many unseen cards as the other hands and the rest of the board need
+	uint8_t opponents = static_cast<uint8_t>(BasicPokerGameState<SEATS>::countSeats(state.in_hand_mask) - 1);
+	uint8_t needed = static_cast<uint8_t>(2 * opponents + 5 - state.board.size());
+	for (uint8_t cursor = 0; cursor < needed; ++cursor) {
+		uint8_t random_card = static_cast<uint8_t>(rng.getRandomNumberInRange(cursor, unseen - 1));
+		Card tmp = snapshot.deck.cards[cursor];
+		snapshot.deck.cards[cursor] = snapshot.deck.cards[random_card];
+		snapshot.deck.cards[random_card] = tmp;
+	}
+
+	// Deal the other hands, the board is dealt from the rest
+	snapshot.deck.deal_cursor = 0;
+	for (uint8_t seat = 0; seat < SEATS; ++seat) {
+		if (seat == player_id || (state.in_hand_mask & (1u << seat)) == 0)
+			continue;
+		snapshot.state.player_states[seat].hand[0] = snapshot.deck.cards[snapshot.deck.deal_cursor++];
+		snapshot.state.player_states[seat].hand[1] = snapshot.deck.cards[snapshot.deck.deal_cursor++];
+	}
+}
+
+/** Search the actions of a player in a single worker
+ *  @tparam SEATS The number of seats at the table
+ *  @param state The game state
+ *  @param player_id The id of the player that is acting
+ *  @param iterations The number of rollouts to play
+ *  @param milliseconds On desktop, the search stops early after this many milliseconds, zero only limits the rollouts
+ *  @param seed The seed of the worker's random number generator
+ *  @return The visits and rewards of each action
+ */
+template <uint8_t SEATS>
+static MCTS::Statistics searchWorker(const BasicPokerGameState<SEATS>& state, uint8_t player_id, uint32_t iterations, uint16_t milliseconds,
+	uint32_t seed)
+{
+	MCTS::Statistics result;
+	Random rng(seed);
+#ifndef EMBEDDED_BUILD
+	std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(milliseconds);
+#else
+	(void)milliseconds;
+#endif
+
+	// The player ends the hand with between its stack less the most it can lose, and its stack plus the pot and what it can win
+	int32_t stack = state.player_states[player_id].stack;
+	int32_t share = state.current_pot_shares[player_id];
+	int32_t lowest = stack;
+	int32_t highest = stack + state.chipsRemaining();
+	for (uint8_t seat = 0; seat < SEATS; ++seat) {
+		if (seat == player_id || (state.in_hand_mask & (1u << seat)) == 0)
+			continue;
+
+		// Each player can only be matched up to what the other has in front and in the pot
+		int32_t other_total = static_cast<int32_t>(state.player_states[seat].stack) + state.current_pot_shares[seat];
+		int32_t to_lose = other_total - share < stack ? other_total - share : stack;
+		int32_t to_win = stack + share - state.current_pot_shares[seat] < state.player_states[seat].stack
+			? stack + share - state.current_pot_shares[seat] : state.player_states[seat].stack;
+		if (to_lose > 0 && stack - to_lose < lowest)
+			lowest = stack - to_lose;
+		if (to_win > 0)
+			highest += to_win;
+	}
+	if (highest == lowest)
+		++highest;
+
+	// Every rollout resumes the betting round at the searching player
+	Rollout rollout;
+	rollout.player_id = player_id;
+	RolloutGame<SEATS> game(&rollout);
+	PokerGameSnapshot<SEATS> snapshot;
+	snapshot.state = state;
+	snapshot.progress.stage = PokerGameBase::Stage::Betting;
+	snapshot.progress.acting_player = player_id;
+	snapshot.progress.actionable_players = BasicPokerGameState<SEATS>::countSeats(state.can_act_mask);
+	snapshot.progress.players_to_act = snapshot.progress.actionable_players;
+
+	uint8_t legal = legalActions(state, player_id);
+	for (uint32_t iteration = 0; iteration < iterations; ++iteration) {
+#ifndef EMBEDDED_BUILD
+		if (milliseconds != 0 && std::chrono::steady_clock::now() >= deadline)
+			break;
+#endif
+
+		// Choose an action, and play out the hand after it with freshly sampled hidden cards
+		MCTS::Action action = select(result, legal);
+		rollout.action = gameAction(state, action);
+		rollout.pending = true;
+		snapshot.state = state;
+		sampleHiddenCards(player_id, rng, snapshot);
+		snapshot.rng = Random(drawSeed(rng));
+		int32_t final_stack = game.playOut(snapshot, player_id);
+
+		// Reward the action with where the player's stack ended in its range
+		++result.visits[action];
+		result.rewards[action] += static_cast<uint64_t>(final_stack - lowest) * 10000 / (highest - lowest);
+	}
+	return result;
+}
+
+void MCTS::Statistics::merge(const Statistics& other)
+{
+	for (uint8_t action = 0; action < ACTIONS; ++action) {
+		this->visits[action] += other.visits[action];
+		this->rewards[action] += other.rewards[action];
+	}
+}
+
+uint16_t MCTS::Statistics::mean(Action action) const
+{
+	if (this->visits[action] == 0)
+		return 0;
+	return static_cast<uint16_t>(this->rewards[action] / this->visits[action]);
+}
+
+MCTS::Action MCTS::Statistics::best() const
+{
+	Action result = CALL;
+	for (uint8_t action = 0; action < ACTIONS; ++action) {
+		if (this->visits[action] > this->visits[result]
+			|| (this->visits[action] == this->visits[result] && this->mean(static_cast<Action>(action)) > this->mean(result)))
+			result = static_cast<Action>(action);
+	}
+	return result;
+}
+
+template <uint8_t SEATS>
+MCTS::Statistics MCTS::search(const BasicPokerGameState<SEATS>& state, uint8_t player_id, uint32_t iterations, uint16_t milliseconds,
+	uint8_t threads, Random& rng)
+{
+#ifndef EMBEDDED_BUILD
+	// Split the rollouts between root parallel workers, each grows its own tree and the trees are merged
+	if (threads == 0)
+		threads = static_cast<uint8_t>(std::thread::hardware_concurrency() > 255 ? 255 : std::thread::hardware_concurrency());
+	if (threads > iterations)
+		threads = static_cast<uint8_t>(iterations);
+	if (threads > 1) {
+		std::vector<Statistics> trees(threads);
+		std::vector<std::thread> workers;
+		for (uint8_t thread = 0; thread < threads; ++thread) {
+			uint32_t share = iterations / threads + (thread < iterations % threads ? 1 : 0);
+			uint32_t seed = drawSeed(rng);
+			workers.emplace_back([&state, &trees, player_id, share, milliseconds, thread, seed]() {
+				trees[thread] = searchWorker(state, player_id, share, milliseconds, seed);
+			});
+		}
+		Statistics result;
+		for (uint8_t thread = 0; thread < threads; ++thread) {
+			workers[thread].join();
+			result.merge(trees[thread]);
+		}
+		return result;
+	}
+#else
+	(void)threads;
+#endif
+	return searchWorker(state, player_id, iterations, milliseconds, drawSeed(rng));
+}
+
+template <uint8_t SEATS>
+utl::pair<PokerGameBase::PlayerAction, uint16_t> MCTS::decide(const BasicPokerGameState<SEATS>& state, uint8_t player_id, uint32_t iterations,
+	uint16_t milliseconds, Random& rng)
+{
+	// Without a choice to make, check
+	if (legalActions(state, player_id) == (1u << CALL))
+		return gameAction(state, CALL);
+
+	return gameAction(state, search(state, player_id, iterations, milliseconds, 0, rng).best());
+}
+
+// Instantiate the supported table sizes
+#ifdef EMBEDDED_BUILD
+template MCTS::Statistics MCTS::search(const BasicPokerGameState<TABLE_SEATS>&, uint8_t, uint32_t, uint16_t, uint8_t, Random&);
+template utl::pair<PokerGameBase::PlayerAction, uint16_t> MCTS::decide(const BasicPokerGameState<TABLE_SEATS>&, uint8_t, uint32_t, uint16_t, Random&);
+#else
+template MCTS::Statistics MCTS::search(const BasicPokerGameState<2>&, uint8_t, uint32_t, uint16_t, uint8_t, Random&);
+template MCTS::Statistics MCTS::search(const BasicPokerGameState<6>&, uint8_t, uint32_t, uint16_t, uint8_t, Random&);
+template MCTS::Statistics MCTS::search(const BasicPokerGameState<9>&, uint8_t, uint32_t, uint16_t, uint8_t, Random&);
+template utl::pair<PokerGameBase::PlayerAction, uint16_t> MCTS::decide(const BasicPokerGameState<2>&, uint8_t, uint32_t, uint16_t, Random&);
+template utl::pair<PokerGameBase::PlayerAction, uint16_t> MCTS::decide(const BasicPokerGameState<6>&, uint8_t, uint32_t, uint16_t, Random&);
+template utl::pair<PokerGameBase::PlayerAction, uint16_t> MCTS::decide(const BasicPokerGameState<9>&, uint8_t, uint32_t, uint16_t, Random&);
+#if TABLE_SEATS != 2 && TABLE_SEATS != 6 && TABLE_SEATS != 9
+template MCTS::Statistics MCTS::search(const BasicPokerGameState<TABLE_SEATS>&, uint8_t, uint32_t, uint16_t, uint8_t, Random&);
+template utl::pair<PokerGameBase::PlayerAction, uint16_t> MCTS::decide(const BasicPokerGameState<TABLE_SEATS>&, uint8_t, uint32_t, uint16_t, Random&);
+#endif
+#endif
\ No newline at end of file
@@ -0,0 +1,72 @@
+/**
+ *  A simple interactive texas holdem poker program.
+ *  Copyright (C) 2020, Matt Zimmerer, mzimmere@gmail.com
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ **/
+#include "PokerGame/NullIO.h"
+
+utl::pair<PokerGame::PlayerAction, uint16_t> NullIO::userDecision(const PokerGameState& state, void* opaque)
+{
+	++reinterpret_cast<NullIO*>(opaque)->decisions;
+	return utl::pair<PokerGame::PlayerAction, uint16_t>(PokerGame::PlayerAction::CheckOrCall, 0);
+}
+
+void NullIO::playerAction(const utl::string<MAX_NAME_SIZE>& player_name, PokerGame::PlayerAction action, uint16_t bet,
+	const PokerGameState& state, void* opaque)
+{
+	++reinterpret_cast<NullIO*>(opaque)->events;
+}
+
+void NullIO::subRoundChange(PokerGame::SubRound new_sub_round, const PokerGameState& state, void* opaque)
+{
+	++reinterpret_cast<NullIO*>(opaque)->events;
+}
+
+bool NullIO::roundEnd(bool draw, const utl::string<MAX_NAME_SIZE>& winner, uint16_t winnings, RankedHand::Ranking ranking,
+	const PokerGameState& state, void* opaque)
+{
+	++reinterpret_cast<NullIO*>(opaque)->rounds;
+	return true;
+}
+
+void NullIO::gameEnd(const utl::string<MAX_NAME_SIZE>& winner, void* opaque)
+{
+	reinterpret_cast<NullIO*>(opaque)->game_over = true;
+}
+
+PokerGame::PlayerAction NullIO::pollContinue()
+{
+	return PokerGame::PlayerAction::CheckOrCall;
+}
+
+uint32_t NullIO::getDecisions() const
+{
+	return this->decisions;
+}
+
+uint32_t NullIO::getEvents() const
+{
+	return this->events;
+}
+
+uint32_t NullIO::getRounds() const
+{
+	return this->rounds;
+}
+
+bool NullIO::isGameOver() const
+{
+	return this->game_over;
+}
\ No newline at end of file
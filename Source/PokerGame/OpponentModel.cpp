@@ -0,0 +1,80 @@
+/**
+ *  A simple interactive texas holdem poker program.
+ *  Copyright (C) 2020, Matt Zimmerer, mzimmere@gmail.com
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ **/
+
+#include "PokerGame/OpponentModel.h"
+
+void SeatProfile::observe(uint16_t& average, bool happened)
+{
+	// Move the average a fraction of the way towards 10000 if the event happened, or towards 0 if it did not
+	int32_t target = happened ? 10000 : 0;
+	average = static_cast<uint16_t>(average + (target - static_cast<int32_t>(average)) / (1 << DECAY_SHIFT));
+}
+
+void SeatProfile::observeHand(bool voluntary, bool raised)
+{
+	observe(this->vpip, voluntary);
+	observe(this->pfr, raised);
+}
+
+void SeatProfile::observeAction(PokerGameBase::PlayerAction action, uint16_t chips, bool facing_bet)
+{
+	switch (action)
+	{
+		// A fold only counts against a bet
+	case PokerGameBase::PlayerAction::Fold:
+		if (facing_bet)
+			observe(this->fold_to_bet, true);
+		break;
+
+		// A call is passive, a check is neither passive nor aggressive
+	case PokerGameBase::PlayerAction::CheckOrCall:
+		if (chips == 0)
+			break;
+		observe(this->aggression, false);
+		if (facing_bet)
+			observe(this->fold_to_bet, false);
+		break;
+
+		// A bet or raise is aggressive
+	case PokerGameBase::PlayerAction::Bet:
+		observe(this->aggression, true);
+		if (facing_bet)
+			observe(this->fold_to_bet, false);
+		break;
+
+	default:
+		break;
+	}
+}
+
+uint16_t SeatProfile::aggressionFactor() const
+{
+	// Bets and raises over calls, a seat that never calls has the largest factor
+	uint32_t calls = 10000 - this->aggression;
+	uint32_t result = calls == 0 ? 10000 : static_cast<uint32_t>(this->aggression) * 100 / calls;
+	return static_cast<uint16_t>(result > 10000 ? 10000 : result);
+}
+
+void SeatProfile::accumulate(const SeatProfile& other, uint8_t count)
+{
+	// Move each mean towards the other profile by its share of the profiles added
+	this->vpip = static_cast<uint16_t>(this->vpip + (static_cast<int32_t>(other.vpip) - this->vpip) / count);
+	this->pfr = static_cast<uint16_t>(this->pfr + (static_cast<int32_t>(other.pfr) - this->pfr) / count);
+	this->aggression = static_cast<uint16_t>(this->aggression + (static_cast<int32_t>(other.aggression) - this->aggression) / count);
+	this->fold_to_bet = static_cast<uint16_t>(this->fold_to_bet + (static_cast<int32_t>(other.fold_to_bet) - this->fold_to_bet) / count);
+}
\ No newline at end of file
@@ -0,0 +1,124 @@
+/**
+ *  A simple interactive texas holdem poker program.
+ *  Copyright (C) 2020, Matt Zimmerer, mzimmere@gmail.com
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ **/
+
+#include "PokerGame/PushFold.h"
+
+#include "Platform/Platform.h"
+
+/// The hand classes that the small blind pushes at each stack depth from 1 big blind, bit N of byte B is hand class
+/// 8 * B + N, printed by the util's pushfold command
+static const uint8_t push_chart[PushFold::MAX_DEPTH][PushFold::CHART_BYTES] ROM_DATA = {
+	{ 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x01 },
+	{ 0x81, 0x5F, 0xF8, 0xFB, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x01 },
+	{ 0x01, 0x5E, 0xE0, 0x13, 0x7C, 0xC6, 0xCF, 0xFF, 0xF9, 0x3F, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x01 },
+	{ 0x01, 0x5E, 0xC0, 0x13, 0x78, 0x86, 0xCF, 0xFF, 0xF9, 0x3F, 0xFF, 0xF7, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x01 },
+	{ 0x01, 0x5C, 0xC0, 0x1B, 0x78, 0x07, 0xCF, 0xF7, 0xF9, 0x3F, 0xFF, 0xE7, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x01 },
+	{ 0x01, 0x5C, 0x80, 0x1B, 0x70, 0x07, 0xEF, 0xE7, 0xF9, 0x3F, 0xFF, 0xC7, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x01 },
+	{ 0x01, 0x5C, 0x80, 0x1B, 0x70, 0x07, 0xEE, 0xC7, 0xF9, 0x3F, 0xFF, 0xC7, 0xFF, 0xFE, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x01 },
+	{ 0x01, 0x58, 0x00, 0x13, 0x70, 0x07, 0xCE, 0xC3, 0xF9, 0x3F, 0xFE, 0xC7, 0xFF, 0xFC, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x01 },
+	{ 0x01, 0x58, 0x00, 0x1B, 0x60, 0x07, 0xCC, 0xC3, 0xF9, 0x3B, 0xFE, 0xC7, 0xFF, 0xFC, 0xDF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x01 },
+	{ 0x01, 0x58, 0x00, 0x1B, 0x60, 0x07, 0xCC, 0x83, 0xF9, 0x39, 0xFF, 0xC7, 0xFF, 0xFC, 0xDF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x01 },
+	{ 0x01, 0x58, 0x00, 0x13, 0x60, 0x07, 0xCC, 0x81, 0xF9, 0x30, 0xFE, 0xC7, 0xFF, 0xF8, 0x9F, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x01 },
+	{ 0x01, 0x50, 0x00, 0x13, 0x60, 0x07, 0xCC, 0x81, 0xF9, 0x30, 0xFE, 0xC7, 0xFF, 0xF8, 0x9F, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x01 },
+	{ 0x01, 0x50, 0x00, 0x12, 0x60, 0x06, 0xCC, 0x81, 0xF9, 0x30, 0xFE, 0xC7, 0xFF, 0xF0, 0x9F, 0xFF, 0xFB, 0xFF, 0xFF, 0xFF, 0xFF, 0x01 },
+	{ 0x01, 0x50, 0x00, 0x12, 0x40, 0x06, 0xCC, 0x81, 0xF1, 0x30, 0x7E, 0xC6, 0xFF, 0xF0, 0x1F, 0xFF, 0xF3, 0xFF, 0xFF, 0xFF, 0xFF, 0x01 },
+	{ 0x01, 0x50, 0x00, 0x12, 0x40, 0x06, 0xC8, 0x81, 0x71, 0x30, 0x7E, 0x86, 0xFF, 0xF0, 0x1F, 0xFE, 0xF3, 0xFF, 0xFF, 0xFF, 0xFF, 0x01 },
+	{ 0x01, 0x50, 0x00, 0x12, 0x40, 0x06, 0xC8, 0x01, 0x71, 0x30, 0x7E, 0x86, 0xFF, 0xF0, 0x1F, 0xFF, 0xF3, 0xFF, 0xFF, 0xFF, 0xFF, 0x01 },
+	{ 0x01, 0x50, 0x00, 0x12, 0x40, 0x06, 0x88, 0x01, 0x71, 0x20, 0x7E, 0x86, 0xFF, 0xF0, 0x1F, 0xFE, 0xE3, 0xFF, 0xFF, 0xFF, 0xFF, 0x01 },
+	{ 0x01, 0x50, 0x00, 0x12, 0x40, 0x06, 0x88, 0x01, 0x71, 0x20, 0x3E, 0x86, 0xFF, 0xF0, 0x1F, 0xFC, 0xE3, 0xFF, 0xFF, 0xFF, 0xFF, 0x01 },
+	{ 0x01, 0x50, 0x00, 0x12, 0x40, 0x06, 0x88, 0x01, 0x71, 0x20, 0x3C, 0x84, 0xFF, 0xF0, 0x1F, 0xFC, 0xE3, 0xFF, 0xFF, 0xFF, 0xFF, 0x01 },
+	{ 0x01, 0x50, 0x00, 0x12, 0x40, 0x06, 0x88, 0x01, 0x71, 0x20, 0x3C, 0x84, 0xFF, 0xF0, 0x1F, 0xFC, 0xE3, 0x7F, 0xFF, 0xFF, 0xFF, 0x01 },
+	{ 0x01, 0x50, 0x00, 0x12, 0x40, 0x06, 0x88, 0x01, 0x71, 0x20, 0x1C, 0x84, 0xDF, 0xE0, 0x1F, 0xFC, 0xC3, 0x7F, 0xFE, 0xFF, 0xFF, 0x01 },
+	{ 0x01, 0x50, 0x00, 0x12, 0x40, 0x06, 0x88, 0x01, 0x71, 0x20, 0x1C, 0x84, 0xDF, 0xF0, 0x1F, 0xFC, 0xE3, 0x7F, 0xFE, 0xFF, 0xFF, 0x01 },
+	{ 0x01, 0x50, 0x00, 0x12, 0x40, 0x06, 0x88, 0x01, 0x71, 0x20, 0x1C, 0x84, 0x9F, 0xF0, 0x1F, 0xFC, 0xC3, 0x7F, 0xFE, 0xFF, 0xFF, 0x01 },
+	{ 0x01, 0x50, 0x00, 0x12, 0x40, 0x04, 0x88, 0x01, 0x71, 0x20, 0x1C, 0x84, 0xBF, 0xF0, 0x1F, 0xFC, 0xC3, 0x7F, 0xFE, 0xFF, 0xFF, 0x01 },
+	{ 0x01, 0x50, 0x00, 0x12, 0x40, 0x04, 0x88, 0x01, 0x61, 0x20, 0x1C, 0x84, 0x9F, 0xE0, 0x1F, 0xFC, 0xC3, 0x7F, 0xFE, 0xFF, 0xFF, 0x01 },
+};
+
+/// The hand classes that the big blind calls a push with at each stack depth from 1 big blind, printed by the util's
+/// pushfold command
+static const uint8_t call_chart[PushFold::MAX_DEPTH][PushFold::CHART_BYTES] ROM_DATA = {
+	{ 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x01 },
+	{ 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x01 },
+	{ 0x81, 0xFF, 0xF1, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x01 },
+	{ 0x01, 0x5E, 0xC0, 0x13, 0x78, 0x07, 0xCF, 0xFF, 0xF9, 0x3F, 0xFF, 0xF7, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x01 },
+	{ 0x01, 0x5C, 0x80, 0x13, 0x70, 0x04, 0x0F, 0xE1, 0x61, 0x3F, 0xFC, 0xC7, 0xFF, 0xFC, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x01 },
+	{ 0x01, 0x58, 0x00, 0x13, 0x70, 0x04, 0x0E, 0xC1, 0x41, 0x3C, 0xF8, 0x07, 0xFF, 0xF0, 0x9F, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x01 },
+	{ 0x01, 0x58, 0x00, 0x13, 0x60, 0x04, 0x0C, 0xC1, 0x41, 0x38, 0x90, 0x07, 0xFF, 0xE0, 0x1F, 0xFE, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x01 },
+	{ 0x01, 0x58, 0x00, 0x13, 0x60, 0x04, 0x0C, 0x81, 0x41, 0x38, 0x10, 0x07, 0xFE, 0xC0, 0x1F, 0xFC, 0xF3, 0xFF, 0xFF, 0xFF, 0xFF, 0x01 },
+	{ 0x01, 0x50, 0x00, 0x12, 0x60, 0x04, 0x0C, 0x81, 0x41, 0x30, 0x10, 0x07, 0xF4, 0xC0, 0x1F, 0xF8, 0xC3, 0xFF, 0xFF, 0xFF, 0xFF, 0x01 },
+	{ 0x01, 0x50, 0x00, 0x12, 0x40, 0x04, 0x0C, 0x81, 0x41, 0x30, 0x10, 0x06, 0xE4, 0x80, 0x1F, 0xF8, 0x83, 0xFF, 0xFF, 0xFF, 0xFF, 0x01 },
+	{ 0x01, 0x50, 0x00, 0x12, 0x40, 0x04, 0x08, 0x81, 0x41, 0x30, 0x10, 0x06, 0xE4, 0x80, 0x1F, 0xF0, 0x03, 0x7F, 0xFF, 0xFF, 0xFF, 0x01 },
+	{ 0x01, 0x50, 0x00, 0x12, 0x40, 0x04, 0x08, 0x01, 0x41, 0x30, 0x10, 0x06, 0xC4, 0x00, 0x1F, 0xF0, 0x03, 0x7F, 0xFE, 0xFF, 0xFF, 0x01 },
+	{ 0x01, 0x50, 0x00, 0x12, 0x40, 0x04, 0x08, 0x01, 0x41, 0x20, 0x10, 0x06, 0xC4, 0x00, 0x1D, 0xF0, 0x03, 0x7E, 0xFC, 0xFF, 0xFF, 0x01 },
+	{ 0x01, 0x50, 0x00, 0x12, 0x40, 0x04, 0x08, 0x01, 0x41, 0x20, 0x10, 0x04, 0xC4, 0x00, 0x1D, 0xE0, 0x03, 0x7E, 0xF8, 0xFF, 0xFF, 0x01 },
+	{ 0x01, 0x50, 0x00, 0x12, 0x40, 0x04, 0x08, 0x01, 0x41, 0x20, 0x10, 0x04, 0xC4, 0x00, 0x1D, 0xE0, 0x03, 0x7E, 0xF0, 0xFF, 0xFF, 0x01 },
+	{ 0x00, 0x40, 0x00, 0x12, 0x40, 0x04, 0x08, 0x01, 0x41, 0x20, 0x10, 0x04, 0xC4, 0x00, 0x19, 0xE0, 0x03, 0x7E, 0xE0, 0xFF, 0xFF, 0x01 },
+	{ 0x00, 0x40, 0x00, 0x10, 0x40, 0x04, 0x08, 0x01, 0x41, 0x20, 0x10, 0x04, 0xC4, 0x00, 0x19, 0xE0, 0x03, 0x7C, 0xE0, 0xFF, 0xFF, 0x01 },
+	{ 0x00, 0x40, 0x00, 0x10, 0x40, 0x04, 0x08, 0x01, 0x41, 0x20, 0x10, 0x04, 0x84, 0x00, 0x19, 0xE0, 0x03, 0x7C, 0xC0, 0xFF, 0xFF, 0x01 },
+	{ 0x00, 0x40, 0x00, 0x10, 0x00, 0x04, 0x08, 0x01, 0x41, 0x20, 0x10, 0x04, 0x84, 0x00, 0x19, 0xC0, 0x03, 0x7C, 0xC0, 0xFF, 0xFF, 0x01 },
+	{ 0x00, 0x40, 0x00, 0x10, 0x00, 0x04, 0x08, 0x01, 0x41, 0x20, 0x10, 0x04, 0x84, 0x00, 0x19, 0x40, 0x03, 0x7C, 0xC0, 0xFF, 0xFF, 0x01 },
+	{ 0x00, 0x40, 0x00, 0x10, 0x00, 0x04, 0x00, 0x01, 0x41, 0x20, 0x10, 0x04, 0x84, 0x00, 0x19, 0x40, 0x03, 0x7C, 0xC0, 0xFF, 0xFF, 0x01 },
+	{ 0x00, 0x40, 0x00, 0x10, 0x00, 0x04, 0x00, 0x01, 0x40, 0x20, 0x10, 0x04, 0x84, 0x00, 0x19, 0x40, 0x03, 0x78, 0xC0, 0xFF, 0xFF, 0x01 },
+	{ 0x00, 0x00, 0x00, 0x10, 0x00, 0x04, 0x00, 0x01, 0x40, 0x20, 0x10, 0x04, 0x84, 0x00, 0x19, 0x40, 0x03, 0x78, 0x80, 0xFF, 0xFF, 0x01 },
+	{ 0x00, 0x00, 0x00, 0x10, 0x00, 0x04, 0x00, 0x01, 0x40, 0x20, 0x10, 0x04, 0x84, 0x00, 0x11, 0x40, 0x03, 0x78, 0x80, 0xEF, 0xFF, 0x01 },
+	{ 0x00, 0x00, 0x00, 0x10, 0x00, 0x04, 0x00, 0x01, 0x40, 0x20, 0x10, 0x04, 0x84, 0x00, 0x11, 0x40, 0x03, 0x78, 0x80, 0xCF, 0xFF, 0x01 },
+};
+
+/** Look up a hand class in a chart
+ *  @param chart The chart of a stack depth
+ *  @param hand_class The hand class
+ *  @return True if the hand class is in the chart
+ */
+static bool inChart(const uint8_t* chart, uint8_t hand_class)
+{
+	return (ACCESS_ROM_DATA(chart[hand_class / 8]) >> (hand_class % 8)) & 1;
+}
+
+uint8_t PushFold::handClass(const utl::array<Card, 2>& hand)
+{
+	// Order the hand values high to low
+	uint8_t high = static_cast<uint8_t>(hand[0].getValue());
+	uint8_t low = static_cast<uint8_t>(hand[1].getValue());
+	if (high < low) {
+		uint8_t swap = high;
+		high = low;
+		low = swap;
+	}
+
+	// Suited hands are below the diagonal and offsuit hands above it
+	if (hand[0].getSuit() == hand[1].getSuit())
+		return static_cast<uint8_t>(high * 13 + low);
+	return static_cast<uint8_t>(low * 13 + high);
+}
+
+uint16_t PushFold::depth(uint16_t effective_stack, uint16_t big_blind)
+{
+	uint16_t result = static_cast<uint16_t>((static_cast<uint32_t>(effective_stack) + big_blind / 2) / big_blind);
+	return result == 0 ? 1 : result;
+}
+
+bool PushFold::push(uint8_t hand_class, uint8_t depth)
+{
+	return inChart(push_chart[depth - 1], hand_class);
+}
+
+bool PushFold::call(uint8_t hand_class, uint8_t depth)
+{
+	return inChart(call_chart[depth - 1], hand_class);
+}
\ No newline at end of file
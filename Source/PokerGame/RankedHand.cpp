@@ -139,7 +139,7 @@ void RankedHand::rankHand()
 	bool is_straight = this->isStraight(straight_map);
 
 	// Check for straight flush
-	if (this->isStraightFlush(is_flush, is_straight, straight_map) == true)
+	if (this->isStraightFlush(is_flush, straight_map) == true)
 	{
 		// Check for the royal flush
 		if (straight_map.begin()->getValue() == Card::Value::Ace)
@@ -163,11 +163,19 @@ void RankedHand::rankHand()
 	}
 
 	// Check for a full house
-	if (largest_set.first == 3 && pair_list.size() > 0)
+	if (largest_set.first == 3)
 	{
-		// The ranking is full house
-		this->rankFullHouse(largest_set, pair_list);
-		return;
+		// A second three of a kind plays as the pair
+		for (const auto& pair : value_map)
+			if (pair.first == 3 && pair.second.getValue() != largest_set.second.getValue())
+				pair_list.push_front(pair.second);
+
+		if (pair_list.size() > 0)
+		{
+			// The ranking is full house
+			this->rankFullHouse(largest_set, pair_list);
+			return;
+		}
 	}
 
 	// Check for a flush
@@ -344,8 +352,8 @@ utl::pair<bool, Card::Suit> RankedHand::isFlush(const SuitMap& suit_map)
 	// Check for a flush
 	for (const auto& suit : suit_map)
 	{
-		// A flush is a set of 5 cards with identical suits
-		if (suit.first == 5)
+		// A flush is a set of at least 5 cards with identical suits
+		if (suit.first >= 5)
 		{
 			// Set the bool to true
 			result.first = true;
@@ -424,20 +432,33 @@ bool RankedHand::isStraight(StraightMap& straight_map)
 	return false;
 }
 
-bool RankedHand::isStraightFlush(const utl::pair<bool, Card::Suit>& is_flush, bool is_straight, const StraightMap& straight_map) {
+bool RankedHand::isStraightFlush(const utl::pair<bool, Card::Suit>& is_flush, StraightMap& straight_map) {
 
-	// If a flush and a straight was detected
-	if (is_flush.first == true && is_straight == true)
-	{
-		// Make sure that each straight card is the same suit
-		for (const auto& card : straight_map)
-			if (card.getSuit() != is_flush.second)
-				return false;
+	// Only a flush can contain a straight flush
+	if (is_flush.first == false)
+		return false;
 
-		return true;
-	}
+	// Construct a value map of only the cards of the flush suit
+	ValueMap flush_value_map;
+	for (const auto& card : this->hand)
+		if (card.getSuit() == is_flush.second) {
+			++flush_value_map[static_cast<size_t>(card.getValue()) % 13].first;
+			flush_value_map[static_cast<size_t>(card.getValue()) % 13].second = card;
+		}
+	for (const auto& card : this->board)
+		if (card.getSuit() == is_flush.second) {
+			++flush_value_map[static_cast<size_t>(card.getValue()) % 13].first;
+			flush_value_map[static_cast<size_t>(card.getValue()) % 13].second = card;
+		}
 
-	return false;
+	// The flush suit must itself hold a straight
+	StraightMap flush_straight_map = this->constructStraightMap(flush_value_map);
+	if (this->isStraight(flush_straight_map) == false)
+		return false;
+
+	// Update the straight map
+	straight_map = flush_straight_map;
+	return true;
 }
 
 void RankedHand::rankRoyalFlush()
@@ -0,0 +1,347 @@
+/**
+ *  A simple interactive texas holdem poker program.
+ *  Copyright (C) 2020, Matt Zimmerer, mzimmere@gmail.com
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ **/
+
+#include "PokerGame/Strategy.h"
+
+#include "Platform/Platform.h"
+#include "PokerGame/AI.h"
+#include "PokerGame/HandBuckets.h"
+
+/// The pre-flop strengths that start each card bucket after the first, the strengths are skewed towards zero
+static const uint8_t preflop_thresholds[Strategy::BUCKETS - 1] ROM_DATA = { 0x01, 0x04, 0x0C, 0x20, 0x40, 0x80, 0xC0 };
+
+/// The post-flop equities against one opponent that start each card bucket after the first, in units of 1/100
+static const uint8_t postflop_thresholds[Strategy::BUCKETS - 1] ROM_DATA = { 30, 40, 50, 60, 70, 80, 90 };
+
+/// The chance of each action in each information set in units of 1/255, printed by the util's train command after five
+/// million iterations
+static const uint8_t strategy_table[Strategy::INFORMATION_SETS * Strategy::ACTIONS] ROM_DATA = {
+	0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00,
+	0x00, 0x00, 0xFF,
+	0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00,
+	0x00, 0x00, 0xFF,
+	0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00,
+	0x00, 0x00, 0xFF,
+	0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00,
+	0x00, 0x00, 0xFF,
+	0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00,
+	0x00, 0x00, 0xFF,
+	0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00,
+	0x00, 0x00, 0xFF,
+	0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00,
+	0x00, 0x00, 0xFF,
+	0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00,
+	0x00, 0x00, 0xFF,
+	0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00,
+	0x00, 0xFF, 0x00,
+	0x00, 0x00, 0x00,
+	0x00, 0xFF, 0x00,
+	0x00, 0x00, 0x00,
+	0x00, 0x00, 0xFF,
+	0x00, 0x00, 0x00,
+	0x00, 0xFF, 0x00,
+	0x00, 0x00, 0x00,
+	0x00, 0xC9, 0x36,
+	0x00, 0x00, 0x00,
+	0x00, 0xFF, 0x00,
+	0x00, 0x00, 0x00,
+	0x00, 0xFF, 0x00,
+	0x00, 0x00, 0x00,
+	0x00, 0xFF, 0x00,
+	0x00, 0x00, 0x00,
+	0x00, 0x00, 0xFF,
+	0x00, 0x00, 0x00,
+	0x00, 0xFF, 0x00,
+	0x00, 0x00, 0x00,
+	0x00, 0x92, 0x6D,
+	0x00, 0x00, 0x00,
+	0x00, 0xFF, 0x00,
+	0x00, 0x00, 0x00,
+	0x00, 0x00, 0xFF,
+	0x00, 0x00, 0x00,
+	0x00, 0xFF, 0x00,
+	0x00, 0x00, 0x00,
+	0x00, 0x00, 0xFF,
+	0x00, 0x00, 0x00,
+	0x00, 0xFF, 0x00,
+	0x00, 0x00, 0x00,
+	0x00, 0x68, 0x97,
+	0x78, 0x7E, 0x09,
+	0xFF, 0x00, 0x00,
+	0x00, 0x00, 0x00,
+	0x00, 0x70, 0x8F,
+	0x2E, 0x95, 0x3C,
+	0x44, 0xBB, 0x00,
+	0x00, 0x00, 0x00,
+	0x00, 0x56, 0xA9,
+	0x00, 0x80, 0x7F,
+	0x00, 0xFF, 0x00,
+	0x00, 0x00, 0x00,
+	0x00, 0x58, 0xA7,
+	0x00, 0xFB, 0x04,
+	0x00, 0xFF, 0x00,
+	0x00, 0x00, 0x00,
+	0x00, 0x2D, 0xD2,
+	0x00, 0xAB, 0x54,
+	0x00, 0xFF, 0x00,
+	0x00, 0x00, 0x00,
+	0x00, 0x00, 0xFF,
+	0x00, 0x16, 0xE9,
+	0x00, 0xFF, 0x00,
+	0x00, 0x00, 0x00,
+	0x00, 0x00, 0xFF,
+	0x00, 0x00, 0xFF,
+	0x00, 0xFF, 0x00,
+	0x00, 0x00, 0x00,
+	0x00, 0x20, 0xDF,
+	0x00, 0x48, 0xB7,
+	0x00, 0xFF, 0x00,
+	0x00, 0x6A, 0x95,
+	0x00, 0x00, 0x00,
+	0xFC, 0x00, 0x03,
+	0xFF, 0x00, 0x00,
+	0x00, 0xC5, 0x3A,
+	0x00, 0x00, 0x00,
+	0x54, 0x6E, 0x3D,
+	0x70, 0x8F, 0x00,
+	0x00, 0xCA, 0x35,
+	0x00, 0x00, 0x00,
+	0x00, 0xFE, 0x01,
+	0x00, 0xFF, 0x00,
+	0x00, 0xA7, 0x58,
+	0x00, 0x00, 0x00,
+	0x00, 0xDB, 0x24,
+	0x00, 0xFF, 0x00,
+	0x00, 0x28, 0xD7,
+	0x00, 0x00, 0x00,
+	0x00, 0xDB, 0x24,
+	0x00, 0xFF, 0x00,
+	0x00, 0x5C, 0xA3,
+	0x00, 0x00, 0x00,
+	0x00, 0x00, 0xFF,
+	0x00, 0xFF, 0x00,
+	0x00, 0xC0, 0x3F,
+	0x00, 0x00, 0x00,
+	0x00, 0x00, 0xFF,
+	0x00, 0xFF, 0x00,
+	0x00, 0xE2, 0x1D,
+	0x00, 0x00, 0x00,
+	0x00, 0x00, 0xFF,
+	0x00, 0xFF, 0x00,
+	0x00, 0x00, 0x00,
+	0x00, 0x0E, 0xF1,
+	0xAB, 0x00, 0x54,
+	0xFF, 0x00, 0x00,
+	0x00, 0x00, 0x00,
+	0x00, 0xB4, 0x4B,
+	0x34, 0x98, 0x33,
+	0x0F, 0xF0, 0x00,
+	0x00, 0x00, 0x00,
+	0x00, 0x2A, 0xD5,
+	0x00, 0xDF, 0x20,
+	0x00, 0xFF, 0x00,
+	0x00, 0x00, 0x00,
+	0x00, 0x54, 0xAB,
+	0x00, 0xFF, 0x00,
+	0x00, 0xFF, 0x00,
+	0x00, 0x00, 0x00,
+	0x00, 0x00, 0xFF,
+	0x00, 0x3F, 0xC0,
+	0x00, 0xFF, 0x00,
+	0x00, 0x00, 0x00,
+	0x00, 0x00, 0xFF,
+	0x00, 0x00, 0xFF,
+	0x00, 0xFF, 0x00,
+	0x00, 0x00, 0x00,
+	0x00, 0x00, 0xFF,
+	0x00, 0x00, 0xFF,
+	0x00, 0xFF, 0x00,
+	0x00, 0x00, 0x00,
+	0x00, 0x00, 0xFF,
+	0x00, 0x00, 0xFF,
+	0x00, 0xFF, 0x00,
+	0x00, 0xC5, 0x3A,
+	0x00, 0x00, 0x00,
+	0xEB, 0x00, 0x14,
+	0xFF, 0x00, 0x00,
+	0x00, 0xA9, 0x56,
+	0x00, 0x00, 0x00,
+	0x69, 0x8D, 0x09,
+	0x75, 0x8A, 0x00,
+	0x00, 0xFE, 0x01,
+	0x00, 0x00, 0x00,
+	0x00, 0x00, 0xFF,
+	0x00, 0xFF, 0x00,
+	0x00, 0xFE, 0x01,
+	0x00, 0x00, 0x00,
+	0x00, 0xFF, 0x00,
+	0x00, 0xFF, 0x00,
+	0x00, 0xFB, 0x04,
+	0x00, 0x00, 0x00,
+	0x00, 0x00, 0xFF,
+	0x00, 0xFF, 0x00,
+	0x00, 0x01, 0xFE,
+	0x00, 0x00, 0x00,
+	0x00, 0x00, 0xFF,
+	0x00, 0xFF, 0x00,
+	0x00, 0xA9, 0x56,
+	0x00, 0x00, 0x00,
+	0x00, 0x00, 0xFF,
+	0x00, 0xFF, 0x00,
+	0x00, 0x43, 0xBC,
+	0x00, 0x00, 0x00,
+	0x00, 0x00, 0xFF,
+	0x00, 0xFF, 0x00,
+	0x00, 0x00, 0x00,
+	0x00, 0x4B, 0xB4,
+	0x8E, 0x01, 0x70,
+	0x92, 0x6D, 0x00,
+	0x00, 0x00, 0x00,
+	0x00, 0x5B, 0xA4,
+	0x4D, 0x5C, 0x56,
+	0x25, 0xDA, 0x00,
+	0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00,
+	0x00, 0x89, 0x76,
+	0x00, 0xFF, 0x00,
+	0x00, 0xFF, 0x00,
+	0x00, 0x00, 0x00,
+	0x00, 0x00, 0xFF,
+	0x00, 0x09, 0xF6,
+	0x00, 0xFF, 0x00,
+	0x00, 0x00, 0x00,
+	0x00, 0x00, 0xFF,
+	0x00, 0x02, 0xFD,
+	0x00, 0xFF, 0x00,
+	0x00, 0x00, 0x00,
+	0x00, 0x00, 0xFF,
+	0x00, 0x00, 0xFF,
+	0x00, 0xFF, 0x00,
+	0x00, 0x00, 0x00,
+	0x00, 0x00, 0xFF,
+	0x00, 0x00, 0xFF,
+	0x00, 0xFF, 0x00,
+	0x00, 0x6A, 0x95,
+	0x00, 0x00, 0x00,
+	0xB9, 0x16, 0x30,
+	0x9A, 0x65, 0x00,
+	0x00, 0x73, 0x8C,
+	0x00, 0x00, 0x00,
+	0x09, 0xE9, 0x0D,
+	0x61, 0x9E, 0x00,
+	0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00,
+	0x00, 0xFF, 0x00,
+	0x00, 0x00, 0x00,
+	0x00, 0xFF, 0x00,
+	0x05, 0xFA, 0x00,
+	0x00, 0x23, 0xDC,
+	0x00, 0x00, 0x00,
+	0x00, 0x00, 0xFF,
+	0x00, 0xFF, 0x00,
+	0x00, 0x00, 0xFF,
+	0x00, 0x00, 0x00,
+	0x00, 0x00, 0xFF,
+	0x00, 0xFF, 0x00,
+	0x00, 0x3A, 0xC5,
+	0x00, 0x00, 0x00,
+	0x00, 0x00, 0xFF,
+	0x00, 0xFF, 0x00,
+	0x00, 0x0D, 0xF2,
+	0x00, 0x00, 0x00,
+	0x00, 0x00, 0xFF,
+	0x00, 0xFF, 0x00,
+};
+
+bool Strategy::isLegal(Node node, Action action)
+{
+	if (action == FOLD)
+		return node == FACING_BET || node == FACING_RAISE;
+	if (action == RAISE)
+		return node != FACING_RAISE;
+	return true;
+}
+
+uint8_t Strategy::street(uint8_t board_size)
+{
+	return board_size < 3 ? 0 : static_cast<uint8_t>(board_size - 2);
+}
+
+uint8_t Strategy::cardBucket(const utl::array<Card, 2>& hand, const utl::vector<Card, 5>& board)
+{
+	// Pre-flop, compare the hand strength to the thresholds
+	uint8_t bucket = 0;
+	if (board.size() < 3) {
+		uint8_t strength = AI::preflopStrength(hand);
+		while (bucket < BUCKETS - 1 && strength >= ACCESS_ROM_DATA(preflop_thresholds[bucket]))
+			++bucket;
+		return bucket;
+	}
+
+	// Post-flop, compare the equity of the hand's bucket against one opponent to the thresholds
+	uint16_t equity = HandBuckets::equity(HandBuckets::bucket(hand, board), 1) / 100;
+	while (bucket < BUCKETS - 1 && equity >= ACCESS_ROM_DATA(postflop_thresholds[bucket]))
+		++bucket;
+	return bucket;
+}
+
+uint16_t Strategy::informationSet(uint8_t street, uint8_t position, uint8_t bucket, Node node)
+{
+	return static_cast<uint16_t>(((street * POSITIONS + position) * BUCKETS + bucket) * NODES + node);
+}
+
+uint8_t Strategy::probability(uint16_t information_set, Action action)
+{
+	return ACCESS_ROM_DATA(strategy_table[information_set * ACTIONS + action]);
+}
+
+Strategy::Action Strategy::chooseAction(uint16_t information_set, Random& rng)
+{
+	// Walk the chances until they pass a random value
+	int random_value = rng.getRandomNumberInRange(0, 254);
+	int total = 0;
+	for (uint8_t action = 0; action < ACTIONS; ++action) {
+		total += probability(information_set, static_cast<Action>(action));
+		if (random_value < total)
+			return static_cast<Action>(action);
+	}
+
+	// The information set was never trained
+	return CALL;
+}
\ No newline at end of file
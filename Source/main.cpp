@@ -27,9 +27,21 @@
 #include <utl/utility>
 #include <utl/vector>
 
-#include "PokerGame/ConsoleIO.h"
 #include "PokerGame/PokerGame.h"
 
+/// Build with BINARY_IO=1 to send binary event frames for a host to draw, instead of drawing the table as text
+#ifndef BINARY_IO
+#define BINARY_IO 0
+#endif
+
+#if BINARY_IO
+#include "PokerGame/BinaryIO.h"
+using FrontEnd = BinaryIO;
+#else
+#include "PokerGame/ConsoleIO.h"
+using FrontEnd = ConsoleIO;
+#endif
+
 static utl::fifo<char, 8> local_fifo;
 
 static utl::fifo<utl::string<8>, 4> line_fifo;
@@ -84,88 +96,58 @@ static void processRxBuffer(utl::fifo<char, 8>& buffer)
 	} while (0);
 }
 
-static utl::string<8> readLine(int max_delay_ms)
+static void pollUART()
 {
-	// Get the current system time
-	utl::pair<uint32_t, uint16_t> tbegin = this_platform.sysTime();
-
-	// Add the delay
-	utl::pair<uint32_t, uint16_t> tend = tbegin;
-	tend.second += max_delay_ms;
-	if (tend.second > 1000) {
-		tend.second -= 1000;
-		tend.first += 1;
-	}
-
-	// While we have not received a full line
-	while (line_fifo.empty() == true) {
-
-		// Get the current system time
-		utl::pair<uint32_t, uint16_t> tnow = this_platform.sysTime();
-
-		// If max_delay_ms milli-seconds have elapsed, return an empty string
-		if (tnow.first >= tend.first && tnow.second >= tend.second)
-			return "";
-
-		// Read bytes from the UART bus
-		utl::vector<char, 8> buffer;
-		buffer.resize(8);
-		size_t bytes_read = uart0.readBytes(buffer.begin(), buffer.end(), max_delay_ms);
-		buffer.resize(bytes_read);
-		if (bytes_read == 0)
-			continue;
-
-		// Copy them to the local_fifo
-		for (const auto c : buffer) {
-			if (local_fifo.full() == true)
-				local_fifo.pop();
-			local_fifo.push(c);
-		}
-
-		// Process the local_fifo, searching for a line
-		processRxBuffer(local_fifo);
+	// Read whatever bytes have arrived on the UART bus, without waiting for more
+	utl::vector<char, 8> buffer;
+	buffer.resize(8);
+	size_t bytes_read = uart0.readBytes(buffer.begin(), buffer.end());
+	buffer.resize(bytes_read);
+	if (bytes_read == 0)
+		return;
+
+	// Copy them to the local_fifo
+	for (const auto c : buffer) {
+		if (local_fifo.full() == true)
+			local_fifo.pop();
+		local_fifo.push(c);
 	}
 
-	return line_fifo.pop();
+	// Process the local_fifo, searching for a line
+	processRxBuffer(local_fifo);
 }
 
-static void writeLineCallback(const utl::string<ConsoleIO::WIDTH>& line, void* opaque)
+static void writeCallback(const char* begin, const char* end, void* opaque)
 {
-	// Write a line to the user's screen
-	uart0.writeBytes(line.begin(), line.end());
-
-	// Write "\r\n" tp the user's screen
-	utl::string<2> end_line(ACCESS_ROM_STR(2, "\r\n"));
-	uart0.writeBytes(end_line.begin(), end_line.end());
+	// Write the bytes to the user's screen
+	uart0.writeBytes(begin, end);
 }
 
-static utl::string<ConsoleIO::MAX_USER_INPUT_LEN> readLineCallback(void* opaque)
+static utl::string<FrontEnd::MAX_USER_INPUT_LEN> readLineCallback(void* opaque)
 {
-	utl::string<ConsoleIO::MAX_USER_INPUT_LEN> line;
+	utl::string<FrontEnd::MAX_USER_INPUT_LEN> line;
+
+	// If the user has not entered a line yet, return an empty line so that the prompt waits without blocking
+	pollUART();
+	if (line_fifo.empty() == true)
+		return line;
+	line = line_fifo.pop();
 
-	// Write "\r\n" tp the user's screen
+#if !BINARY_IO
+	// Write "\r\n" tp the user's screen, the host echoes the user's input in binary mode
 	utl::string<2> end_line(ACCESS_ROM_STR(2, "\r\n"));
 	uart0.writeBytes(end_line.begin(), end_line.end());
-
-	// While the user hasn't supplied feedback for some time
-	do {
-
-		// Read a line from the user
-		line = readLine(250);
-
-		// Write "\r" tp the user's screen
-		end_line = "\r";
-		uart0.writeBytes(end_line.begin(), end_line.end());
-
-	} while (line.size() == 0);
+#endif
 
 	return line;
 }
 
+#if !BINARY_IO
 static void delayCallback(int16_t delay_ms)
 {
 	this_platform.delayMilliSeconds(delay_ms);
 }
+#endif
 
 int main()
 {
@@ -185,15 +167,35 @@ int main()
 		// Update the random seed
 		uint32_t random_seed = this_platform.randomSeed();
 
-		// Construct the console IO object
-		ConsoleIO console_io(&writeLineCallback, &readLineCallback, &delayCallback);
+		// Construct the front end object
+#if BINARY_IO
+		BinaryIO front_end(&writeCallback, &readLineCallback);
+#else
+		ConsoleIO front_end(&writeCallback, &readLineCallback, &delayCallback);
+#endif
 
 		// Construct the poker game object
-		PokerGame poker_game(random_seed, 5, 500, &ConsoleIO::userDecision, &ConsoleIO::playerAction, &ConsoleIO::subRoundChange,
-			&ConsoleIO::roundEnd, &ConsoleIO::gameEnd, &console_io);
-
-		// Play poker until one of the players has quit or only one player remains
-		poker_game.play();
+		PokerGame poker_game(random_seed, 5, 500, &FrontEnd::userDecision, &FrontEnd::playerAction, &FrontEnd::subRoundChange,
+			&FrontEnd::roundEnd, &FrontEnd::gameEnd, &front_end);
+
+		// Play poker until one of the players has quit or only one player remains, stepping the game so that
+		// the UART is serviced between steps instead of blocking on user input
+		PokerGame::StepResult result = PokerGame::StepResult::Running;
+		while (result != PokerGame::StepResult::GameOver) {
+
+			// Hold the game between rounds until the user continues or quits
+			PokerGame::PlayerAction continue_action = front_end.pollContinue();
+			if (continue_action == PokerGame::PlayerAction::Quit)
+				poker_game.quit();
+
+			// Advance the game, unless it is held
+			if (continue_action != PokerGame::PlayerAction::Pending)
+				result = poker_game.step();
+
+			// Idle the CPU in a low power mode while waiting for the user, until the UART receives a byte
+			if (continue_action == PokerGame::PlayerAction::Pending || result == PokerGame::StepResult::WaitingForInput)
+				this_platform.idle();
+		}
 
 		// Wait 3 seconds
 		this_platform.delayMilliSeconds(3000);
@@ -0,0 +1,99 @@
+/**
+ *  A simple interactive texas holdem poker program.
+ *  Copyright (C) 2020, Matt Zimmerer, mzimmere@gmail.com
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ **/
+
+#include "GTestIncludes.h"
+
+#include "PokerGame/AI.h"
+
+/** Find the pot odds of a bet the way that the floating point AI does
+ *  @param bet The bet that the pot odds are of
+ *  @param pot The chips in the pot
+ *  @return The pot odds
+ */
+static float potOdds(uint16_t bet, uint16_t pot)
+{
+	return static_cast<float>(bet) / (static_cast<float>(bet) + static_cast<float>(pot));
+}
+
+TEST(AITests, FixedPointBandsMatchPreflop)
+{
+	// Pre-flop strengths are whole numbers out of 255, every band should match the floating point AI
+	for (uint16_t strength = 0; strength <= 255; ++strength) {
+		for (uint16_t bet = 0; bet <= 200; ++bet) {
+			for (uint16_t pot = 0; pot <= 600; pot += 3) {
+				ASSERT_EQ(AI::fixedRateOfReturnBand(strength, 1, bet, pot), AI::rateOfReturnBand(static_cast<float>(strength), potOdds(bet, pot)))
+					<< "strength " << strength << " bet " << bet << " pot " << pot;
+			}
+		}
+	}
+}
+
+TEST(AITests, FixedPointBandsMatchPostflop)
+{
+	// Post-flop strengths are equities out of 10000, bands should only differ where the rate of return is exactly a threshold
+	for (uint16_t strength = 0; strength <= 10000; strength += 7) {
+		for (uint16_t bet = 1; bet <= 150; ++bet) {
+			for (uint16_t pot = 0; pot <= 600; pot += 5) {
+				uint8_t fixed_band = AI::fixedRateOfReturnBand(strength, 10000, bet, pot);
+				uint8_t float_band = AI::rateOfReturnBand(static_cast<float>(strength) / 10000.0f, potOdds(bet, pot));
+				if (fixed_band == float_band)
+					continue;
+
+				// Check that the rate of return is exactly a threshold
+				uint64_t rate_tenths = static_cast<uint64_t>(strength) * (bet + pot) * 10;
+				uint64_t unit = static_cast<uint64_t>(bet) * 10000;
+				ASSERT_TRUE(rate_tenths == 8 * unit || rate_tenths == 10 * unit || rate_tenths == 13 * unit)
+					<< "strength " << strength << " bet " << bet << " pot " << pot;
+			}
+		}
+	}
+}
+
+TEST(AITests, FixedPointBandsFitLargeStacks)
+{
+	// Up to the largest bets and pots the 32 bit comparison should find the band that exact arithmetic does, away from
+	// the limits themselves
+	const AI::Parameters& parameters = AI::tunedParameters();
+	for (uint32_t strength = 0; strength <= 10000; strength += 101) {
+		for (uint32_t bet = 1; bet <= 65535; bet += 1021) {
+			for (uint32_t pot = 0; pot <= 65535; pot += 1031) {
+				uint64_t rate_hundredths = static_cast<uint64_t>(strength) * (bet + pot) * 100;
+				uint64_t unit = static_cast<uint64_t>(bet) * 10000;
+				uint8_t expected = 0;
+				bool on_limit = false;
+				for (uint16_t limit : parameters.band_limits) {
+					on_limit = on_limit || rate_hundredths == limit * unit;
+					if (rate_hundredths >= limit * unit)
+						++expected;
+				}
+				if (on_limit == false) {
+					ASSERT_EQ(expected, AI::fixedRateOfReturnBand(static_cast<uint16_t>(strength), 10000, static_cast<uint16_t>(bet), static_cast<uint16_t>(pot)))
+						<< "strength " << strength << " bet " << bet << " pot " << pot;
+				}
+			}
+		}
+	}
+}
+
+TEST(AITests, TunedLimitsRoundDownAsFound)
+{
+	// The rounding of the tuned band limits is written into the parameters, it must be what the limits round to
+	const AI::Parameters& parameters = AI::tunedParameters();
+	EXPECT_EQ(AI::roundedDownLimits(parameters.band_limits), parameters.rounded_down_limits);
+	EXPECT_EQ(0x4, AI::roundedDownLimits({ { 80, 100, 130 } }));
+}
\ No newline at end of file
@@ -0,0 +1,183 @@
+/**
+ *  A simple interactive texas holdem poker program.
+ *  Copyright (C) 2020, Matt Zimmerer, mzimmere@gmail.com
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ **/
+
+#include "GTestIncludes.h"
+
+#include <string>
+#include <vector>
+
+#include "PokerGame/BinaryIO.h"
+#include "PokerGame/ConsoleIO.h"
+#include "PokerGame/PokerGameImpl.h"
+
+/** A console that records what is written to it, and answers prompts from a fixed script of lines
+ */
+class ScriptedConsole
+{
+public:
+
+	/// The bytes written to the console
+	std::string output;
+
+	/// The index of the next line of the script
+	size_t next_line = 0;
+
+	static void write(const char* begin, const char* end, void* opaque)
+	{
+		reinterpret_cast<ScriptedConsole*>(opaque)->output.append(begin, end);
+	}
+
+	static utl::string<ConsoleIO::MAX_USER_INPUT_LEN> readLine(void* opaque)
+	{
+		static const char* const script[] = { "c", "f", "c", "f", "b", "10", "f", "x", "c", "f" };
+		ScriptedConsole* self = reinterpret_cast<ScriptedConsole*>(opaque);
+		return utl::string<ConsoleIO::MAX_USER_INPUT_LEN>(script[self->next_line++ % (sizeof(script) / sizeof(script[0]))]);
+	}
+
+	static void delay(int16_t delay_ms)
+	{
+	}
+};
+
+/** Plays a game through a BinaryIO device and a ConsoleIO drawing it directly, with the same user input
+ */
+class DeviceHarness
+{
+public:
+
+	/// The bytes sent over the link
+	std::vector<uint8_t> link;
+
+	ScriptedConsole device_input;
+	BinaryIO device{ &DeviceHarness::writeLink, &DeviceHarness::readLine, this };
+	ScriptedConsole direct_terminal;
+	ConsoleIO direct_console{ &ScriptedConsole::write, &ScriptedConsole::readLine, &ScriptedConsole::delay, &direct_terminal };
+
+	static void writeLink(const char* begin, const char* end, void* opaque)
+	{
+		DeviceHarness* self = reinterpret_cast<DeviceHarness*>(opaque);
+		self->link.insert(self->link.end(), begin, end);
+	}
+
+	static utl::string<ConsoleIO::MAX_USER_INPUT_LEN> readLine(void* opaque)
+	{
+		return ScriptedConsole::readLine(&reinterpret_cast<DeviceHarness*>(opaque)->device_input);
+	}
+
+	static utl::pair<PokerGame::PlayerAction, uint16_t> userDecision(const PokerGameState& state, void* opaque)
+	{
+		DeviceHarness* self = reinterpret_cast<DeviceHarness*>(opaque);
+		ConsoleIO::userDecision(state, &self->direct_console);
+		return BinaryIO::userDecision(state, &self->device);
+	}
+
+	static void playerAction(const utl::string<MAX_NAME_SIZE>& player_name, PokerGame::PlayerAction action, uint16_t bet,
+		const PokerGameState& state, void* opaque)
+	{
+		DeviceHarness* self = reinterpret_cast<DeviceHarness*>(opaque);
+		ConsoleIO::playerAction(player_name, action, bet, state, &self->direct_console);
+		BinaryIO::playerAction(player_name, action, bet, state, &self->device);
+	}
+
+	static void subRoundChange(PokerGame::SubRound new_sub_round, const PokerGameState& state, void* opaque)
+	{
+		DeviceHarness* self = reinterpret_cast<DeviceHarness*>(opaque);
+		ConsoleIO::subRoundChange(new_sub_round, state, &self->direct_console);
+		BinaryIO::subRoundChange(new_sub_round, state, &self->device);
+	}
+
+	static bool roundEnd(bool draw, const utl::string<MAX_NAME_SIZE>& winner, uint16_t winnings, RankedHand::Ranking ranking,
+		const PokerGameState& state, void* opaque)
+	{
+		DeviceHarness* self = reinterpret_cast<DeviceHarness*>(opaque);
+		ConsoleIO::roundEnd(draw, winner, winnings, ranking, state, &self->direct_console);
+		return BinaryIO::roundEnd(draw, winner, winnings, ranking, state, &self->device);
+	}
+
+	static void gameEnd(const utl::string<MAX_NAME_SIZE>& winner, void* opaque)
+	{
+		DeviceHarness* self = reinterpret_cast<DeviceHarness*>(opaque);
+		ConsoleIO::gameEnd(winner, &self->direct_console);
+		BinaryIO::gameEnd(winner, &self->device);
+	}
+};
+
+TEST(BinaryIOTests, HostDrawsTheSameScreensAsConsoleIO)
+{
+	DeviceHarness harness;
+	PokerGame poker_game(4321, 5, 500, &DeviceHarness::userDecision, &DeviceHarness::playerAction, &DeviceHarness::subRoundChange,
+		&DeviceHarness::roundEnd, &DeviceHarness::gameEnd, &harness);
+	for (uint16_t i = 0; i < 2000 && poker_game.step() != PokerGame::StepResult::GameOver; ++i);
+
+	// Decode the link a byte at a time, drawing the game with a console on the host
+	ScriptedConsole host_terminal;
+	ConsoleIO host_console(&ScriptedConsole::write, &ScriptedConsole::readLine, &ScriptedConsole::delay, &host_terminal);
+	BinaryIODecoder decoder(&ConsoleIO::userDecision, &ConsoleIO::playerAction, &ConsoleIO::subRoundChange, &ConsoleIO::roundEnd,
+		&ConsoleIO::gameEnd, &host_console);
+	for (uint8_t byte : harness.link)
+		decoder.feed(&byte, 1);
+
+	// The host must draw exactly what the device would have drawn, from a small fraction of the bytes
+	ASSERT_GT(harness.direct_terminal.output.size(), 0u);
+	EXPECT_EQ(harness.direct_terminal.output, host_terminal.output);
+	EXPECT_EQ(harness.device_input.next_line, host_terminal.next_line);
+	EXPECT_LT(harness.link.size() * 10, harness.direct_terminal.output.size());
+}
+
+TEST(BinaryIOTests, DecodesFramesOnceTheyAreComplete)
+{
+	BinaryIODecoder decoder(nullptr, nullptr, nullptr, nullptr, nullptr, nullptr);
+
+	// A table frame split across two reads updates the state only once its end has arrived, the second stack is 192
+	// and its first byte is escaped
+	const uint8_t table[] = { BinaryIO::TABLE, 2, 3, 'Y', 'o', 'u', 100, 2, 'A', 'l', BinaryIO::FRAME_ESCAPE, BinaryIO::ESCAPED_END, 1,
+		BinaryIO::FRAME_END };
+	decoder.feed(table, sizeof(table) - 1);
+	EXPECT_EQ(utl::string<MAX_NAME_SIZE>(""), decoder.getState().player_states[1].name);
+	decoder.feed(table + sizeof(table) - 1, 1);
+	EXPECT_EQ(utl::string<MAX_NAME_SIZE>("You"), decoder.getState().player_states[0].name);
+	EXPECT_EQ(utl::string<MAX_NAME_SIZE>("Al"), decoder.getState().player_states[1].name);
+	EXPECT_EQ(192, decoder.getState().player_states[1].stack);
+
+	// A frame that lost a byte is dropped, and the frame after it decodes
+	const uint8_t short_table[] = { BinaryIO::TABLE, 2, 3, 'B', 'o', 'b', 100, 2, 'A', 'l', BinaryIO::FRAME_END };
+	decoder.feed(short_table, sizeof(short_table));
+	EXPECT_EQ(utl::string<MAX_NAME_SIZE>("You"), decoder.getState().player_states[0].name);
+	decoder.feed(table, sizeof(table));
+	EXPECT_EQ(192, decoder.getState().player_states[1].stack);
+}
+
+TEST(BinaryIOTests, HostResynchronizesAfterALostByte)
+{
+	DeviceHarness harness;
+	PokerGame poker_game(4321, 5, 500, &DeviceHarness::userDecision, &DeviceHarness::playerAction, &DeviceHarness::subRoundChange,
+		&DeviceHarness::roundEnd, &DeviceHarness::gameEnd, &harness);
+	for (uint16_t i = 0; i < 2000 && poker_game.step() != PokerGame::StepResult::GameOver; ++i);
+
+	// Drop a byte from the middle of the link, the host still follows the game to its end
+	std::vector<uint8_t> link(harness.link);
+	link.erase(link.begin() + link.size() / 2);
+	ScriptedConsole host_terminal;
+	ConsoleIO host_console(&ScriptedConsole::write, &ScriptedConsole::readLine, &ScriptedConsole::delay, &host_terminal);
+	BinaryIODecoder decoder(&ConsoleIO::userDecision, &ConsoleIO::playerAction, &ConsoleIO::subRoundChange, &ConsoleIO::roundEnd,
+		&ConsoleIO::gameEnd, &host_console);
+	decoder.feed(link.data(), link.size());
+	EXPECT_TRUE(decoder.isGameOver());
+	for (uint8_t player_id = 0; player_id < PokerGameState::SEATS; ++player_id)
+		EXPECT_EQ(poker_game.takeSnapshot().state.player_states[player_id].stack, decoder.getState().player_states[player_id].stack);
+}
\ No newline at end of file
@@ -0,0 +1,240 @@
+/**
+ *  A simple interactive texas holdem poker program.
+ *  Copyright (C) 2020, Matt Zimmerer, mzimmere@gmail.com
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ **/
+
+#include "GTestIncludes.h"
+
+#include <string>
+#include <vector>
+
+#include "PokerGame/ConsoleIO.h"
+#include "PokerGame/PokerGameImpl.h"
+
+/** A terminal that interprets the escape sequences written by ConsoleIO, answering every prompt with 'c'
+ */
+class TestTerminal
+{
+public:
+
+	/// The terminal height
+	static constexpr size_t ROWS = 24;
+
+	/// The screen contents
+	std::vector<std::string> screen = std::vector<std::string>(ROWS, std::string(ConsoleIO::WIDTH, ' '));
+
+	/// The bytes written to the terminal
+	size_t bytes = 0;
+
+	/// The writes to the terminal
+	size_t writes = 0;
+
+	/** Write a string at the cursor, interpreting escape sequences
+	 *  @param text The string
+	 */
+	void write(const std::string& text)
+	{
+		this->bytes += text.size();
+		for (size_t i = 0; i < text.size(); ++i) {
+			char c = text[i];
+			if (c == '\033') {
+
+				// Read the parameters up to the final character
+				std::vector<size_t> params(1, 0);
+				for (i += 2; text[i] == ';' || (text[i] >= '0' && text[i] <= '9'); ++i) {
+					if (text[i] == ';')
+						params.push_back(0);
+					else
+						params.back() = params.back() * 10 + text[i] - '0';
+				}
+
+				if (text[i] == 'H') {
+					this->row = params[0] - 1;
+					this->column = params[1] - 1;
+				}
+				else if (text[i] == 'J') {
+					for (size_t row = params[0] == 2 ? 0 : this->row; row < ROWS; ++row)
+						for (size_t column = row == this->row && params[0] != 2 ? this->column : 0; column < ConsoleIO::WIDTH; ++column)
+							this->screen[row][column] = ' ';
+				}
+			}
+			else if (c == '\r') {
+				this->column = 0;
+			}
+			else if (c == '\n') {
+				if (++this->row == ROWS) {
+					this->screen.erase(this->screen.begin());
+					this->screen.push_back(std::string(ConsoleIO::WIDTH, ' '));
+					--this->row;
+				}
+			}
+			else if (this->column < ConsoleIO::WIDTH) {
+				this->screen[this->row][this->column++] = c;
+			}
+		}
+	}
+
+	static void writeBytes(const char* begin, const char* end, void* opaque)
+	{
+		TestTerminal* self = reinterpret_cast<TestTerminal*>(opaque);
+		++self->writes;
+		self->write(std::string(begin, end));
+	}
+
+	static utl::string<ConsoleIO::MAX_USER_INPUT_LEN> readLine(void* opaque)
+	{
+		return utl::string<ConsoleIO::MAX_USER_INPUT_LEN>("c");
+	}
+
+	static void delay(int16_t delay_ms)
+	{
+	}
+
+private:
+
+	/// The cursor position
+	size_t row = 0;
+	size_t column = 0;
+};
+
+/** Forwards game events to a console that draws only what changed and to one that redraws every frame
+ */
+class DiffHarness
+{
+public:
+
+	TestTerminal diff_terminal;
+	TestTerminal full_terminal;
+	ConsoleIO diff_console{ &TestTerminal::writeBytes, &TestTerminal::readLine, &TestTerminal::delay, &diff_terminal };
+	ConsoleIO full_console{ &TestTerminal::writeBytes, &TestTerminal::readLine, &TestTerminal::delay, &full_terminal };
+
+	/// The number of events compared
+	size_t events = 0;
+
+	/// The writes to the diff terminal by the events compared
+	size_t writes = 0;
+
+	/** Make the full console redraw its next frame, by ending its game. Only the bytes of its frames are counted
+	 */
+	void invalidate()
+	{
+		size_t bytes = this->full_terminal.bytes;
+		ConsoleIO::gameEnd(utl::string<MAX_NAME_SIZE>("You"), &this->full_console);
+		this->full_terminal.bytes = bytes;
+	}
+
+	/** Both terminals show the same frame, once the event has been drawn
+	 */
+	void compare()
+	{
+		// Each event draws at most one update, written at once
+		++this->events;
+		ASSERT_LE(this->diff_terminal.writes, this->writes + 1);
+		if (this->diff_terminal.writes == this->writes)
+			return;
+		this->writes = this->diff_terminal.writes;
+
+		for (uint8_t row = 0; row < ConsoleIO::HEIGHT; ++row)
+			ASSERT_EQ(this->full_terminal.screen[row], this->diff_terminal.screen[row]) << "row " << int(row) << " after event " << this->events;
+	}
+
+	static utl::pair<PokerGame::PlayerAction, uint16_t> userDecision(const PokerGameState& state, void* opaque)
+	{
+		DiffHarness* self = reinterpret_cast<DiffHarness*>(opaque);
+		self->invalidate();
+		ConsoleIO::userDecision(state, &self->full_console);
+		auto result = ConsoleIO::userDecision(state, &self->diff_console);
+		self->compare();
+		return result;
+	}
+
+	static void playerAction(const utl::string<MAX_NAME_SIZE>& player_name, PokerGame::PlayerAction action, uint16_t bet,
+		const PokerGameState& state, void* opaque)
+	{
+		DiffHarness* self = reinterpret_cast<DiffHarness*>(opaque);
+		self->invalidate();
+		ConsoleIO::playerAction(player_name, action, bet, state, &self->full_console);
+		ConsoleIO::playerAction(player_name, action, bet, state, &self->diff_console);
+		self->compare();
+	}
+
+	static void subRoundChange(PokerGame::SubRound new_sub_round, const PokerGameState& state, void* opaque)
+	{
+		DiffHarness* self = reinterpret_cast<DiffHarness*>(opaque);
+		self->invalidate();
+		ConsoleIO::subRoundChange(new_sub_round, state, &self->full_console);
+		ConsoleIO::subRoundChange(new_sub_round, state, &self->diff_console);
+		self->compare();
+	}
+
+	static bool roundEnd(bool draw, const utl::string<MAX_NAME_SIZE>& winner, uint16_t winnings, RankedHand::Ranking ranking,
+		const PokerGameState& state, void* opaque)
+	{
+		DiffHarness* self = reinterpret_cast<DiffHarness*>(opaque);
+		self->invalidate();
+		ConsoleIO::roundEnd(draw, winner, winnings, ranking, state, &self->full_console);
+		bool result = ConsoleIO::roundEnd(draw, winner, winnings, ranking, state, &self->diff_console);
+		self->compare();
+		return result;
+	}
+
+	static void gameEnd(const utl::string<MAX_NAME_SIZE>& winner, void* opaque)
+	{
+	}
+};
+
+TEST(ConsoleIOTests, DrawsTheSameFramesAsAFullRedraw)
+{
+	DiffHarness harness;
+	PokerGame poker_game(1234, 5, 500, &DiffHarness::userDecision, &DiffHarness::playerAction, &DiffHarness::subRoundChange,
+		&DiffHarness::roundEnd, &DiffHarness::gameEnd, &harness);
+
+	// Play a few rounds, the diff console must leave the terminal showing every frame exactly as a full redraw would
+	for (uint16_t i = 0; i < 200 && poker_game.step() != PokerGame::StepResult::GameOver && !testing::Test::HasFatalFailure(); ++i);
+	ASSERT_FALSE(testing::Test::HasFatalFailure());
+	EXPECT_GT(harness.events, 20);
+
+#if CONSOLE_COALESCE_EVENTS > 1
+	// Back to back events are drawn together
+	EXPECT_LT(harness.diff_terminal.writes, harness.events);
+#endif
+
+#if CONSOLE_SHADOW_FRAME
+	// Only the changed cells are written, which takes at least a third fewer bytes
+	EXPECT_LT(harness.diff_terminal.bytes * 3, harness.full_terminal.bytes * 2);
+#endif
+}
+
+TEST(ConsoleIOTests, CoalescesBackToBackEvents)
+{
+	TestTerminal terminal;
+	ConsoleIO console(&TestTerminal::writeBytes, &TestTerminal::readLine, &TestTerminal::delay, &terminal);
+	PokerGameState state;
+
+	// Player actions are drawn together, once enough have happened
+	for (uint8_t i = 1; i < CONSOLE_COALESCE_EVENTS; ++i)
+		ConsoleIO::playerAction(utl::string<MAX_NAME_SIZE>("Alice"), PokerGame::PlayerAction::CheckOrCall, 0, state, &console);
+	EXPECT_EQ(0, terminal.writes);
+	ConsoleIO::subRoundChange(PokerGame::SubRound::Flop, state, &console);
+	EXPECT_EQ(1, terminal.writes);
+
+	// Every event is drawn, in order, before the user decides
+	ConsoleIO::playerAction(utl::string<MAX_NAME_SIZE>("Alice"), PokerGame::PlayerAction::Fold, 0, state, &console);
+	ConsoleIO::userDecision(state, &console);
+	EXPECT_EQ(CONSOLE_COALESCE_EVENTS > 1 ? 2 : 3, terminal.writes);
+	EXPECT_EQ("Alice folds.", terminal.screen[1].substr(40, 12));
+	EXPECT_EQ("The flop.", terminal.screen[2].substr(40, 9));
+}
\ No newline at end of file
@@ -0,0 +1,95 @@
+/**
+ *  A simple interactive texas holdem poker program.
+ *  Copyright (C) 2020, Matt Zimmerer, mzimmere@gmail.com
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ **/
+
+#include "GTestIncludes.h"
+
+#include <utl/array>
+#include <utl/vector>
+
+#include "PokerGame/AI.h"
+#include "PokerGame/EquityCache.h"
+
+TEST(EquityCacheTests, KeysAreCanonical)
+{
+	using V = Card::Value;
+	using S = Card::Suit;
+
+	// Relabeling the suits and reordering the cards does not change the key
+	utl::array<Card, 2> hand = { Card(V::Ace, S::Spades), Card(V::King, S::Spades) };
+	utl::vector<Card, 5> board;
+	board.push_back(Card(V::Two, S::Spades));
+	board.push_back(Card(V::Seven, S::Hearts));
+	board.push_back(Card(V::Seven, S::Clubs));
+	utl::array<Card, 2> relabeled_hand = { Card(V::King, S::Diamonds), Card(V::Ace, S::Diamonds) };
+	utl::vector<Card, 5> relabeled_board;
+	relabeled_board.push_back(Card(V::Seven, S::Spades));
+	relabeled_board.push_back(Card(V::Two, S::Diamonds));
+	relabeled_board.push_back(Card(V::Seven, S::Hearts));
+	uint64_t key = EquityCache::key(hand, board, 1);
+	EXPECT_EQ(key, EquityCache::key(relabeled_hand, relabeled_board, 1));
+
+	// A different suit pattern, board or number of opponents is a different situation
+	utl::array<Card, 2> offsuit = { Card(V::Ace, S::Spades), Card(V::King, S::Hearts) };
+	EXPECT_NE(key, EquityCache::key(offsuit, board, 1));
+	EXPECT_NE(key, EquityCache::key(hand, board, 2));
+	board.push_back(Card(V::Nine, S::Clubs));
+	EXPECT_NE(key, EquityCache::key(hand, board, 1));
+}
+
+#if AI_EQUITY_BUDGET > 0 && AI_EQUITY_CACHE > 0
+TEST(EquityCacheTests, FindsStoredEquities)
+{
+	EquityCache::clear();
+	uint16_t equity = 0;
+	EXPECT_FALSE(EquityCache::find(12345, equity));
+	EquityCache::store(12345, 6789);
+	ASSERT_TRUE(EquityCache::find(12345, equity));
+	EXPECT_EQ(6789, equity);
+
+	// Storing a key again replaces its equity
+	EquityCache::store(12345, 1234);
+	ASSERT_TRUE(EquityCache::find(12345, equity));
+	EXPECT_EQ(1234, equity);
+	EquityCache::clear();
+	EXPECT_FALSE(EquityCache::find(12345, equity));
+}
+
+TEST(EquityCacheTests, EvictsUnusedEntries)
+{
+	// Fill a set, with keys that differ only above the index bits, and keep looking up the first
+	EquityCache::clear();
+	const uint64_t stride = static_cast<uint64_t>(1) << 40;
+	uint64_t first = 8;
+	uint16_t equity = 0;
+	EquityCache::store(first, 1);
+	for (uint64_t i = 1; i < 32; ++i) {
+		ASSERT_TRUE(EquityCache::find(first, equity));
+		EquityCache::store(first + i * stride, static_cast<uint16_t>(i + 1));
+	}
+
+	// The entry that is used survives, the newest entry is kept and most of the others have been evicted
+	EXPECT_TRUE(EquityCache::find(first, equity));
+	EXPECT_EQ(1, equity);
+	EXPECT_TRUE(EquityCache::find(first + 31 * stride, equity));
+	int cached = 0;
+	for (uint64_t i = 1; i < 32; ++i)
+		cached += EquityCache::find(first + i * stride, equity) ? 1 : 0;
+	EXPECT_LT(cached, 8);
+	EquityCache::clear();
+}
+#endif
\ No newline at end of file
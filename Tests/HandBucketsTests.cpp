@@ -0,0 +1,84 @@
+/**
+ *  A simple interactive texas holdem poker program.
+ *  Copyright (C) 2020, Matt Zimmerer, mzimmere@gmail.com
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ **/
+
+#include "GTestIncludes.h"
+
+#include "PokerGame/HandBuckets.h"
+
+TEST(HandBucketsTests, ClassifiesFlopsAndRivers)
+{
+    using V = Card::Value;
+    using S = Card::Suit;
+
+    // A dry flop, top pair and a set
+    utl::vector<Card, 5> board;
+    board.push_back(Card(V::King, S::Hearts));
+    board.push_back(Card(V::Seven, S::Clubs));
+    board.push_back(Card(V::Two, S::Diamonds));
+    utl::array<Card, 2> top_pair = { Card(V::Ace, S::Spades), Card(V::King, S::Spades) };
+    utl::array<Card, 2> set = { Card(V::Seven, S::Spades), Card(V::Seven, S::Diamonds) };
+    EXPECT_EQ((2 * HandBuckets::TEXTURES + 0) * HandBuckets::DRAWS + 0, HandBuckets::bucket(top_pair, board));
+    EXPECT_EQ((4 * HandBuckets::TEXTURES + 0) * HandBuckets::DRAWS + 0, HandBuckets::bucket(set, board));
+
+    // A gutshot on another dry flop
+    board.clear();
+    board.push_back(Card(V::Nine, S::Hearts));
+    board.push_back(Card(V::Seven, S::Clubs));
+    board.push_back(Card(V::Two, S::Diamonds));
+    utl::array<Card, 2> gutshot = { Card(V::Jack, S::Spades), Card(V::Ten, S::Clubs) };
+    EXPECT_EQ((0 * HandBuckets::TEXTURES + 0) * HandBuckets::DRAWS + 1, HandBuckets::bucket(gutshot, board));
+
+    // An open ended straight and flush draw on the turn
+    board.clear();
+    board.push_back(Card(V::Four, S::Hearts));
+    board.push_back(Card(V::Three, S::Hearts));
+    board.push_back(Card(V::King, S::Clubs));
+    board.push_back(Card(V::Queen, S::Diamonds));
+    utl::array<Card, 2> combo = { Card(V::Six, S::Hearts), Card(V::Five, S::Hearts) };
+    EXPECT_EQ(HandBuckets::DRAWING_STREET_BUCKETS + (0 * HandBuckets::TEXTURES + 0) * HandBuckets::DRAWS + 3, HandBuckets::bucket(combo, board));
+
+    // On a connected river where the board plays, the hole cards add nothing
+    board.clear();
+    board.push_back(Card(V::Ace, S::Spades));
+    board.push_back(Card(V::King, S::Spades));
+    board.push_back(Card(V::Queen, S::Hearts));
+    board.push_back(Card(V::Jack, S::Diamonds));
+    board.push_back(Card(V::Ten, S::Clubs));
+    utl::array<Card, 2> low = { Card(V::Two, S::Spades), Card(V::Three, S::Clubs) };
+    EXPECT_EQ(2 * HandBuckets::DRAWING_STREET_BUCKETS + 0 * HandBuckets::TEXTURES + 4, HandBuckets::bucket(low, board));
+}
+
+TEST(HandBucketsTests, EquityOrdersBuckets)
+{
+    using V = Card::Value;
+    using S = Card::Suit;
+
+    utl::vector<Card, 5> board;
+    board.push_back(Card(V::King, S::Hearts));
+    board.push_back(Card(V::Seven, S::Clubs));
+    board.push_back(Card(V::Two, S::Diamonds));
+    uint16_t set = HandBuckets::bucket({ Card(V::Seven, S::Spades), Card(V::Seven, S::Diamonds) }, board);
+    uint16_t top_pair = HandBuckets::bucket({ Card(V::Ace, S::Spades), Card(V::King, S::Spades) }, board);
+    uint16_t nothing = HandBuckets::bucket({ Card(V::Nine, S::Spades), Card(V::Eight, S::Diamonds) }, board);
+
+    // Stronger hands expect more of the pot, and every further opponent expects some of it
+    EXPECT_GT(HandBuckets::equity(set, 1), HandBuckets::equity(top_pair, 1));
+    EXPECT_GT(HandBuckets::equity(top_pair, 1), HandBuckets::equity(nothing, 1));
+    EXPECT_GT(HandBuckets::equity(top_pair, 1), HandBuckets::equity(top_pair, 2));
+    EXPECT_EQ(10000, HandBuckets::equity(nothing, 0));
+}
\ No newline at end of file
@@ -0,0 +1,259 @@
+/**
+ *  A simple interactive texas holdem poker program.
+ *  Copyright (C) 2020, Matt Zimmerer, mzimmere@gmail.com
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ **/
+#include "GTestIncludes.h"
+
+#include "PokerGame/HandEvaluator.h"
+#include "PokerGame/Random.h"
+
+/** Build a card mask from a list of cards
+ *  @param cards The cards
+ *  @return The card mask
+ */
+static HandEvaluator::CardMask cards(std::initializer_list<Card> cards)
+{
+    HandEvaluator::CardMask result = 0;
+    for (const auto& card : cards)
+        result |= HandEvaluator::cardMask(card);
+    return result;
+}
+
+TEST(HandEvaluatorTests, Categories)
+{
+    using V = Card::Value;
+    using S = Card::Suit;
+
+    EXPECT_EQ(RankedHand::Ranking::RoyalFlush, HandEvaluator::ranking(HandEvaluator::evaluate(cards({ Card(V::Two, S::Diamonds), Card(V::Two, S::Spades),
+        Card(V::Ace, S::Hearts), Card(V::King, S::Hearts), Card(V::Queen, S::Hearts), Card(V::Jack, S::Hearts), Card(V::Ten, S::Hearts) }))));
+    EXPECT_EQ(RankedHand::Ranking::StraightFlush, HandEvaluator::ranking(HandEvaluator::evaluate(cards({ Card(V::Ace, S::Clubs), Card(V::Two, S::Clubs),
+        Card(V::Three, S::Clubs), Card(V::Four, S::Clubs), Card(V::Five, S::Clubs), Card(V::King, S::Hearts), Card(V::King, S::Spades) }))));
+    EXPECT_EQ(RankedHand::Ranking::FourOfAKind, HandEvaluator::ranking(HandEvaluator::evaluate(cards({ Card(V::Nine, S::Clubs), Card(V::Nine, S::Spades),
+        Card(V::Nine, S::Hearts), Card(V::Nine, S::Diamonds), Card(V::Five, S::Clubs), Card(V::King, S::Hearts), Card(V::King, S::Spades) }))));
+    EXPECT_EQ(RankedHand::Ranking::FullHouse, HandEvaluator::ranking(HandEvaluator::evaluate(cards({ Card(V::Nine, S::Clubs), Card(V::Nine, S::Spades),
+        Card(V::Nine, S::Hearts), Card(V::Four, S::Diamonds), Card(V::Four, S::Clubs), Card(V::Four, S::Hearts), Card(V::King, S::Spades) }))));
+    EXPECT_EQ(RankedHand::Ranking::Flush, HandEvaluator::ranking(HandEvaluator::evaluate(cards({ Card(V::Two, S::Hearts), Card(V::Nine, S::Hearts),
+        Card(V::Jack, S::Hearts), Card(V::Four, S::Hearts), Card(V::Six, S::Hearts), Card(V::Seven, S::Clubs), Card(V::Eight, S::Spades) }))));
+    EXPECT_EQ(RankedHand::Ranking::Straight, HandEvaluator::ranking(HandEvaluator::evaluate(cards({ Card(V::Ace, S::Hearts), Card(V::Two, S::Spades),
+        Card(V::Three, S::Hearts), Card(V::Four, S::Diamonds), Card(V::Five, S::Hearts), Card(V::Jack, S::Clubs), Card(V::Eight, S::Spades) }))));
+    EXPECT_EQ(RankedHand::Ranking::ThreeOfAKind, HandEvaluator::ranking(HandEvaluator::evaluate(cards({ Card(V::Ace, S::Hearts), Card(V::Ace, S::Spades),
+        Card(V::Ace, S::Clubs), Card(V::Four, S::Diamonds), Card(V::Six, S::Hearts), Card(V::Jack, S::Clubs), Card(V::Eight, S::Spades) }))));
+    EXPECT_EQ(RankedHand::Ranking::TwoPair, HandEvaluator::ranking(HandEvaluator::evaluate(cards({ Card(V::Ace, S::Hearts), Card(V::Ace, S::Spades),
+        Card(V::Six, S::Clubs), Card(V::Four, S::Diamonds), Card(V::Six, S::Hearts), Card(V::Four, S::Clubs), Card(V::Eight, S::Spades) }))));
+    EXPECT_EQ(RankedHand::Ranking::Pair, HandEvaluator::ranking(HandEvaluator::evaluate(cards({ Card(V::Ace, S::Hearts), Card(V::Ace, S::Spades),
+        Card(V::Six, S::Clubs), Card(V::Four, S::Diamonds), Card(V::Nine, S::Hearts), Card(V::Two, S::Clubs), Card(V::Eight, S::Spades) }))));
+    EXPECT_EQ(RankedHand::Ranking::HighCard, HandEvaluator::ranking(HandEvaluator::evaluate(cards({ Card(V::Ace, S::Hearts), Card(V::King, S::Spades),
+        Card(V::Six, S::Clubs), Card(V::Four, S::Diamonds), Card(V::Nine, S::Hearts), Card(V::Two, S::Clubs), Card(V::Eight, S::Spades) }))));
+}
+
+TEST(HandEvaluatorTests, MatchesRankedHand)
+{
+    // Deal random pairs of hands onto a shared board and compare both evaluators' verdicts
+    Random rng(1234);
+    for (int deal = 0; deal < 2000; ++deal) {
+
+        // Draw nine distinct cards
+        utl::array<Card, 9> drawn;
+        HandEvaluator::CardMask used = 0;
+        for (auto& card : drawn) {
+            do {
+                card = Card(static_cast<Card::Value>(rng.getRandomNumberInRange(0, 12)), static_cast<Card::Suit>(rng.getRandomNumberInRange(0, 3)));
+            } while (used & HandEvaluator::cardMask(card));
+            used |= HandEvaluator::cardMask(card);
+        }
+        utl::array<Card, 2> first = { drawn[0], drawn[1] };
+        utl::array<Card, 2> second = { drawn[2], drawn[3] };
+        utl::vector<Card, 5> board;
+        for (size_t i = 4; i < 9; ++i)
+            board.push_back(drawn[i]);
+
+        RankedHand first_ranked(0, first, board);
+        RankedHand second_ranked(1, second, board);
+        uint32_t first_value = HandEvaluator::evaluate(first, board);
+        uint32_t second_value = HandEvaluator::evaluate(second, board);
+
+        EXPECT_EQ(first_ranked.getRanking(), HandEvaluator::ranking(first_value));
+        EXPECT_EQ(first_ranked < second_ranked, first_value < second_value);
+        EXPECT_EQ(first_ranked == second_ranked, first_value == second_value);
+    }
+}
+
+TEST(HandEvaluatorTests, TurnEquity)
+{
+    // Ace king of spades draws to the flush, an ace or a king against queens on the turn
+    BasicPokerGameState<2> state;
+    state.player_states[0].hand = { Card(Card::Value::Ace, Card::Suit::Spades), Card(Card::Value::King, Card::Suit::Spades) };
+    state.player_states[1].hand = { Card(Card::Value::Queen, Card::Suit::Diamonds), Card(Card::Value::Queen, Card::Suit::Clubs) };
+    state.board.push_back(Card(Card::Value::Two, Card::Suit::Spades));
+    state.board.push_back(Card(Card::Value::Seven, Card::Suit::Spades));
+    state.board.push_back(Card(Card::Value::Nine, Card::Suit::Hearts));
+    state.board.push_back(Card(Card::Value::Three, Card::Suit::Diamonds));
+    state.in_hand_mask = 0x03;
+
+    HandEvaluator::AllInEquity<2> equity = HandEvaluator::allInEquity(state);
+
+    // 15 of the 44 rivers win for ace king
+    EXPECT_EQ(44u, equity.boards);
+    EXPECT_EQ(15u * HandEvaluator::AllInEquity<2>::SPLIT, equity.shares[0]);
+    EXPECT_EQ(29u * HandEvaluator::AllInEquity<2>::SPLIT, equity.shares[1]);
+    EXPECT_EQ(3409, equity.permyriad(0));
+}
+
+TEST(HandEvaluatorTests, SplitEquity)
+{
+    // The board plays for three players on the river
+    BasicPokerGameState<6> state;
+    state.player_states[0].hand = { Card(Card::Value::Two, Card::Suit::Spades), Card(Card::Value::Three, Card::Suit::Clubs) };
+    state.player_states[2].hand = { Card(Card::Value::Two, Card::Suit::Hearts), Card(Card::Value::Three, Card::Suit::Diamonds) };
+    state.player_states[5].hand = { Card(Card::Value::Two, Card::Suit::Clubs), Card(Card::Value::Four, Card::Suit::Hearts) };
+    state.board.push_back(Card(Card::Value::Ace, Card::Suit::Spades));
+    state.board.push_back(Card(Card::Value::King, Card::Suit::Spades));
+    state.board.push_back(Card(Card::Value::Queen, Card::Suit::Hearts));
+    state.board.push_back(Card(Card::Value::Jack, Card::Suit::Diamonds));
+    state.board.push_back(Card(Card::Value::Ten, Card::Suit::Clubs));
+    state.in_hand_mask = 0x25;
+
+    HandEvaluator::AllInEquity<6> equity = HandEvaluator::allInEquity(state);
+
+    EXPECT_EQ(1u, equity.boards);
+    for (uint8_t player_id : { 0, 2, 5 })
+        EXPECT_EQ(HandEvaluator::AllInEquity<6>::SPLIT / 3, equity.shares[player_id]);
+    EXPECT_EQ(0u, equity.shares[1]);
+}
+
+TEST(HandEvaluatorTests, HandEquityEnumeratesRiver)
+{
+    using V = Card::Value;
+    using S = Card::Suit;
+    Random rng(1);
+
+    // A royal flush can not be beaten by any number of opponents
+    utl::vector<Card, 5> board;
+    board.push_back(Card(V::Queen, S::Hearts));
+    board.push_back(Card(V::Jack, S::Hearts));
+    board.push_back(Card(V::Ten, S::Hearts));
+    board.push_back(Card(V::Two, S::Clubs));
+    board.push_back(Card(V::Three, S::Diamonds));
+    utl::array<Card, 2> royal = { Card(V::Ace, S::Hearts), Card(V::King, S::Hearts) };
+    EXPECT_EQ(10000, HandEvaluator::handEquity(royal, board, 1, 1000, rng));
+    EXPECT_EQ(10000, HandEvaluator::handEquity(royal, board, 3, 1000, rng));
+    EXPECT_EQ(10000, HandEvaluator::handEquity(royal, board, 0, 0, rng));
+
+    // When the board plays, every opponent hand splits the pot
+    board.clear();
+    board.push_back(Card(V::Ace, S::Spades));
+    board.push_back(Card(V::King, S::Spades));
+    board.push_back(Card(V::Queen, S::Hearts));
+    board.push_back(Card(V::Jack, S::Diamonds));
+    board.push_back(Card(V::Ten, S::Clubs));
+    utl::array<Card, 2> low = { Card(V::Two, S::Spades), Card(V::Three, S::Clubs) };
+    EXPECT_EQ(5000, HandEvaluator::handEquity(low, board, 1, 1000, rng));
+    EXPECT_EQ(2500, HandEvaluator::handEquity(low, board, 2, 1000, rng));
+}
+
+TEST(HandEvaluatorTests, HandEquitySamplingAgreesWithEnumeration)
+{
+    using V = Card::Value;
+    using S = Card::Suit;
+    Random rng(2);
+
+    // Pocket aces on the turn, enumerated and sampled
+    utl::vector<Card, 5> board;
+    board.push_back(Card(V::King, S::Hearts));
+    board.push_back(Card(V::Seven, S::Clubs));
+    board.push_back(Card(V::Two, S::Diamonds));
+    board.push_back(Card(V::Nine, S::Spades));
+    utl::array<Card, 2> aces = { Card(V::Ace, S::Spades), Card(V::Ace, S::Diamonds) };
+    uint16_t exact = HandEvaluator::handEquity(aces, board, 1, 100000, rng);
+    uint16_t sampled = HandEvaluator::handEquity(aces, board, 1, 4000, rng);
+    EXPECT_GT(exact, 8500);
+    EXPECT_NEAR(exact, sampled, 300);
+
+    // On the flop, aces are sampled ahead of an unpaired four three
+    board.pop_back();
+    utl::array<Card, 2> four_three = { Card(V::Four, S::Hearts), Card(V::Three, S::Clubs) };
+    EXPECT_GT(HandEvaluator::handEquity(aces, board, 2, 3000, rng), HandEvaluator::handEquity(four_three, board, 2, 3000, rng));
+}
+
+TEST(HandEvaluatorTests, HandPotentialBatchesMerge)
+{
+    using V = Card::Value;
+    using S = Card::Suit;
+
+    utl::vector<Card, 5> board;
+    board.push_back(Card(V::King, S::Hearts));
+    board.push_back(Card(V::Seven, S::Clubs));
+    board.push_back(Card(V::Two, S::Diamonds));
+    utl::array<Card, 2> hand = { Card(V::Ace, S::Spades), Card(V::King, S::Spades) };
+
+    // Every opponent holding is counted once now, and once for every next card
+    HandEvaluator::HandPotential whole = HandEvaluator::handPotential(hand, board, 1, 1);
+    uint32_t now = 0;
+    uint32_t later = 0;
+    for (uint8_t i = 0; i < HandEvaluator::HandPotential::STANDINGS; ++i) {
+        now += whole.now[i];
+        for (uint8_t j = 0; j < HandEvaluator::HandPotential::STANDINGS; ++j)
+            later += whole.later[i][j];
+    }
+    EXPECT_EQ(1081u, now);
+    EXPECT_EQ(1081u * 45, later);
+    EXPECT_GE(HandEvaluator::potentialEvaluations(3, 1), now + later);
+
+    // Batches and threads add up to the whole
+    HandEvaluator::HandPotential batches = HandEvaluator::handPotential(hand, board, 1, 0, 500);
+    batches.merge(HandEvaluator::handPotential(hand, board, 1, 500, 1081));
+    HandEvaluator::HandPotential threaded = HandEvaluator::handPotential(hand, board, 1, 4);
+    for (uint8_t i = 0; i < HandEvaluator::HandPotential::STANDINGS; ++i) {
+        EXPECT_EQ(whole.now[i], batches.now[i]);
+        EXPECT_EQ(whole.now[i], threaded.now[i]);
+        for (uint8_t j = 0; j < HandEvaluator::HandPotential::STANDINGS; ++j) {
+            EXPECT_EQ(whole.later[i][j], batches.later[i][j]);
+            EXPECT_EQ(whole.later[i][j], threaded.later[i][j]);
+        }
+    }
+}
+
+TEST(HandEvaluatorTests, HandPotentialOfDrawsAndMadeHands)
+{
+    using V = Card::Value;
+    using S = Card::Suit;
+
+    // A straight and flush draw is mostly behind now but often gets ahead
+    utl::vector<Card, 5> board;
+    board.push_back(Card(V::Four, S::Hearts));
+    board.push_back(Card(V::Three, S::Hearts));
+    board.push_back(Card(V::King, S::Clubs));
+    utl::array<Card, 2> draw = { Card(V::Six, S::Hearts), Card(V::Five, S::Hearts) };
+    HandEvaluator::HandPotential drawing = HandEvaluator::handPotential(draw, board, 2, 1);
+    EXPECT_LT(drawing.strength(), 5000);
+    EXPECT_GT(drawing.positive(), 3000);
+    EXPECT_GT(drawing.effective(1), drawing.strength());
+
+    // An over pair is mostly ahead, and only falls behind sometimes
+    utl::array<Card, 2> aces = { Card(V::Ace, S::Spades), Card(V::Ace, S::Diamonds) };
+    HandEvaluator::HandPotential ahead = HandEvaluator::handPotential(aces, board, 2, 1);
+    EXPECT_GT(ahead.strength(), 8500);
+    EXPECT_GT(ahead.negative(), 0);
+    EXPECT_LT(ahead.negative(), 3000);
+
+    // The river has no potential, the made straight only splits with other sixes and fives
+    board.push_back(Card(V::Ten, S::Spades));
+    board.push_back(Card(V::Two, S::Diamonds));
+    HandEvaluator::HandPotential river = HandEvaluator::handPotential(draw, board, 1, 1);
+    EXPECT_GT(river.strength(), 9900);
+    EXPECT_EQ(0, river.positive());
+    EXPECT_EQ(river.strength(), river.effective(1));
+}
\ No newline at end of file
@@ -0,0 +1,392 @@
+/**
+ *  A simple interactive texas holdem poker program.
+ *  Copyright (C) 2020, Matt Zimmerer, mzimmere@gmail.com
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ **/
+#include "GTestIncludes.h"
+
+#include <vector>
+
+#include "PokerGame/HandHistory.h"
+#include "PokerGame/HandHistoryReplay.h"
+#include "PokerGame/HandHistoryStats.h"
+#include "PokerGame/PokerGame.h"
+#include "PokerGame/PokerGameImpl.h"
+
+/** Observer that stops the game after a fixed number of rounds
+ */
+class RoundLimitObserver
+{
+public:
+
+    explicit RoundLimitObserver(int max_rounds_in) : max_rounds(max_rounds_in) {}
+
+    void playerAction(const utl::string<MAX_NAME_SIZE>&, PokerGameBase::PlayerAction, uint16_t, const BasicPokerGameState<2>&) {}
+
+    void subRoundChange(PokerGameBase::SubRound, const BasicPokerGameState<2>&) {}
+
+    bool roundEnd(bool, const utl::string<MAX_NAME_SIZE>&, uint16_t, RankedHand::Ranking, const BasicPokerGameState<2>&,
+        const utl::vector<uint8_t, 2>&)
+    {
+        return ++this->rounds < this->max_rounds;
+    }
+
+    void gameEnd(const utl::string<MAX_NAME_SIZE>&)
+    {
+        this->game_ended = true;
+    }
+
+    int rounds = 0;
+    bool game_ended = false;
+
+private:
+
+    int max_rounds;
+};
+
+/** Append each chunk of the stream to a byte vector
+ */
+static void appendBytes(const uint8_t* data, size_t size, void* opaque)
+{
+    std::vector<uint8_t>* stream = static_cast<std::vector<uint8_t>*>(opaque);
+    stream->insert(stream->end(), data, data + size);
+}
+
+TEST(HandHistoryTests, CardCodes)
+{
+    // Every card round trips through its six bit code
+    for (uint8_t code = 0; code < 52; ++code) {
+        Card card = HandHistoryFormat::codeCard(code);
+        EXPECT_EQ(code, HandHistoryFormat::cardCode(card));
+    }
+    EXPECT_EQ(51, HandHistoryFormat::cardCode(Card(Card::Value::Ace, Card::Suit::Hearts)));
+}
+
+TEST(HandHistoryTests, EncoderPacksBitsAndVarints)
+{
+    std::vector<uint8_t> stream;
+    HandHistoryEncoder encoder(&appendBytes, &stream);
+    encoder.writeVarint(300);
+    encoder.writeBits(0x2A, 6);
+    encoder.writeBits(0x15, 6);
+    encoder.alignBits();
+    encoder.writeByte(0x7F);
+    encoder.flush();
+
+    // 300 is two varint bytes, twelve bits pad to two bytes
+    ASSERT_EQ(5u, stream.size());
+    EXPECT_EQ(0xAC, stream[0]);
+    EXPECT_EQ(0x02, stream[1]);
+    EXPECT_EQ(0x6A, stream[2]);
+    EXPECT_EQ(0x05, stream[3]);
+    EXPECT_EQ(0x7F, stream[4]);
+}
+
+TEST(HandHistoryTests, RecordsAndReadsBackGame)
+{
+    using Observer = TeeObserver<HandHistoryWriter<2>, RoundLimitObserver>;
+    using Game = BasicPokerGame<2, AIDecider<2>, Observer>;
+
+    struct AccessibleGame : public Game {
+        using Game::Game;
+        const Observer& getObserver() const { return this->observer; }
+    };
+
+    // Play an all AI heads up game, recording every hand
+    std::vector<uint8_t> stream;
+    AccessibleGame game(2024, 5, 500, AIDecider<2>(), Observer(HandHistoryWriter<2>(&appendBytes, &stream, 2024, 5), RoundLimitObserver(25)));
+    game.play();
+
+    // Both observers saw the game
+    int rounds = game.getObserver().second.rounds;
+    EXPECT_GT(rounds, 0);
+    EXPECT_TRUE(game.getObserver().second.game_ended);
+
+    // The header records the game setup
+    HandHistoryReader reader(stream.data(), stream.size());
+    HandHistoryHeader header;
+    ASSERT_TRUE(reader.readHeader(header));
+    EXPECT_EQ(HandHistoryFormat::VERSION, header.version);
+    EXPECT_EQ(2, header.seats);
+    EXPECT_EQ(2024u, header.random_seed);
+    EXPECT_EQ(5, header.small_blind);
+
+    // Every hand reads back
+    HandHistoryHand hand;
+    int hands = 0;
+    while (reader.readHand(hand)) {
+        ++hands;
+        EXPECT_EQ(static_cast<uint32_t>(hands), hand.round_number);
+        EXPECT_EQ(0x3, hand.seated_mask);
+
+        // Both players started with all the chips in play
+        if (hands == 1) {
+            EXPECT_EQ(1000, hand.starting_stacks[0] + hand.starting_stacks[1]);
+        }
+
+        // The blinds open the hand
+        ASSERT_GE(hand.events.size(), 2u);
+        EXPECT_EQ(PokerGameBase::PlayerAction::Bet, hand.events[0].action);
+        EXPECT_EQ(PokerGameBase::PlayerAction::Bet, hand.events[1].action);
+        EXPECT_NE(hand.events[0].player_id, hand.events[1].player_id);
+
+        // No card was dealt twice
+        uint64_t dealt = 0;
+        size_t dealt_count = 0;
+        for (uint8_t player_id = 0; player_id < 2; ++player_id) {
+            for (const auto& card : hand.hands[player_id]) {
+                dealt |= 1ull << HandHistoryFormat::cardCode(card);
+                ++dealt_count;
+            }
+        }
+        for (const auto& card : hand.board) {
+            dealt |= 1ull << HandHistoryFormat::cardCode(card);
+            ++dealt_count;
+        }
+        size_t distinct = 0;
+        for (; dealt; dealt &= dealt - 1)
+            ++distinct;
+        EXPECT_EQ(dealt_count, distinct);
+
+        // Streets that were marked were dealt
+        if (hand.street_events[0] < hand.events.size()) {
+            EXPECT_GE(hand.board.size(), 3u);
+        }
+    }
+    EXPECT_EQ(rounds, hands);
+    EXPECT_EQ(stream.size(), reader.getOffset());
+
+    // A heads up hand fits in a few dozen bytes
+    EXPECT_LT(stream.size(), static_cast<size_t>(hands) * 40);
+}
+
+/** Record an all AI heads up game
+ *  @param random_seed The game's random seed
+ *  @param max_rounds The number of rounds to play
+ *  @param stream The recorded stream
+ *  @return The number of rounds played
+ */
+static int recordGame(uint32_t random_seed, int max_rounds, std::vector<uint8_t>& stream)
+{
+    using Observer = TeeObserver<HandHistoryWriter<2>, RoundLimitObserver>;
+    using Game = BasicPokerGame<2, AIDecider<2>, Observer>;
+
+    struct AccessibleGame : public Game {
+        using Game::Game;
+        const Observer& getObserver() const { return this->observer; }
+    };
+
+    AccessibleGame game(random_seed, 5, 500, AIDecider<2>(), Observer(HandHistoryWriter<2>(&appendBytes, &stream, random_seed, 5), RoundLimitObserver(max_rounds)));
+    game.play();
+    return game.getObserver().second.rounds;
+}
+
+TEST(HandHistoryTests, ReplayReproducesGame)
+{
+    // Every hand of several games replays exactly as it was recorded
+    for (uint32_t random_seed = 1; random_seed <= 10; ++random_seed) {
+        std::vector<uint8_t> stream;
+        int rounds = recordGame(random_seed, 60, stream);
+
+        HandHistoryReplayer<2> replayer(stream.data(), stream.size());
+        HandHistoryReplayResult result = replayer.replay();
+        EXPECT_EQ(static_cast<uint32_t>(rounds), result.hands);
+        EXPECT_EQ(0u, result.mismatches);
+        EXPECT_EQ(0u, result.first_mismatch);
+        EXPECT_TRUE(result.complete);
+        EXPECT_EQ(stream.size(), result.bytes);
+    }
+}
+
+TEST(HandHistoryTests, ReplayDetectsTamperedStream)
+{
+    std::vector<uint8_t> stream;
+    recordGame(77, 10, stream);
+
+    // Raise the recorded small blind, the blinds posted by the replay no longer match the record
+    ASSERT_EQ(5, stream[5]);
+    stream[5] = 6;
+    HandHistoryReplayer<2> replayer(stream.data(), stream.size());
+    HandHistoryReplayResult result = replayer.replay();
+    EXPECT_GT(result.mismatches, 0u);
+    EXPECT_EQ(1u, result.first_mismatch);
+
+    // A stream for another table size is not replayed
+    HandHistoryReplayer<6> six_seats(stream.data(), stream.size());
+    EXPECT_EQ(0u, six_seats.replay().hands);
+}
+
+TEST(HandHistoryTests, StatsCountPreflopActions)
+{
+    // The blinds, the small blind raises and the big blind folds
+    HandHistoryHand hand;
+    hand.seated_mask = 0x3;
+    hand.events.push_back({ 0, PokerGameBase::PlayerAction::Bet, 5 });
+    hand.events.push_back({ 1, PokerGameBase::PlayerAction::Bet, 10 });
+    hand.events.push_back({ 0, PokerGameBase::PlayerAction::Bet, 20 });
+    hand.events.push_back({ 1, PokerGameBase::PlayerAction::Fold, 0 });
+    hand.street_events = { 4, 4, 4 };
+    hand.winnings = 40;
+
+    HandHistoryStats stats;
+    stats.add(hand);
+    EXPECT_EQ(1u, stats.hands);
+    EXPECT_EQ(1u, stats.vpip[0]);
+    EXPECT_EQ(1u, stats.pfr[0]);
+    EXPECT_EQ(0u, stats.vpip[1]);
+    EXPECT_EQ(1u, stats.street_hands[0]);
+    EXPECT_EQ(40u, stats.street_pots[0]);
+
+    // The small blind calls and the big blind checks, only the small blind put chips in voluntarily
+    hand.events.resize(2);
+    hand.events.push_back({ 0, PokerGameBase::PlayerAction::CheckOrCall, 0 });
+    hand.events.push_back({ 1, PokerGameBase::PlayerAction::CheckOrCall, 0 });
+    stats.add(hand, HandHistoryStats::PREFLOP);
+    EXPECT_EQ(2u, stats.vpip[0]);
+    EXPECT_EQ(1u, stats.pfr[0]);
+    EXPECT_EQ(0u, stats.vpip[1]);
+    EXPECT_EQ(1u, stats.street_hands[0]);
+}
+
+TEST(HandHistoryTests, StatsOverRecordedGames)
+{
+    // Gather statistics over two games at once, and over each game separately
+    std::vector<uint8_t> first;
+    std::vector<uint8_t> second;
+    int rounds = recordGame(3, 60, first) + recordGame(4, 60, second);
+    std::vector<uint8_t> both(first);
+    both.insert(both.end(), second.begin(), second.end());
+
+    HandHistoryStats stats;
+    size_t first_size = stats.addStream(both.data(), both.size());
+    ASSERT_EQ(first.size(), first_size);
+    ASSERT_EQ(second.size(), stats.addStream(both.data() + first_size, both.size() - first_size));
+    EXPECT_EQ(static_cast<uint32_t>(rounds), stats.hands);
+    EXPECT_EQ(stats.hands, stats.dealt[0]);
+    EXPECT_EQ(stats.hands, stats.dealt[1]);
+    uint32_t street_hands = 0;
+    for (auto hands : stats.street_hands)
+        street_hands += hands;
+    EXPECT_EQ(stats.hands, street_hands);
+    for (size_t i = 0; i < HandHistoryStats::RANKINGS; ++i)
+        EXPECT_LE(stats.showdown_wins[i], stats.showdowns[i]);
+    EXPECT_LE(stats.pfr[0], stats.vpip[0]);
+    EXPECT_LE(stats.vpip[0], stats.dealt[0]);
+
+    HandHistoryStats merged;
+    HandHistoryStats second_stats;
+    merged.addStream(first.data(), first.size());
+    second_stats.addStream(second.data(), second.size());
+    merged.merge(second_stats);
+    EXPECT_EQ(stats.hands, merged.hands);
+    for (size_t i = 0; i < 2; ++i)
+        EXPECT_EQ(stats.vpip[i], merged.vpip[i]);
+    for (size_t i = 0; i < HandHistoryStats::RANKINGS; ++i)
+        EXPECT_EQ(stats.showdowns[i], merged.showdowns[i]);
+    for (size_t i = 0; i < HandHistoryStats::STREETS; ++i)
+        EXPECT_EQ(stats.street_pots[i], merged.street_pots[i]);
+}
+
+/** Write a heads up hand where the players raise each other a number of times, and the big blind then folds
+ */
+static void writeRaisingHand(HandHistoryEncoder& encoder, uint32_t round_number, int raises)
+{
+    encoder.writeVarint(round_number);
+    encoder.writeByte(0);
+    encoder.writeVarint(0x3);
+    encoder.writeVarint(5000);
+    encoder.writeVarint(5000);
+    for (uint8_t code = 0; code < 4; ++code)
+        encoder.writeBits(code, HandHistoryFormat::CARD_BITS);
+    encoder.alignBits();
+    for (int i = 0; i < raises; ++i) {
+        encoder.writeByte(HandHistoryFormat::actionEvent(static_cast<uint8_t>(i % 2), PokerGameBase::PlayerAction::Bet));
+        encoder.writeVarint(static_cast<uint32_t>(10 * (i + 1)));
+    }
+    encoder.writeByte(HandHistoryFormat::actionEvent(static_cast<uint8_t>(raises % 2), PokerGameBase::PlayerAction::Fold));
+    encoder.writeByte(HandHistoryFormat::END);
+    encoder.writeByte(0);
+    encoder.writeVarint(static_cast<uint32_t>(10 * raises));
+    encoder.writeByte(static_cast<uint8_t>((raises + 1) % 2));
+}
+
+TEST(HandHistoryTests, ReadsPastHandWithTooManyActions)
+{
+    // A hand with more raises than a hand keeps, then an ordinary hand
+    std::vector<uint8_t> stream;
+    HandHistoryEncoder encoder(&appendBytes, &stream);
+    encoder.writeByte('H');
+    encoder.writeByte('H');
+    encoder.writeByte(HandHistoryFormat::VERSION);
+    encoder.writeByte(2);
+    encoder.writeVarint(1);
+    encoder.writeVarint(5);
+    writeRaisingHand(encoder, 1, 150);
+    writeRaisingHand(encoder, 2, 3);
+    encoder.writeByte(HandHistoryFormat::END_OF_STREAM);
+    encoder.flush();
+
+    // Both hands are read, the first keeps as many actions as it can
+    HandHistoryReader reader(stream.data(), stream.size());
+    HandHistoryHeader header;
+    ASSERT_TRUE(reader.readHeader(header));
+    HandHistoryHand hand;
+    ASSERT_TRUE(reader.readHand(hand));
+    EXPECT_EQ(HandHistoryHand::MAX_EVENTS, hand.events.size());
+    EXPECT_EQ(151 - HandHistoryHand::MAX_EVENTS, hand.dropped_events);
+    EXPECT_EQ(1500, hand.winnings);
+    EXPECT_EQ(1, hand.winner);
+    ASSERT_TRUE(reader.readHand(hand));
+    EXPECT_EQ(2u, hand.round_number);
+    EXPECT_EQ(4u, hand.events.size());
+    EXPECT_EQ(0u, hand.dropped_events);
+    EXPECT_FALSE(reader.readHand(hand));
+    EXPECT_TRUE(reader.isComplete());
+    EXPECT_EQ(stream.size(), reader.getOffset());
+
+    // The long hand counts toward the pots, not toward who put chips in
+    HandHistoryStats stats;
+    EXPECT_EQ(stream.size(), stats.addStream(stream.data(), stream.size()));
+    EXPECT_EQ(2u, stats.hands);
+    EXPECT_EQ(1u, stats.vpip[0]);
+    EXPECT_EQ(0u, stats.vpip[1]);
+
+    // The replay stops at the long hand, and reads past the rest of the stream
+    HandHistoryReplayer<2> replayer(stream.data(), stream.size());
+    HandHistoryReplayResult result = replayer.replay();
+    EXPECT_EQ(0u, result.hands);
+    EXPECT_EQ(1u, result.overlong_hand);
+    EXPECT_EQ(2u, result.skipped);
+    EXPECT_TRUE(result.complete);
+    EXPECT_EQ(stream.size(), result.bytes);
+}
+
+TEST(HandHistoryTests, RejectsTruncatedStream)
+{
+    std::vector<uint8_t> stream;
+    HandHistoryWriter<2> writer(&appendBytes, &stream, 1, 5);
+    using Game = BasicPokerGame<2, AIDecider<2>, TeeObserver<HandHistoryWriter<2>, RoundLimitObserver>>;
+    Game game(7, 5, 500, AIDecider<2>(), TeeObserver<HandHistoryWriter<2>, RoundLimitObserver>(writer, RoundLimitObserver(1)));
+    game.play();
+
+    // Cut the only hand short
+    ASSERT_GT(stream.size(), 12u);
+    stream.resize(12);
+    HandHistoryReader reader(stream.data(), stream.size());
+    HandHistoryHeader header;
+    ASSERT_TRUE(reader.readHeader(header));
+    HandHistoryHand hand;
+    EXPECT_FALSE(reader.readHand(hand));
+}
\ No newline at end of file
@@ -119,6 +119,90 @@ TEST(HandTests, FlushRanking7Card)
     EXPECT_EQ(Card::Value::Two, hand.getSubRanking()[4].getValue());
 }
 
+TEST(HandTests, FlushRanking7CardOneSuit)
+{
+    HandTestWrapper hand;
+    hand.addCard(Card::Value::Four, Card::Suit::Hearts);
+    hand.addCard(Card::Value::Three, Card::Suit::Hearts);
+    hand.addCard(Card::Value::Nine, Card::Suit::Hearts);
+    hand.addCard(Card::Value::Two, Card::Suit::Hearts);
+    hand.addCard(Card::Value::Queen, Card::Suit::Hearts);
+    hand.addCard(Card::Value::Jack, Card::Suit::Hearts);
+    hand.addCard(Card::Value::King, Card::Suit::Hearts);
+
+    hand.rankNow();
+
+    EXPECT_EQ(RankedHand::Ranking::Flush, hand.getRanking());
+
+    EXPECT_EQ(5, hand.getSubRanking().size());
+    EXPECT_EQ(Card::Value::King, hand.getSubRanking()[0].getValue());
+    EXPECT_EQ(Card::Value::Queen, hand.getSubRanking()[1].getValue());
+    EXPECT_EQ(Card::Value::Jack, hand.getSubRanking()[2].getValue());
+    EXPECT_EQ(Card::Value::Nine, hand.getSubRanking()[3].getValue());
+    EXPECT_EQ(Card::Value::Four, hand.getSubRanking()[4].getValue());
+}
+
+TEST(HandTests, FlushRanking7CardSixOfASuit)
+{
+    HandTestWrapper hand;
+    hand.addCard(Card::Value::Four, Card::Suit::Spades);
+    hand.addCard(Card::Value::Three, Card::Suit::Spades);
+    hand.addCard(Card::Value::Nine, Card::Suit::Spades);
+    hand.addCard(Card::Value::Two, Card::Suit::Spades);
+    hand.addCard(Card::Value::Queen, Card::Suit::Spades);
+    hand.addCard(Card::Value::Jack, Card::Suit::Spades);
+    hand.addCard(Card::Value::Ace, Card::Suit::Diamonds);
+
+    hand.rankNow();
+
+    EXPECT_EQ(RankedHand::Ranking::Flush, hand.getRanking());
+
+    EXPECT_EQ(5, hand.getSubRanking().size());
+    EXPECT_EQ(Card::Value::Queen, hand.getSubRanking()[0].getValue());
+    EXPECT_EQ(Card::Value::Jack, hand.getSubRanking()[1].getValue());
+    EXPECT_EQ(Card::Value::Nine, hand.getSubRanking()[2].getValue());
+    EXPECT_EQ(Card::Value::Four, hand.getSubRanking()[3].getValue());
+    EXPECT_EQ(Card::Value::Three, hand.getSubRanking()[4].getValue());
+}
+
+TEST(HandTests, FullHouseRanking7CardTwoThreeOfAKinds)
+{
+    HandTestWrapper hand;
+    hand.addCard(Card::Value::Two, Card::Suit::Diamonds);
+    hand.addCard(Card::Value::Two, Card::Suit::Spades);
+    hand.addCard(Card::Value::Queen, Card::Suit::Hearts);
+    hand.addCard(Card::Value::Two, Card::Suit::Hearts);
+    hand.addCard(Card::Value::Queen, Card::Suit::Clubs);
+    hand.addCard(Card::Value::Queen, Card::Suit::Spades);
+    hand.addCard(Card::Value::Jack, Card::Suit::Clubs);
+
+    hand.rankNow();
+
+    EXPECT_EQ(RankedHand::Ranking::FullHouse, hand.getRanking());
+
+    EXPECT_EQ(2, hand.getSubRanking().size());
+    EXPECT_EQ(Card::Value::Queen, hand.getSubRanking()[0].getValue());
+    EXPECT_EQ(Card::Value::Two, hand.getSubRanking()[1].getValue());
+}
+
+TEST(HandTests, StraightFlushRanking7CardBehindStraight)
+{
+    HandTestWrapper hand;
+    hand.addCard(Card::Value::Five, Card::Suit::Hearts);
+    hand.addCard(Card::Value::Six, Card::Suit::Hearts);
+    hand.addCard(Card::Value::Seven, Card::Suit::Hearts);
+    hand.addCard(Card::Value::Eight, Card::Suit::Hearts);
+    hand.addCard(Card::Value::Nine, Card::Suit::Hearts);
+    hand.addCard(Card::Value::Ten, Card::Suit::Clubs);
+    hand.addCard(Card::Value::Two, Card::Suit::Diamonds);
+
+    hand.rankNow();
+
+    EXPECT_EQ(RankedHand::Ranking::StraightFlush, hand.getRanking());
+    EXPECT_EQ(1, hand.getSubRanking().size());
+    EXPECT_EQ(Card::Value::Nine, hand.getSubRanking()[0].getValue());
+}
+
 TEST(HandTests, StraightRanking7Card)
 {
     HandTestWrapper hand;
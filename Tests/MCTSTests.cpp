@@ -0,0 +1,124 @@
+/**
+ *  A simple interactive texas holdem poker program.
+ *  Copyright (C) 2020, Matt Zimmerer, mzimmere@gmail.com
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ **/
+
+#include "GTestIncludes.h"
+
+#include "PokerGame/MCTS.h"
+#include "PokerGame/PokerGameImpl.h"
+
+/** Build a heads up state pre-flop, the dealer in seat 0 has posted the small blind and seat 1 the big blind
+ *  @param hand The dealer's hand
+ *  @return The state
+ */
+static BasicPokerGameState<2> blindsPosted(const utl::array<Card, 2>& hand)
+{
+	BasicPokerGameState<2> state;
+	state.current_dealer = 0;
+	state.current_bet = 10;
+	state.player_states[0].stack = 995;
+	state.player_states[0].pot_investment = 5;
+	state.current_pot_shares[0] = 5;
+	state.player_states[0].hand = hand;
+	state.player_states[1].stack = 990;
+	state.player_states[1].pot_investment = 10;
+	state.current_pot_shares[1] = 10;
+	state.updateSeatMasks();
+	return state;
+}
+
+/** Decider that searches with MCTS for one seat, the rule based AI plays the other
+ *  @tparam SEATS The number of seats at the table
+ */
+template <uint8_t SEATS>
+class MatchDecider
+{
+public:
+
+	explicit MatchDecider(uint8_t searching_player_in) : searching_player(searching_player_in) {}
+
+	utl::pair<PokerGameBase::PlayerAction, uint16_t> decide(const BasicPokerGameState<SEATS>& state, uint8_t player_id, Random& rng)
+	{
+		if (player_id == this->searching_player)
+			return MCTS::decide(state, player_id, 32, 0, rng);
+		return AI::computerDecision<SEATS>(state, rng, player_id);
+	}
+
+private:
+
+	uint8_t searching_player;
+};
+
+/** Observer that ends the game after a single round
+ */
+class SingleRoundObserver : public NullObserver
+{
+public:
+
+	template <class State, class RevealingPlayers>
+	bool roundEnd(bool, const utl::string<MAX_NAME_SIZE>&, uint16_t, RankedHand::Ranking, const State&, const RevealingPlayers&)
+	{
+		return false;
+	}
+};
+
+TEST(MCTSTests, SearchVisitsLegalActions)
+{
+	using V = Card::Value;
+	using S = Card::Suit;
+
+	// Facing the big blind every action is legal, and is visited
+	BasicPokerGameState<2> state = blindsPosted({ Card(V::Ace, S::Spades), Card(V::Ace, S::Hearts) });
+	Random rng(7);
+	MCTS::Statistics statistics = MCTS::search(state, 0, 300, 0, 1, rng);
+	EXPECT_EQ(300u, statistics.visits[MCTS::FOLD] + statistics.visits[MCTS::CALL] + statistics.visits[MCTS::BET]);
+	for (uint8_t action = 0; action < MCTS::ACTIONS; ++action)
+		EXPECT_GT(statistics.visits[action], 0u);
+
+	// Aces do not fold, and root parallel workers share the rollouts
+	EXPECT_NE(MCTS::FOLD, statistics.best());
+	statistics = MCTS::search(state, 0, 300, 0, 4, rng);
+	EXPECT_EQ(300u, statistics.visits[MCTS::FOLD] + statistics.visits[MCTS::CALL] + statistics.visits[MCTS::BET]);
+	EXPECT_NE(MCTS::FOLD, statistics.best());
+
+	// Without a bet to call there is nothing to fold to
+	state.player_states[0].stack = 990;
+	state.player_states[0].pot_investment = 10;
+	state.current_pot_shares[0] = 10;
+	statistics = MCTS::search(state, 0, 100, 0, 1, rng);
+	EXPECT_EQ(0u, statistics.visits[MCTS::FOLD]);
+	EXPECT_EQ(100u, statistics.visits[MCTS::CALL] + statistics.visits[MCTS::BET]);
+}
+
+TEST(MCTSTests, SmallBudgetBeatsRuleBasedAI)
+{
+	using Game = BasicPokerGame<2, MatchDecider<2>, SingleRoundObserver>;
+	struct AccessibleGame : public Game {
+		using Game::Game;
+		int stack(uint8_t player_id) const { return this->current_state.player_states[player_id].stack; }
+	};
+
+	// Play single hands from both seats, the search should win chips from the AI that plays its rollouts
+	int winnings = 0;
+	for (uint32_t seed = 0; seed < 1000; ++seed) {
+		uint8_t searching_player = static_cast<uint8_t>(seed % 2);
+		AccessibleGame game(seed, 5, 1000, MatchDecider<2>(searching_player), SingleRoundObserver());
+		game.play();
+		winnings += game.stack(searching_player) - 1000;
+	}
+	EXPECT_GT(winnings, 0);
+}
\ No newline at end of file
@@ -0,0 +1,46 @@
+/**
+ *  A simple interactive texas holdem poker program.
+ *  Copyright (C) 2020, Matt Zimmerer, mzimmere@gmail.com
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ **/
+
+#include "GTestIncludes.h"
+
+#include "PokerGame/NullIO.h"
+#include "PokerGame/PokerGameImpl.h"
+
+TEST(NullIOTests, PlaysAGameWithoutInput)
+{
+	NullIO null_io;
+	PokerGame poker_game(4321, 5, 500, &NullIO::userDecision, &NullIO::playerAction, &NullIO::subRoundChange, &NullIO::roundEnd,
+		&NullIO::gameEnd, &null_io);
+
+	// Every step runs to the end of a round or the game, the null front end never waits for input
+	uint32_t rounds = 0;
+	PokerGame::StepResult result = PokerGame::StepResult::Running;
+	for (uint16_t i = 0; i < 5000 && result != PokerGame::StepResult::GameOver; ++i) {
+		result = poker_game.step();
+		ASSERT_NE(PokerGame::StepResult::WaitingForInput, result);
+		if (result == PokerGame::StepResult::RoundOver)
+			++rounds;
+	}
+
+	// Each round ended has two blinds at least
+	EXPECT_EQ(PokerGame::StepResult::GameOver, result);
+	EXPECT_TRUE(null_io.isGameOver());
+	EXPECT_GT(null_io.getDecisions(), 0u);
+	EXPECT_GE(null_io.getRounds(), rounds);
+	EXPECT_GE(null_io.getEvents(), 2 * null_io.getRounds());
+}
\ No newline at end of file
@@ -0,0 +1,191 @@
+/**
+ *  A simple interactive texas holdem poker program.
+ *  Copyright (C) 2020, Matt Zimmerer, mzimmere@gmail.com
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ **/
+
+#include "GTestIncludes.h"
+
+#include "PokerGame/OpponentModel.h"
+#include "PokerGame/PokerGameImpl.h"
+
+/** Drives an observer through heads up hands, seat 0 deals and posts the small blind
+ */
+class ModelHarness
+{
+public:
+
+	OpponentModel<2> model;
+	OpponentModelObserver<2> observer{ &model };
+	BasicPokerGameState<2> state;
+
+	/** Post the blinds and open the pre-flop betting round
+	 */
+	void startHand()
+	{
+		for (uint8_t seat = 0; seat < 2; ++seat) {
+			this->state.player_states[seat].stack = 1000;
+			this->state.player_states[seat].pot_investment = 0;
+			this->state.player_states[seat].folded = false;
+			this->state.current_pot_shares[seat] = 0;
+		}
+		this->state.board.clear();
+		this->state.updateSeatMasks();
+		this->state.current_bet = 0;
+		this->act(0, PokerGameBase::PlayerAction::Bet, 5);
+		this->act(1, PokerGameBase::PlayerAction::Bet, 5);
+		this->observer.subRoundChange(PokerGameBase::SubRound::PreFlop, this->state);
+	}
+
+	/** Apply an action to the state and notify the observer
+	 *  @param seat The acting seat
+	 *  @param action The action
+	 *  @param raise The raise of a bet
+	 */
+	void act(uint8_t seat, PokerGameBase::PlayerAction action, uint16_t raise)
+	{
+		uint16_t chips = action == PokerGameBase::PlayerAction::Fold ? 0 : this->state.current_bet - this->state.current_pot_shares[seat];
+		if (action == PokerGameBase::PlayerAction::Bet)
+			chips += raise;
+		this->state.player_states[seat].stack -= chips;
+		this->state.player_states[seat].pot_investment += chips;
+		this->state.current_pot_shares[seat] += chips;
+		if (action == PokerGameBase::PlayerAction::Bet)
+			this->state.current_bet = this->state.current_pot_shares[seat];
+		if (action == PokerGameBase::PlayerAction::Fold)
+			this->state.player_states[seat].folded = true;
+		this->state.updateSeat(seat);
+		this->state.current_player = seat;
+		this->observer.playerAction(this->state.player_states[seat].name, action, raise, this->state);
+	}
+
+	/** End the hand
+	 */
+	void endHand()
+	{
+		utl::vector<uint8_t, 2> revealing_players;
+		this->observer.roundEnd(false, this->state.player_states[0].name, 0, RankedHand::Ranking::Unranked, this->state, revealing_players);
+	}
+};
+
+TEST(OpponentModelTests, ObserverTracksTendencies)
+{
+	// Seat 0 raises the big blind every hand, seat 1 folds to every raise
+	ModelHarness harness;
+	for (int hand = 0; hand < 60; ++hand) {
+		harness.startHand();
+		harness.act(0, PokerGameBase::PlayerAction::Bet, 20);
+		harness.act(1, PokerGameBase::PlayerAction::Fold, 0);
+		harness.endHand();
+	}
+	const SeatProfile& raiser = harness.model.profiles[0];
+	const SeatProfile& folder = harness.model.profiles[1];
+	EXPECT_GT(raiser.vpip, 9800);
+	EXPECT_GT(raiser.pfr, 9800);
+	EXPECT_GT(raiser.aggression, 9800);
+	EXPECT_LT(raiser.fold_to_bet, 200);
+	EXPECT_LT(folder.vpip, 200);
+	EXPECT_LT(folder.pfr, 200);
+	EXPECT_GT(folder.fold_to_bet, 9800);
+
+	// Blinds are not voluntary, and a check is neither a call nor a bet
+	ModelHarness checks;
+	for (int hand = 0; hand < 60; ++hand) {
+		checks.startHand();
+		checks.act(0, PokerGameBase::PlayerAction::CheckOrCall, 0);
+		checks.act(1, PokerGameBase::PlayerAction::CheckOrCall, 0);
+		checks.endHand();
+	}
+	EXPECT_GT(checks.model.profiles[0].vpip, 9800);
+	EXPECT_LT(checks.model.profiles[0].aggression, 200);
+	EXPECT_LT(checks.model.profiles[0].fold_to_bet, 200);
+	EXPECT_LT(checks.model.profiles[1].vpip, 200);
+	EXPECT_EQ(SeatProfile::NEUTRAL, checks.model.profiles[1].aggression);
+
+	// The profile of the opponents in the hand is their mean
+	harness.startHand();
+	SeatProfile opponents = harness.model.opponents(harness.state, 0);
+	EXPECT_EQ(folder.fold_to_bet, opponents.fold_to_bet);
+	EXPECT_EQ(100, SeatProfile().aggressionFactor());
+}
+
+/** Count the AI's actions with a hand facing a raise pre-flop
+ *  @param hand The AI's hand
+ *  @param opponents The opponents' profile
+ *  @return The number of times the AI checked or called, bet and folded, by PlayerAction - 1
+ */
+static utl::array<int, 3> countActions(const utl::array<Card, 2>& hand, const SeatProfile& opponents)
+{
+	BasicPokerGameState<2> state;
+	state.current_bet = 40;
+	state.player_states[0].stack = 990;
+	state.player_states[0].pot_investment = 10;
+	state.current_pot_shares[0] = 10;
+	state.player_states[0].hand = hand;
+	state.player_states[1].stack = 960;
+	state.player_states[1].pot_investment = 40;
+	state.current_pot_shares[1] = 40;
+	state.updateSeatMasks();
+
+	utl::array<int, 3> result{};
+	for (uint32_t seed = 0; seed < 2000; ++seed) {
+
+		// A neutral profile plays exactly as the AI does without one
+		Random rng(seed);
+		Random model_rng(seed);
+		utl::pair<PokerGameBase::PlayerAction, uint16_t> plain = AI::computerDecision<2>(state, rng, 0);
+		utl::pair<PokerGameBase::PlayerAction, uint16_t> modeled = AI::computerDecision<2>(state, model_rng, 0, opponents);
+		if (opponents.vpip == SeatProfile::NEUTRAL && opponents.fold_to_bet == SeatProfile::NEUTRAL) {
+			EXPECT_EQ(plain.first, modeled.first);
+			EXPECT_EQ(plain.second, modeled.second);
+		}
+		++result[static_cast<int>(modeled.first) - 1];
+	}
+	return result;
+}
+
+TEST(OpponentModelTests, AIAdjustsToOpponents)
+{
+	using V = Card::Value;
+	using S = Card::Suit;
+	int bet = static_cast<int>(PokerGameBase::PlayerAction::Bet) - 1;
+	int fold = static_cast<int>(PokerGameBase::PlayerAction::Fold) - 1;
+	SeatProfile neutral;
+
+	// Against players that fold to bets a strong hand raises more
+	utl::array<Card, 2> aces = { Card(V::Ace, S::Spades), Card(V::Ace, S::Hearts) };
+	SeatProfile folds;
+	folds.fold_to_bet = 10000;
+	EXPECT_GT(countActions(aces, folds)[bet], countActions(aces, neutral)[bet]);
+
+	// Against loose players a weak hand folds less
+	utl::array<Card, 2> seven_deuce = { Card(V::Seven, S::Spades), Card(V::Two, S::Hearts) };
+	SeatProfile loose;
+	loose.vpip = 10000;
+	EXPECT_LT(countActions(seven_deuce, loose)[fold], countActions(seven_deuce, neutral)[fold]);
+}
+
+TEST(OpponentModelTests, ModeledGame)
+{
+	using Game = BasicPokerGame<2, OpponentModelDecider<2>, OpponentModelObserver<2>>;
+
+	// Every seat is played by the AI against the model the observer keeps
+	OpponentModel<2> model;
+	Game game(5, 5, 500, OpponentModelDecider<2>(&model), OpponentModelObserver<2>(&model));
+	game.play();
+	EXPECT_GT(game.getRoundNumber(), 0u);
+	EXPECT_NE(SeatProfile::NEUTRAL, model.profiles[0].vpip);
+	EXPECT_NE(SeatProfile::NEUTRAL, model.profiles[1].vpip);
+}
\ No newline at end of file
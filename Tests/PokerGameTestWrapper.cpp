@@ -18,9 +18,51 @@
 
 #include "PokerGameTestWrapper.h"
 
-PokerGameTestWrapper::PokerGameTestWrapper() : PokerGame(0, 5, 500, &decisionCallback,
-	&playerActionCallback, &subRoundChangeCallback,
-	&roundEndCallback, &gameEndCallback, this)
+ScriptedDecider::ScriptedDecider(PokerGameTestWrapper* wrapper_in) : wrapper(wrapper_in)
+{
+}
+
+utl::pair<PokerGame::PlayerAction, uint16_t> ScriptedDecider::decide(const PokerGameState& state, uint8_t player_id, Random& rng)
+{
+	// Allow the player to decide an action
+	if (player_id == 0)
+	{
+		// Allow player to make a decision
+		utl::vector<uint8_t, 6> revealing_players;
+		return PokerGameTestWrapper::decisionCallback(state.playerView(player_id, revealing_players), this->wrapper);
+	}
+	else
+	{
+		// Play the pre-loaded AI decision
+		utl::pair<PokerGame::PlayerAction, uint16_t> action = this->wrapper->player_decisions[player_id].back();
+		this->wrapper->player_decisions[player_id].pop_back();
+		return action;
+	}
+}
+
+ScriptedDealer::ScriptedDealer(PokerGameTestWrapper* wrapper_in) : wrapper(wrapper_in)
+{
+}
+
+uint8_t ScriptedDealer::chooseDealer(Random& rng, uint8_t seats)
+{
+	return this->wrapper->starting_dealer;
+}
+
+void ScriptedDealer::shuffle(Deck& deck)
+{
+}
+
+Card ScriptedDealer::dealCard(Deck& deck)
+{
+	Card result = this->wrapper->card_list.back();
+	this->wrapper->card_list.pop_back();
+	return result;
+}
+
+PokerGameTestWrapper::PokerGameTestWrapper() : BasicPokerGame(0, 5, 500, ScriptedDecider(this),
+	CallbackObserver<6>(&playerActionCallback, &subRoundChangeCallback, &roundEndCallback, &gameEndCallback, this),
+	ScriptedDealer(this))
 {
 }
 
@@ -116,40 +158,6 @@ void PokerGameTestWrapper::gameEndCallback(const utl::string<MAX_NAME_SIZE>& win
 	self->game_winner_list.push_front(std::string(winner.begin(), winner.end()));
 }
 
-uint8_t PokerGameTestWrapper::chooseDealer()
-{
-	return this->starting_dealer;
-}
-
-Card PokerGameTestWrapper::dealCard()
-{
-	Card result = this->card_list.back();
-	this->card_list.pop_back();
-	return result;
-}
-
-utl::pair<PokerGame::PlayerAction, uint16_t> PokerGameTestWrapper::playerAction(uint8_t player_id)
-{
-	// Construct state
-	utl::vector<uint8_t, 6> revealing_players;
-	PokerGameState state = this->constructState(player_id, revealing_players);
-
-	// Allow the player to decide an action
-	utl::pair<PokerGame::PlayerAction, uint16_t> action(PokerGame::PlayerAction::CheckOrCall, 0);
-	if (player_id == 0)
-	{
-		// Allow player to make a decision
-		return this->decision_callback(state, this->opaque);
-	}
-	else
-	{
-		// Allow AI to make a decision
-		action = this->player_decisions[state.current_player].back();
-		this->player_decisions[state.current_player].pop_back();
-		return action;
-	}
-}
-
 void PokerGameTestWrapper::expectAIHandsUnrevealed(const PokerGameState& state) {
 	for (size_t i = 1; i < 6; ++i) {
 		EXPECT_EQ(Card::Value::Unrevealed, state.player_states[i].hand[0].getValue());
@@ -24,11 +24,73 @@
 #include <vector>
 
 #include "PokerGame/PokerGame.h"
+#include "PokerGame/PokerGameImpl.h"
+
+class PokerGameTestWrapper;
+
+/** Decider that lets seat 0 decide through the wrapper's decision callback, every other seat plays a pre-loaded action
+ */
+class ScriptedDecider
+{
+public:
+
+	/** ScriptedDecider constructor
+	 *  @param wrapper The wrapper holding the pre-loaded actions
+	 */
+	explicit ScriptedDecider(PokerGameTestWrapper* wrapper);
+
+	/** Decide an action
+	 *  @param state The full game state
+	 *  @param player_id The id of the player that is deciding
+	 *  @param rng A random number generator
+	 *  @return The action
+	 */
+	utl::pair<PokerGame::PlayerAction, uint16_t> decide(const PokerGameState& state, uint8_t player_id, Random& rng);
+
+private:
+
+	/// The wrapper holding the pre-loaded actions
+	PokerGameTestWrapper* wrapper;
+};
+
+/** Dealer that uses a user chosen dealer, and deals user chosen cards
+ */
+class ScriptedDealer
+{
+public:
+
+	/** ScriptedDealer constructor
+	 *  @param wrapper The wrapper holding the starting dealer and the pre-loaded cards
+	 */
+	explicit ScriptedDealer(PokerGameTestWrapper* wrapper);
+
+	/** Choose the user chosen dealer
+	 *  @return The dealer id
+	 */
+	uint8_t chooseDealer(Random& rng, uint8_t seats);
+
+	/** Skip shuffling, the cards are pre-loaded
+	 */
+	void shuffle(Deck& deck);
+
+	/** Deal a user chosen card
+	 *  @return The card
+	 */
+	Card dealCard(Deck& deck);
+
+private:
+
+	/// The wrapper holding the starting dealer and the pre-loaded cards
+	PokerGameTestWrapper* wrapper;
+};
 
 /** PokerGameTestWrapper class, provides additional access to PokerGame objects for testing purposes
  */
-class PokerGameTestWrapper : public PokerGame
+class PokerGameTestWrapper : public BasicPokerGame<6, ScriptedDecider, CallbackObserver<6>, ScriptedDealer>
 {
+	friend class ScriptedDecider;
+	friend class ScriptedDealer;
+
 public:
 
 	/** PokerGameTestWrapper constructor
@@ -171,22 +233,6 @@ private:
 	 */
 	static void gameEndCallback(const utl::string<MAX_NAME_SIZE>& winner, void* opaque);
 
-	/** Choose dealer override, sets a user chosen dealer
-	 *  @return The dealer id
-	 */
-	uint8_t chooseDealer() override;
-
-	/** Deal a card override, deals a user chosen card
-	 *  @return The card
-	 */
-	Card dealCard() override;
-
-	/** player action override, returns a user chosen action
-	 *  @param player_id The id of the player that is deciding
-	 *  @return The action
-	 */
-	utl::pair<PokerGame::PlayerAction, uint16_t> playerAction(uint8_t player_id) override;
-
 	/** Check that AI hands are un-revealed
 	 *  @param state The current poker game state
 	 */
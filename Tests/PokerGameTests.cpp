@@ -937,4 +937,197 @@ TEST_F(PokerGameTestFixture, CascadingSplitPots)
 
 	// We should have examined callback info in the range [0..EXPECTED_CB_INFO_CNT)
 	EXPECT_EQ(EXPECTED_CB_INFO_CNT, callback_index + 1);
+}
+
+TEST(PokerGameStateTests, SeatMaskHelpers)
+{
+	// Count seats
+	EXPECT_EQ(0, PokerGameState::countSeats(0x00));
+	EXPECT_EQ(1, PokerGameState::countSeats(0x20));
+	EXPECT_EQ(6, PokerGameState::countSeats(0x3F));
+
+	// Next seat wraps around the table
+	EXPECT_EQ(3, PokerGameState::nextSeat(0x29, 0));
+	EXPECT_EQ(5, PokerGameState::nextSeat(0x29, 3));
+	EXPECT_EQ(0, PokerGameState::nextSeat(0x29, 5));
+	EXPECT_EQ(2, PokerGameState::nextSeat(0x04, 2));
+}
+
+TEST_F(PokerGameTestFixture, SeatMasksTrackActions)
+{
+	// The dealer starts right of player 0
+	this->poker_game.setStartingDealer(5);
+
+	// You check, one AI goes all in, the rest fold, you call.
+	this->poker_game.pushAction(0, PokerGame::PlayerAction::CheckOrCall);
+	this->poker_game.pushAction(1, PokerGame::PlayerAction::Bet, 490);
+	this->poker_game.pushAction(2, PokerGame::PlayerAction::Fold);
+	this->poker_game.pushAction(3, PokerGame::PlayerAction::Fold);
+	this->poker_game.pushAction(4, PokerGame::PlayerAction::Fold);
+	this->poker_game.pushAction(5, PokerGame::PlayerAction::Fold);
+	this->poker_game.pushAction(0, PokerGame::PlayerAction::CheckOrCall);
+
+	// Deal each player two pre-determined cards and a pre-determined board
+	for (size_t i = 0; i < 2 * 6 + 5; ++i) {
+		this->poker_game.pushCard(static_cast<Card::Value>(i % 13), static_cast<Card::Suit>(i % 4));
+	}
+
+	// Run the poker game
+	this->poker_game.play();
+
+	// Everyone is dealt in pre flop
+	const PokerGameState& preflop = this->poker_game.callbackInfoAt(2).state;
+	EXPECT_EQ(0x3F, preflop.seated_mask);
+	EXPECT_EQ(0x3F, preflop.in_hand_mask);
+	EXPECT_EQ(0x3F, preflop.can_act_mask);
+	EXPECT_EQ(0x00, preflop.all_in_mask);
+
+	// After the folds and Ron's all in bet, you are the only player that may act
+	const PokerGameState& ron_all_in = this->poker_game.callbackInfoAt(10).state;
+	EXPECT_EQ(0x3F, ron_all_in.seated_mask);
+	EXPECT_EQ(0x03, ron_all_in.in_hand_mask);
+	EXPECT_EQ(0x01, ron_all_in.can_act_mask);
+	EXPECT_EQ(0x02, ron_all_in.all_in_mask);
+}
+
+/** Records the all in equity reported by a game
+ */
+struct EquityRecorder {
+	int calls = 0;
+	size_t board_size = 0;
+	PokerGameTestWrapper::AllInEquity equity;
+
+	static void record(const PokerGameTestWrapper::AllInEquity& equity, const PokerGameState& state, void* opaque)
+	{
+		EquityRecorder* recorder = reinterpret_cast<EquityRecorder*>(opaque);
+		++recorder->calls;
+		recorder->board_size = state.board.size();
+		recorder->equity = equity;
+	}
+};
+
+TEST_F(PokerGameTestFixture, AllInRunoutReportsEquity)
+{
+	// The dealer starts right of player 0
+	this->poker_game.setStartingDealer(5);
+
+	// You check, one AI goes all in, the rest fold, you call.
+	this->poker_game.pushAction(0, PokerGame::PlayerAction::CheckOrCall);
+	this->poker_game.pushAction(1, PokerGame::PlayerAction::Bet, 490);
+	this->poker_game.pushAction(2, PokerGame::PlayerAction::Fold);
+	this->poker_game.pushAction(3, PokerGame::PlayerAction::Fold);
+	this->poker_game.pushAction(4, PokerGame::PlayerAction::Fold);
+	this->poker_game.pushAction(5, PokerGame::PlayerAction::Fold);
+	this->poker_game.pushAction(0, PokerGame::PlayerAction::CheckOrCall);
+
+	// Deal each player two pre-determined cards and a pre-determined board
+	for (size_t i = 0; i < 2 * 6 + 5; ++i) {
+		this->poker_game.pushCard(static_cast<Card::Value>(i % 13), static_cast<Card::Suit>(i % 4));
+	}
+
+	// Run the poker game
+	EquityRecorder recorder;
+	this->poker_game.setAllInEquityCallback(&EquityRecorder::record, &recorder);
+	this->poker_game.play();
+
+	// Equity was reported once, pre-flop, over every five card board
+	EXPECT_EQ(1, recorder.calls);
+	EXPECT_EQ(0u, recorder.board_size);
+	EXPECT_EQ(1712304u, recorder.equity.boards);
+	EXPECT_EQ(static_cast<uint64_t>(recorder.equity.boards) * PokerGameTestWrapper::AllInEquity::SPLIT, recorder.equity.shares[0] + recorder.equity.shares[1]);
+	for (size_t i = 2; i < 6; ++i)
+		EXPECT_EQ(0u, recorder.equity.shares[i]);
+
+	// Ron's nine three beats your eight two more often than not
+	EXPECT_GT(recorder.equity.permyriad(1), recorder.equity.permyriad(0));
+
+	// Nobody was asked to act after your call
+	size_t decisions = 0;
+	for (size_t i = 0; i < this->poker_game.callbackInfoSize(); ++i) {
+		if (this->poker_game.callbackInfoAt(i).callback_type == PokerGameTestWrapper::CallbackType::Decision)
+			++decisions;
+	}
+	EXPECT_EQ(2u, decisions);
+}
+
+TEST_F(PokerGameTestFixture, ShortStackPostsAllInBlind)
+{
+	// The dealer starts right of player 0, Ron can not cover the big blind
+	this->poker_game.setStartingDealer(5);
+	this->poker_game.setPlayerStack(1, 3);
+
+	// Everyone folds to you, you call
+	this->poker_game.pushAction(2, PokerGame::PlayerAction::Fold);
+	this->poker_game.pushAction(3, PokerGame::PlayerAction::Fold);
+	this->poker_game.pushAction(4, PokerGame::PlayerAction::Fold);
+	this->poker_game.pushAction(5, PokerGame::PlayerAction::Fold);
+	this->poker_game.pushAction(0, PokerGame::PlayerAction::CheckOrCall);
+
+	// Deal each player two pre-determined cards and a pre-determined board
+	for (size_t i = 0; i < 2 * 6 + 5; ++i) {
+		this->poker_game.pushCard(static_cast<Card::Value>(i % 13), static_cast<Card::Suit>(i % 4));
+	}
+
+	// Run the poker game
+	this->poker_game.play();
+
+	// Ron is all in for three chips
+	const PokerGameTestWrapper::CallbackInfo& big_blind = this->poker_game.callbackInfoAt(1);
+	EXPECT_EQ(PokerGameTestWrapper::CallbackType::PlayerAction, big_blind.callback_type);
+	EXPECT_EQ("Ron", big_blind.player_name);
+	EXPECT_EQ(3, big_blind.bet);
+	EXPECT_EQ(0, big_blind.state.player_states[1].stack);
+	EXPECT_EQ(0x02, big_blind.state.all_in_mask);
+	EXPECT_EQ(8, big_blind.state.chipsRemaining());
+}
+
+TEST_F(PokerGameTestFixture, StepWaitsForPendingDecision)
+{
+	// The dealer starts right of player 0
+	this->poker_game.setStartingDealer(5);
+
+	// The AI fold to you, you take two steps to decide to fold
+	this->poker_game.pushAction(2, PokerGame::PlayerAction::Fold);
+	this->poker_game.pushAction(3, PokerGame::PlayerAction::Fold);
+	this->poker_game.pushAction(4, PokerGame::PlayerAction::Fold);
+	this->poker_game.pushAction(5, PokerGame::PlayerAction::Fold);
+	this->poker_game.pushAction(0, PokerGame::PlayerAction::Pending);
+	this->poker_game.pushAction(0, PokerGame::PlayerAction::Pending);
+	this->poker_game.pushAction(0, PokerGame::PlayerAction::Fold);
+
+	// Deal each player two pre-determined cards
+	for (size_t i = 0; i < 2 * 6; ++i) {
+		this->poker_game.pushCard(static_cast<Card::Value>(i % 13), static_cast<Card::Suit>(i % 4));
+	}
+
+	// Step the game to completion
+	std::vector<PokerGame::StepResult> results;
+	do {
+		results.push_back(this->poker_game.step());
+	} while (results.back() != PokerGame::StepResult::GameOver && results.size() < 100);
+
+	// Choose the dealer, start the round, four folds, two pending decisions, your fold ends the round, end the game
+	std::vector<PokerGame::StepResult> expected = {
+		PokerGame::StepResult::Running,
+		PokerGame::StepResult::Running,
+		PokerGame::StepResult::Running,
+		PokerGame::StepResult::Running,
+		PokerGame::StepResult::Running,
+		PokerGame::StepResult::Running,
+		PokerGame::StepResult::WaitingForInput,
+		PokerGame::StepResult::WaitingForInput,
+		PokerGame::StepResult::RoundOver,
+		PokerGame::StepResult::GameOver,
+	};
+	EXPECT_EQ(expected, results);
+
+	// The game stays over
+	EXPECT_EQ(PokerGame::StepResult::GameOver, this->poker_game.step());
+
+	// Ron won the blinds
+	EXPECT_EQ("Ron", this->poker_game.getNextRoundWinner());
+	EXPECT_EQ("Ron", this->poker_game.getNextGameWinner());
+	const PokerGameState& round_end = this->poker_game.callbackInfoAt(this->poker_game.callbackInfoSize() - 2).state;
+	EXPECT_EQ(495, round_end.player_states[0].stack);
+	EXPECT_EQ(505, round_end.player_states[1].stack);
 }
\ No newline at end of file
@@ -0,0 +1,130 @@
+/**
+ *  A simple interactive texas holdem poker program.
+ *  Copyright (C) 2020, Matt Zimmerer, mzimmere@gmail.com
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ **/
+
+#include "GTestIncludes.h"
+
+#include <utl/array>
+
+#include "PokerGame/AI.h"
+#include "PokerGame/PushFold.h"
+
+TEST(PushFoldTests, HandClasses)
+{
+	using V = Card::Value;
+	using S = Card::Suit;
+
+	// Every hand falls in one of the classes, pairs have 6 hands, suited hands 4 and offsuit hands 12
+	utl::array<int, PushFold::HAND_CLASSES> hands{};
+	for (uint8_t first = 0; first < 52; ++first) {
+		for (uint8_t second = first + 1; second < 52; ++second) {
+			utl::array<Card, 2> hand = { Card(static_cast<V>(first % 13), static_cast<S>(first / 13)),
+				Card(static_cast<V>(second % 13), static_cast<S>(second / 13)) };
+			uint8_t hand_class = PushFold::handClass(hand);
+			ASSERT_LT(hand_class, PushFold::HAND_CLASSES);
+			++hands[hand_class];
+		}
+	}
+	for (uint8_t hand_class = 0; hand_class < PushFold::HAND_CLASSES; ++hand_class) {
+		uint8_t row = hand_class / 13;
+		uint8_t column = hand_class % 13;
+		EXPECT_EQ(row == column ? 6 : row > column ? 4 : 12, hands[hand_class]) << "hand class " << static_cast<int>(hand_class);
+	}
+
+	// The order of the cards does not matter
+	utl::array<Card, 2> seven_deuce = { Card(V::Seven, S::Spades), Card(V::Two, S::Hearts) };
+	utl::array<Card, 2> deuce_seven = { Card(V::Two, S::Hearts), Card(V::Seven, S::Spades) };
+	EXPECT_EQ(PushFold::handClass(seven_deuce), PushFold::handClass(deuce_seven));
+	EXPECT_EQ(1, PushFold::depth(0, 20));
+	EXPECT_EQ(10, PushFold::depth(205, 20));
+}
+
+TEST(PushFoldTests, ChartsNarrowWithDepth)
+{
+	using V = Card::Value;
+	using S = Card::Suit;
+	uint8_t aces = PushFold::handClass({ Card(V::Ace, S::Spades), Card(V::Ace, S::Hearts) });
+	uint8_t seven_deuce = PushFold::handClass({ Card(V::Seven, S::Spades), Card(V::Two, S::Hearts) });
+
+	// Aces are always played, the weakest hand is not played deep, and deeper stacks play no more hands
+	int previous_pushes = PushFold::HAND_CLASSES;
+	int previous_calls = PushFold::HAND_CLASSES;
+	for (uint8_t depth = 1; depth <= PushFold::MAX_DEPTH; ++depth) {
+		EXPECT_TRUE(PushFold::push(aces, depth));
+		EXPECT_TRUE(PushFold::call(aces, depth));
+		int pushes = 0;
+		int calls = 0;
+		for (uint8_t hand_class = 0; hand_class < PushFold::HAND_CLASSES; ++hand_class) {
+			pushes += PushFold::push(hand_class, depth) ? 1 : 0;
+			calls += PushFold::call(hand_class, depth) ? 1 : 0;
+		}
+		EXPECT_LE(pushes, previous_pushes + 2) << "depth " << static_cast<int>(depth);
+		EXPECT_LE(calls, previous_calls + 2) << "depth " << static_cast<int>(depth);
+		previous_pushes = pushes;
+		previous_calls = calls;
+	}
+	EXPECT_FALSE(PushFold::push(seven_deuce, PushFold::MAX_DEPTH));
+	EXPECT_FALSE(PushFold::call(seven_deuce, PushFold::MAX_DEPTH));
+}
+
+#if AI_PUSH_FOLD_DEPTH >= 10
+/** Build a heads up state before the flop with 10 big blind stacks
+ *  @param hand The acting player's hand
+ *  @param facing_push True for the big blind facing a push, false for the small blind to open
+ *  @return The state, player 0 acts
+ */
+static BasicPokerGameState<2> shortStackState(const utl::array<Card, 2>& hand, bool facing_push)
+{
+	BasicPokerGameState<2> state;
+	state.player_states[0].hand = hand;
+	state.player_states[1].hand = { Card(Card::Value::King, Card::Suit::Clubs), Card(Card::Value::Queen, Card::Suit::Clubs) };
+	uint16_t shares[2] = { 10, 20 };
+	if (facing_push) {
+		shares[0] = 20;
+		shares[1] = 200;
+	}
+	for (uint8_t seat = 0; seat < 2; ++seat) {
+		state.current_pot_shares[seat] = shares[seat];
+		state.player_states[seat].pot_investment = shares[seat];
+		state.player_states[seat].stack = static_cast<uint16_t>(200 - shares[seat]);
+	}
+	state.current_bet = shares[1];
+	state.updateSeatMasks();
+	return state;
+}
+
+TEST(PushFoldTests, AIPushesOrFolds)
+{
+	using V = Card::Value;
+	using S = Card::Suit;
+	utl::array<Card, 2> aces = { Card(V::Ace, S::Spades), Card(V::Ace, S::Hearts) };
+	utl::array<Card, 2> seven_deuce = { Card(V::Seven, S::Spades), Card(V::Two, S::Hearts) };
+
+	// The small blind pushes aces all in and folds the weakest hand, every time
+	for (uint32_t seed = 0; seed < 20; ++seed) {
+		Random rng(seed);
+		utl::pair<PokerGameBase::PlayerAction, uint16_t> push = AI::quickDecision<2>(shortStackState(aces, false), rng, 0);
+		EXPECT_EQ(PokerGameBase::PlayerAction::Bet, push.first);
+		EXPECT_EQ(190, push.second);
+		EXPECT_EQ(PokerGameBase::PlayerAction::Fold, AI::quickDecision<2>(shortStackState(seven_deuce, false), rng, 0).first);
+
+		// The big blind calls a push with aces and folds the weakest hand
+		EXPECT_EQ(PokerGameBase::PlayerAction::CheckOrCall, AI::quickDecision<2>(shortStackState(aces, true), rng, 0).first);
+		EXPECT_EQ(PokerGameBase::PlayerAction::Fold, AI::quickDecision<2>(shortStackState(seven_deuce, true), rng, 0).first);
+	}
+}
+#endif
\ No newline at end of file
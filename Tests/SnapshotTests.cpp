@@ -0,0 +1,166 @@
+/**
+ *  A simple interactive texas holdem poker program.
+ *  Copyright (C) 2020, Matt Zimmerer, mzimmere@gmail.com
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ **/
+
+#include "GTestIncludes.h"
+
+#include <type_traits>
+#include <vector>
+
+#include "PokerGame/Deck.h"
+#include "PokerGame/PokerGameImpl.h"
+#include "PokerGame/Random.h"
+#include "PokerGameTestFixture.h"
+
+// Snapshots are forked and stored by copying their bytes
+static_assert(std::is_trivially_copyable<PokerGame::Snapshot>::value, "PokerGame::Snapshot must be trivially copyable");
+
+/** Observer that records every action, street and round result of a game
+ */
+class EventRecorder
+{
+public:
+
+	explicit EventRecorder(std::vector<uint32_t>* events_in) : events(events_in) {}
+
+	void playerAction(const utl::string<MAX_NAME_SIZE>&, PokerGameBase::PlayerAction action, uint16_t bet, const BasicPokerGameState<2>&)
+	{
+		this->events->push_back((static_cast<uint32_t>(action) << 16) | bet);
+	}
+
+	void subRoundChange(PokerGameBase::SubRound new_sub_round, const BasicPokerGameState<2>&)
+	{
+		this->events->push_back(0xFF000000u | static_cast<uint32_t>(new_sub_round));
+	}
+
+	bool roundEnd(bool, const utl::string<MAX_NAME_SIZE>&, uint16_t winnings, RankedHand::Ranking ranking, const BasicPokerGameState<2>&,
+		const utl::vector<uint8_t, 2>&)
+	{
+		this->events->push_back(0xFE000000u | (static_cast<uint32_t>(ranking) << 16) | winnings);
+		return true;
+	}
+
+	void gameEnd(const utl::string<MAX_NAME_SIZE>&) {}
+
+private:
+
+	std::vector<uint32_t>* events;
+};
+
+TEST(SnapshotTests, DeckAndRandomRestore)
+{
+	Random rng(1234);
+	Deck deck(rng);
+	deck.shuffle();
+
+	// Deal a few cards, then take a snapshot mid-deck
+	for (size_t i = 0; i < 3; ++i)
+		deck.dealCard();
+	Deck::Snapshot deck_snapshot = deck.takeSnapshot();
+	Random rng_snapshot = rng;
+
+	// Record the remaining deal order, and the order of the next shuffle
+	std::vector<Card> expected;
+	for (size_t i = 0; i < 10; ++i)
+		expected.push_back(deck.dealCard());
+	deck.shuffle();
+	for (size_t i = 0; i < 10; ++i)
+		expected.push_back(deck.dealCard());
+
+	// Restore and check that the same cards are dealt
+	deck.restoreSnapshot(deck_snapshot);
+	rng = rng_snapshot;
+	EXPECT_EQ(3, deck.cardsDealt());
+	std::vector<Card> actual;
+	for (size_t i = 0; i < 10; ++i)
+		actual.push_back(deck.dealCard());
+	deck.shuffle();
+	for (size_t i = 0; i < 10; ++i)
+		actual.push_back(deck.dealCard());
+
+	ASSERT_EQ(expected.size(), actual.size());
+	for (size_t i = 0; i < expected.size(); ++i) {
+		EXPECT_EQ(expected[i].getValue(), actual[i].getValue());
+		EXPECT_EQ(expected[i].getSuit(), actual[i].getSuit());
+	}
+}
+
+TEST_F(PokerGameTestFixture, SnapshotRestoresIntoFreshGame)
+{
+	// You are the big blind, and all the AI fold
+	this->poker_game.setStartingDealer(4);
+	for (uint8_t player_id = 1; player_id < 6; ++player_id)
+		this->poker_game.pushAction(player_id, PokerGame::PlayerAction::Fold);
+	for (size_t i = 0; i < 2 * 6; ++i)
+		this->poker_game.pushCard(static_cast<Card::Value>(i % 13), static_cast<Card::Suit>(i % 4));
+	this->poker_game.play();
+
+	// Restore the finished game into a fresh instance
+	PokerGame::Snapshot snapshot = this->poker_game.takeSnapshot();
+	PokerGameTestWrapper restored_game;
+	restored_game.restoreSnapshot(snapshot);
+	PokerGame::Snapshot restored = restored_game.takeSnapshot();
+
+	EXPECT_EQ(1u, restored.round_number);
+	EXPECT_EQ(snapshot.run, restored.run);
+	EXPECT_EQ(4, restored.state.current_dealer);
+	EXPECT_EQ(505, restored.state.player_states[0].stack);
+	EXPECT_EQ(495, restored.state.player_states[5].stack);
+	for (size_t i = 1; i < 5; ++i)
+		EXPECT_EQ(500, restored.state.player_states[i].stack);
+	EXPECT_EQ(0, restored.state.chipsRemaining());
+	EXPECT_EQ(snapshot.deck.deal_cursor, restored.deck.deal_cursor);
+}
+
+
+TEST(SnapshotTests, MidHandSnapshotContinuesIdentically)
+{
+	using Game = BasicPokerGame<2, AIDecider<2>, EventRecorder>;
+	std::vector<uint32_t> events;
+	Game game(21, 5, 500, AIDecider<2>(), EventRecorder(&events));
+
+	// Step into the second hand, until a player has put in more than the blinds
+	Game::Snapshot snapshot;
+	for (uint16_t i = 0; i < 1000; ++i) {
+		ASSERT_NE(Game::StepResult::GameOver, game.step());
+		snapshot = game.takeSnapshot();
+		if (game.getRoundNumber() == 2 && snapshot.state.player_states[0].pot_investment + snapshot.state.player_states[1].pot_investment > 15)
+			break;
+	}
+	ASSERT_EQ(2u, snapshot.round_number);
+
+	// Restore the hand in progress into a game with another seed
+	std::vector<uint32_t> restored_events;
+	Game restored_game(99, 5, 500, AIDecider<2>(), EventRecorder(&restored_events));
+	restored_game.restoreSnapshot(snapshot);
+
+	// Both games play on through the same events to the same end
+	events.clear();
+	Game::StepResult result = Game::StepResult::Running;
+	for (uint16_t i = 0; i < 5000 && result != Game::StepResult::GameOver; ++i) {
+		result = game.step();
+		EXPECT_EQ(result, restored_game.step());
+	}
+	EXPECT_EQ(Game::StepResult::GameOver, result);
+	EXPECT_FALSE(events.empty());
+	EXPECT_EQ(events, restored_events);
+	Game::Snapshot end = game.takeSnapshot();
+	Game::Snapshot restored_end = restored_game.takeSnapshot();
+	EXPECT_EQ(end.round_number, restored_end.round_number);
+	for (size_t i = 0; i < 2; ++i)
+		EXPECT_EQ(end.state.player_states[i].stack, restored_end.state.player_states[i].stack);
+}
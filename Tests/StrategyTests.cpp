@@ -0,0 +1,71 @@
+/**
+ *  A simple interactive texas holdem poker program.
+ *  Copyright (C) 2020, Matt Zimmerer, mzimmere@gmail.com
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ **/
+
+#include "GTestIncludes.h"
+
+#include "PokerGame/Random.h"
+#include "PokerGame/Strategy.h"
+
+TEST(StrategyTests, TrainedChancesAreLegal)
+{
+	// Every information set is either untrained or shares 255 between its legal actions
+	for (uint16_t information_set = 0; information_set < Strategy::INFORMATION_SETS; ++information_set) {
+		Strategy::Node node = static_cast<Strategy::Node>(information_set % Strategy::NODES);
+		int total = 0;
+		for (uint8_t action = 0; action < Strategy::ACTIONS; ++action) {
+			uint8_t chance = Strategy::probability(information_set, static_cast<Strategy::Action>(action));
+			if (Strategy::isLegal(node, static_cast<Strategy::Action>(action)) == false) {
+				EXPECT_EQ(0, chance) << "information set " << information_set;
+			}
+			total += chance;
+		}
+		EXPECT_TRUE(total == 0 || total == 255) << "information set " << information_set;
+	}
+
+	// Chosen actions are always legal
+	Random rng(1);
+	for (uint16_t information_set = 0; information_set < Strategy::INFORMATION_SETS; ++information_set) {
+		Strategy::Node node = static_cast<Strategy::Node>(information_set % Strategy::NODES);
+		for (int i = 0; i < 20; ++i)
+			EXPECT_TRUE(Strategy::isLegal(node, Strategy::chooseAction(information_set, rng))) << "information set " << information_set;
+	}
+}
+
+TEST(StrategyTests, CardBuckets)
+{
+	using V = Card::Value;
+	using S = Card::Suit;
+
+	// Pre-flop, aces are in the strongest bucket and seven deuce in the weakest
+	utl::vector<Card, 5> board;
+	EXPECT_EQ(Strategy::BUCKETS - 1, Strategy::cardBucket({ Card(V::Ace, S::Spades), Card(V::Ace, S::Hearts) }, board));
+	EXPECT_EQ(0, Strategy::cardBucket({ Card(V::Seven, S::Spades), Card(V::Two, S::Hearts) }, board));
+
+	// After the flop, a set is in a stronger bucket than nothing
+	board.push_back(Card(V::King, S::Hearts));
+	board.push_back(Card(V::Seven, S::Clubs));
+	board.push_back(Card(V::Two, S::Diamonds));
+	EXPECT_GT(Strategy::cardBucket({ Card(V::Seven, S::Spades), Card(V::Seven, S::Diamonds) }, board),
+		Strategy::cardBucket({ Card(V::Nine, S::Spades), Card(V::Eight, S::Diamonds) }, board));
+
+	// Information sets cover every street, position, bucket and node once
+	EXPECT_EQ(0, Strategy::informationSet(0, 0, 0, Strategy::OPEN));
+	EXPECT_EQ(Strategy::INFORMATION_SETS - 1, Strategy::informationSet(Strategy::STREETS - 1, Strategy::POSITIONS - 1, Strategy::BUCKETS - 1, Strategy::FACING_RAISE));
+	EXPECT_EQ(3, Strategy::street(5));
+	EXPECT_EQ(0, Strategy::street(0));
+}
\ No newline at end of file
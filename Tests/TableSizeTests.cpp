@@ -0,0 +1,166 @@
+/**
+ *  A simple interactive texas holdem poker program.
+ *  Copyright (C) 2020, Matt Zimmerer, mzimmere@gmail.com
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ **/
+
+#include "GTestIncludes.h"
+
+#include <string>
+
+#include "PokerGame/PokerGame.h"
+#include "PokerGame/PokerGameImpl.h"
+
+/** Plays a table of a given size where the human player always checks or calls
+ */
+template <uint8_t SEATS>
+class TableSizeHarness
+{
+public:
+
+	/// The number of rounds played
+	int rounds = 0;
+
+	/// The number of players that were dealt into the first round
+	uint8_t first_round_players = 0;
+
+	/// The game winner
+	std::string winner;
+
+	/// The maximum number of rounds to play
+	static constexpr int MAX_ROUNDS = 20;
+
+	/** Play a game to completion
+	 *  @param random_seed The random seed
+	 */
+	void play(uint32_t random_seed)
+	{
+		BasicPokerGame<SEATS> poker_game(random_seed, 5, 500, &decision, &playerAction, &subRoundChange, &roundEnd, &gameEnd, this);
+		poker_game.play();
+	}
+
+private:
+
+	using State = BasicPokerGameState<SEATS>;
+
+	static utl::pair<PokerGameBase::PlayerAction, uint16_t> decision(const State&, void*)
+	{
+		return utl::pair<PokerGameBase::PlayerAction, uint16_t>(PokerGameBase::PlayerAction::CheckOrCall, 0);
+	}
+
+	static void playerAction(const utl::string<MAX_NAME_SIZE>&, PokerGameBase::PlayerAction, uint16_t, const State&, void*) {}
+
+	static void subRoundChange(PokerGameBase::SubRound new_sub_round, const State& state, void* opaque)
+	{
+		TableSizeHarness* harness = static_cast<TableSizeHarness*>(opaque);
+		if (harness->rounds == 0 && new_sub_round == PokerGameBase::SubRound::PreFlop)
+			harness->first_round_players = State::countSeats(state.seated_mask);
+	}
+
+	static bool roundEnd(bool, const utl::string<MAX_NAME_SIZE>&, uint16_t, RankedHand::Ranking, const State&, void* opaque)
+	{
+		TableSizeHarness* harness = static_cast<TableSizeHarness*>(opaque);
+		return ++harness->rounds < MAX_ROUNDS;
+	}
+
+	static void gameEnd(const utl::string<MAX_NAME_SIZE>& winner, void* opaque)
+	{
+		TableSizeHarness* harness = static_cast<TableSizeHarness*>(opaque);
+		harness->winner = std::string(winner.begin(), winner.end());
+	}
+};
+
+/** Observer that counts rounds and stops the game after a fixed number of them
+ */
+template <uint8_t SEATS>
+class RoundCountingObserver
+{
+public:
+
+	explicit RoundCountingObserver(int max_rounds_in) : max_rounds(max_rounds_in) {}
+
+	void playerAction(const utl::string<MAX_NAME_SIZE>&, PokerGameBase::PlayerAction, uint16_t, const BasicPokerGameState<SEATS>&) {}
+
+	void subRoundChange(PokerGameBase::SubRound, const BasicPokerGameState<SEATS>&) {}
+
+	bool roundEnd(bool, const utl::string<MAX_NAME_SIZE>&, uint16_t, RankedHand::Ranking, const BasicPokerGameState<SEATS>&,
+		const utl::vector<uint8_t, SEATS>&)
+	{
+		return ++this->rounds < this->max_rounds;
+	}
+
+	void gameEnd(const utl::string<MAX_NAME_SIZE>&)
+	{
+		this->game_ended = true;
+	}
+
+	int rounds = 0;
+	bool game_ended = false;
+
+private:
+
+	int max_rounds;
+};
+
+TEST(TableSizeTests, StateIsSizedByTable)
+{
+	EXPECT_EQ(2, HeadsUpPokerGame::PokerGameState::SEATS);
+	EXPECT_EQ(9, FullRingPokerGame::PokerGameState::SEATS);
+	EXPECT_LT(sizeof(BasicPokerGameState<2>), sizeof(BasicPokerGameState<6>));
+	EXPECT_EQ(sizeof(uint8_t), sizeof(BasicPokerGameState<6>::SeatMask));
+	EXPECT_EQ(sizeof(uint16_t), sizeof(BasicPokerGameState<9>::SeatMask));
+}
+
+TEST(TableSizeTests, HeadsUpGame)
+{
+	TableSizeHarness<2> harness;
+	harness.play(1234);
+	EXPECT_GT(harness.rounds, 0);
+	EXPECT_EQ(2, harness.first_round_players);
+	EXPECT_FALSE(harness.winner.empty());
+}
+
+TEST(TableSizeTests, FullRingGame)
+{
+	TableSizeHarness<9> harness;
+	harness.play(4321);
+	EXPECT_GT(harness.rounds, 0);
+	EXPECT_EQ(9, harness.first_round_players);
+	EXPECT_FALSE(harness.winner.empty());
+}
+
+TEST(TableSizeTests, FullRingSeatMaskHelpers)
+{
+	using State = BasicPokerGameState<9>;
+	EXPECT_EQ(9, State::countSeats(0x1FF));
+	EXPECT_EQ(8, State::nextSeat(0x101, 0));
+	EXPECT_EQ(0, State::nextSeat(0x101, 8));
+	EXPECT_EQ(8, State::lowestSeat(0x100));
+}
+
+TEST(TableSizeTests, AllAIHeadsUpPolicies)
+{
+	using Game = BasicPokerGame<2, AIDecider<2>, RoundCountingObserver<2>>;
+
+	// Batch simulation configuration, every seat is played by the AI and nothing is drawn
+	struct AccessibleGame : public Game {
+		using Game::Game;
+		const RoundCountingObserver<2>& getObserver() const { return this->observer; }
+	};
+	AccessibleGame game(99, 5, 500, AIDecider<2>(), RoundCountingObserver<2>(10));
+	game.play();
+	EXPECT_GT(game.getObserver().rounds, 0);
+	EXPECT_TRUE(game.getObserver().game_ended);
+}
\ No newline at end of file